@@ -31,6 +31,7 @@ TASKS = [
     ("raytrace", "lancer de rayons", "480&times;360, f64, r&eacute;cursion"),
     ("leven", "Levenshtein", "40 requ&ecirc;tes contre 6000 mots"),
     ("chacha", "ChaCha20", "16 Mio de flot de cl&eacute;, lanes 32 bits, rotations"),
+    ("dispatch", "interpr&eacute;teur", "16 M instructions, 16 opcodes, un switch par instruction"),
 ]
 TASK_IDS = [t[0] for t in TASKS]
 
@@ -0,0 +1,145 @@
+#include "common.h"
+
+static const u64 PROG = 4096; // instructions in the generated program
+static const u64 RUNS = 4096; // passes over it, sixteen million dispatches
+static const u64 M32  = 0xFFFFFFFF;
+
+typedef uint32_t u32;
+
+enum Op : u8
+{
+    OP_LOADI,
+    OP_ADD,
+    OP_SUB,
+    OP_XOR,
+    OP_AND,
+    OP_OR,
+    OP_SHR,
+    OP_ROL,
+    OP_ADDI,
+    OP_MULI,
+    OP_MOV,
+    OP_NOT,
+    OP_SKIP,
+    OP_ACC,
+    OP_MIN,
+    OP_SWAP,
+};
+
+static inline u64 rol(u64 x, u64 k)
+{
+    return ((x << k) | (x >> (32 - k))) & M32;
+}
+
+int main()
+{
+    // ---- data generation (not timed) ----
+    u8*  ops = (u8*) xalloc(PROG);
+    u8*  ra  = (u8*) xalloc(PROG);
+    u8*  rb  = (u8*) xalloc(PROG);
+    u64* imm = (u64*) xalloc(PROG * sizeof(u64));
+    for (u64 i = 0; i < PROG; i++)
+    {
+        ops[i]  = (u8) (rnd() % 16);
+        ra[i]   = (u8) (rnd() % 8);
+        rb[i]   = (u8) (rnd() % 8);
+        u64 raw = rnd();
+        if (ops[i] == OP_SHR || ops[i] == OP_ROL)
+            imm[i] = 1 + raw % 31;
+        else
+            imm[i] = raw % 65536;
+    }
+
+    u64 regs[8];
+    for (u64 i = 0; i < 8; i++)
+        regs[i] = rnd() & M32;
+
+    // ---- timed work ----
+    double t0 = now();
+
+    u64 acc = 0;
+    for (u64 run = 0; run < RUNS; run++)
+    {
+        // Every pass starts from a different state, so no two passes compute the same thing.
+        regs[run % 8] ^= run;
+
+        u64 pc = 0;
+        while (pc < PROG)
+        {
+            u64 a = ra[pc];
+            switch (ops[pc])
+            {
+            case OP_LOADI:
+                regs[a] = imm[pc];
+                break;
+            case OP_ADD:
+                regs[a] = (regs[a] + regs[rb[pc]]) & M32;
+                break;
+            case OP_SUB:
+                regs[a] = (regs[a] + M32 + 1 - regs[rb[pc]]) & M32;
+                break;
+            case OP_XOR:
+                regs[a] ^= regs[rb[pc]];
+                break;
+            case OP_AND:
+                regs[a] &= regs[rb[pc]];
+                break;
+            case OP_OR:
+                regs[a] |= regs[rb[pc]];
+                break;
+            case OP_SHR:
+                regs[a] >>= imm[pc];
+                break;
+            case OP_ROL:
+                regs[a] = rol(regs[a], imm[pc]);
+                break;
+            case OP_ADDI:
+                regs[a] = (regs[a] + imm[pc]) & M32;
+                break;
+            case OP_MULI:
+                regs[a] = (regs[a] * imm[pc]) & M32;
+                break;
+            case OP_MOV:
+                regs[a] = regs[rb[pc]];
+                break;
+            case OP_NOT:
+                regs[a] = M32 - regs[a];
+                break;
+            case OP_SKIP:
+                if (regs[a] & 1)
+                    pc += 1;
+                break;
+            case OP_ACC:
+                acc = rol(acc, 5) ^ regs[a];
+                break;
+            case OP_MIN:
+                if (regs[rb[pc]] < regs[a])
+                    regs[a] = regs[rb[pc]];
+                break;
+            case OP_SWAP:
+            {
+                u64 b   = rb[pc];
+                u64 t   = regs[a];
+                regs[a] = regs[b];
+                regs[b] = t;
+                break;
+            }
+            }
+
+            pc += 1;
+        }
+    }
+
+    u64 check = acc;
+    for (u64 i = 0; i < 8; i++)
+        check = rol(check, 3) ^ regs[i];
+
+    double t1 = now();
+    report(check, t0, t1);
+
+    free(ops);
+    free(ra);
+    free(rb);
+    free(imm);
+    return 0;
+}
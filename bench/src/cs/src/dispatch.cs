@@ -0,0 +1,147 @@
+using System;
+using System.Diagnostics;
+
+static class Bench
+{
+    const int PROG = 4096; // instructions in the generated program
+    const ulong RUNS = 4096; // passes over it, sixteen million dispatches
+    const ulong M32 = 0xFFFFFFFF;
+
+    const byte OP_LOADI = 0;
+    const byte OP_ADD = 1;
+    const byte OP_SUB = 2;
+    const byte OP_XOR = 3;
+    const byte OP_AND = 4;
+    const byte OP_OR = 5;
+    const byte OP_SHR = 6;
+    const byte OP_ROL = 7;
+    const byte OP_ADDI = 8;
+    const byte OP_MULI = 9;
+    const byte OP_MOV = 10;
+    const byte OP_NOT = 11;
+    const byte OP_SKIP = 12;
+    const byte OP_ACC = 13;
+    const byte OP_MIN = 14;
+    const byte OP_SWAP = 15;
+
+    static ulong gSeed = 12345;
+
+    static ulong Rnd()
+    {
+        gSeed = (gSeed * 16807) % 2147483647;
+        return gSeed;
+    }
+
+    static ulong Rol(ulong x, int k)
+    {
+        return ((x << k) | (x >> (32 - k))) & M32;
+    }
+
+    static int Main()
+    {
+        // ---- data generation (not timed) ----
+        var ops = new byte[PROG];
+        var ra = new int[PROG];
+        var rb = new int[PROG];
+        var imm = new ulong[PROG];
+        for (int i = 0; i < PROG; i++)
+        {
+            ops[i] = (byte) (Rnd() % 16);
+            ra[i] = (int) (Rnd() % 8);
+            rb[i] = (int) (Rnd() % 8);
+            ulong raw = Rnd();
+            if (ops[i] == OP_SHR || ops[i] == OP_ROL)
+                imm[i] = 1 + raw % 31;
+            else
+                imm[i] = raw % 65536;
+        }
+
+        var regs = new ulong[8];
+        for (int i = 0; i < 8; i++)
+            regs[i] = Rnd() & M32;
+
+        // ---- timed work ----
+        long start_t = Stopwatch.GetTimestamp();
+
+        ulong acc = 0;
+        for (ulong run = 0; run < RUNS; run++)
+        {
+            // Every pass starts from a different state, so no two passes compute the same thing.
+            regs[(int) (run % 8)] ^= run;
+
+            int pc = 0;
+            while (pc < PROG)
+            {
+                int a = ra[pc];
+                switch (ops[pc])
+                {
+                    case OP_LOADI:
+                        regs[a] = imm[pc];
+                        break;
+                    case OP_ADD:
+                        regs[a] = (regs[a] + regs[rb[pc]]) & M32;
+                        break;
+                    case OP_SUB:
+                        regs[a] = (regs[a] + M32 + 1 - regs[rb[pc]]) & M32;
+                        break;
+                    case OP_XOR:
+                        regs[a] ^= regs[rb[pc]];
+                        break;
+                    case OP_AND:
+                        regs[a] &= regs[rb[pc]];
+                        break;
+                    case OP_OR:
+                        regs[a] |= regs[rb[pc]];
+                        break;
+                    case OP_SHR:
+                        regs[a] >>= (int) imm[pc];
+                        break;
+                    case OP_ROL:
+                        regs[a] = Rol(regs[a], (int) imm[pc]);
+                        break;
+                    case OP_ADDI:
+                        regs[a] = (regs[a] + imm[pc]) & M32;
+                        break;
+                    case OP_MULI:
+                        regs[a] = (regs[a] * imm[pc]) & M32;
+                        break;
+                    case OP_MOV:
+                        regs[a] = regs[rb[pc]];
+                        break;
+                    case OP_NOT:
+                        regs[a] = M32 - regs[a];
+                        break;
+                    case OP_SKIP:
+                        if ((regs[a] & 1) != 0)
+                            pc += 1;
+                        break;
+                    case OP_ACC:
+                        acc = Rol(acc, 5) ^ regs[a];
+                        break;
+                    case OP_MIN:
+                        if (regs[rb[pc]] < regs[a])
+                            regs[a] = regs[rb[pc]];
+                        break;
+                    case OP_SWAP:
+                    {
+                        int b = rb[pc];
+                        ulong t = regs[a];
+                        regs[a] = regs[b];
+                        regs[b] = t;
+                        break;
+                    }
+                }
+
+                pc += 1;
+            }
+        }
+
+        ulong check = acc;
+        for (int i = 0; i < 8; i++)
+            check = Rol(check, 3) ^ regs[i];
+
+        double ms = (Stopwatch.GetTimestamp() - start_t) * 1000.0 / Stopwatch.Frequency;
+        Console.WriteLine($"CHECK={check} MS={ms:F6}");
+        return 0;
+    }
+}
@@ -0,0 +1,78 @@
+const PROG = 4096; // instructions in the generated program
+const RUNS = 4096; // passes over it, sixteen million dispatches
+
+const OP_LOADI = 0, OP_ADD = 1, OP_SUB = 2, OP_XOR = 3, OP_AND = 4, OP_OR = 5, OP_SHR = 6, OP_ROL = 7;
+const OP_ADDI = 8, OP_MULI = 9, OP_MOV = 10, OP_NOT = 11, OP_SKIP = 12, OP_ACC = 13, OP_MIN = 14, OP_SWAP = 15;
+
+let seed = 12345;
+function rnd() {
+    seed = (seed * 16807) % 2147483647;
+    return seed;
+}
+
+function rol(x, k) {
+    return ((x << k) | (x >>> (32 - k))) >>> 0;
+}
+
+// ---- data generation (not timed) ----
+const ops = new Uint8Array(PROG);
+const ra = new Uint8Array(PROG);
+const rb = new Uint8Array(PROG);
+const imm = new Uint32Array(PROG);
+for (let i = 0; i < PROG; i++) {
+    ops[i] = rnd() % 16;
+    ra[i] = rnd() % 8;
+    rb[i] = rnd() % 8;
+    const raw = rnd();
+    if (ops[i] === OP_SHR || ops[i] === OP_ROL) imm[i] = 1 + raw % 31;
+    else imm[i] = raw % 65536;
+}
+
+const regs = new Uint32Array(8);
+for (let i = 0; i < 8; i++) regs[i] = rnd() >>> 0;
+
+// ---- timed work ----
+const t0 = performance.now();
+
+let acc = 0;
+for (let run = 0; run < RUNS; run++) {
+    // Every pass starts from a different state, so no two passes compute the same thing.
+    regs[run % 8] ^= run;
+
+    let pc = 0;
+    while (pc < PROG) {
+        const a = ra[pc];
+        switch (ops[pc]) {
+            case OP_LOADI: regs[a] = imm[pc]; break;
+            case OP_ADD: regs[a] = regs[a] + regs[rb[pc]]; break;
+            case OP_SUB: regs[a] = regs[a] - regs[rb[pc]]; break;
+            case OP_XOR: regs[a] ^= regs[rb[pc]]; break;
+            case OP_AND: regs[a] &= regs[rb[pc]]; break;
+            case OP_OR: regs[a] |= regs[rb[pc]]; break;
+            case OP_SHR: regs[a] = regs[a] >>> imm[pc]; break;
+            case OP_ROL: regs[a] = rol(regs[a], imm[pc]); break;
+            case OP_ADDI: regs[a] = regs[a] + imm[pc]; break;
+            case OP_MULI: regs[a] = Math.imul(regs[a], imm[pc]); break;
+            case OP_MOV: regs[a] = regs[rb[pc]]; break;
+            case OP_NOT: regs[a] = ~regs[a]; break;
+            case OP_SKIP: if (regs[a] & 1) pc += 1; break;
+            case OP_ACC: acc = (rol(acc, 5) ^ regs[a]) >>> 0; break;
+            case OP_MIN: if (regs[rb[pc]] < regs[a]) regs[a] = regs[rb[pc]]; break;
+            case OP_SWAP: {
+                const b = rb[pc];
+                const t = regs[a];
+                regs[a] = regs[b];
+                regs[b] = t;
+                break;
+            }
+        }
+
+        pc += 1;
+    }
+}
+
+let check = acc;
+for (let i = 0; i < 8; i++) check = (rol(check, 3) ^ regs[i]) >>> 0;
+
+const t1 = performance.now();
+console.log("CHECK=" + check + " MS=" + (t1 - t0).toFixed(3));
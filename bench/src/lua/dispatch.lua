@@ -0,0 +1,107 @@
+local PROG = 4096 -- instructions in the generated program
+local RUNS = 4096 -- passes over it, sixteen million dispatches
+
+local U = 4294967296
+local M = U - 1
+
+local OP_LOADI, OP_ADD, OP_SUB, OP_XOR, OP_AND, OP_OR, OP_SHR, OP_ROL = 0, 1, 2, 3, 4, 5, 6, 7
+local OP_ADDI, OP_MULI, OP_MOV, OP_NOT, OP_SKIP, OP_ACC, OP_MIN = 8, 9, 10, 11, 12, 13, 14
+
+-- bit-operation shim: LuaJIT/5.1 use the "bit" library, 5.4 uses native operators
+local band, bor, bxor, lshift, rshift
+local ok, bitlib = pcall(require, "bit")
+if ok then
+    band, bor, bxor = bitlib.band, bitlib.bor, bitlib.bxor
+    lshift, rshift = bitlib.lshift, bitlib.rshift
+else
+    band = load("return function(a,b) return a & b end")()
+    bor = load("return function(a,b) return a | b end")()
+    bxor = load("return function(a,b) return a ~ b end")()
+    lshift = load("return function(a,b) return (a << b) & 0xffffffff end")()
+    rshift = load("return function(a,b) return (a & 0xffffffff) >> b end")()
+end
+
+local function ROL(x, k) return (lshift(x, k) % U + rshift(x, 32 - k) % U) % U end
+local function XOR(a, b) return bxor(a, b) % U end
+
+local seed = 12345
+local function rnd()
+    seed = (seed * 16807) % 2147483647
+    return seed
+end
+
+-- ---- data generation (not timed) ----
+local ops, ra, rb, imm = {}, {}, {}, {}
+for i = 1, PROG do
+    ops[i] = rnd() % 16
+    ra[i] = rnd() % 8 + 1
+    rb[i] = rnd() % 8 + 1
+    local raw = rnd()
+    if ops[i] == OP_SHR or ops[i] == OP_ROL then
+        imm[i] = 1 + raw % 31
+    else
+        imm[i] = raw % 65536
+    end
+end
+
+-- one-based, so register n lives at index n + 1
+local regs = {}
+for i = 1, 8 do regs[i] = rnd() % U end
+
+-- ---- timed work ----
+local t0 = os.clock()
+
+local acc = 0
+for run = 0, RUNS - 1 do
+    -- every pass starts from a different state, so no two passes compute the same thing
+    regs[run % 8 + 1] = XOR(regs[run % 8 + 1], run)
+
+    local pc = 1
+    while pc <= PROG do
+        local op = ops[pc]
+        local a = ra[pc]
+        if op == OP_LOADI then
+            regs[a] = imm[pc]
+        elseif op == OP_ADD then
+            regs[a] = (regs[a] + regs[rb[pc]]) % U
+        elseif op == OP_SUB then
+            regs[a] = (regs[a] - regs[rb[pc]]) % U
+        elseif op == OP_XOR then
+            regs[a] = XOR(regs[a], regs[rb[pc]])
+        elseif op == OP_AND then
+            regs[a] = band(regs[a], regs[rb[pc]]) % U
+        elseif op == OP_OR then
+            regs[a] = bor(regs[a], regs[rb[pc]]) % U
+        elseif op == OP_SHR then
+            regs[a] = rshift(regs[a], imm[pc]) % U
+        elseif op == OP_ROL then
+            regs[a] = ROL(regs[a], imm[pc])
+        elseif op == OP_ADDI then
+            regs[a] = (regs[a] + imm[pc]) % U
+        elseif op == OP_MULI then
+            regs[a] = (regs[a] * imm[pc]) % U
+        elseif op == OP_MOV then
+            regs[a] = regs[rb[pc]]
+        elseif op == OP_NOT then
+            regs[a] = M - regs[a]
+        elseif op == OP_SKIP then
+            if regs[a] % 2 == 1 then pc = pc + 1 end
+        elseif op == OP_ACC then
+            acc = XOR(ROL(acc, 5), regs[a])
+        elseif op == OP_MIN then
+            if regs[rb[pc]] < regs[a] then regs[a] = regs[rb[pc]] end
+        else
+            local b = rb[pc]
+            regs[a], regs[b] = regs[b], regs[a]
+        end
+        pc = pc + 1
+    end
+end
+
+local check = acc
+for i = 1, 8 do
+    check = XOR(ROL(check, 3), regs[i])
+end
+
+local t1 = os.clock()
+print(string.format("CHECK=%d MS=%.3f", check, (t1 - t0) * 1000.0))
@@ -0,0 +1,90 @@
+import time
+
+PROG = 4096  # instructions in the generated program
+RUNS = 4096  # passes over it, sixteen million dispatches
+M = 0xffffffff
+
+OP_LOADI, OP_ADD, OP_SUB, OP_XOR, OP_AND, OP_OR, OP_SHR, OP_ROL = range(8)
+OP_ADDI, OP_MULI, OP_MOV, OP_NOT, OP_SKIP, OP_ACC, OP_MIN, OP_SWAP = range(8, 16)
+
+seed = 12345
+def rnd():
+    global seed
+    seed = (seed * 16807) % 2147483647
+    return seed
+
+def rol(x, k):
+    return ((x << k) | (x >> (32 - k))) & M
+
+# ---- data generation (not timed) ----
+ops = [0] * PROG
+ra = [0] * PROG
+rb = [0] * PROG
+imm = [0] * PROG
+for i in range(PROG):
+    ops[i] = rnd() % 16
+    ra[i] = rnd() % 8
+    rb[i] = rnd() % 8
+    raw = rnd()
+    if ops[i] == OP_SHR or ops[i] == OP_ROL:
+        imm[i] = 1 + raw % 31
+    else:
+        imm[i] = raw % 65536
+
+regs = [rnd() & M for _ in range(8)]
+
+# ---- timed work ----
+t0 = time.perf_counter()
+
+acc = 0
+for run in range(RUNS):
+    # Every pass starts from a different state, so no two passes compute the same thing.
+    regs[run % 8] ^= run
+
+    pc = 0
+    while pc < PROG:
+        op = ops[pc]
+        a = ra[pc]
+        if op == OP_LOADI:
+            regs[a] = imm[pc]
+        elif op == OP_ADD:
+            regs[a] = (regs[a] + regs[rb[pc]]) & M
+        elif op == OP_SUB:
+            regs[a] = (regs[a] - regs[rb[pc]]) & M
+        elif op == OP_XOR:
+            regs[a] ^= regs[rb[pc]]
+        elif op == OP_AND:
+            regs[a] &= regs[rb[pc]]
+        elif op == OP_OR:
+            regs[a] |= regs[rb[pc]]
+        elif op == OP_SHR:
+            regs[a] >>= imm[pc]
+        elif op == OP_ROL:
+            regs[a] = rol(regs[a], imm[pc])
+        elif op == OP_ADDI:
+            regs[a] = (regs[a] + imm[pc]) & M
+        elif op == OP_MULI:
+            regs[a] = (regs[a] * imm[pc]) & M
+        elif op == OP_MOV:
+            regs[a] = regs[rb[pc]]
+        elif op == OP_NOT:
+            regs[a] = M - regs[a]
+        elif op == OP_SKIP:
+            if regs[a] & 1:
+                pc += 1
+        elif op == OP_ACC:
+            acc = rol(acc, 5) ^ regs[a]
+        elif op == OP_MIN:
+            if regs[rb[pc]] < regs[a]:
+                regs[a] = regs[rb[pc]]
+        else:
+            b = rb[pc]
+            regs[a], regs[b] = regs[b], regs[a]
+        pc += 1
+
+check = acc
+for i in range(8):
+    check = rol(check, 3) ^ regs[i]
+
+t1 = time.perf_counter()
+print("CHECK=%d MS=%.3f" % (check, (t1 - t0) * 1000.0))
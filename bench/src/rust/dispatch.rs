@@ -0,0 +1,111 @@
+use std::time::Instant;
+
+const PROG: usize = 4096; // instructions in the generated program
+const RUNS: u64 = 4096; // passes over it, sixteen million dispatches
+const M32: u64 = 0xFFFFFFFF;
+
+const OP_LOADI: u8 = 0;
+const OP_ADD: u8 = 1;
+const OP_SUB: u8 = 2;
+const OP_XOR: u8 = 3;
+const OP_AND: u8 = 4;
+const OP_OR: u8 = 5;
+const OP_SHR: u8 = 6;
+const OP_ROL: u8 = 7;
+const OP_ADDI: u8 = 8;
+const OP_MULI: u8 = 9;
+const OP_MOV: u8 = 10;
+const OP_NOT: u8 = 11;
+const OP_SKIP: u8 = 12;
+const OP_ACC: u8 = 13;
+const OP_MIN: u8 = 14;
+const OP_SWAP: u8 = 15;
+
+static mut G_SEED: u64 = 12345;
+
+fn rnd() -> u64 {
+    unsafe {
+        G_SEED = (G_SEED * 16807) % 2147483647;
+        G_SEED
+    }
+}
+
+#[inline(always)]
+fn rol(x: u64, k: u64) -> u64 {
+    ((x << k) | (x >> (32 - k))) & M32
+}
+
+fn main() {
+    // ---- data generation (not timed) ----
+    let mut ops = vec![0u8; PROG];
+    let mut ra = vec![0usize; PROG];
+    let mut rb = vec![0usize; PROG];
+    let mut imm = vec![0u64; PROG];
+    for i in 0..PROG {
+        ops[i] = (rnd() % 16) as u8;
+        ra[i] = (rnd() % 8) as usize;
+        rb[i] = (rnd() % 8) as usize;
+        let raw = rnd();
+        if ops[i] == OP_SHR || ops[i] == OP_ROL {
+            imm[i] = 1 + raw % 31;
+        } else {
+            imm[i] = raw % 65536;
+        }
+    }
+
+    let mut regs = [0u64; 8];
+    for i in 0..8 {
+        regs[i] = rnd() & M32;
+    }
+
+    // ---- timed work ----
+    let start_t = Instant::now();
+
+    let mut acc: u64 = 0;
+    for run in 0..RUNS {
+        // Every pass starts from a different state, so no two passes compute the same thing.
+        regs[(run % 8) as usize] ^= run;
+
+        let mut pc = 0usize;
+        while pc < PROG {
+            let a = ra[pc];
+            match ops[pc] {
+                OP_LOADI => regs[a] = imm[pc],
+                OP_ADD => regs[a] = (regs[a] + regs[rb[pc]]) & M32,
+                OP_SUB => regs[a] = (regs[a] + M32 + 1 - regs[rb[pc]]) & M32,
+                OP_XOR => regs[a] ^= regs[rb[pc]],
+                OP_AND => regs[a] &= regs[rb[pc]],
+                OP_OR => regs[a] |= regs[rb[pc]],
+                OP_SHR => regs[a] >>= imm[pc],
+                OP_ROL => regs[a] = rol(regs[a], imm[pc]),
+                OP_ADDI => regs[a] = (regs[a] + imm[pc]) & M32,
+                OP_MULI => regs[a] = (regs[a] * imm[pc]) & M32,
+                OP_MOV => regs[a] = regs[rb[pc]],
+                OP_NOT => regs[a] = M32 - regs[a],
+                OP_SKIP => {
+                    if regs[a] & 1 != 0 {
+                        pc += 1;
+                    }
+                }
+                OP_ACC => acc = rol(acc, 5) ^ regs[a],
+                OP_MIN => {
+                    if regs[rb[pc]] < regs[a] {
+                        regs[a] = regs[rb[pc]];
+                    }
+                }
+                OP_SWAP => regs.swap(a, rb[pc]),
+                _ => {}
+            }
+
+            pc += 1;
+        }
+    }
+
+    let mut check = acc;
+    for i in 0..8 {
+        check = rol(check, 3) ^ regs[i];
+    }
+
+    let ms = start_t.elapsed().as_secs_f64() * 1000.0;
+    println!("CHECK={} MS={:.6}", check, ms);
+}
@@ -0,0 +1,131 @@
+import WinSDK
+import Foundation
+
+let PROG = 4096 // instructions in the generated program
+let RUNS: UInt64 = 4096 // passes over it, sixteen million dispatches
+let M32: UInt64 = 0xFFFFFFFF
+
+let OP_LOADI: UInt8 = 0
+let OP_ADD: UInt8 = 1
+let OP_SUB: UInt8 = 2
+let OP_XOR: UInt8 = 3
+let OP_AND: UInt8 = 4
+let OP_OR: UInt8 = 5
+let OP_SHR: UInt8 = 6
+let OP_ROL: UInt8 = 7
+let OP_ADDI: UInt8 = 8
+let OP_MULI: UInt8 = 9
+let OP_MOV: UInt8 = 10
+let OP_NOT: UInt8 = 11
+let OP_SKIP: UInt8 = 12
+let OP_ACC: UInt8 = 13
+let OP_MIN: UInt8 = 14
+let OP_SWAP: UInt8 = 15
+
+var gSeed: UInt64 = 12345
+
+func rnd() -> UInt64 {
+    gSeed = (gSeed &* 16807) % 2147483647
+    return gSeed
+}
+
+func now() -> Double {
+    var c = LARGE_INTEGER()
+    var f = LARGE_INTEGER()
+    QueryPerformanceCounter(&c)
+    QueryPerformanceFrequency(&f)
+    return Double(c.QuadPart) / Double(f.QuadPart)
+}
+
+@inline(__always)
+func rol(_ x: UInt64, _ k: UInt64) -> UInt64 {
+    return ((x &<< k) | (x &>> (32 - k))) & M32
+}
+
+func runMain() {
+    // ---- data generation (not timed) ----
+    var ops = [UInt8](repeating: 0, count: PROG)
+    var ra = [Int](repeating: 0, count: PROG)
+    var rb = [Int](repeating: 0, count: PROG)
+    var imm = [UInt64](repeating: 0, count: PROG)
+    for i in 0..<PROG {
+        ops[i] = UInt8(rnd() % 16)
+        ra[i] = Int(rnd() % 8)
+        rb[i] = Int(rnd() % 8)
+        let raw = rnd()
+        if ops[i] == OP_SHR || ops[i] == OP_ROL {
+            imm[i] = 1 + raw % 31
+        } else {
+            imm[i] = raw % 65536
+        }
+    }
+
+    var regs = [UInt64](repeating: 0, count: 8)
+    for i in 0..<8 {
+        regs[i] = rnd() & M32
+    }
+
+    // ---- timed work ----
+    let t0 = now()
+
+    var acc: UInt64 = 0
+    for run in 0..<RUNS {
+        // Every pass starts from a different state, so no two passes compute the same thing.
+        regs[Int(run % 8)] ^= run
+
+        var pc = 0
+        while pc < PROG {
+            let a = ra[pc]
+            switch ops[pc] {
+            case OP_LOADI:
+                regs[a] = imm[pc]
+            case OP_ADD:
+                regs[a] = (regs[a] + regs[rb[pc]]) & M32
+            case OP_SUB:
+                regs[a] = (regs[a] + M32 + 1 - regs[rb[pc]]) & M32
+            case OP_XOR:
+                regs[a] ^= regs[rb[pc]]
+            case OP_AND:
+                regs[a] &= regs[rb[pc]]
+            case OP_OR:
+                regs[a] |= regs[rb[pc]]
+            case OP_SHR:
+                regs[a] = regs[a] &>> imm[pc]
+            case OP_ROL:
+                regs[a] = rol(regs[a], imm[pc])
+            case OP_ADDI:
+                regs[a] = (regs[a] + imm[pc]) & M32
+            case OP_MULI:
+                regs[a] = (regs[a] &* imm[pc]) & M32
+            case OP_MOV:
+                regs[a] = regs[rb[pc]]
+            case OP_NOT:
+                regs[a] = M32 - regs[a]
+            case OP_SKIP:
+                if regs[a] & 1 != 0 {
+                    pc += 1
+                }
+            case OP_ACC:
+                acc = rol(acc, 5) ^ regs[a]
+            case OP_MIN:
+                if regs[rb[pc]] < regs[a] {
+                    regs[a] = regs[rb[pc]]
+                }
+            default:
+                regs.swapAt(a, rb[pc])
+            }
+
+            pc += 1
+        }
+    }
+
+    var check = acc
+    for i in 0..<8 {
+        check = rol(check, 3) ^ regs[i]
+    }
+
+    let t1 = now()
+    print(String(format: "CHECK=%llu MS=%.6f", check, (t1 - t0) * 1000.0))
+}
+
+runMain()
@@ -9,6 +9,7 @@
 #include "Compiler/Sema/Type/TypeInfo.h"
 #include "Compiler/SourceFile.h"
 #include "Main/CompilerInstance.h"
+#include "Main/Stats.h"
 #include "Main/Version.h"
 #include "Support/Math/Hash.h"
 #include "Support/Math/Helpers.h"
@@ -822,6 +823,33 @@ namespace
             writeU32(bytes, K_CV_TYPE_SIGNATURE);
         }
 
+        // Closes a record whose meaning is its bytes alone. When an identical record is already in
+        // the table, the new one is dropped and the existing index is returned instead, so every
+        // function with the same signature shares one procedure type.
+        uint32_t endSharedTypeRecord(const uint32_t recordOffset, const uint32_t typeIndex)
+        {
+            endTypeRecord(bytes, recordOffset);
+
+            const std::span<const std::byte> record = bytes.span().subspan(recordOffset);
+            const uint32_t                   hash   = Math::hash(record);
+            for (auto [it, end] = sharedRecords.equal_range(hash); it != end; ++it)
+            {
+                const SharedRecord& shared = it->second;
+                if (!std::ranges::equal(bytes.span().subspan(shared.offset, shared.size), record))
+                    continue;
+
+                bytes.resize(recordOffset);
+                SWC_ASSERT(typeIndex + 1 == nextTypeIndex);
+                nextTypeIndex = typeIndex;
+                if (Stats::enabledRuntime())
+                    Stats::get().numDebugTypeRecordsShared.add(1);
+                return shared.typeIndex;
+            }
+
+            sharedRecords.emplace(hash, SharedRecord{recordOffset, static_cast<uint32_t>(record.size()), typeIndex});
+            return typeIndex;
+        }
+
         uint32_t appendArgList(const std::span<const uint32_t> arguments)
         {
             const uint32_t typeIndex    = nextTypeIndex++;
@@ -829,8 +857,7 @@ namespace
             writeU32(bytes, static_cast<uint32_t>(arguments.size()));
             for (const uint32_t argType : arguments)
                 writeU32(bytes, argType);
-            endTypeRecord(bytes, recordOffset);
-            return typeIndex;
+            return endSharedTypeRecord(recordOffset, typeIndex);
         }
 
         uint32_t appendProcedureType(const uint32_t returnType, const std::span<const uint32_t> arguments)
@@ -843,8 +870,7 @@ namespace
             bytes.pushBack(std::byte{0});
             writeU16(bytes, static_cast<uint16_t>(arguments.size()));
             writeU32(bytes, argListType);
-            endTypeRecord(bytes, recordOffset);
-            return typeIndex;
+            return endSharedTypeRecord(recordOffset, typeIndex);
         }
 
         uint32_t appendFunctionId(const Utf8& functionName, const uint32_t procedureType)
@@ -854,8 +880,7 @@ namespace
             writeU32(bytes, 0);
             writeU32(bytes, procedureType);
             writeCString(bytes, functionName);
-            endTypeRecord(bytes, recordOffset);
-            return typeIndex;
+            return endSharedTypeRecord(recordOffset, typeIndex);
         }
 
         uint32_t appendStringId(const Utf8& value)
@@ -864,8 +889,7 @@ namespace
             const uint32_t recordOffset = beginTypeRecord(bytes, K_LF_STRING_ID);
             writeU32(bytes, 0);
             writeCString(bytes, value);
-            endTypeRecord(bytes, recordOffset);
-            return typeIndex;
+            return endSharedTypeRecord(recordOffset, typeIndex);
         }
 
         uint32_t appendModifierType(const uint32_t baseTypeIndex, const uint16_t modifiers)
@@ -1244,20 +1268,27 @@ namespace
             writeU16(bytes, size);
             for (const uint32_t item : items)
                 writeU32(bytes, item);
-            endTypeRecord(bytes, recordOffset);
-            return typeIndex;
+            return endSharedTypeRecord(recordOffset, typeIndex);
         }
 
-        TaskContext*                           ctx = nullptr;
-        ByteArray                              bytes;
-        uint32_t                               nextTypeIndex = K_CV_FIRST_NONPRIM;
-        std::unordered_map<uint64_t, uint32_t> builtTypes;
-        std::unordered_map<uint64_t, uint32_t> modifierTypes;
-        std::unordered_map<uint32_t, uint32_t> pointerTypes;
-        std::unordered_map<uint64_t, uint32_t> arrayTypes;
-        std::unordered_map<uint32_t, uint32_t> forwardStructTypes;
-        std::unordered_set<uint32_t>           buildingStructs;
-        std::map<uint32_t, Utf8>               udtNames;
+        struct SharedRecord
+        {
+            uint32_t offset    = 0;
+            uint32_t size      = 0;
+            uint32_t typeIndex = 0;
+        };
+
+        TaskContext*                                    ctx = nullptr;
+        ByteArray                                       bytes;
+        uint32_t                                        nextTypeIndex = K_CV_FIRST_NONPRIM;
+        std::unordered_multimap<uint32_t, SharedRecord> sharedRecords;
+        std::unordered_map<uint64_t, uint32_t>          builtTypes;
+        std::unordered_map<uint64_t, uint32_t>          modifierTypes;
+        std::unordered_map<uint32_t, uint32_t>          pointerTypes;
+        std::unordered_map<uint64_t, uint32_t>          arrayTypes;
+        std::unordered_map<uint32_t, uint32_t>          forwardStructTypes;
+        std::unordered_set<uint32_t>                    buildingStructs;
+        std::map<uint32_t, Utf8>                        udtNames;
     };
 
     void appendLinesSubsection(ByteArray& bytes, NativeSectionData& debugSection, const DebugInfoFunctionRecord& function, const FunctionLines& functionLines, const FileChecksumBuilder& checksums)
@@ -127,6 +127,7 @@ protected:
     virtual void encodePush(MicroReg reg)                                                                                                                                                  = 0;
     virtual void encodePop(MicroReg reg)                                                                                                                                                   = 0;
     virtual void encodeNop()                                                                                                                                                               = 0;
+    virtual void encodeNopPadding(uint32_t numBytes)                                                                                                                                       = 0;
     virtual void encodeBreakpoint()                                                                                                                                                        = 0;
     virtual void encodeRet()                                                                                                                                                               = 0;
     virtual void encodeCallLocal(Symbol* targetSymbol, CallConvKind callConv)                                                                                                              = 0;
@@ -136,6 +137,7 @@ protected:
     virtual void encodePatchJump(const MicroJump& jump, uint64_t offsetDestination)                                                                                                        = 0;
     virtual void encodePatchJump(const MicroJump& jump)                                                                                                                                    = 0;
     virtual void encodeJumpReg(MicroReg reg)                                                                                                                                               = 0;
+    virtual void encodeTailJumpReg(MicroReg reg)                                                                                                                                           = 0;
     virtual void encodeLoadRegMem(MicroReg reg, MicroReg memReg, uint64_t memOffset, MicroOpBits opBits)                                                                                   = 0;
     virtual void encodeLoadVecRegMem(MicroReg regDst, MicroReg memReg, uint64_t memOffset, MicroOpBits opBits)                                                                             = 0;
     virtual void encodeStoreVecMemReg(MicroReg memReg, uint64_t memOffset, MicroReg regSrc, MicroOpBits opBits)                                                                            = 0;
@@ -196,6 +198,11 @@ public:
 protected:
     static void addSymbolRelocation(uint32_t, uint32_t, uint16_t);
 
+    // Drops every byte encoded so far, so that the emitter can encode the function again
+    // once it has picked shorter branch forms.
+    void         resetCode();
+    virtual void onCodeReset() {}
+
     virtual void onInstructionEncoded(const MicroInstr& inst, const MicroInstrOperand* ops, uint32_t codeStartOffset, uint32_t codeEndOffset)
     {
         SWC_UNUSED(inst);
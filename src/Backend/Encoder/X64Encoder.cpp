@@ -1009,6 +1009,11 @@ void X64Encoder::onInstructionEncoded(const MicroInstr& inst, const MicroInstrOp
     unwind_->onInstructionEncoded(inst, ops, codeStartOffset, codeEndOffset);
 }
 
+void X64Encoder::onCodeReset()
+{
+    unwind_ = X64Unwind::create(ctx().compiler().cmdLine().targetOs);
+}
+
 // ============================================================================
 
 void X64Encoder::updateRegUseDef(const MicroInstr& inst, const MicroInstrOperand* ops, MicroInstrUseDef& info) const
@@ -3907,6 +3912,15 @@ void X64Encoder::encodeJumpReg(MicroReg reg)
     emitModRm(store_, ModRmMode::Register, MODRM_REG_4, encodeReg(reg));
 }
 
+void X64Encoder::encodeTailJumpReg(MicroReg reg)
+{
+    // Same `jmp r64` as encodeJumpReg, but always with REX.W: the Windows unwinder only
+    // takes a register jump as the end of an epilogue in that form.
+    emitRex(store_, MicroOpBits::B64, MicroReg{}, reg);
+    emitCpuOp(store_, 0xFF);
+    emitModRm(store_, ModRmMode::Register, MODRM_REG_4, encodeReg(reg));
+}
+
 // ============================================================================
 
 void X64Encoder::encodeCallExtern(Symbol* targetSymbol, uint64_t targetAddress, CallConvKind callConv)
@@ -3942,6 +3956,31 @@ void X64Encoder::encodeNop()
     emitCpuOp(store_, 0x90);
 }
 
+void X64Encoder::encodeNopPadding(uint32_t numBytes)
+{
+    // The multi-byte NOP forms recommended by the Intel and AMD optimization manuals: one
+    // instruction decodes faster than a run of single-byte NOPs.
+    static constexpr std::array<std::array<uint8_t, 9>, 9> NOPS = {{
+        {0x90},
+        {0x66, 0x90},
+        {0x0F, 0x1F, 0x00},
+        {0x0F, 0x1F, 0x40, 0x00},
+        {0x0F, 0x1F, 0x44, 0x00, 0x00},
+        {0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00},
+        {0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00},
+        {0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+    }};
+
+    while (numBytes)
+    {
+        const uint32_t chunk = std::min<uint32_t>(numBytes, NOPS.size());
+        for (uint32_t i = 0; i < chunk; ++i)
+            store_.pushU8(NOPS[chunk - 1][i]);
+        numBytes -= chunk;
+    }
+}
+
 void X64Encoder::encodeBreakpoint()
 {
     emitCpuOp(store_, 0xCC);
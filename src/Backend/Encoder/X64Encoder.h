@@ -37,10 +37,12 @@ protected:
     uint64_t currentOffset() const override { return store_.size(); }
     void     updateRegUseDef(const MicroInstr& inst, const MicroInstrOperand* ops, MicroInstrUseDef& info) const override;
     void     onInstructionEncoded(const MicroInstr& inst, const MicroInstrOperand* ops, uint32_t codeStartOffset, uint32_t codeEndOffset) override;
+    void     onCodeReset() override;
 
     void encodePush(MicroReg reg) override;
     void encodePop(MicroReg reg) override;
     void encodeNop() override;
+    void encodeNopPadding(uint32_t numBytes) override;
     void encodeBreakpoint() override;
     void encodeRet() override;
     void encodeCallLocal(Symbol* targetSymbol, CallConvKind callConv) override;
@@ -50,6 +52,7 @@ protected:
     void encodePatchJump(const MicroJump& jump, uint64_t offsetDestination) override;
     void encodePatchJump(const MicroJump& jump) override;
     void encodeJumpReg(MicroReg reg) override;
+    void encodeTailJumpReg(MicroReg reg) override;
     void encodeLoadRegMem(MicroReg reg, MicroReg memReg, uint64_t memOffset, MicroOpBits opBits) override;
     void encodeLoadVecRegMem(MicroReg regDst, MicroReg memReg, uint64_t memOffset, MicroOpBits opBits) override;
     void encodeStoreVecMemReg(MicroReg memReg, uint64_t memOffset, MicroReg regSrc, MicroOpBits opBits) override;
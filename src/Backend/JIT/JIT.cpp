@@ -8,6 +8,7 @@
 #include "Backend/JIT/JITPatchJob.h"
 #include "Backend/Micro/MachineCode.h"
 #include "Backend/Micro/MicroBuilder.h"
+#include "Backend/Micro/MicroPassContext.h"
 #include "Backend/RuntimeName.h"
 #include "Compiler/CodeGen/Core/CodeGenJob.h"
 #include "Compiler/Lexer/SourceView.h"
@@ -1251,6 +1252,37 @@ void JIT::finalize(JITMemory& executableMemory)
     JITMemoryManager::registerUnwindInfo(executableMemory);
 }
 
+// Sends every later call of code lowered with a reserved entry patch to 'target'. The entry NOP
+// is replaced by a rel32 jump in a single aligned 8-byte store, so a thread entering the
+// function at the same time runs either the whole NOP or the whole jump. Fails, leaving the code
+// as it was, when the target is out of rel32 reach.
+bool JIT::redirect(const JITMemory& executableMemory, const void* target)
+{
+    constexpr uint32_t patchSize = MicroPassContext::K_JIT_ENTRY_PATCH_SIZE;
+    static_assert(patchSize == sizeof(uint64_t));
+
+    auto* const entry = static_cast<uint8_t*>(executableMemory.entryPoint());
+    SWC_ASSERT(entry != nullptr);
+    SWC_ASSERT(reinterpret_cast<uintptr_t>(entry) % patchSize == 0);
+    SWC_ASSERT(executableMemory.size() >= patchSize);
+
+    const int64_t displacement = reinterpret_cast<intptr_t>(target) - reinterpret_cast<intptr_t>(entry + 5);
+    if (displacement < std::numeric_limits<int32_t>::min() || displacement > std::numeric_limits<int32_t>::max())
+        return false;
+
+    std::array<uint8_t, patchSize> jump = {0xE9, 0, 0, 0, 0, 0xCC, 0xCC, 0xCC};
+    const auto                     rel  = static_cast<int32_t>(displacement);
+    std::memcpy(jump.data() + 1, &rel, sizeof(rel));
+
+    uint64_t patch = 0;
+    std::memcpy(&patch, jump.data(), sizeof(patch));
+    if (!Os::makeWritableExecutableMemory(entry, patchSize))
+        return false;
+    std::atomic_ref(*reinterpret_cast<uint64_t*>(entry)).store(patch, std::memory_order_release);
+    SWC_FORCE_ASSERT(Os::makeExecutableMemory(entry, patchSize));
+    return true;
+}
+
 Result JIT::emit(TaskContext& ctx, JITMemory& outExecutableMemory, const ByteArray& linearCode, std::span<const MicroRelocation> relocations, const ByteArray& unwindInfo, const SymbolFunction* ownerFunction)
 {
     const TaskScopedContext scopedContext(ctx);
@@ -1569,16 +1601,9 @@ namespace
         return true;
     }
 
-    bool tryMatchJitFunctionAtRip(const SymbolFunction& function, uint64_t rip, JitCrashFunctionMatch& outMatch)
+    bool tryMatchJitCodeAtRip(const SymbolFunction& function, const MachineCode& code, const void* entryPtr, uint64_t rip, JitCrashFunctionMatch& outMatch)
     {
-        outMatch = {};
-
-        const void* entryPtr = function.jitEntryAddress();
-        if (!entryPtr)
-            return false;
-
-        const auto& code = function.loweredCode();
-        if (code.bytes.empty())
+        if (!entryPtr || code.bytes.empty())
             return false;
 
         const uint64_t entryAddress = reinterpret_cast<uint64_t>(entryPtr);
@@ -1593,6 +1618,24 @@ namespace
         return true;
     }
 
+    bool tryMatchJitFunctionAtRip(const SymbolFunction& function, uint64_t rip, JitCrashFunctionMatch& outMatch)
+    {
+        outMatch = {};
+
+        const void* entryPtr = function.jitEntryAddress();
+        if (!entryPtr)
+            return false;
+        if (tryMatchJitCodeAtRip(function, function.loweredCode(), entryPtr, rip, outMatch))
+            return true;
+
+        // Once a baseline function has tiered up, its calls run in the optimized copy.
+        const MachineCode* optimizedCode  = nullptr;
+        const void*        optimizedEntry = nullptr;
+        if (function.tryGetJitOptimizedCode(optimizedCode, optimizedEntry))
+            return tryMatchJitCodeAtRip(function, *optimizedCode, optimizedEntry, rip, outMatch);
+        return false;
+    }
+
     bool tryResolveJitCrashFunction(const TaskContext& ctx, uint64_t rip, JitCrashFunctionMatch& outMatch)
     {
         outMatch = {};
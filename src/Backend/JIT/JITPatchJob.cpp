@@ -7,10 +7,11 @@
 
 SWC_BEGIN_NAMESPACE();
 
-JITPatchJob::JITPatchJob(const TaskContext& ctx, SymbolFunction& symbolFunc, const SymbolFunction* weakRelocationBlocker) :
+JITPatchJob::JITPatchJob(const TaskContext& ctx, SymbolFunction& symbolFunc, const SymbolFunction* weakRelocationBlocker, JITPatchMode mode) :
     Job(ctx, JobKind::JitPatch),
     symbolFunc_(&symbolFunc),
-    weakRelocationBlocker_(weakRelocationBlocker)
+    weakRelocationBlocker_(weakRelocationBlocker),
+    mode_(mode)
 {
 }
 
@@ -29,10 +30,27 @@ bool JITPatchJob::schedule(TaskContext& ctx, SymbolFunction& symbolFunc, const S
     return true;
 }
 
+// The optimized recompile of a hot baseline function. Nothing waits on it: the baseline code
+// keeps running until the job redirects it, so it goes behind the work that blocks compilation.
+void JITPatchJob::scheduleTierUp(TaskContext& ctx, SymbolFunction& symbolFunc)
+{
+    auto* job = ctx.compiler().makeJob<JITPatchJob>(ctx, symbolFunc, nullptr, JITPatchMode::TierUp);
+    ctx.compiler().global().jobMgr().enqueue(*job, JobPriority::Low, ctx.compiler().jitTierUpClientId());
+}
+
+void JITPatchJob::traceTarget(Utf8& outFile, Utf8& outSymbol) const
+{
+    SWC_UNUSED(outFile);
+    outSymbol = symbolFunc_->getFullScopedName(ctx());
+}
+
 JobResult JITPatchJob::exec()
 {
     SWC_ASSERT(symbolFunc_ != nullptr);
     ctx().state().setNone();
+    if (mode_ == JITPatchMode::TierUp)
+        return toJobResult(ctx(), symbolFunc_->jitTierUp(ctx()));
+
     ctx().state().weakJitRelocationBlocker = weakRelocationBlocker_;
 
     const Result result = symbolFunc_->jitMaterialize(ctx());
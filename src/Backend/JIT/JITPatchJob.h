@@ -5,19 +5,28 @@ SWC_BEGIN_NAMESPACE();
 
 class SymbolFunction;
 
+enum class JITPatchMode : uint8_t
+{
+    Materialize,
+    TierUp,
+};
+
 class JITPatchJob : public Job
 {
 public:
     static constexpr auto K = JobKind::JitPatch;
 
-    JITPatchJob(const TaskContext& ctx, SymbolFunction& symbolFunc, const SymbolFunction* weakRelocationBlocker);
+    JITPatchJob(const TaskContext& ctx, SymbolFunction& symbolFunc, const SymbolFunction* weakRelocationBlocker, JITPatchMode mode = JITPatchMode::Materialize);
     JobResult exec() override;
+    void      traceTarget(Utf8& outFile, Utf8& outSymbol) const override;
 
     static bool schedule(TaskContext& ctx, SymbolFunction& symbolFunc, const SymbolFunction* weakRelocationBlocker = nullptr);
+    static void scheduleTierUp(TaskContext& ctx, SymbolFunction& symbolFunc);
 
 private:
     SymbolFunction*       symbolFunc_            = nullptr;
     const SymbolFunction* weakRelocationBlocker_ = nullptr;
+    JITPatchMode          mode_                  = JITPatchMode::Materialize;
 };
 
 SWC_END_NAMESPACE();
@@ -1,7 +1,13 @@
 #include "pch.h"
 #include "Backend/Linker/Archive.h"
 #include "Backend/Linker/CoffReader.h"
+#include "Main/FileSystem.h"
+#include "Main/Version.h"
+#include "Main/WorkspaceLayout.h"
+#include "Support/Math/Hash.h"
 #include "Support/Math/Helpers.h"
+#include "Support/Math/Sha256.h"
+#include "Support/Os/Os.h"
 #include "Support/Report/Assert.h"
 #include "Support/Report/Diagnostic.h"
 
@@ -15,10 +21,35 @@ namespace
     constexpr uint16_t         IMPORT_SIG2          = 0xFFFF;
     constexpr uint16_t         IMPORT_MACHINE_AMD64 = 0x8664;
 
+    // The first linker member always follows the magic: its data starts with the symbol count,
+    // then one big-endian member offset per symbol.
+    constexpr size_t LINKER_MEMBER_HEADER  = ARCHIVE_MAGIC.size();
+    constexpr size_t LINKER_MEMBER_DATA    = LINKER_MEMBER_HEADER + MEMBER_HEADER_SIZE;
+    constexpr size_t LINKER_MEMBER_OFFSETS = LINKER_MEMBER_DATA + 4;
+
+    constexpr std::string_view ARCHIVE_INDEX_MAGIC   = "SWAI";
+    constexpr uint32_t         ARCHIVE_INDEX_FORMAT  = 1;
+    constexpr std::string_view ARCHIVE_INDEX_TMP_EXT = ".swctmp";
+    constexpr size_t           ARCHIVE_INDEX_HEADER  = ARCHIVE_INDEX_MAGIC.size() + sizeof(uint32_t) + 32 + sizeof(uint32_t);
+
+    bool containsRange(const std::span<const std::byte> bytes, const size_t offset, const size_t byteCount) noexcept
+    {
+        return offset <= bytes.size() && byteCount <= bytes.size() - offset;
+    }
+
+    uint32_t readBe32(const std::span<const std::byte> bytes, const size_t offset) noexcept
+    {
+        SWC_ASSERT(containsRange(bytes, offset, sizeof(uint32_t)));
+        return std::to_integer<uint32_t>(bytes[offset + 0]) << 24 |
+               std::to_integer<uint32_t>(bytes[offset + 1]) << 16 |
+               std::to_integer<uint32_t>(bytes[offset + 2]) << 8 |
+               std::to_integer<uint32_t>(bytes[offset + 3]);
+    }
+
     // Member sizes are stored as a right-padded decimal ASCII string.
-    bool parseMemberSize(uint32_t& outSize, const ByteArray& bytes, size_t headerOffset)
+    bool parseMemberSize(uint32_t& outSize, const std::span<const std::byte> bytes, size_t headerOffset)
     {
-        if (!bytes.containsRange(headerOffset, MEMBER_HEADER_SIZE))
+        if (!containsRange(bytes, headerOffset, MEMBER_HEADER_SIZE))
             return false;
 
         outSize = 0;
@@ -44,81 +75,275 @@ namespace
     {
         return Math::alignUpU64(size, 2);
     }
+
+    Utf8 digestToHex(const std::array<uint8_t, 32>& digest)
+    {
+        Utf8 result;
+        for (const uint8_t b : digest)
+            result += std::format("{:02x}", b);
+        return result;
+    }
+
+    // An index describes one version of one file. The compiler build is part of it because the
+    // hash of the names is.
+    bool archiveIndexIdentity(std::array<uint8_t, 32>& outIdentity, const fs::path& path, const size_t size)
+    {
+        std::error_code ec;
+        const auto      writeTime = fs::last_write_time(path, ec);
+        if (ec)
+            return false;
+
+        const std::string identity = std::format("swc {}.{}.{}\nformat={}\npath={}\nsize={}\nmtime={}",
+                                                 SWC_VERSION,
+                                                 SWC_REVISION,
+                                                 SWC_BUILD_NUM,
+                                                 ARCHIVE_INDEX_FORMAT,
+                                                 FileSystem::normalizePath(path).string(),
+                                                 size,
+                                                 writeTime.time_since_epoch().count());
+        outIdentity = sha256(std::span{reinterpret_cast<const std::byte*>(identity.data()), identity.size()});
+        return true;
+    }
+}
+
+void Archive::MappedFileRelease::operator()(Os::MappedFile* file) const
+{
+    Os::unmapFile(*file);
+    delete file;
 }
 
 bool Archive::load(Diagnostic& outDiag, ByteArray bytes)
 {
-    bytes_ = std::move(bytes);
-    symbolToMember_.clear();
+    mappedBytes_.reset();
+    ownedBytes_ = std::move(bytes);
+    bytes_      = ownedBytes_.span();
+    return readLinkerMember(outDiag) && buildSymbolIndex(outDiag);
+}
 
-    if (!bytes_.containsRange(0, ARCHIVE_MAGIC.size()) || std::memcmp(bytes_.data(), ARCHIVE_MAGIC.data(), ARCHIVE_MAGIC.size()) != 0)
+bool Archive::loadFile(Diagnostic& outDiag, const fs::path& path, const bool readIndexCache)
+{
+    ownedBytes_.clear();
+    mappedBytes_.reset();
+    bytes_ = {};
+
+    Os::MappedFile mapped;
+    if (Os::mapFileReadOnly(mapped, path, ARCHIVE_MAGIC.size(), 0))
+    {
+        mappedBytes_.reset(new Os::MappedFile(mapped));
+        bytes_ = {reinterpret_cast<const std::byte*>(mapped.data), mapped.size};
+    }
+    else
+    {
+        FileSystem::IoErrorInfo ioError;
+        if (FileSystem::readBinaryFile(path, ownedBytes_, ioError) != Result::Continue)
+        {
+            outDiag = Diagnostic::get(ioError.problem == FileSystem::IoProblem::OpenRead ? DiagnosticId::io_err_open_file : DiagnosticId::io_err_read_file);
+            FileSystem::setDiagnosticPathAndBecause(outDiag, nullptr, path, ioError.because);
+            return false;
+        }
+
+        bytes_ = ownedBytes_.span();
+    }
+
+    if (!readLinkerMember(outDiag))
+        return false;
+
+    // Without an identity there is nothing to key the side file by: the index is rebuilt and
+    // not stored.
+    std::array<uint8_t, 32> identity = {};
+    if (!archiveIndexIdentity(identity, path, bytes_.size()))
+        return buildSymbolIndex(outDiag);
+
+    const fs::path indexPath = (WorkspaceLayout::archiveIndexCacheRoot() / fs::path(digestToHex(identity).c_str())).lexically_normal();
+    if (readIndexCache && loadSymbolIndex(indexPath, identity))
+        return true;
+
+    if (!buildSymbolIndex(outDiag))
+        return false;
+
+    storeSymbolIndex(indexPath, identity);
+    return true;
+}
+
+bool Archive::readLinkerMember(Diagnostic& outDiag)
+{
+    symbols_.clear();
+    symbolCount_ = 0;
+    namesBegin_  = 0;
+    namesEnd_    = 0;
+
+    if (!containsRange(bytes_, 0, ARCHIVE_MAGIC.size()) || std::memcmp(bytes_.data(), ARCHIVE_MAGIC.data(), ARCHIVE_MAGIC.size()) != 0)
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_bad_magic);
         return false;
     }
 
-    // The first member is the linker member: a big-endian symbol -> member-offset directory.
-    constexpr size_t firstHeader = ARCHIVE_MAGIC.size();
-    if (!bytes_.containsRange(firstHeader, MEMBER_HEADER_SIZE))
+    // The member offsets are 32 bits, so nothing past 4 GB can be addressed anyway.
+    if (bytes_.size() > std::numeric_limits<uint32_t>::max() || !containsRange(bytes_, LINKER_MEMBER_HEADER, MEMBER_HEADER_SIZE))
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_truncated);
         return false;
     }
 
+    // The first member is the linker member: a big-endian symbol -> member-offset directory.
     uint32_t memberSize = 0;
-    if (!parseMemberSize(memberSize, bytes_, firstHeader))
+    if (!parseMemberSize(memberSize, bytes_, LINKER_MEMBER_HEADER))
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_bad_member);
         return false;
     }
 
-    constexpr size_t dataOffset = firstHeader + MEMBER_HEADER_SIZE;
-    if (!bytes_.containsRange(dataOffset, memberSize) || memberSize < 4)
+    if (!containsRange(bytes_, LINKER_MEMBER_DATA, memberSize) || memberSize < 4)
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_truncated_linker_member);
         return false;
     }
 
-    const uint32_t   symbolCount = bytes_.readBe32(dataOffset);
-    constexpr size_t offsetsAt   = dataOffset + 4;
-    const size_t     namesAt     = offsetsAt + static_cast<size_t>(symbolCount) * 4;
-    if (namesAt > dataOffset + memberSize)
+    const uint32_t symbolCount = readBe32(bytes_, LINKER_MEMBER_DATA);
+    const size_t   namesAt     = LINKER_MEMBER_OFFSETS + static_cast<size_t>(symbolCount) * 4;
+    const size_t   memberEnd   = LINKER_MEMBER_DATA + memberSize;
+    if (namesAt > memberEnd)
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_bad_symbol_index);
         return false;
     }
 
-    size_t       nameCursor = namesAt;
-    const size_t memberEnd  = dataOffset + memberSize;
-    for (uint32_t i = 0; i < symbolCount; ++i)
+    symbolCount_ = symbolCount;
+    namesBegin_  = static_cast<uint32_t>(namesAt);
+    namesEnd_    = static_cast<uint32_t>(memberEnd);
+    return true;
+}
+
+bool Archive::buildSymbolIndex(Diagnostic& outDiag)
+{
+    symbols_.clear();
+    symbols_.reserve(symbolCount_);
+
+    size_t nameCursor = namesBegin_;
+    for (uint32_t i = 0; i < symbolCount_; ++i)
     {
-        if (nameCursor >= memberEnd)
+        if (nameCursor >= namesEnd_)
         {
+            symbols_.clear();
             outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_bad_symbol_names);
             return false;
         }
-        const auto* nameStart = reinterpret_cast<const char*>(bytes_.data() + nameCursor);
-        size_t      nameLen   = 0;
-        while (nameCursor + nameLen < memberEnd && nameStart[nameLen] != '\0')
-            ++nameLen;
-
-        const uint32_t memberOffset = bytes_.readBe32(offsetsAt + static_cast<size_t>(i) * 4);
-        symbolToMember_.emplace(Utf8{std::string_view{nameStart, nameLen}}, memberOffset);
-        nameCursor += nameLen + 1;
+
+        SymbolEntry entry;
+        entry.nameOffset   = static_cast<uint32_t>(nameCursor);
+        entry.memberOffset = readBe32(bytes_, LINKER_MEMBER_OFFSETS + static_cast<size_t>(i) * 4);
+
+        const std::string_view name = symbolName(entry);
+        entry.hash                  = Math::hash(name);
+        symbols_.push_back(entry);
+        nameCursor += name.size() + 1;
+    }
+
+    std::ranges::stable_sort(symbols_, {}, &SymbolEntry::hash);
+    return true;
+}
+
+// Every entry is checked against the archive it is about to index: a side file is a file anybody
+// can truncate or overwrite, and a bad one must read as a miss rather than as an index.
+bool Archive::loadSymbolIndex(const fs::path& indexPath, const std::array<uint8_t, 32>& identity)
+{
+    static_assert(std::is_trivially_copyable_v<SymbolEntry> && sizeof(SymbolEntry) == 3 * sizeof(uint32_t));
+
+    ByteArray               bytes;
+    FileSystem::IoErrorInfo ioError;
+    if (FileSystem::readBinaryFile(indexPath, bytes, ioError) != Result::Continue)
+        return false;
+    if (bytes.size() != ARCHIVE_INDEX_HEADER + static_cast<size_t>(symbolCount_) * sizeof(SymbolEntry))
+        return false;
+
+    size_t offset = 0;
+    if (std::memcmp(bytes.data(), ARCHIVE_INDEX_MAGIC.data(), ARCHIVE_INDEX_MAGIC.size()) != 0)
+        return false;
+    offset += ARCHIVE_INDEX_MAGIC.size();
+    if (bytes.readLe32(offset) != ARCHIVE_INDEX_FORMAT)
+        return false;
+    offset += sizeof(uint32_t);
+    if (std::memcmp(bytes.data() + offset, identity.data(), identity.size()) != 0)
+        return false;
+    offset += identity.size();
+    if (bytes.readLe32(offset) != symbolCount_)
+        return false;
+    offset += sizeof(uint32_t);
+
+    symbols_.resize(symbolCount_);
+    std::memcpy(symbols_.data(), bytes.data() + offset, symbols_.size() * sizeof(SymbolEntry));
+
+    uint32_t prevHash = 0;
+    for (const SymbolEntry& entry : symbols_)
+    {
+        if (entry.nameOffset < namesBegin_ || entry.nameOffset >= namesEnd_ || entry.hash < prevHash)
+        {
+            symbols_.clear();
+            return false;
+        }
+        prevHash = entry.hash;
     }
 
     return true;
 }
 
+void Archive::storeSymbolIndex(const fs::path& indexPath, const std::array<uint8_t, 32>& identity) const
+{
+    ByteArray bytes;
+    bytes.reserve(ARCHIVE_INDEX_HEADER + symbols_.size() * sizeof(SymbolEntry));
+    bytes.append(ARCHIVE_INDEX_MAGIC);
+    bytes.appendLe32(ARCHIVE_INDEX_FORMAT);
+    bytes.append(std::as_bytes(std::span{identity}));
+    bytes.appendLe32(symbolCount_);
+    bytes.append(std::as_bytes(std::span{symbols_}));
+
+    // Written beside the entry under a name only this thread uses, then renamed into place, so a
+    // concurrent link sees either the whole index or none. An index that cannot be written costs
+    // the next link a decode, nothing more, so failures are not reported.
+    std::error_code ec;
+    fs::create_directories(indexPath.parent_path(), ec);
+
+    fs::path tempPath = indexPath;
+    tempPath += std::format(".{}.{}{}", Os::currentProcessId(), Os::currentThreadId(), ARCHIVE_INDEX_TMP_EXT);
+
+    FileSystem::IoErrorInfo ioError;
+    if (FileSystem::writeBinaryFile(tempPath, bytes.data(), bytes.size(), ioError) == Result::Continue)
+    {
+        ec.clear();
+        fs::rename(tempPath, indexPath, ec);
+        if (!ec)
+            return;
+    }
+
+    ec.clear();
+    fs::remove(tempPath, ec);
+}
+
+std::string_view Archive::symbolName(const SymbolEntry& entry) const
+{
+    SWC_ASSERT(entry.nameOffset < namesEnd_);
+    const auto*  nameStart = reinterpret_cast<const char*>(bytes_.data() + entry.nameOffset);
+    const size_t maxLen    = namesEnd_ - entry.nameOffset;
+    const auto*  nameEnd   = static_cast<const char*>(std::memchr(nameStart, '\0', maxLen));
+    return {nameStart, nameEnd ? static_cast<size_t>(nameEnd - nameStart) : maxLen};
+}
+
 uint32_t Archive::memberOffsetForSymbol(const Utf8& symbol) const
 {
-    const auto it = symbolToMember_.find(symbol);
-    return it == symbolToMember_.end() ? 0 : it->second;
+    const std::string_view name = symbol.view();
+    const uint32_t         hash = Math::hash(name);
+    for (auto it = std::ranges::lower_bound(symbols_, hash, {}, &SymbolEntry::hash); it != symbols_.end() && it->hash == hash; ++it)
+    {
+        if (symbolName(*it) == name)
+            return it->memberOffset;
+    }
+
+    return 0;
 }
 
 std::span<const std::byte> Archive::memberData(Diagnostic& outDiag, uint32_t headerOffset) const
 {
-    if (!bytes_.containsRange(headerOffset, MEMBER_HEADER_SIZE))
+    if (!containsRange(bytes_, headerOffset, MEMBER_HEADER_SIZE))
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_member_out_of_range);
         return {};
@@ -130,7 +355,7 @@ std::span<const std::byte> Archive::memberData(Diagnostic& outDiag, uint32_t hea
         return {};
     }
     const size_t dataOffset = headerOffset + MEMBER_HEADER_SIZE;
-    if (!bytes_.containsRange(dataOffset, memberSize))
+    if (!containsRange(bytes_, dataOffset, memberSize))
     {
         outDiag = Diagnostic::get(DiagnosticId::cmd_err_link_archive_truncated_member);
         return {};
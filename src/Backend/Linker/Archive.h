@@ -7,10 +7,19 @@ SWC_BEGIN_NAMESPACE();
 
 class Diagnostic;
 
+namespace Os
+{
+    struct MappedFile;
+}
+
 // Reader for Windows COFF archives (`!<arch>`), covering both static libraries (members are COFF
 // objects) and import libraries (members are "short import" records describing a DLL export). Only
 // the first linker member (the symbol -> member index) is decoded; that is all symbol resolution
 // needs. Members are pulled on demand by the linker.
+//
+// An archive read from disk is mapped rather than copied, and its symbol index is kept in a side
+// file named after the archive path, size and modification time. The index holds no names, only
+// where they are in the archive, so a link that finds it decodes nothing and allocates one array.
 
 struct ArchiveImport
 {
@@ -27,6 +36,11 @@ public:
     // Takes ownership of the archive bytes. Returns false and fills outDiag on a malformed archive.
     bool load(Diagnostic& outDiag, ByteArray bytes);
 
+    // Maps the archive at the given path, falling back to reading it. The symbol index comes from
+    // the side file when 'readIndexCache' is set and a valid one exists, and is stored otherwise.
+    // Returns false and fills outDiag when the file cannot be read or is not an archive.
+    bool loadFile(Diagnostic& outDiag, const fs::path& path, bool readIndexCache);
+
     // Returns the file offset of the member header defining the given symbol, or 0 if this archive
     // does not provide it (0 is never a valid member offset because the magic occupies offset 0).
     uint32_t memberOffsetForSymbol(const Utf8& symbol) const;
@@ -38,8 +52,33 @@ public:
     bool tryReadImport(ArchiveImport& outImport, Diagnostic& outDiag, uint32_t headerOffset) const;
 
 private:
-    ByteArray                          bytes_;
-    std::unordered_map<Utf8, uint32_t> symbolToMember_;
+    // Sorted by hash, then by position in the linker member, so the first of several archive
+    // members defining a name is the one found.
+    struct SymbolEntry
+    {
+        uint32_t hash         = 0;
+        uint32_t nameOffset   = 0;
+        uint32_t memberOffset = 0;
+    };
+
+    struct MappedFileRelease
+    {
+        void operator()(Os::MappedFile* file) const;
+    };
+
+    bool             readLinkerMember(Diagnostic& outDiag);
+    bool             buildSymbolIndex(Diagnostic& outDiag);
+    bool             loadSymbolIndex(const fs::path& indexPath, const std::array<uint8_t, 32>& identity);
+    void             storeSymbolIndex(const fs::path& indexPath, const std::array<uint8_t, 32>& identity) const;
+    std::string_view symbolName(const SymbolEntry& entry) const;
+
+    ByteArray                                          ownedBytes_;
+    std::unique_ptr<Os::MappedFile, MappedFileRelease> mappedBytes_;
+    std::span<const std::byte>                         bytes_;
+    std::vector<SymbolEntry>                           symbols_;
+    uint32_t                                           symbolCount_ = 0;
+    uint32_t                                           namesBegin_  = 0;
+    uint32_t                                           namesEnd_    = 0;
 };
 
 // Builds a COFF static library (`!<arch>`) from prepared object members: a symbol-directory linker
@@ -8,6 +8,7 @@
 SWC_BEGIN_NAMESPACE();
 
 class Diagnostic;
+class TaskContext;
 
 // Serialises the resolved link inputs into the final on-disk artifact bytes for one target format:
 // executable/shared-library images plus the static and import libraries that accompany them. A
@@ -21,6 +22,10 @@ public:
 
     static std::unique_ptr<ImageWriter> create(Runtime::TargetOs targetOs);
 
+    // Context of the link job, used only to split independent work across the job manager. Without
+    // one, every method runs entirely on the calling thread.
+    void setWorkerContext(TaskContext* ctx) { workerCtx_ = ctx; }
+
     // Executable or shared-library image. Returns false and fills outDiag on an unresolved symbol or a
     // structural problem. When debugInfo is enabled, also produces the matching debug-info sidecar bytes
     // (a PDB on Windows) into outPdbBytes and embeds the reference to it in the image; outPdbBytes is left
@@ -33,6 +38,9 @@ public:
 
     // Import library that accompanies a shared library so dependents can resolve its exports by name.
     virtual void buildImportLibrary(ByteArray& outBytes, std::string_view dllFileName, const std::vector<Utf8>& exportNames) = 0;
+
+protected:
+    TaskContext* workerCtx_ = nullptr;
 };
 
 SWC_END_NAMESPACE();
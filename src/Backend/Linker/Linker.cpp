@@ -77,10 +77,11 @@ namespace
     // Serialise the LinkImage (or archive the objects) and write the artifact. Runs on a background
     // thread and so touches nothing but the self-contained job. The target format is chosen from the
     // job alone (set during prepareLink), so this stays usable on a detached thread.
-    void executePreparedLink(LinkJob& job)
+    void executePreparedLink(TaskContext& ctx, LinkJob& job)
     {
         const std::unique_ptr<ImageWriter> writer = ImageWriter::create(job.targetOs);
         SWC_ASSERT(writer != nullptr);
+        writer->setWorkerContext(&ctx);
         job.ok = runInternalLink(job, *writer);
     }
 }
@@ -131,14 +132,14 @@ Result Linker::link()
 {
     LinkJob job;
     SWC_RESULT(prepareLink(job));
-    executeLink(job);
+    executeLink(builder_->ctx(), job);
     return finishLink(job);
 }
 
-void Linker::executeLink(LinkJob& job)
+void Linker::executeLink(TaskContext& ctx, LinkJob& job)
 {
     job.executed = true;
-    executePreparedLink(job);
+    executePreparedLink(ctx, job);
 }
 
 Result Linker::finishLink(const LinkJob& job) const
@@ -30,7 +30,7 @@ public:
     Result link();
 
     virtual Result prepareLink(LinkJob& outJob) = 0;
-    static void    executeLink(LinkJob& job);
+    static void    executeLink(TaskContext& ctx, LinkJob& job);
     Result         finishLink(const LinkJob& job) const;
 
 protected:
@@ -54,7 +54,7 @@ public:
     JobResult exec() override
     {
         ctx().state().setNone();
-        Linker::executeLink(*job_);
+        Linker::executeLink(ctx(), *job_);
         return JobResult::Done;
     }
 
@@ -177,16 +177,11 @@ namespace
         }
     }
 
-    Result loadArchiveItem(ArchiveLoadItem& item)
+    Result loadArchiveItem(ArchiveLoadItem& item, const bool readIndexCache)
     {
-        FileSystem::IoErrorInfo ioError;
-        ByteArray               bytes;
-        if (FileSystem::readBinaryFile(item.path, bytes, ioError) != Result::Continue)
-            return Result::Continue;
-
         Archive    archive;
-        Diagnostic diag; // a non-archive candidate is silently skipped
-        if (archive.load(diag, std::move(bytes)))
+        Diagnostic diag; // an unreadable or non-archive candidate is silently skipped
+        if (archive.loadFile(diag, item.path, readIndexCache))
         {
             item.archive = std::move(archive);
             item.loaded  = true;
@@ -194,13 +189,13 @@ namespace
         return Result::Continue;
     }
 
-    Result loadArchivesFromSearch(std::vector<Archive>& outArchives, const std::set<Utf8>& libNames, const std::vector<fs::path>& dirs)
+    Result loadArchivesFromSearch(std::vector<Archive>& outArchives, const std::set<Utf8>& libNames, const std::vector<fs::path>& dirs, const bool readIndexCache)
     {
         std::vector<ArchiveLoadItem> items;
         collectArchiveLoadItems(items, libNames, dirs);
         for (ArchiveLoadItem& item : items)
         {
-            SWC_RESULT(loadArchiveItem(item));
+            SWC_RESULT(loadArchiveItem(item, readIndexCache));
             if (item.loaded)
                 outArchives.push_back(std::move(item.archive));
         }
@@ -487,7 +482,7 @@ namespace
         {
             ctx().state().setNone();
             SWC_ASSERT(item_ != nullptr);
-            setResult(loadArchiveItem(*item_));
+            setResult(loadArchiveItem(*item_, !ctx().cmdLine().rebuild));
             return JobResult::Done;
         }
 
@@ -603,7 +598,7 @@ Result PELinker::loadArchives(std::vector<Archive>& outArchives) const
     std::set<Utf8>        libNames;
     std::vector<fs::path> dirs;
     collectLibrarySearch(libNames, dirs);
-    return loadArchivesFromSearch(outArchives, libNames, dirs);
+    return loadArchivesFromSearch(outArchives, libNames, dirs, !builder_->ctx().cmdLine().rebuild);
 }
 
 Result PELinker::resolveSymbols(LinkImage& image, std::vector<Archive>& archives) const
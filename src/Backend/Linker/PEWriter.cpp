@@ -889,7 +889,7 @@ void PEWriter::emitDebugInfo()
     uint32_t                age        = 0;
     uint32_t                signature  = 0;
     const Utf8              pdbPathStr = nativePdbPathString(pdbPath_);
-    PdbWriter::build(*outPdbBytes_, guid, age, signature, *debugInfo_, pdbSections, resolver, image_->moduleName, pdbPathStr);
+    PdbWriter::build(*outPdbBytes_, guid, age, signature, *debugInfo_, pdbSections, resolver, image_->moduleName, pdbPathStr, workerCtx_);
 
     // Fill the reserved debug-directory section. Emit CodeView (the RSDS record pointing at the PDB)
     // and VC_FEATURE (feature counts) followed by their data blobs in the same section.
@@ -1,8 +1,13 @@
 #include "pch.h"
 #include "Backend/Linker/PdbWriter.h"
+#include "Main/Global.h"
+#include "Main/Stats.h"
+#include "Main/TaskContext.h"
 #include "Main/Version.h"
+#include "Support/Core/Timer.h"
 #include "Support/Math/Helpers.h"
 #include "Support/Report/Assert.h"
+#include "Support/Thread/JobManager.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -366,6 +371,7 @@ namespace
         uint32_t                              codeSize       = 0;
         uint32_t                              codeChars      = 0;
         uint32_t                              buildInfoIndex = 0;
+        std::vector<ProcRefSym>               procRefs;
     };
 
     struct PdbSectionContribBuild
@@ -519,210 +525,13 @@ namespace
         out.appendLe32(0); // data CRC
         out.appendLe32(0); // reloc CRC
     }
-}
-
-// =================================================================================================
 
-void PdbWriter::build(ByteArray&                         outBytes,
-                      std::array<uint8_t, 16>&           outGuid,
-                      uint32_t&                          outAge,
-                      uint32_t&                          outSignature,
-                      const LinkDebugInfo&               debugInfo,
-                      const std::vector<PdbSectionInfo>& sections,
-                      const SymbolResolver&              resolver,
-                      const Utf8&                        moduleName,
-                      const Utf8&                        pdbPath)
-{
-    outAge = 1;
-
-    // Deterministic GUID/signature derived from the module's debug content so rebuilds are stable.
-    uint64_t   h0  = 0xcbf29ce484222325ull;
-    uint64_t   h1  = 0x100000001b3ull;
-    const auto mix = [&](std::string_view text) {
-        for (const char ch : text)
-        {
-            h0 = (h0 ^ static_cast<uint8_t>(ch)) * 0x100000001b3ull;
-            h1 = (h1 ^ static_cast<uint8_t>(ch)) * 0xcbf29ce484222325ull + 0x9e3779b97f4a7c15ull;
-        }
-    };
-    mix(moduleName.view());
-    for (const LinkDebugFunction& fn : debugInfo.functions)
+    // Serialises one module stream: the compiland's symbols followed by its C13 line and checksum
+    // subsections. Reads only its own module and shared immutable inputs, so modules are built
+    // concurrently.
+    void buildModuleStream(PdbModuleBuild& module, const uint16_t moduleIndex, const LinkDebugInfo& debugInfo, const PdbWriter::SymbolResolver& resolver, const std::vector<uint32_t>& fileNameOffsets)
     {
-        mix(fn.symbolName.view());
-        h0 += fn.codeSize;
-    }
-    std::memcpy(outGuid.data(), &h0, 8);
-    std::memcpy(outGuid.data() + 8, &h1, 8);
-    outSignature = static_cast<uint32_t>(h0 ^ (h0 >> 32));
-
-    // ---- /names ---------------------------------------------------------------------------------
-    NamesTable            names;
-    std::vector<uint32_t> fileNameOffsets(debugInfo.files.size());
-    for (size_t i = 0; i < debugInfo.files.size(); ++i)
-        fileNameOffsets[i] = names.insert(debugInfo.files[i].path);
-
-    // ---- Symbol record stream (publics + globals referenced by GSI/PSI) -------------------------
-    Bytes                                              symRecords;
-    std::vector<HashedSym>                             publicSyms;
-    std::vector<HashedSym>                             globalSyms;
-    std::vector<std::pair<uint32_t, PdbSymbolAddress>> publicAddrs; // record offset + address (for the addr map)
-
-    for (const LinkDebugFunction& fn : debugInfo.functions)
-    {
-        const PdbSymbolAddress addr = resolver.resolve(fn.symbolName);
-        if (!addr.found)
-            continue;
-
-        Bytes payload;
-        payload.appendLe32(K_PUB_FLAG_FUNCTION);
-        payload.appendLe32(addr.offset);
-        payload.appendLe16(addr.segment);
-        payload.appendCString(fn.symbolName.view());
-        const uint32_t recordOffset = appendSymbol(symRecords, K_S_PUB32, payload);
-
-        publicSyms.push_back({recordOffset, fn.symbolName});
-        publicAddrs.emplace_back(recordOffset, addr);
-    }
-
-    for (const LinkDebugGlobal& g : debugInfo.globals)
-    {
-        const PdbSymbolAddress addr = resolver.resolveSection(g.sectionName, g.sectionOffset);
-        if (!addr.found)
-            continue;
-
-        Bytes payload;
-        payload.appendLe32(g.typeIndex);
-        payload.appendLe32(addr.offset);
-        payload.appendLe16(addr.segment);
-        payload.appendCString(g.displayName.view());
-        const uint32_t recordOffset = appendSymbol(symRecords, g.isPublic ? K_S_GDATA32 : K_S_LDATA32, payload);
-        globalSyms.push_back({recordOffset, g.displayName});
-    }
-
-    for (const LinkDebugUdt& udt : debugInfo.udts)
-    {
-        Bytes payload;
-        payload.appendLe32(udt.typeIndex);
-        payload.appendCString(udt.name.view());
-        const uint32_t recordOffset = appendSymbol(symRecords, K_S_UDT, payload);
-        globalSyms.push_back({recordOffset, udt.name});
-    }
-
-    // ---- Module streams -------------------------------------------------------------------------
-    // Model each PDB compiland as the object file the backend split functions into (the codegen job),
-    // named after that .obj. This mirrors the MSVC-style layout Visual Studio expects while every
-    // function still carries its own source-file line table.
-    std::vector<PdbModuleBuild>          modules;
-    std::unordered_map<uint32_t, size_t> moduleOfObj;
-    const auto                           addFileToModule = [](PdbModuleBuild& module, const uint32_t fileIndex) {
-        if (fileIndex == std::numeric_limits<uint32_t>::max())
-            return;
-        for (const uint32_t existing : module.fileIndices)
-            if (existing == fileIndex)
-                return;
-        module.fileIndices.push_back(fileIndex);
-    };
-
-    for (const LinkDebugFunction& fn : debugInfo.functions)
-    {
-        const PdbSymbolAddress addr = resolver.resolve(fn.symbolName);
-        if (!addr.found)
-            continue;
-
-        uint32_t primaryFile = fn.primaryFileIndex;
-        if (primaryFile >= debugInfo.files.size() && !fn.lineBlocks.empty() && fn.lineBlocks.front().fileIndex < debugInfo.files.size())
-            primaryFile = fn.lineBlocks.front().fileIndex;
-
-        size_t     moduleIndex;
-        const auto it = moduleOfObj.find(fn.objIndex);
-        if (it != moduleOfObj.end())
-        {
-            moduleIndex = it->second;
-        }
-        else
-        {
-            moduleIndex = modules.size();
-            moduleOfObj.emplace(fn.objIndex, moduleIndex);
-            PdbModuleBuild module;
-            module.primaryFileIndex = primaryFile;
-            module.name             = fn.objIndex < debugInfo.objectNames.size() ? debugInfo.objectNames[fn.objIndex] : moduleName;
-            modules.push_back(std::move(module));
-        }
-
-        PdbModuleBuild& module = modules[moduleIndex];
-        module.functions.push_back(&fn);
-        addFileToModule(module, primaryFile);
-        for (const LinkDebugLineBlock& block : fn.lineBlocks)
-            if (block.fileIndex < debugInfo.files.size())
-                addFileToModule(module, block.fileIndex);
-    }
-
-    uint16_t textSegment = 1;
-    uint32_t textChars   = 0;
-    for (size_t i = 0; i < sections.size(); ++i)
-    {
-        if (sections[i].name == ".text")
-        {
-            textSegment = static_cast<uint16_t>(i + 1);
-            textChars   = sections[i].characteristics;
-            break;
-        }
-    }
-
-    constexpr uint32_t      symBase = sizeof(uint32_t);
-    std::vector<ProcRefSym> procRefs;
-    constexpr uint16_t      moduleStreamStart = STREAM_NAMES + 1;
-    for (PdbModuleBuild& module : modules)
-    {
-        module.codeSegment = textSegment;
-        module.codeChars   = textChars;
-
-        uint32_t minCodeOffset = std::numeric_limits<uint32_t>::max();
-        uint32_t maxCodeOffset = 0;
-        for (const LinkDebugFunction* fn : module.functions)
-        {
-            const PdbSymbolAddress addr = resolver.resolve(fn->symbolName);
-            if (!addr.found)
-                continue;
-
-            minCodeOffset = std::min(minCodeOffset, addr.offset);
-            maxCodeOffset = std::max(maxCodeOffset, addr.offset + fn->codeSize);
-        }
-
-        if (minCodeOffset != std::numeric_limits<uint32_t>::max())
-        {
-            module.codeOffset = minCodeOffset;
-            module.codeSize   = maxCodeOffset - minCodeOffset;
-        }
-    }
-
-    std::ranges::sort(modules, [](const PdbModuleBuild& a, const PdbModuleBuild& b) {
-        if (a.codeSegment != b.codeSegment)
-            return a.codeSegment < b.codeSegment;
-        if (a.codeOffset != b.codeOffset)
-            return a.codeOffset < b.codeOffset;
-        if (a.codeSize != b.codeSize)
-            return a.codeSize < b.codeSize;
-        return a.name < b.name;
-    });
-
-    Bytes    ipiRecords  = debugInfo.ipiRecords;
-    uint32_t ipiIndexEnd = std::max<uint32_t>(0x1000, debugInfo.ipiIndexEnd);
-    for (PdbModuleBuild& module : modules)
-    {
-        const Utf8     primarySource = module.primaryFileIndex < debugInfo.files.size() ? debugInfo.files[module.primaryFileIndex].path : module.name;
-        const uint32_t currentDirId  = appendStringIdRecord(ipiRecords, ipiIndexEnd, buildInfoDirectory(primarySource));
-        const uint32_t buildToolId   = appendStringIdRecord(ipiRecords, ipiIndexEnd, {});
-        const uint32_t sourceFileId  = appendStringIdRecord(ipiRecords, ipiIndexEnd, buildInfoFileName(primarySource));
-        const uint32_t pdbFileId     = appendStringIdRecord(ipiRecords, ipiIndexEnd, pdbPath);
-        const uint32_t commandLineId = appendStringIdRecord(ipiRecords, ipiIndexEnd, {});
-        module.buildInfoIndex        = appendBuildInfoRecord(ipiRecords, ipiIndexEnd, {currentDirId, buildToolId, sourceFileId, pdbFileId, commandLineId});
-    }
-
-    for (size_t i = 0; i < modules.size(); ++i)
-    {
-        PdbModuleBuild& module = modules[i];
-        module.streamIndex     = static_cast<uint16_t>(moduleStreamStart + i);
+        constexpr uint32_t symBase = sizeof(uint32_t);
 
         Bytes moduleSymbols;
         {
@@ -777,7 +586,7 @@ void PdbWriter::build(ByteArray&                         outBytes,
             payload.pushBack(std::byte{0}); // flags
             payload.appendCString(functionName);
             const uint32_t procOffset = appendSymbol(moduleSymbols, K_S_GPROC32, payload);
-            procRefs.push_back({Utf8(functionName), symBase + procOffset, static_cast<uint16_t>(i)});
+            module.procRefs.push_back({Utf8(functionName), symBase + procOffset, moduleIndex});
             const uint32_t endFieldOffset = procOffset + 2 + 2 + 4;
 
             {
@@ -886,137 +695,263 @@ void PdbWriter::build(ByteArray&                         outBytes,
         module.c13ByteSize = static_cast<uint32_t>(c13.size());
         module.stream.appendLe32(0); // GlobalRefs byte size
     }
+}
 
-    for (const ProcRefSym& procRef : procRefs)
+// =================================================================================================
+
+void PdbWriter::build(ByteArray&                         outBytes,
+                      std::array<uint8_t, 16>&           outGuid,
+                      uint32_t&                          outAge,
+                      uint32_t&                          outSignature,
+                      const LinkDebugInfo&               debugInfo,
+                      const std::vector<PdbSectionInfo>& sections,
+                      const SymbolResolver&              resolver,
+                      const Utf8&                        moduleName,
+                      const Utf8&                        pdbPath,
+                      TaskContext*                       ctx)
+{
+    outAge = 1;
+
+    // Deterministic GUID/signature derived from the module's debug content so rebuilds are stable.
+    uint64_t   h0  = 0xcbf29ce484222325ull;
+    uint64_t   h1  = 0x100000001b3ull;
+    const auto mix = [&](std::string_view text) {
+        for (const char ch : text)
+        {
+            h0 = (h0 ^ static_cast<uint8_t>(ch)) * 0x100000001b3ull;
+            h1 = (h1 ^ static_cast<uint8_t>(ch)) * 0xcbf29ce484222325ull + 0x9e3779b97f4a7c15ull;
+        }
+    };
+    mix(moduleName.view());
+    for (const LinkDebugFunction& fn : debugInfo.functions)
     {
-        Bytes payload;
-        payload.appendLe32(0); // checksum of the procedure name; 0 is accepted by MSVC-produced PDBs
-        payload.appendLe32(procRef.moduleSymOffset);
-        payload.appendLe16(static_cast<uint16_t>(procRef.moduleIndex + 1)); // one-based module index
-        payload.appendCString(procRef.name.view());
-        const uint32_t recordOffset = appendSymbol(symRecords, K_S_PROCREF, payload);
-        globalSyms.push_back({recordOffset, procRef.name});
+        mix(fn.symbolName.view());
+        h0 += fn.codeSize;
     }
+    std::memcpy(outGuid.data(), &h0, 8);
+    std::memcpy(outGuid.data() + 8, &h1, 8);
+    outSignature = static_cast<uint32_t>(h0 ^ (h0 >> 32));
 
-    // ---- DBI stream -----------------------------------------------------------------------------
-    Bytes    modInfo;
-    uint32_t sourceFileRefCount = 0;
-    for (PdbModuleBuild& module : modules)
+    // ---- /names ---------------------------------------------------------------------------------
+    NamesTable            names;
+    std::vector<uint32_t> fileNameOffsets(debugInfo.files.size());
+    for (size_t i = 0; i < debugInfo.files.size(); ++i)
+        fileNameOffsets[i] = names.insert(debugInfo.files[i].path);
+
+    // ---- Symbol record stream (publics + globals referenced by GSI/PSI) -------------------------
+    Bytes                                              symRecords;
+    std::vector<HashedSym>                             publicSyms;
+    std::vector<HashedSym>                             globalSyms;
+    std::vector<std::pair<uint32_t, PdbSymbolAddress>> publicAddrs; // record offset + address (for the addr map)
     {
-        modInfo.appendLe32(0); // Unused1
-        appendSectionContribEntry(modInfo, module.codeSegment, module.codeOffset, module.codeSize, module.codeChars, static_cast<uint16_t>(&module - modules.data()));
-        modInfo.appendLe16(0);                                                // Flags
-        modInfo.appendLe16(module.streamIndex);                               // ModuleSymStream
-        modInfo.appendLe32(module.symByteSize);                               // SymByteSize
-        modInfo.appendLe32(0);                                                // C11ByteSize
-        modInfo.appendLe32(module.c13ByteSize);                               // C13ByteSize
-        modInfo.appendLe16(static_cast<uint16_t>(module.fileIndices.size())); // SourceFileCount
-        modInfo.appendLe16(0);                                                // padding
-        modInfo.appendLe32(0);                                                // Unused2
-        modInfo.appendLe32(0);                                                // SourceFileNameIndex (EC string table index)
-        modInfo.appendLe32(0);                                                // PdbFilePathNameIndex (EC string table index)
-        modInfo.appendCString(module.name.view());                            // ModuleName (the object file)
-        modInfo.appendCString(module.name.view());                            // ObjFileName (standalone object: same as ModuleName)
-        modInfo.align(4);
-        sourceFileRefCount += static_cast<uint32_t>(module.fileIndices.size());
+        Timer time(Stats::timedMetric(Stats::get().timePdbSymbolStreams));
+        for (const LinkDebugFunction& fn : debugInfo.functions)
+        {
+            const PdbSymbolAddress addr = resolver.resolve(fn.symbolName);
+            if (!addr.found)
+                continue;
+
+            Bytes payload;
+            payload.appendLe32(K_PUB_FLAG_FUNCTION);
+            payload.appendLe32(addr.offset);
+            payload.appendLe16(addr.segment);
+            payload.appendCString(fn.symbolName.view());
+            const uint32_t recordOffset = appendSymbol(symRecords, K_S_PUB32, payload);
+
+            publicSyms.push_back({recordOffset, fn.symbolName});
+            publicAddrs.emplace_back(recordOffset, addr);
+        }
+
+        for (const LinkDebugGlobal& g : debugInfo.globals)
+        {
+            const PdbSymbolAddress addr = resolver.resolveSection(g.sectionName, g.sectionOffset);
+            if (!addr.found)
+                continue;
+
+            Bytes payload;
+            payload.appendLe32(g.typeIndex);
+            payload.appendLe32(addr.offset);
+            payload.appendLe16(addr.segment);
+            payload.appendCString(g.displayName.view());
+            const uint32_t recordOffset = appendSymbol(symRecords, g.isPublic ? K_S_GDATA32 : K_S_LDATA32, payload);
+            globalSyms.push_back({recordOffset, g.displayName});
+        }
+
+        for (const LinkDebugUdt& udt : debugInfo.udts)
+        {
+            Bytes payload;
+            payload.appendLe32(udt.typeIndex);
+            payload.appendCString(udt.name.view());
+            const uint32_t recordOffset = appendSymbol(symRecords, K_S_UDT, payload);
+            globalSyms.push_back({recordOffset, udt.name});
+        }
     }
 
-    Bytes secContr;
+    // ---- Module streams -------------------------------------------------------------------------
+    // Model each PDB compiland as the object file the backend split functions into (the codegen job),
+    // named after that .obj. This mirrors the MSVC-style layout Visual Studio expects while every
+    // function still carries its own source-file line table.
+    std::vector<PdbModuleBuild>          modules;
+    std::unordered_map<uint32_t, size_t> moduleOfObj;
+    const auto                           addFileToModule = [](PdbModuleBuild& module, const uint32_t fileIndex) {
+        if (fileIndex == std::numeric_limits<uint32_t>::max())
+            return;
+        for (const uint32_t existing : module.fileIndices)
+            if (existing == fileIndex)
+                return;
+        module.fileIndices.push_back(fileIndex);
+    };
+
+    for (const LinkDebugFunction& fn : debugInfo.functions)
     {
-        std::vector<PdbSectionContribBuild> sectionContribs;
-        sectionContribs.reserve(debugInfo.functions.size());
-        for (size_t i = 0; i < modules.size(); ++i)
+        const PdbSymbolAddress addr = resolver.resolve(fn.symbolName);
+        if (!addr.found)
+            continue;
+
+        uint32_t primaryFile = fn.primaryFileIndex;
+        if (primaryFile >= debugInfo.files.size() && !fn.lineBlocks.empty() && fn.lineBlocks.front().fileIndex < debugInfo.files.size())
+            primaryFile = fn.lineBlocks.front().fileIndex;
+
+        size_t     moduleIndex;
+        const auto it = moduleOfObj.find(fn.objIndex);
+        if (it != moduleOfObj.end())
         {
-            const PdbModuleBuild& module = modules[i];
-            for (const LinkDebugFunction* fn : module.functions)
-            {
-                const PdbSymbolAddress addr = resolver.resolve(fn->symbolName);
-                if (!addr.found || !fn->codeSize)
-                    continue;
-                sectionContribs.push_back({addr.segment, addr.offset, fn->codeSize, module.codeChars, static_cast<uint16_t>(i)});
-            }
+            moduleIndex = it->second;
+        }
+        else
+        {
+            moduleIndex = modules.size();
+            moduleOfObj.emplace(fn.objIndex, moduleIndex);
+            PdbModuleBuild module;
+            module.primaryFileIndex = primaryFile;
+            module.name             = fn.objIndex < debugInfo.objectNames.size() ? debugInfo.objectNames[fn.objIndex] : moduleName;
+            modules.push_back(std::move(module));
         }
 
-        std::ranges::sort(sectionContribs, [](const PdbSectionContribBuild& a, const PdbSectionContribBuild& b) {
-            if (a.segment != b.segment)
-                return a.segment < b.segment;
-            if (a.offset != b.offset)
-                return a.offset < b.offset;
-            if (a.size != b.size)
-                return a.size < b.size;
-            return a.moduleIndex < b.moduleIndex;
-        });
+        PdbModuleBuild& module = modules[moduleIndex];
+        module.functions.push_back(&fn);
+        addFileToModule(module, primaryFile);
+        for (const LinkDebugLineBlock& block : fn.lineBlocks)
+            if (block.fileIndex < debugInfo.files.size())
+                addFileToModule(module, block.fileIndex);
+    }
+
+    uint16_t textSegment = 1;
+    uint32_t textChars   = 0;
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        if (sections[i].name == ".text")
+        {
+            textSegment = static_cast<uint16_t>(i + 1);
+            textChars   = sections[i].characteristics;
+            break;
+        }
+    }
+
+    constexpr uint16_t moduleStreamStart = STREAM_NAMES + 1;
+    for (PdbModuleBuild& module : modules)
+    {
+        module.codeSegment = textSegment;
+        module.codeChars   = textChars;
+
+        uint32_t minCodeOffset = std::numeric_limits<uint32_t>::max();
+        uint32_t maxCodeOffset = 0;
+        for (const LinkDebugFunction* fn : module.functions)
+        {
+            const PdbSymbolAddress addr = resolver.resolve(fn->symbolName);
+            if (!addr.found)
+                continue;
 
-        secContr.appendLe32(0xeffe0000u + 19970605u); // Ver60
-        for (const PdbSectionContribBuild& sectionContrib : sectionContribs)
-            appendSectionContribEntry(secContr, sectionContrib.segment, sectionContrib.offset, sectionContrib.size, sectionContrib.characteristics, sectionContrib.moduleIndex);
+            minCodeOffset = std::min(minCodeOffset, addr.offset);
+            maxCodeOffset = std::max(maxCodeOffset, addr.offset + fn->codeSize);
+        }
+
+        if (minCodeOffset != std::numeric_limits<uint32_t>::max())
+        {
+            module.codeOffset = minCodeOffset;
+            module.codeSize   = maxCodeOffset - minCodeOffset;
+        }
     }
 
-    Bytes secMap;
+    std::ranges::sort(modules, [](const PdbModuleBuild& a, const PdbModuleBuild& b) {
+        if (a.codeSegment != b.codeSegment)
+            return a.codeSegment < b.codeSegment;
+        if (a.codeOffset != b.codeOffset)
+            return a.codeOffset < b.codeOffset;
+        if (a.codeSize != b.codeSize)
+            return a.codeSize < b.codeSize;
+        return a.name < b.name;
+    });
+
+    // Modules built from the same source share their build-info records, and every module shares
+    // the empty and pdb-path string ids.
+    Bytes    ipiRecords  = debugInfo.ipiRecords;
+    uint32_t ipiIndexEnd = std::max<uint32_t>(0x1000, debugInfo.ipiIndexEnd);
     {
-        const auto count = static_cast<uint16_t>(sections.size() + 1);
-        secMap.appendLe16(count);
-        secMap.appendLe16(count);
-        for (size_t i = 0; i < sections.size(); ++i)
+        Timer time(Stats::timedMetric(Stats::get().timePdbTypeStreams));
+        std::unordered_map<Utf8, uint32_t>          stringIds;
+        std::map<std::array<uint32_t, 5>, uint32_t> buildInfos;
+        const auto                                  stringId = [&](const Utf8& value) {
+            const auto [it, inserted] = stringIds.try_emplace(value, 0);
+            if (inserted)
+                it->second = appendStringIdRecord(ipiRecords, ipiIndexEnd, value);
+            return it->second;
+        };
+
+        for (PdbModuleBuild& module : modules)
         {
-            const uint32_t ch    = sections[i].characteristics;
-            uint16_t       flags = 0x8; // AddressIs32Bit
-            if (ch & K_SCN_MEM_READ)
-                flags |= 0x1;
-            if (ch & K_SCN_MEM_WRITE)
-                flags |= 0x2;
-            if (ch & K_SCN_MEM_EXECUTE)
-                flags |= 0x4;
-            secMap.appendLe16(flags);
-            secMap.appendLe16(0);                            // Ovl
-            secMap.appendLe16(0);                            // Group
-            secMap.appendLe16(static_cast<uint16_t>(i + 1)); // Frame
-            secMap.appendLe16(0xFFFF);                       // SectionName
-            secMap.appendLe16(0xFFFF);                       // ClassName
-            secMap.appendLe32(0);                            // Offset
-            secMap.appendLe32(sections[i].virtualSize);      // SectionLength
+            const Utf8                    primarySource = module.primaryFileIndex < debugInfo.files.size() ? debugInfo.files[module.primaryFileIndex].path : module.name;
+            const std::array<uint32_t, 5> items         = {stringId(buildInfoDirectory(primarySource)), stringId({}), stringId(buildInfoFileName(primarySource)), stringId(pdbPath), stringId({})};
+            const auto [it, inserted]                   = buildInfos.try_emplace(items, 0);
+            if (inserted)
+                it->second = appendBuildInfoRecord(ipiRecords, ipiIndexEnd, items);
+            module.buildInfoIndex = it->second;
         }
-        // Trailing absolute section descriptor.
-        secMap.appendLe16(0x208);
-        secMap.appendLe16(0);
-        secMap.appendLe16(0);
-        secMap.appendLe16(count);
-        secMap.appendLe16(0xFFFF);
-        secMap.appendLe16(0xFFFF);
-        secMap.appendLe32(0);
-        secMap.appendLe32(0xFFFFFFFFu);
     }
 
-    Bytes sourceInfo;
+    for (size_t i = 0; i < modules.size(); ++i)
+        modules[i].streamIndex = static_cast<uint16_t>(moduleStreamStart + i);
+
     {
-        sourceInfo.appendLe16(static_cast<uint16_t>(modules.size()));     // NumModules
-        sourceInfo.appendLe16(static_cast<uint16_t>(sourceFileRefCount)); // NumSourceFiles
-        uint16_t sourceFileBase = 0;
-        for (const PdbModuleBuild& module : modules)
+        Timer time(Stats::timedMetric(Stats::get().timePdbModuleStreams));
+        const auto buildModule = [&](const uint32_t i) {
+            buildModuleStream(modules[i], static_cast<uint16_t>(i), debugInfo, resolver, fileNameOffsets);
+        };
+
+        const auto numModules = static_cast<uint32_t>(modules.size());
+        if (ctx)
         {
-            sourceInfo.appendLe16(sourceFileBase);
-            sourceFileBase = static_cast<uint16_t>(sourceFileBase + module.fileIndices.size());
+            JobManager&       jobMgr   = ctx->global().jobMgr();
+            const JobClientId clientId = jobMgr.newClientId();
+            jobMgr.parallelForIndexed(*ctx, numModules, JobKind::NativeLink, clientId, [&](TaskContext&, const uint32_t i) { buildModule(i); });
+            jobMgr.releaseClientId(clientId);
         }
-        for (const PdbModuleBuild& module : modules)
-            sourceInfo.appendLe16(static_cast<uint16_t>(module.fileIndices.size()));
+        else
+        {
+            for (uint32_t i = 0; i < numModules; ++i)
+                buildModule(i);
+        }
+    }
 
-        Bytes                 namesBuf;
-        std::vector<uint32_t> offs;
-        offs.reserve(sourceFileRefCount);
+    // Procedure references are appended in module order, as the serial build produced them.
+    {
+        Timer time(Stats::timedMetric(Stats::get().timePdbSymbolStreams));
         for (const PdbModuleBuild& module : modules)
         {
-            for (const uint32_t fileIndex : module.fileIndices)
+            for (const ProcRefSym& procRef : module.procRefs)
             {
-                offs.push_back(static_cast<uint32_t>(namesBuf.size()));
-                namesBuf.appendCString(debugInfo.files[fileIndex].path.view());
+                Bytes payload;
+                payload.appendLe32(0); // checksum of the procedure name; 0 is accepted by MSVC-produced PDBs
+                payload.appendLe32(procRef.moduleSymOffset);
+                payload.appendLe16(static_cast<uint16_t>(procRef.moduleIndex + 1)); // one-based module index
+                payload.appendCString(procRef.name.view());
+                const uint32_t recordOffset = appendSymbol(symRecords, K_S_PROCREF, payload);
+                globalSyms.push_back({recordOffset, procRef.name});
             }
         }
-        for (const uint32_t o : offs)
-            sourceInfo.appendLe32(o);
-        sourceInfo.append(namesBuf);
-        sourceInfo.align(4);
     }
 
+    // ---- DBI stream -----------------------------------------------------------------------------
     const uint16_t globalsStreamIndex    = static_cast<uint16_t>(moduleStreamStart + modules.size());
     const uint16_t publicsStreamIndex    = static_cast<uint16_t>(globalsStreamIndex + 1);
     const uint16_t symRecordsStreamIndex = static_cast<uint16_t>(publicsStreamIndex + 1);
@@ -1024,60 +959,183 @@ void PdbWriter::build(ByteArray&                         outBytes,
     const uint16_t tpiHashStreamIndex    = static_cast<uint16_t>(sectionHdrStreamIndex + 1);
     const uint16_t ipiHashStreamIndex    = static_cast<uint16_t>(tpiHashStreamIndex + 1);
 
-    // Edit-and-continue substream: a minimal but valid empty string table.
-    Bytes ecSubstream;
+    Bytes dbi;
     {
-        ecSubstream.appendLe32(0xEFFEEFFEu);
-        ecSubstream.appendLe32(1);
-        ecSubstream.appendLe32(1);
-        ecSubstream.pushBack(std::byte{0});
-        ecSubstream.appendLe32(1); // bucket count
-        ecSubstream.appendLe32(0); // bucket[0]
-        ecSubstream.appendLe32(0); // name count
-        ecSubstream.align(4);
-    }
+        Timer time(Stats::timedMetric(Stats::get().timePdbDbiStream));
+        Bytes    modInfo;
+        uint32_t sourceFileRefCount = 0;
+        for (PdbModuleBuild& module : modules)
+        {
+            modInfo.appendLe32(0); // Unused1
+            appendSectionContribEntry(modInfo, module.codeSegment, module.codeOffset, module.codeSize, module.codeChars, static_cast<uint16_t>(&module - modules.data()));
+            modInfo.appendLe16(0);                                                // Flags
+            modInfo.appendLe16(module.streamIndex);                               // ModuleSymStream
+            modInfo.appendLe32(module.symByteSize);                               // SymByteSize
+            modInfo.appendLe32(0);                                                // C11ByteSize
+            modInfo.appendLe32(module.c13ByteSize);                               // C13ByteSize
+            modInfo.appendLe16(static_cast<uint16_t>(module.fileIndices.size())); // SourceFileCount
+            modInfo.appendLe16(0);                                                // padding
+            modInfo.appendLe32(0);                                                // Unused2
+            modInfo.appendLe32(0);                                                // SourceFileNameIndex (EC string table index)
+            modInfo.appendLe32(0);                                                // PdbFilePathNameIndex (EC string table index)
+            modInfo.appendCString(module.name.view());                            // ModuleName (the object file)
+            modInfo.appendCString(module.name.view());                            // ObjFileName (standalone object: same as ModuleName)
+            modInfo.align(4);
+            sourceFileRefCount += static_cast<uint32_t>(module.fileIndices.size());
+        }
 
-    Bytes optDbgHeader;
-    {
-        for (uint16_t i = 0; i < 11; ++i)
-            optDbgHeader.appendLe16(i == 5 ? sectionHdrStreamIndex : 0xFFFF);
-    }
+        Bytes secContr;
+        {
+            std::vector<PdbSectionContribBuild> sectionContribs;
+            sectionContribs.reserve(debugInfo.functions.size());
+            for (size_t i = 0; i < modules.size(); ++i)
+            {
+                const PdbModuleBuild& module = modules[i];
+                for (const LinkDebugFunction* fn : module.functions)
+                {
+                    const PdbSymbolAddress addr = resolver.resolve(fn->symbolName);
+                    if (!addr.found || !fn->codeSize)
+                        continue;
+                    sectionContribs.push_back({addr.segment, addr.offset, fn->codeSize, module.codeChars, static_cast<uint16_t>(i)});
+                }
+            }
 
-    Bytes dbi;
-    {
-        dbi.appendLe32(0xFFFFFFFFu);           // VersionSignature (-1)
-        dbi.appendLe32(19990903);              // VersionHeader (V70)
-        dbi.appendLe32(outAge);                // Age
-        dbi.appendLe16(globalsStreamIndex);    // GlobalStreamIndex
-        dbi.appendLe16(0x8e32);                // BuildNumber: new-format flag | 14.50, matching MSVC's DBI header
-        dbi.appendLe16(publicsStreamIndex);    // PublicStreamIndex
-        dbi.appendLe16(35726);                 // PdbDllVersion (non-zero, matching MSVC-produced PDBs)
-        dbi.appendLe16(symRecordsStreamIndex); // SymRecordStreamIndex
-        dbi.appendLe16(0);                     // PdbDllRbld
-        dbi.appendLe32(static_cast<uint32_t>(modInfo.size()));
-        dbi.appendLe32(static_cast<uint32_t>(secContr.size()));
-        dbi.appendLe32(static_cast<uint32_t>(secMap.size()));
-        dbi.appendLe32(static_cast<uint32_t>(sourceInfo.size()));
-        dbi.appendLe32(0); // TypeServerMapSize
-        dbi.appendLe32(0); // MFCTypeServerIndex
-        dbi.appendLe32(static_cast<uint32_t>(optDbgHeader.size()));
-        dbi.appendLe32(static_cast<uint32_t>(ecSubstream.size()));
-        dbi.appendLe16(0);      // Flags
-        dbi.appendLe16(0x8664); // Machine (AMD64)
-        dbi.appendLe32(0);      // Reserved
-        dbi.append(modInfo);
-        dbi.append(secContr);
-        dbi.append(secMap);
-        dbi.append(sourceInfo);
-        dbi.append(ecSubstream);
-        dbi.append(optDbgHeader);
+            std::ranges::sort(sectionContribs, [](const PdbSectionContribBuild& a, const PdbSectionContribBuild& b) {
+                if (a.segment != b.segment)
+                    return a.segment < b.segment;
+                if (a.offset != b.offset)
+                    return a.offset < b.offset;
+                if (a.size != b.size)
+                    return a.size < b.size;
+                return a.moduleIndex < b.moduleIndex;
+            });
+
+            secContr.appendLe32(0xeffe0000u + 19970605u); // Ver60
+            for (const PdbSectionContribBuild& sectionContrib : sectionContribs)
+                appendSectionContribEntry(secContr, sectionContrib.segment, sectionContrib.offset, sectionContrib.size, sectionContrib.characteristics, sectionContrib.moduleIndex);
+        }
+
+        Bytes secMap;
+        {
+            const auto count = static_cast<uint16_t>(sections.size() + 1);
+            secMap.appendLe16(count);
+            secMap.appendLe16(count);
+            for (size_t i = 0; i < sections.size(); ++i)
+            {
+                const uint32_t ch    = sections[i].characteristics;
+                uint16_t       flags = 0x8; // AddressIs32Bit
+                if (ch & K_SCN_MEM_READ)
+                    flags |= 0x1;
+                if (ch & K_SCN_MEM_WRITE)
+                    flags |= 0x2;
+                if (ch & K_SCN_MEM_EXECUTE)
+                    flags |= 0x4;
+                secMap.appendLe16(flags);
+                secMap.appendLe16(0);                            // Ovl
+                secMap.appendLe16(0);                            // Group
+                secMap.appendLe16(static_cast<uint16_t>(i + 1)); // Frame
+                secMap.appendLe16(0xFFFF);                       // SectionName
+                secMap.appendLe16(0xFFFF);                       // ClassName
+                secMap.appendLe32(0);                            // Offset
+                secMap.appendLe32(sections[i].virtualSize);      // SectionLength
+            }
+            // Trailing absolute section descriptor.
+            secMap.appendLe16(0x208);
+            secMap.appendLe16(0);
+            secMap.appendLe16(0);
+            secMap.appendLe16(count);
+            secMap.appendLe16(0xFFFF);
+            secMap.appendLe16(0xFFFF);
+            secMap.appendLe32(0);
+            secMap.appendLe32(0xFFFFFFFFu);
+        }
+
+        Bytes sourceInfo;
+        {
+            sourceInfo.appendLe16(static_cast<uint16_t>(modules.size()));     // NumModules
+            sourceInfo.appendLe16(static_cast<uint16_t>(sourceFileRefCount)); // NumSourceFiles
+            uint16_t sourceFileBase = 0;
+            for (const PdbModuleBuild& module : modules)
+            {
+                sourceInfo.appendLe16(sourceFileBase);
+                sourceFileBase = static_cast<uint16_t>(sourceFileBase + module.fileIndices.size());
+            }
+            for (const PdbModuleBuild& module : modules)
+                sourceInfo.appendLe16(static_cast<uint16_t>(module.fileIndices.size()));
+
+            Bytes                 namesBuf;
+            std::vector<uint32_t> offs;
+            offs.reserve(sourceFileRefCount);
+            for (const PdbModuleBuild& module : modules)
+            {
+                for (const uint32_t fileIndex : module.fileIndices)
+                {
+                    offs.push_back(static_cast<uint32_t>(namesBuf.size()));
+                    namesBuf.appendCString(debugInfo.files[fileIndex].path.view());
+                }
+            }
+            for (const uint32_t o : offs)
+                sourceInfo.appendLe32(o);
+            sourceInfo.append(namesBuf);
+            sourceInfo.align(4);
+        }
+
+        // Edit-and-continue substream: a minimal but valid empty string table.
+        Bytes ecSubstream;
+        {
+            ecSubstream.appendLe32(0xEFFEEFFEu);
+            ecSubstream.appendLe32(1);
+            ecSubstream.appendLe32(1);
+            ecSubstream.pushBack(std::byte{0});
+            ecSubstream.appendLe32(1); // bucket count
+            ecSubstream.appendLe32(0); // bucket[0]
+            ecSubstream.appendLe32(0); // name count
+            ecSubstream.align(4);
+        }
+
+        Bytes optDbgHeader;
+        {
+            for (uint16_t i = 0; i < 11; ++i)
+                optDbgHeader.appendLe16(i == 5 ? sectionHdrStreamIndex : 0xFFFF);
+        }
+
+        {
+            dbi.appendLe32(0xFFFFFFFFu);           // VersionSignature (-1)
+            dbi.appendLe32(19990903);              // VersionHeader (V70)
+            dbi.appendLe32(outAge);                // Age
+            dbi.appendLe16(globalsStreamIndex);    // GlobalStreamIndex
+            dbi.appendLe16(0x8e32);                // BuildNumber: new-format flag | 14.50, matching MSVC's DBI header
+            dbi.appendLe16(publicsStreamIndex);    // PublicStreamIndex
+            dbi.appendLe16(35726);                 // PdbDllVersion (non-zero, matching MSVC-produced PDBs)
+            dbi.appendLe16(symRecordsStreamIndex); // SymRecordStreamIndex
+            dbi.appendLe16(0);                     // PdbDllRbld
+            dbi.appendLe32(static_cast<uint32_t>(modInfo.size()));
+            dbi.appendLe32(static_cast<uint32_t>(secContr.size()));
+            dbi.appendLe32(static_cast<uint32_t>(secMap.size()));
+            dbi.appendLe32(static_cast<uint32_t>(sourceInfo.size()));
+            dbi.appendLe32(0); // TypeServerMapSize
+            dbi.appendLe32(0); // MFCTypeServerIndex
+            dbi.appendLe32(static_cast<uint32_t>(optDbgHeader.size()));
+            dbi.appendLe32(static_cast<uint32_t>(ecSubstream.size()));
+            dbi.appendLe16(0);      // Flags
+            dbi.appendLe16(0x8664); // Machine (AMD64)
+            dbi.appendLe32(0);      // Reserved
+            dbi.append(modInfo);
+            dbi.append(secContr);
+            dbi.append(secMap);
+            dbi.append(sourceInfo);
+            dbi.append(ecSubstream);
+            dbi.append(optDbgHeader);
+        }
     }
 
     // ---- Globals / publics streams --------------------------------------------------------------
-    const Bytes globalsStream = buildGsiHash(globalSyms);
-
+    Bytes globalsStream;
     Bytes publicsStream;
     {
+        Timer time(Stats::timedMetric(Stats::get().timePdbSymbolStreams));
+        globalsStream = buildGsiHash(globalSyms);
+
         std::ranges::sort(publicAddrs, [](const auto& a, const auto& b) {
             if (a.second.segment != b.second.segment)
                 return a.second.segment < b.second.segment;
@@ -1173,11 +1231,15 @@ void PdbWriter::build(ByteArray&                         outBytes,
     Bytes              tpiHash;
     Bytes              ipiHash;
     std::vector<Bytes> streams(static_cast<size_t>(ipiHashStreamIndex) + 1);
+    {
+        Timer time(Stats::timedMetric(Stats::get().timePdbTypeStreams));
+        streams[STREAM_TPI] = buildTpiStream(debugInfo.tpiRecords, debugInfo.tpiIndexEnd, tpiHashStreamIndex, tpiHash);
+        streams[STREAM_IPI] = buildTpiStream(ipiRecords, ipiIndexEnd, ipiHashStreamIndex, ipiHash);
+    }
+
     streams[STREAM_OLD_DIRECTORY] = {};
     streams[STREAM_PDB_INFO]      = std::move(pdbInfo);
-    streams[STREAM_TPI]           = buildTpiStream(debugInfo.tpiRecords, debugInfo.tpiIndexEnd, tpiHashStreamIndex, tpiHash);
     streams[STREAM_DBI]           = std::move(dbi);
-    streams[STREAM_IPI]           = buildTpiStream(ipiRecords, ipiIndexEnd, ipiHashStreamIndex, ipiHash);
     streams[STREAM_NAMES]         = names.serialize();
     for (PdbModuleBuild& module : modules)
         streams[module.streamIndex] = std::move(module.stream);
@@ -1188,7 +1250,7 @@ void PdbWriter::build(ByteArray&                         outBytes,
     streams[tpiHashStreamIndex]    = std::move(tpiHash);
     streams[ipiHashStreamIndex]    = std::move(ipiHash);
 
-    (void) pdbPath;
+    Timer time(Stats::timedMetric(Stats::get().timePdbMsfLayout));
     buildMsf(outBytes, streams);
 }
 
@@ -5,6 +5,8 @@
 
 SWC_BEGIN_NAMESPACE();
 
+class TaskContext;
+
 // Final placement of a defined symbol once the image layout is known.
 struct PdbSymbolAddress
 {
@@ -41,7 +43,8 @@ public:
     };
 
     // Returns the PDB bytes in outBytes and fills outGuid/outAge/outSignature. moduleName/pdbPath are used
-    // for the module and object-name records. Never fails for well-formed input.
+    // for the module and object-name records. With a context, module streams are built in parallel on the
+    // job manager; without one, everything runs on the calling thread. Never fails for well-formed input.
     static void build(ByteArray&                         outBytes,
                       std::array<uint8_t, 16>&           outGuid,
                       uint32_t&                          outAge,
@@ -50,7 +53,8 @@ public:
                       const std::vector<PdbSectionInfo>& sections,
                       const SymbolResolver&              resolver,
                       const Utf8&                        moduleName,
-                      const Utf8&                        pdbPath);
+                      const Utf8&                        pdbPath,
+                      TaskContext*                       ctx = nullptr);
 };
 
 SWC_END_NAMESPACE();
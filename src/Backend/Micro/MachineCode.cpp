@@ -1,12 +1,52 @@
 #include "pch.h"
 #include "Backend/Micro/MachineCode.h"
 #include "Backend/Encoder/X64Encoder.h"
+#include "Backend/Micro/MachineCodeDedup.h"
 #include "Backend/Micro/MicroPassContext.h"
+#include "Compiler/Sema/Symbol/Symbol.Function.h"
 #include "Main/CompilerInstance.h"
 #include "Main/Stats.h"
 
 SWC_BEGIN_NAMESPACE();
 
+namespace
+{
+    MachineCodeDedup::PassStats capturePassStats(const MicroPassContext& passContext)
+    {
+        return {
+            .instrInitial          = passContext.statsInstrInitial,
+            .instrAfterStart       = passContext.statsInstrAfterStart,
+            .instrAfterPreRaOptim  = passContext.statsInstrAfterPreRaOptim,
+            .instrAfterRa          = passContext.statsInstrAfterRa,
+            .instrAfterPostRaSetup = passContext.statsInstrAfterPostRaSetup,
+            .instrAfterPostRaOptim = passContext.statsInstrAfterPostRaOptim,
+            .instrFinal            = passContext.statsInstrFinal,
+            .safetyGuardsRemoved   = passContext.statsSafetyGuardsRemoved,
+            .tailCalls             = passContext.statsTailCalls,
+        };
+    }
+
+    void addPassStats(const MachineCodeDedup::PassStats& stats)
+    {
+        if (!Stats::enabledRuntime())
+            return;
+
+        Stats::get().numMicroInstrInitial.add(stats.instrInitial);
+        Stats::get().numMicroInstrAfterStart.add(stats.instrAfterStart);
+        Stats::get().numMicroInstrAfterPreRaOptim.add(stats.instrAfterPreRaOptim);
+        Stats::get().numMicroInstrAfterRa.add(stats.instrAfterRa);
+        Stats::get().numMicroInstrAfterPostRaSetup.add(stats.instrAfterPostRaSetup);
+        Stats::get().numMicroInstrAfterPostRaOptim.add(stats.instrAfterPostRaOptim);
+        Stats::get().numMicroInstrFinal.add(stats.instrFinal);
+        if (stats.safetyGuardsRemoved)
+        {
+            Stats::get().numMicroSafetyGuardsRemoved.add(stats.safetyGuardsRemoved);
+            Stats::get().numMicroSafetyGuardFunctions.add(1);
+        }
+        Stats::get().numMicroTailCalls.add(stats.tailCalls);
+    }
+}
+
 const MachineCode::DebugSourceRange* MachineCode::findDebugSourceRangeAtOffset(const uint32_t codeOffset) const
 {
     for (const auto& range : debugSourceRanges)
@@ -40,18 +80,48 @@ bool MachineCode::tryResolveDebugSourceRangeAtOffset(const TaskContext& ctx, Res
     return tryResolveDebugSourceRange(ctx, outResolvedRange, *range);
 }
 
-Result MachineCode::emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debugStackBaseVirtualReg, uint16_t sanitizerSafetyMask, const SymbolFunction* sanitizerFunction)
+Result MachineCode::emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debugStackBaseVirtualReg, uint16_t sanitizerSafetyMask, const SymbolFunction* sanitizerFunction, MachineCodeTier tier)
 {
     const Runtime::BuildCfgBackend& backendBuildCfg   = ctx.compiler().buildCfg().backend;
     const bool                      computeUnwindInfo = backendBuildCfg.enableExceptions || backendBuildCfg.debugInfo;
+    const bool                      baseline          = tier == MachineCodeTier::Baseline;
+
+    // The pipeline reads the optimization level from the builder.
+    if (baseline && builder.backendBuildCfg().optimize)
+    {
+        Runtime::BuildCfgBackend baselineCfg = builder.backendBuildCfg();
+        baselineCfg.optimize                 = false;
+        builder.setBackendBuildCfg(baselineCfg);
+    }
 
     MicroPassContext passContext;
     passContext.callConvKind             = CallConvKind::Swag;
     passContext.preservePersistentRegs   = true;
     passContext.forceFramePointer        = computeUnwindInfo;
+    passContext.relaxBranches            = true;
+    passContext.alignLoopHeaders         = backendBuildCfg.optimize && !baseline;
+    passContext.reserveJitEntryPatch     = baseline;
     passContext.debugStackBaseVirtualReg = debugStackBaseVirtualReg;
     passContext.sanitizerSafetyMask      = sanitizerSafetyMask;
     passContext.sanitizerFunction        = sanitizerFunction;
+    passContext.safetyPanicFunction      = ctx.compiler().runtimeFunctionSymbol(ctx.idMgr().runtimeFunction(IdentifierManager::RuntimeFunctionKind::SafetyPanic));
+
+    // Identical micro streams lower to identical code: reuse the first result.
+    const bool            useDedup = MachineCodeDedup::canShare(ctx, builder, passContext);
+    MachineCodeDedup::Key dedupKey = {};
+    if (useDedup)
+    {
+        dedupKey = MachineCodeDedup::computeKey(builder, passContext);
+        MachineCodeDedup::PassStats sharedStats;
+        const bool                  hit = ctx.compiler().machineCodeDedup().find(dedupKey, *this, sharedStats);
+        if (Stats::enabledRuntime())
+            (hit ? Stats::get().numMachineCodeDedupHits : Stats::get().numMachineCodeDedupMisses).add(1);
+        if (hit)
+        {
+            addPassStats(sharedStats);
+            return Result::Continue;
+        }
+    }
 
 #ifdef _M_X64
     X64Encoder encoder(ctx);
@@ -64,18 +134,8 @@ Result MachineCode::emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debug
 
     debugStackBasePhysReg = passContext.debugStackBasePhysReg;
 
-#if SWC_HAS_STATS
-    if (Stats::enabledRuntime())
-    {
-        Stats::get().numMicroInstrInitial.fetch_add(passContext.statsInstrInitial, std::memory_order_relaxed);
-        Stats::get().numMicroInstrAfterStart.fetch_add(passContext.statsInstrAfterStart, std::memory_order_relaxed);
-        Stats::get().numMicroInstrAfterPreRaOptim.fetch_add(passContext.statsInstrAfterPreRaOptim, std::memory_order_relaxed);
-        Stats::get().numMicroInstrAfterRa.fetch_add(passContext.statsInstrAfterRa, std::memory_order_relaxed);
-        Stats::get().numMicroInstrAfterPostRaSetup.fetch_add(passContext.statsInstrAfterPostRaSetup, std::memory_order_relaxed);
-        Stats::get().numMicroInstrAfterPostRaOptim.fetch_add(passContext.statsInstrAfterPostRaOptim, std::memory_order_relaxed);
-        Stats::get().numMicroInstrFinal.fetch_add(passContext.statsInstrFinal, std::memory_order_relaxed);
-    }
-#endif
+    const MachineCodeDedup::PassStats passStats = capturePassStats(passContext);
+    addPassStats(passStats);
 
     // Diagnostics can abort lowering before any encodable instruction is produced.
     // Propagate the existing failure instead of crashing in the test runner.
@@ -93,6 +153,9 @@ Result MachineCode::emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debug
     codeRelocations   = builder.codeRelocations();
     debugSourceRanges = encoder.debugSourceRanges();
 
+    if (useDedup)
+        ctx.compiler().machineCodeDedup().store(dedupKey, *this, passStats);
+
     return Result::Continue;
 }
 
@@ -10,6 +10,15 @@ class TaskContext;
 class SourceFile;
 class SymbolFunction;
 
+// How much the pass pipeline works on a function. Baseline skips the optimization loops, for
+// JIT code that may run only a few times; it also leaves room at the entry for redirecting
+// callers to an optimized version later.
+enum class MachineCodeTier : uint8_t
+{
+    Optimized,
+    Baseline,
+};
+
 struct MachineCode
 {
     using DebugSourceRange = EncoderDebugSourceRange;
@@ -32,7 +41,7 @@ struct MachineCode
     const DebugSourceRange* findDebugSourceRangeAtOffset(uint32_t codeOffset) const;
     static bool             tryResolveDebugSourceRange(const TaskContext& ctx, ResolvedDebugSourceRange& outResolvedRange, const DebugSourceRange& range);
     bool                    tryResolveDebugSourceRangeAtOffset(const TaskContext& ctx, ResolvedDebugSourceRange& outResolvedRange, uint32_t codeOffset) const;
-    Result                  emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debugStackBaseVirtualReg = MicroReg::invalid(), uint16_t sanitizerSafetyMask = 0, const SymbolFunction* sanitizerFunction = nullptr);
+    Result                  emit(TaskContext& ctx, MicroBuilder& builder, MicroReg debugStackBaseVirtualReg = MicroReg::invalid(), uint16_t sanitizerSafetyMask = 0, const SymbolFunction* sanitizerFunction = nullptr, MachineCodeTier tier = MachineCodeTier::Optimized);
 };
 
 SWC_END_NAMESPACE();
@@ -0,0 +1,256 @@
+#include "pch.h"
+#include "Backend/Micro/MachineCodeDedup.h"
+#include "Backend/Micro/MicroPassContext.h"
+#include "Compiler/Sema/Symbol/Symbol.Function.h"
+#include "Compiler/Sema/Symbol/Symbol.Variable.h"
+#include "Main/TaskContext.h"
+#include "Support/Math/Sha256.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    class KeyWriter
+    {
+    public:
+        template<typename T>
+        void put(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* first = reinterpret_cast<const std::byte*>(&value);
+            bytes_.insert(bytes_.end(), first, first + sizeof(T));
+        }
+
+        // Both words of a wide value: operands of two builders point at different copies of it.
+        void putWideImmediate(const MicroInstrOperand& op)
+        {
+            put(op.hasWideImmediateValue());
+            if (!op.hasWideImmediateValue())
+                return;
+
+            const ApInt& value = op.wideImmediateValue();
+            ApInt        high  = value;
+            high.logicalShiftRight(64);
+            put(value.bitWidth());
+            put(high.as64());
+        }
+
+        void putReg(const MicroReg reg) { put(reg.packed); }
+
+        const std::vector<std::byte>& bytes() const { return bytes_; }
+
+    private:
+        std::vector<std::byte> bytes_;
+    };
+
+    void putBackendBuildCfg(KeyWriter& writer, const Runtime::BuildCfgBackend& cfg)
+    {
+        writer.put(cfg.optimize);
+        writer.put(cfg.debugInfo);
+        writer.put(cfg.enableExceptions);
+        writer.put(cfg.fpMathFma);
+        writer.put(cfg.fpMathNoNaN);
+        writer.put(cfg.fpMathNoInf);
+        writer.put(cfg.fpMathNoSignedZero);
+        writer.put(cfg.fpMathUnsafe);
+        writer.put(cfg.fpMathApproxFunc);
+        writer.put(cfg.unrollMemLimit);
+        writer.put(static_cast<uint32_t>(cfg.inlineMode));
+        writer.put(static_cast<uint32_t>(cfg.cpuVectorize));
+    }
+
+    void putInstructions(KeyWriter& writer, const MicroBuilder& builder)
+    {
+        const MicroStorage::ConstView view = builder.instructions().view();
+        writer.put(builder.instructions().count());
+        for (auto it = view.begin(); it != view.end(); ++it)
+        {
+            const MicroInstr& inst = *it;
+            writer.put(it.current.get());
+            writer.put(static_cast<uint32_t>(inst.op));
+            writer.put(inst.numOperands);
+
+            const MicroInstrOperand* ops = inst.ops(builder.operands());
+            for (uint32_t i = 0; ops && i < inst.numOperands; ++i)
+            {
+                writer.put(ops[i].valueU64);
+                writer.putWideImmediate(ops[i]);
+            }
+        }
+    }
+
+    void putRelocations(KeyWriter& writer, const MicroBuilder& builder)
+    {
+        const std::vector<MicroRelocation>& relocations = builder.codeRelocations();
+        writer.put(static_cast<uint32_t>(relocations.size()));
+        for (const MicroRelocation& reloc : relocations)
+        {
+            writer.put(static_cast<uint8_t>(reloc.kind));
+            writer.put(static_cast<uint8_t>(reloc.form));
+            writer.put(reloc.codeOffset);
+            writer.put(reloc.relativeEndOffset);
+            writer.put(reloc.instructionRef.get());
+            writer.put(reloc.targetAddress);
+            writer.put(reinterpret_cast<uintptr_t>(reloc.targetSymbol));
+            writer.put(reloc.constantRef.get());
+            writer.put(reloc.constantShard);
+            writer.put(reloc.constantOffset);
+        }
+    }
+
+    // Memory-to-register promotion reads the frame extent of every local of the lowered function,
+    // so those extents are all the key needs from the function symbol.
+    void putLocalFrameLayout(KeyWriter& writer, const SymbolFunction* function)
+    {
+        writer.put(function != nullptr);
+        if (!function)
+            return;
+
+        std::vector<std::pair<uint32_t, uint32_t>> extents;
+        for (const SymbolVariable* localVar : function->localVariables())
+        {
+            if (!localVar || !localVar->hasExtraFlag(SymbolVariableFlagsE::CodeGenLocalStack))
+                continue;
+            extents.emplace_back(localVar->offset(), localVar->codeGenLocalSize());
+        }
+
+        writer.put(static_cast<uint32_t>(extents.size()));
+        for (const auto& [offset, size] : extents)
+        {
+            writer.put(offset);
+            writer.put(size);
+        }
+    }
+
+    // Whether a call may become a jump is decided by the pass pipeline from these marks, so two
+    // streams that differ only by them lower to different code.
+    void putTailCallCandidates(KeyWriter& writer, const MicroBuilder& builder)
+    {
+        std::vector<uint32_t> candidates;
+        candidates.reserve(builder.tailCallCandidates().size());
+        for (const MicroInstrRef ref : builder.tailCallCandidates())
+            candidates.push_back(ref.get());
+        std::ranges::sort(candidates);
+        writer.put(static_cast<uint32_t>(candidates.size()));
+        for (const uint32_t ref : candidates)
+            writer.put(ref);
+    }
+
+    // Register constraints live in hashed containers; sort them so that two builders holding the
+    // same constraints produce the same key whatever order they were recorded in.
+    void putRegisterConstraints(KeyWriter& writer, const MicroBuilder& builder)
+    {
+        std::vector<std::pair<uint32_t, std::vector<uint32_t>>> forbidden;
+        forbidden.reserve(builder.virtualRegForbiddenPhysRegs().size());
+        for (const auto& [virtualReg, physRegs] : builder.virtualRegForbiddenPhysRegs())
+        {
+            std::vector<uint32_t> packedPhysRegs;
+            packedPhysRegs.reserve(physRegs.size());
+            for (const MicroReg physReg : physRegs)
+                packedPhysRegs.push_back(physReg.packed);
+            std::ranges::sort(packedPhysRegs);
+            forbidden.emplace_back(virtualReg.packed, std::move(packedPhysRegs));
+        }
+
+        std::ranges::sort(forbidden);
+        writer.put(static_cast<uint32_t>(forbidden.size()));
+        for (const auto& [virtualReg, physRegs] : forbidden)
+        {
+            writer.put(virtualReg);
+            writer.put(static_cast<uint32_t>(physRegs.size()));
+            for (const uint32_t physReg : physRegs)
+                writer.put(physReg);
+        }
+
+        std::vector<uint32_t> preserved;
+        preserved.reserve(builder.preservedVirtualCopyRegs().size());
+        for (const MicroReg reg : builder.preservedVirtualCopyRegs())
+            preserved.push_back(reg.packed);
+        std::ranges::sort(preserved);
+        writer.put(static_cast<uint32_t>(preserved.size()));
+        for (const uint32_t reg : preserved)
+            writer.put(reg);
+    }
+}
+
+size_t MachineCodeDedup::KeyHash::operator()(const Key& key) const noexcept
+{
+    size_t result = 0;
+    std::memcpy(&result, key.data(), sizeof(result));
+    return result;
+}
+
+// Only code whose output is a pure function of the key is shared. Debug info ties every range
+// to the source of one function, the sanitizer reads the whole function symbol, and printing
+// passes is a side effect the user asked for on that one function.
+bool MachineCodeDedup::canShare(const TaskContext& ctx, const MicroBuilder& builder, const MicroPassContext& passContext)
+{
+    if (!ctx.hasCompiler())
+        return false;
+    if (builder.hasFlag(MicroBuilderFlagsE::DebugInfo))
+        return false;
+    if (!builder.printPassOptions().empty())
+        return false;
+    if (passContext.sanitizerSafetyMask != 0)
+        return false;
+    return true;
+}
+
+MachineCodeDedup::Key MachineCodeDedup::computeKey(const MicroBuilder& builder, const MicroPassContext& passContext)
+{
+    KeyWriter writer;
+    putBackendBuildCfg(writer, builder.backendBuildCfg());
+    writer.put(builder.flags().get());
+    writer.put(builder.usesIntReturnRegOnRet());
+    writer.put(builder.usesFloatReturnRegOnRet());
+
+    writer.put(static_cast<uint32_t>(passContext.callConvKind));
+    writer.put(passContext.preservePersistentRegs);
+    writer.put(passContext.forceFramePointer);
+    writer.put(passContext.relaxBranches);
+    writer.put(passContext.alignLoopHeaders);
+    writer.put(passContext.reserveJitEntryPatch);
+    writer.putReg(passContext.debugStackBaseVirtualReg);
+    putLocalFrameLayout(writer, passContext.sanitizerFunction);
+
+    putInstructions(writer, builder);
+    putRelocations(writer, builder);
+    putRegisterConstraints(writer, builder);
+    putTailCallCandidates(writer, builder);
+
+    return sha256(writer.bytes());
+}
+
+bool MachineCodeDedup::find(const Key& key, MachineCode& outCode, PassStats& outStats) const
+{
+    const std::shared_lock lock(mutex_);
+    const auto             it = entries_.find(key);
+    if (it == entries_.end())
+        return false;
+
+    outCode  = it->second.code;
+    outStats = it->second.stats;
+    return true;
+}
+
+size_t MachineCodeDedup::entryBytes(const MachineCode& code)
+{
+    return code.bytes.size() +
+           code.unwindInfo.size() +
+           code.codeRelocations.size() * sizeof(MicroRelocation) +
+           code.debugSourceRanges.size() * sizeof(MachineCode::DebugSourceRange);
+}
+
+// Only the first functions of a build are kept once the budget is spent: most duplicates are
+// small helpers and generic instances, which tend to be met early and often.
+void MachineCodeDedup::store(const Key& key, const MachineCode& code, const PassStats& stats)
+{
+    const size_t           size = entryBytes(code);
+    const std::unique_lock lock(mutex_);
+    if (bytes_ + size > MAX_BYTES)
+        return;
+    if (entries_.try_emplace(key, Entry{.code = code, .stats = stats}).second)
+        bytes_ += size;
+}
+
+SWC_END_NAMESPACE();
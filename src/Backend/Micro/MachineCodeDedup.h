@@ -0,0 +1,65 @@
+#pragma once
+#include "Backend/Micro/MachineCode.h"
+
+SWC_BEGIN_NAMESPACE();
+
+struct MicroPassContext;
+
+// Deduplicates lowering inside one build. Finished machine code is addressed by the content of
+// the micro stream it was lowered from: two functions that reach the backend with the same
+// instructions, the same relocation targets and the same pass configuration get the same bytes,
+// so only the first one runs the pass pipeline and the encoder.
+//
+// Relocation targets are part of the key as they are (symbols, constants, addresses), which
+// keeps a hit valid without any rebinding, but ties an entry to the instance that owns them.
+// Nothing is shared between builds: the entries live and die with one compilation and are never
+// written to disk. They stop growing at MAX_BYTES of code, after which a function that misses is
+// lowered as if there were no deduplication at all.
+class MachineCodeDedup
+{
+public:
+    using Key = std::array<uint8_t, 32>;
+
+    static constexpr size_t MAX_BYTES = 64ull * 1024 * 1024;
+
+    // What lowering the function added to the micro pipeline stats. A hit adds it again, so the
+    // totals count every lowered function whether or not its code was shared.
+    struct PassStats
+    {
+        size_t instrInitial          = 0;
+        size_t instrAfterStart       = 0;
+        size_t instrAfterPreRaOptim  = 0;
+        size_t instrAfterRa          = 0;
+        size_t instrAfterPostRaSetup = 0;
+        size_t instrAfterPostRaOptim = 0;
+        size_t instrFinal            = 0;
+        size_t safetyGuardsRemoved   = 0;
+        size_t tailCalls             = 0;
+    };
+
+    static bool canShare(const TaskContext& ctx, const MicroBuilder& builder, const MicroPassContext& passContext);
+    static Key  computeKey(const MicroBuilder& builder, const MicroPassContext& passContext);
+
+    bool find(const Key& key, MachineCode& outCode, PassStats& outStats) const;
+    void store(const Key& key, const MachineCode& code, const PassStats& stats);
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct Entry
+    {
+        MachineCode code;
+        PassStats   stats;
+    };
+
+    static size_t entryBytes(const MachineCode& code);
+
+    mutable std::shared_mutex               mutex_;
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    size_t                                  bytes_ = 0;
+};
+
+SWC_END_NAMESPACE();
@@ -167,11 +167,15 @@ bool MicroBuilder::pruneDeadRelocations()
     std::erase_if(relocations_, [](const MicroRelocation& reloc) {
         return reloc.instructionRef.isInvalid();
     });
+    std::erase_if(tailCallCandidates_, [this](const MicroInstrRef ref) {
+        return !instructions_.ptr(ref);
+    });
 
     // Nothing is keyed by an erased instruction any more, so its slot can be
     // handed out again. Doing this here and nowhere else is what keeps a
-    // recycled reference from carrying a dead relocation onto a new
-    // instruction - a wrong patch target, not a crash at the point of reuse.
+    // recycled reference from carrying a dead relocation (or tail-call mark)
+    // onto a new instruction - a wrong patch target, not a crash at the point
+    // of reuse.
     instructions_.releaseErasedRefs();
 
     return changed || beforeSize != relocations_.size();
@@ -308,6 +312,130 @@ void MicroBuilder::markControlFlowGraphMaybeDirty()
         controlFlowGraphMaybeDirty_ = true;
 }
 
+// Label jumps, conditional or not, are JumpCond: one whose label is already placed goes
+// backward. A jump through a register or to an immediate has no label to tell, so it counts
+// as one: a false positive only costs the function its baseline tier.
+bool MicroBuilder::hasBackwardJump() const
+{
+    std::unordered_set<uint64_t> placedLabels;
+    for (const MicroInstr& inst : instructions_.view())
+    {
+        const MicroInstrOperand* ops = inst.ops(operands_);
+        switch (inst.op)
+        {
+            case MicroInstrOpcode::Label:
+                placedLabels.insert(ops[0].valueU64);
+                break;
+            case MicroInstrOpcode::JumpCond:
+                if (placedLabels.contains(ops[2].valueU64))
+                    return true;
+                break;
+            case MicroInstrOpcode::JumpReg:
+            case MicroInstrOpcode::JumpCondImm:
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+// The probe is emitted inline by code generation, between these two calls. Only the references of
+// its ends are kept: the probe is a straight run of instructions, and nothing is erased from the
+// stream before lowering.
+void MicroBuilder::beginJitTierUpProbe()
+{
+    SWC_ASSERT(!hasJitTierUpProbe_);
+    jitTierUpProbeBefore_ = instructions_.findPreviousInstructionRef(MicroInstrRef::invalid());
+}
+
+void MicroBuilder::endJitTierUpProbe()
+{
+    jitTierUpProbeLast_ = instructions_.findPreviousInstructionRef(MicroInstrRef::invalid());
+    hasJitTierUpProbe_  = jitTierUpProbeLast_ != jitTierUpProbeBefore_;
+}
+
+void MicroBuilder::eraseJitTierUpProbe()
+{
+    if (!hasJitTierUpProbe_)
+        return;
+
+    MicroInstrRef ref = instructions_.findNextInstructionRef(jitTierUpProbeBefore_);
+    while (ref.isValid())
+    {
+        const MicroInstrRef next = instructions_.findNextInstructionRef(ref);
+        const bool          last = ref == jitTierUpProbeLast_;
+        instructions_.erase(ref);
+        if (last)
+            break;
+        ref = next;
+    }
+
+    hasJitTierUpProbe_ = false;
+    invalidateControlFlowGraph();
+}
+
+// A second lowering of the same function starts from a copy of what code generation produced.
+// The control-flow graph is not copied: the copy builds its own on first use.
+void MicroBuilder::copyStreamFrom(const MicroBuilder& other)
+{
+    ctx_                         = other.ctx_;
+    instructions_                = other.instructions_;
+    operands_                    = other.operands_;
+    flags_                       = other.flags_;
+    currentDebugSourceInfo_      = other.currentDebugSourceInfo_;
+    printSymbolName_             = other.printSymbolName_;
+    printFilePath_               = other.printFilePath_;
+    printSourceLine_             = other.printSourceLine_;
+    usesIntReturnRegOnRet_       = other.usesIntReturnRegOnRet_;
+    usesFloatReturnRegOnRet_     = other.usesFloatReturnRegOnRet_;
+    printPassOptions_            = other.printPassOptions_;
+    backendBuildCfg_             = other.backendBuildCfg_;
+    labels_                      = other.labels_;
+    relocations_                 = other.relocations_;
+    wideImmediates_              = other.wideImmediates_;
+    virtualRegForbiddenPhysRegs_ = other.virtualRegForbiddenPhysRegs_;
+    preservedVirtualCopyRegs_    = other.preservedVirtualCopyRegs_;
+    jitTierUpProbeBefore_        = other.jitTierUpProbeBefore_;
+    jitTierUpProbeLast_          = other.jitTierUpProbeLast_;
+    hasJitTierUpProbe_           = other.hasJitTierUpProbe_;
+    lastCallRef_                 = other.lastCallRef_;
+    tailCallCandidates_          = other.tailCallCandidates_;
+    controlFlowGraph_            = {};
+    hasControlFlowGraph_         = false;
+    controlFlowGraphMaybeDirty_  = false;
+
+    // The copied operands still point at the other builder's wide immediates.
+    if (wideImmediates_.empty())
+        return;
+
+    std::unordered_map<const ApInt*, const ApInt*> remap;
+    for (size_t i = 0; i < wideImmediates_.size(); ++i)
+        remap.emplace(&other.wideImmediates_[i], &wideImmediates_[i]);
+
+    for (const MicroInstr& inst : instructions_.view())
+    {
+        MicroInstrOperand* ops = inst.ops(operands_);
+        for (uint32_t i = 0; ops && i < inst.numOperands; ++i)
+        {
+            if (!ops[i].wideImm)
+                continue;
+            const auto it = remap.find(ops[i].wideImm);
+            if (it != remap.end())
+                ops[i].wideImm = it->second;
+        }
+    }
+}
+
+void MicroBuilder::setImmediateOperand(MicroInstrOperand& op, const ApInt& value)
+{
+    if (value.bitWidth() <= 64)
+        op.setImmediateValue(value);
+    else
+        op.setWideImmediateValue(wideImmediates_.emplace_back(value));
+}
+
 void MicroBuilder::emitPush(MicroReg reg)
 {
     const auto&        inst = addInstruction(MicroInstrOpcode::Push, 1);
@@ -388,6 +516,7 @@ void MicroBuilder::emitCallLocal(const Symbol* targetSymbol, const CallConvKind
     ops[0].callConv        = callConv;
     ops[1].valueU32        = intArgMask;
     ops[2].valueU32        = floatArgMask;
+    lastCallRef_           = instRef;
 
     addRelocation({
         .kind           = MicroRelocation::Kind::LocalFunctionAddress,
@@ -409,6 +538,7 @@ void MicroBuilder::emitCallExtern(const Symbol* targetSymbol, const CallConvKind
     ops[0].callConv        = callConv;
     ops[1].valueU32        = intArgMask;
     ops[2].valueU32        = floatArgMask;
+    lastCallRef_           = instRef;
 
     addRelocation({
         .kind           = MicroRelocation::Kind::ForeignFunctionAddress,
@@ -422,12 +552,21 @@ void MicroBuilder::emitCallExtern(const Symbol* targetSymbol, const CallConvKind
 void MicroBuilder::emitCallReg(const MicroReg reg, const CallConvKind callConv, const uint8_t intArgMask, const uint8_t floatArgMask)
 {
     // Micro IR models calls as indirect calls carrying the selected calling convention.
-    const auto&        inst = addInstruction(MicroInstrOpcode::CallIndirect, 4);
-    MicroInstrOperand* ops  = inst.ops(operands_);
-    ops[0].reg              = reg;
-    ops[1].callConv         = callConv;
-    ops[2].valueU32         = intArgMask;
-    ops[3].valueU32         = floatArgMask;
+    auto [instRef, inst]   = addInstructionWithRef(MicroInstrOpcode::CallIndirect, 4);
+    MicroInstrOperand* ops = inst.ops(operands_);
+    ops[0].reg             = reg;
+    ops[1].callConv        = callConv;
+    ops[2].valueU32        = intArgMask;
+    ops[3].valueU32        = floatArgMask;
+    lastCallRef_           = instRef;
+}
+
+void MicroBuilder::markLastCallTailCallCandidate()
+{
+    // Only a promise about the call itself: the prolog/epilog pass still checks, once registers
+    // are final, that nothing but stack releases and return moves separate it from the Ret.
+    SWC_ASSERT(lastCallRef_.isValid());
+    tailCallCandidates_.insert(lastCallRef_);
 }
 
 void MicroBuilder::emitJumpToLabel(MicroCond cpuCond, MicroOpBits opBits, MicroLabelRef labelRef)
@@ -523,7 +662,7 @@ void MicroBuilder::emitLoadRegImm(MicroReg reg, const ApInt& value, MicroOpBits
     MicroInstrOperand* ops  = inst.ops(operands_);
     ops[0].reg              = reg;
     ops[1].opBits           = opBits;
-    ops[2].setImmediateValue(value);
+    setImmediateOperand(ops[2], value);
 }
 
 void MicroBuilder::emitLoadRegPtrImm(MicroReg reg, uint64_t value)
@@ -689,7 +828,7 @@ void MicroBuilder::emitLoadAmcMemImm(MicroReg regBase, MicroReg regMul, uint64_t
     ops[4].opBits           = opBitsValue;
     ops[5].valueU64         = mulValue;
     ops[6].valueU64         = addValue;
-    ops[7].setImmediateValue(value);
+    setImmediateOperand(ops[7], value);
 }
 
 void MicroBuilder::emitLoadAddressAmcRegMem(MicroReg regDst, MicroOpBits opBitsDst, MicroReg regBase, MicroReg regMul, uint64_t mulValue, uint64_t addValue, MicroOpBits opBitsValue)
@@ -722,7 +861,7 @@ void MicroBuilder::emitLoadMemImm(MicroReg memReg, uint64_t memOffset, const ApI
     ops[0].reg              = memReg;
     ops[1].opBits           = opBits;
     ops[2].valueU64         = memOffset;
-    ops[3].setImmediateValue(value);
+    setImmediateOperand(ops[3], value);
 }
 
 void MicroBuilder::emitCmpRegReg(MicroReg reg0, MicroReg reg1, MicroOpBits opBits)
@@ -751,7 +890,7 @@ void MicroBuilder::emitCmpMemImm(MicroReg memReg, uint64_t memOffset, const ApIn
     ops[0].reg              = memReg;
     ops[1].opBits           = opBits;
     ops[2].valueU64         = memOffset;
-    ops[3].setImmediateValue(value);
+    setImmediateOperand(ops[3], value);
 }
 
 void MicroBuilder::emitCmpRegImm(MicroReg reg, const ApInt& value, MicroOpBits opBits)
@@ -760,7 +899,7 @@ void MicroBuilder::emitCmpRegImm(MicroReg reg, const ApInt& value, MicroOpBits o
     MicroInstrOperand* ops  = inst.ops(operands_);
     ops[0].reg              = reg;
     ops[1].opBits           = opBits;
-    ops[2].setImmediateValue(value);
+    setImmediateOperand(ops[2], value);
 }
 
 void MicroBuilder::emitSetCondReg(MicroReg reg, MicroCond cpuCond)
@@ -847,7 +986,7 @@ void MicroBuilder::emitOpBinaryRegImm(MicroReg reg, const ApInt& value, MicroOp
     ops[0].reg              = reg;
     ops[1].opBits           = opBits;
     ops[2].microOp          = op;
-    ops[3].setImmediateValue(value);
+    setImmediateOperand(ops[3], value);
 }
 
 void MicroBuilder::emitOpBinaryMemImm(MicroReg memReg, uint64_t memOffset, const ApInt& value, MicroOp op, MicroOpBits opBits)
@@ -858,7 +997,7 @@ void MicroBuilder::emitOpBinaryMemImm(MicroReg memReg, uint64_t memOffset, const
     ops[1].opBits           = opBits;
     ops[2].microOp          = op;
     ops[3].valueU64         = memOffset;
-    ops[4].setImmediateValue(value);
+    setImmediateOperand(ops[4], value);
 }
 
 void MicroBuilder::emitOpTernaryRegRegReg(MicroReg reg0, MicroReg reg1, MicroReg reg2, MicroOp op, MicroOpBits opBits)
@@ -891,7 +1030,7 @@ void MicroBuilder::emitOpBinaryRegRegImm(MicroReg regDst, MicroReg regSrc, const
     ops[1].reg              = regSrc;
     ops[2].opBits           = opBits;
     ops[3].microOp          = op;
-    ops[4].setImmediateValue(value);
+    setImmediateOperand(ops[4], value);
 }
 
 Result MicroBuilder::runPasses(const MicroPassManager& passes, Encoder* encoder, MicroPassContext& context)
@@ -957,6 +1096,7 @@ void MicroBuilder::releaseMemory()
     printPassOptions_                = {};
     labels_                          = {};
     relocations_                     = {};
+    wideImmediates_                  = {};
     virtualRegForbiddenPhysRegs_     = {};
     preservedVirtualCopyRegs_        = {};
     controlFlowGraph_                = {};
@@ -964,6 +1104,11 @@ void MicroBuilder::releaseMemory()
     controlFlowGraphHash_            = 0;
     hasControlFlowGraph_             = false;
     controlFlowGraphMaybeDirty_      = false;
+    jitTierUpProbeBefore_            = MicroInstrRef::invalid();
+    jitTierUpProbeLast_              = MicroInstrRef::invalid();
+    hasJitTierUpProbe_               = false;
+    lastCallRef_                     = MicroInstrRef::invalid();
+    tailCallCandidates_              = {};
 }
 
 SWC_END_NAMESPACE();
@@ -103,6 +103,7 @@ public:
     void                                                       setCurrentDebugNoStep(bool value);
     bool                                                       currentDebugNoStep() const { return currentDebugSourceInfo_.debugNoStep; }
     void                                                       setPrintPassOptions(std::span<const Utf8> options) { printPassOptions_.assign(options.begin(), options.end()); }
+    std::span<const Utf8>                                      printPassOptions() const { return printPassOptions_; }
     void                                                       setBackendBuildCfg(const Runtime::BuildCfgBackend& value) { backendBuildCfg_ = value; }
     const Runtime::BuildCfgBackend&                            backendBuildCfg() const { return backendBuildCfg_; }
     void                                                       setRetUsesAbiRegs(bool usesIntReturnReg, bool usesFloatReturnReg);
@@ -110,6 +111,7 @@ public:
     bool                                                       usesFloatReturnRegOnRet() const { return usesFloatReturnRegOnRet_; }
     void                                                       setPrintLocation(Utf8 symbolName, Utf8 filePath, uint32_t sourceLine);
     void                                                       releaseMemory();
+    void                                                       copyStreamFrom(const MicroBuilder& other);
     const Utf8&                                                printSymbolName() const { return printSymbolName_; }
     const Utf8&                                                printFilePath() const { return printFilePath_; }
     uint32_t                                                   printSourceLine() const { return printSourceLine_; }
@@ -132,6 +134,14 @@ public:
     const MicroControlFlowGraph&                               controlFlowGraph();
     void                                                       invalidateControlFlowGraph();
     void                                                       markControlFlowGraphMaybeDirty();
+    bool                                                       hasBackwardJump() const;
+    void                                                       beginJitTierUpProbe();
+    void                                                       endJitTierUpProbe();
+    bool                                                       hasJitTierUpProbe() const { return hasJitTierUpProbe_; }
+    void                                                       eraseJitTierUpProbe();
+    void                                                       markLastCallTailCallCandidate();
+    bool                                                       isTailCallCandidate(MicroInstrRef instructionRef) const { return tailCallCandidates_.contains(instructionRef); }
+    const std::unordered_set<MicroInstrRef>&                   tailCallCandidates() const { return tailCallCandidates_; }
 
     Result        runPasses(Encoder* encoder, MicroPassContext& context);
     Result        runPasses(const MicroPassManager& passes, Encoder* encoder, MicroPassContext& context);
@@ -196,6 +206,7 @@ private:
     std::pair<MicroInstrRef, MicroInstr&> addInstructionWithRef(MicroInstrOpcode op, uint8_t numOperands);
     MicroInstr&                           addInstruction(MicroInstrOpcode op, uint8_t numOperands);
     void                                  storeInstructionDebugInfo(MicroInstrRef instructionRef);
+    void                                  setImmediateOperand(MicroInstrOperand& op, const ApInt& value);
 
     TaskContext*                                        ctx_ = nullptr;
     MicroStorage                                        instructions_;
@@ -211,6 +222,9 @@ private:
     Runtime::BuildCfgBackend                            backendBuildCfg_{};
     std::vector<MicroInstrRef>                          labels_;
     std::vector<MicroRelocation>                        relocations_;
+    // Values of the immediates wider than 64 bits, which operands point into: a deque never
+    // moves its elements, and the values go away with the function's stream.
+    std::deque<ApInt>                                   wideImmediates_;
     std::unordered_map<MicroReg, SmallVector<MicroReg>> virtualRegForbiddenPhysRegs_;
     std::unordered_set<MicroReg>                        preservedVirtualCopyRegs_;
     MicroControlFlowGraph                               controlFlowGraph_;
@@ -218,6 +232,15 @@ private:
     uint64_t                                            controlFlowGraphHash_            = 0;
     bool                                                hasControlFlowGraph_             = false;
     bool                                                controlFlowGraphMaybeDirty_      = false;
+    // Instructions strictly after the first ref, up to and including the last one, form the
+    // call counter that only baseline JIT code keeps. See beginJitTierUpProbe.
+    MicroInstrRef                                       jitTierUpProbeBefore_            = MicroInstrRef::invalid();
+    MicroInstrRef                                       jitTierUpProbeLast_              = MicroInstrRef::invalid();
+    bool                                                hasJitTierUpProbe_               = false;
+    // Calls the code generator vouched for as `return f(...)` with a register-only argument
+    // list and a matching convention and return. See markLastCallTailCallCandidate.
+    MicroInstrRef                                       lastCallRef_                     = MicroInstrRef::invalid();
+    std::unordered_set<MicroInstrRef>                   tailCallCandidates_;
 };
 
 SWC_END_NAMESPACE();
@@ -3,9 +3,26 @@
 #include "Backend/ABI/CallConv.h"
 #include "Backend/Encoder/Encoder.h"
 #include "Backend/Micro/MicroStorage.h"
+#include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
 
+// Passes only ever compute 64 bits of an immediate, so a wider value they write has to fit in
+// them. A value that does not needs storage (see MicroBuilder::setImmediateOperand).
+void MicroInstrOperand::setImmediateValue(const ApInt& value)
+{
+    SWC_ASSERT(value.fit64());
+    valueU64 = value.as64();
+    wideImm  = nullptr;
+}
+
+void MicroInstrOperand::setWideImmediateValue(const ApInt& storedValue)
+{
+    SWC_ASSERT(storedValue.bitWidth() > 64);
+    valueU64 = storedValue.as64();
+    wideImm  = &storedValue;
+}
+
 void MicroInstrUseDef::addUse(MicroReg reg)
 {
     if (reg.isValid() && !reg.isNoBase())
@@ -119,6 +136,7 @@ namespace
                 maskOperandIndex = floatMask ? 2 : 1;
                 break;
             case MicroInstrOpcode::CallIndirect:
+            case MicroInstrOpcode::TailCallIndirect:
                 maskOperandIndex = floatMask ? 3 : 2;
                 break;
             default:
@@ -70,6 +70,9 @@ inline constexpr std::array MICRO_INSTR_OPCODE_INFOS = {
 
 static_assert(MICRO_INSTR_OPCODE_INFOS.size() == static_cast<size_t>(MicroInstrOpcode::VecGatherS32) + 1);
 
+// Immediates wider than 64 bits are rare enough to live out of line: the operand keeps the low
+// word in 'valueU64' and points at the full value, which the builder that emitted the operand
+// owns (see MicroBuilder::setImmediateOperand), so every other operand stays two words.
 struct MicroInstrOperand
 {
     union
@@ -85,38 +88,48 @@ struct MicroInstrOperand
         uint64_t      valueU64;
     };
 
-    ApInt valueInt;
+    // Full value of an immediate wider than 64 bits, null for none.
+    const ApInt* wideImm;
 
     MicroInstrOperand() :
         valueU64(0),
-        valueInt(uint64_t{0}, 64)
+        wideImm(nullptr)
     {
     }
 
-    void setImmediateValue(const ApInt& value)
+    // The value must fit in 64 bits: a wider one needs storage that outlives the operand, and
+    // goes through setWideImmediateValue.
+    void setImmediateValue(const ApInt& value);
+    void setWideImmediateValue(const ApInt& storedValue);
+
+    void copyImmediateFrom(const MicroInstrOperand& other)
     {
-        valueInt = value;
-        valueU64 = value.as64();
+        valueU64 = other.valueU64;
+        wideImm  = other.wideImm;
     }
 
+    // A write to 'valueU64' after the wide value was set leaves a stale pointer behind; the low
+    // word no longer matching is what tells it apart.
     bool hasWideImmediateValue() const
     {
-        return valueInt.bitWidth() > 64 && valueInt.as64() == valueU64;
+        return wideImm && wideImm->as64() == valueU64;
     }
 
-    const ApInt& wideImmediateValue() const
-    {
-        return valueInt;
-    }
+    const ApInt& wideImmediateValue() const { return *wideImm; }
 
     ApInt immediateValue(uint32_t fallbackBitWidth = 64) const
     {
         if (hasWideImmediateValue())
-            return valueInt;
+            return wideImmediateValue();
         return ApInt(valueU64, fallbackBitWidth);
     }
 };
 
+// Refs carry a debug pointer when SWC_HAS_REF_DEBUG_INFO is on, which widens the union.
+#if !SWC_HAS_REF_DEBUG_INFO
+static_assert(sizeof(MicroInstrOperand) == 16);
+#endif
+
 struct MicroInstrUseDef
 {
     SmallVector4<MicroReg> uses;
@@ -12,6 +12,7 @@ class MicroUseDefMap;
 class MicroSsaState;
 class TaskContext;
 class Encoder;
+class Symbol;
 class SymbolFunction;
 
 struct MicroPassContext
@@ -32,6 +33,17 @@ struct MicroPassContext
     bool                  usesIntReturnRegOnRet   = true;
     bool                  usesFloatReturnRegOnRet = true;
 
+    // Emission: let rel32 label jumps shrink to rel8 where the target is close enough, and
+    // pad loop headers to a 16-byte boundary when the padding is small. Both change the
+    // code layout, so they are off for callers that compare exact encodings.
+    bool relaxBranches    = false;
+    bool alignLoopHeaders = false;
+
+    // Baseline JIT code opens with a NOP of this size. Once an optimized version exists,
+    // JIT::redirect overwrites it in one aligned store with a jump there.
+    static constexpr uint32_t K_JIT_ENTRY_PATCH_SIZE = 8;
+    bool                      reserveJitEntryPatch   = false;
+
     // The function's effective runtime-safety mask (build-config default combined with
     // any `#[Swag.Safety(...)]` overrides). The static sanitizer runs the checks whose
     // safety guard is set here, so it honours per-scope safety, not just the global
@@ -42,6 +54,10 @@ struct MicroPassContext
     // type nullability, ...). Null for compiler-generated code.
     const SymbolFunction* sanitizerFunction = nullptr;
 
+    // The runtime helper the safety guards call to panic. Guard elimination only treats a
+    // branch over a call to it as a guard. Null leaves every guard in place.
+    const Symbol* safetyPanicFunction = nullptr;
+
     // Debug info: the virtual register that holds the local-stack base (the value all local
     // variables are addressed against). Set by the caller before the pass pipeline runs.
     // Register allocation records the physical register it resolves to in debugStackBasePhysReg,
@@ -89,7 +105,6 @@ struct MicroPassContext
     // restored from. Reset with the rest of the pipeline state.
     SmallVector<MicroReg> globalReservedRegs;
 
-#if SWC_HAS_STATS
     size_t optimizationInstrRemoved = 0;
     size_t optimizationInstrAdded   = 0;
 
@@ -101,7 +116,12 @@ struct MicroPassContext
     size_t statsInstrAfterPostRaSetup = 0;
     size_t statsInstrAfterPostRaOptim = 0;
     size_t statsInstrFinal            = 0;
-#endif
+
+    // Runtime-safety guards the pre-RA loop proved redundant and removed.
+    size_t statsSafetyGuardsRemoved = 0;
+
+    // Calls in tail position the prolog/epilog pass turned into jumps.
+    size_t statsTailCalls = 0;
 };
 
 SWC_END_NAMESPACE();
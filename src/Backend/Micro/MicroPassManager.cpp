@@ -23,6 +23,7 @@
 #include "Backend/Micro/Passes/Pass.PrologEpilog.h"
 #include "Backend/Micro/Passes/Pass.PrologEpilogSanitize.h"
 #include "Backend/Micro/Passes/Pass.RegisterAllocation.h"
+#include "Backend/Micro/Passes/Pass.SafetyCheckElimination.h"
 #include "Backend/Micro/Passes/Pass.Sanity.h"
 #include "Backend/Micro/Passes/Pass.SlpVectorize.h"
 #include "Backend/Micro/Passes/Pass.StackAdjustNormalize.h"
@@ -31,6 +32,7 @@
 #include "Backend/Micro/Passes/Pass.VecLoopPromote.h"
 #include "Main/Global.h"
 #include "Main/TaskContext.h"
+#include "Main/Trace.h"
 #include "Support/Core/Utf8Helper.h"
 #include "Support/Report/Assert.h"
 #include "Support/Report/Logger.h"
@@ -134,6 +136,18 @@ namespace
         Logger::print(ctx, optimize);
         Logger::print(ctx, "\n");
 
+        // Guards this function has lost so far; '--stats' only reports the total over all functions.
+        if (context.statsSafetyGuardsRemoved)
+        {
+            Logger::print(ctx, SyntaxColorHelper::toAnsi(ctx, SyntaxColor::Keyword));
+            Logger::print(ctx, "  guards");
+            Logger::print(ctx, SyntaxColorHelper::toAnsi(ctx, SyntaxColor::Code));
+            Logger::print(ctx, "   : ");
+            Logger::print(ctx, SyntaxColorHelper::toAnsi(ctx, SyntaxColor::Number));
+            Logger::print(ctx, std::format("{} removed", context.statsSafetyGuardsRemoved));
+            Logger::print(ctx, "\n");
+        }
+
         Logger::print(ctx, SyntaxColorHelper::toAnsi(ctx, SyntaxColor::Default));
     }
 
@@ -227,7 +241,10 @@ namespace
             printPassInstructions(context, pass, true);
 
         context.passChanged = false;
-        SWC_RESULT(pass.run(context));
+        {
+            const Trace::ScopedSpan span(TraceEventKind::Pass, pass.name());
+            SWC_RESULT(pass.run(context));
+        }
 
         uint64_t storageRevisionAfter = storageRevisionBefore;
         if (context.instructions)
@@ -428,18 +445,19 @@ MicroPassManager::MicroPassManager()
     emitPass_                 = std::make_unique<MicroEmitPass>();
 
     // Pre-RA optimization passes
-    preRaPeepholePass_       = std::make_unique<MicroPreRaPeepholePass>();
-    constantFoldingPass_     = std::make_unique<MicroConstantFoldingPass>();
-    copyEliminationPass_     = std::make_unique<MicroCopyEliminationPass>();
-    instructionCombinePass_  = std::make_unique<MicroInstructionCombinePass>();
-    strengthReductionPass_   = std::make_unique<MicroStrengthReductionPass>();
-    valueNumberingPass_      = std::make_unique<MicroValueNumberingPass>();
-    licmPass_                = std::make_unique<MicroLoopInvariantCodeMotionPass>();
-    deadCodeEliminationPass_ = std::make_unique<MicroDeadCodeEliminationPass>();
-    branchSimplifyPass_      = std::make_unique<MicroBranchSimplifyPass>();
-    loopUnrollPass_          = std::make_unique<MicroLoopUnrollPass>();
-    slpVectorizePass_        = std::make_unique<MicroSlpVectorizePass>();
-    vecLoopPromotePass_      = std::make_unique<MicroVecLoopPromotePass>();
+    preRaPeepholePass_          = std::make_unique<MicroPreRaPeepholePass>();
+    constantFoldingPass_        = std::make_unique<MicroConstantFoldingPass>();
+    copyEliminationPass_        = std::make_unique<MicroCopyEliminationPass>();
+    instructionCombinePass_     = std::make_unique<MicroInstructionCombinePass>();
+    strengthReductionPass_      = std::make_unique<MicroStrengthReductionPass>();
+    valueNumberingPass_         = std::make_unique<MicroValueNumberingPass>();
+    safetyCheckEliminationPass_ = std::make_unique<MicroSafetyCheckEliminationPass>();
+    licmPass_                   = std::make_unique<MicroLoopInvariantCodeMotionPass>();
+    deadCodeEliminationPass_    = std::make_unique<MicroDeadCodeEliminationPass>();
+    branchSimplifyPass_         = std::make_unique<MicroBranchSimplifyPass>();
+    loopUnrollPass_             = std::make_unique<MicroLoopUnrollPass>();
+    slpVectorizePass_           = std::make_unique<MicroSlpVectorizePass>();
+    vecLoopPromotePass_         = std::make_unique<MicroVecLoopPromotePass>();
 
     // Post-RA optimization passes
     postRaPeepholePass_     = std::make_unique<MicroPostRaPeepholePass>();
@@ -494,6 +512,12 @@ void MicroPassManager::configureDefaultPipeline(const bool optimize)
         // exist to be shared, and before LICM so a loop body slimmed by
         // sharing exposes more hoisting.
         addPreRaLoopPass(*valueNumberingPass_);
+        // Drop bound, null and overflow guards the dominating branches and value
+        // ranges already prove. Runs after value numbering so a re-loaded count
+        // or index is the same value as the one the loop test compared, and
+        // before branch simplification, which removes the panic blocks left
+        // unreachable.
+        addPreRaLoopPass(*safetyCheckEliminationPass_);
         // Hoist loop-invariant address/load/constant computations into the loop
         // preheader. Runs after instruction-combine so address modes (lea) are
         // already formed, and before DCE so any now-redundant copies are cleaned.
@@ -562,16 +586,12 @@ Result MicroPassManager::run(MicroPassContext& context) const
     SWC_ASSERT(context.instructions != nullptr);
     VerifyStateCache verifyCache;
 
-#if SWC_HAS_STATS
     context.statsInstrInitial = context.instructions->count();
-#endif
 
     SWC_RESULT(runLinearPasses(context, startPasses_, verifyCache));
 
     context.printInstrCountBefore = context.instructions->count();
-#if SWC_HAS_STATS
     context.statsInstrAfterStart = context.instructions->count();
-#endif
 
     // Read-only analyses over the unoptimized virtual-register IR (run once, before
     // any optimization). Running before the optimization loop keeps the IR faithful
@@ -594,23 +614,17 @@ Result MicroPassManager::run(MicroPassContext& context) const
             SWC_RESULT(runLoopPasses(context, preRaLoopPasses_, preRaMaxIterations, true, "post-vectorize-cleanup-loop", verifyCache));
     }
 
-#if SWC_HAS_STATS
     context.statsInstrAfterPreRaOptim = context.instructions->count();
-#endif
 
     // Register allocation loop - legalize + regalloc iterate until stable.
     const uint32_t raMaxIterations = std::max<uint32_t>(loopIterationLimit(context, K_RA_ITERATION_ON), 1);
     SWC_RESULT(runLoopPasses(context, raLoopPasses_, raMaxIterations, false, "ra-legalize-loop", verifyCache));
 
-#if SWC_HAS_STATS
     context.statsInstrAfterRa = context.instructions->count();
-#endif
 
     SWC_RESULT(runLinearPasses(context, postRaSetupPasses_, verifyCache));
 
-#if SWC_HAS_STATS
     context.statsInstrAfterPostRaSetup = context.instructions->count();
-#endif
 
     // Post-RA optimization loop - peephole and dead-code elimination feed each
     // other (a folded copy exposes a dead compare, an erased compare exposes a
@@ -625,15 +639,11 @@ Result MicroPassManager::run(MicroPassContext& context) const
     const uint32_t postRaMaxIterations = std::max<uint32_t>(loopIterationLimit(context, optimizationIterationLimit(context.builder->backendBuildCfg())), 1);
     SWC_RESULT(runBoundedLoopPasses(context, postRaOptimPasses_, postRaMaxIterations, verifyCache));
 
-#if SWC_HAS_STATS
     context.statsInstrAfterPostRaOptim = context.instructions->count();
-#endif
 
     SWC_RESULT(runLinearPasses(context, finalPasses_, verifyCache));
 
-#if SWC_HAS_STATS
     context.statsInstrFinal = context.instructions->count();
-#endif
 
     return Result::Continue;
 }
@@ -29,6 +29,7 @@ class MicroCopyEliminationPass;
 class MicroInstructionCombinePass;
 class MicroStrengthReductionPass;
 class MicroValueNumberingPass;
+class MicroSafetyCheckEliminationPass;
 class MicroLoopInvariantCodeMotionPass;
 class MicroDeadCodeEliminationPass;
 class MicroBranchSimplifyPass;
@@ -98,6 +99,7 @@ private:
     std::unique_ptr<MicroInstructionCombinePass>      instructionCombinePass_;
     std::unique_ptr<MicroStrengthReductionPass>       strengthReductionPass_;
     std::unique_ptr<MicroValueNumberingPass>          valueNumberingPass_;
+    std::unique_ptr<MicroSafetyCheckEliminationPass>  safetyCheckEliminationPass_;
     std::unique_ptr<MicroLoopInvariantCodeMotionPass> licmPass_;
     std::unique_ptr<MicroDeadCodeEliminationPass>     deadCodeEliminationPass_;
     std::unique_ptr<MicroBranchSimplifyPass>          branchSimplifyPass_;
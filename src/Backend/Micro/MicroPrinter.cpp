@@ -921,6 +921,8 @@ namespace
                 return std::format("{} {}", tagInstructionToken("call"), relocValue.empty() ? "<reloc>" : tagNaturalToken(NaturalTagKind::Function, relocValue));
             case MicroInstrOpcode::CallIndirect:
                 return std::format("{} {}", tagInstructionToken("call"), regName(ops[0].reg, regPrintMode, encoder));
+            case MicroInstrOpcode::TailCallIndirect:
+                return std::format("{} {}", tagInstructionToken("tailcall"), regName(ops[0].reg, regPrintMode, encoder));
 
             case MicroInstrOpcode::JumpReg:
                 return std::format("{} {}", tagInstructionToken("jump"), regName(ops[0].reg, regPrintMode, encoder));
@@ -1719,6 +1721,7 @@ Utf8 MicroPrinter::format(const TaskContext& ctx, const MicroStorage& instructio
                 break;
 
             case MicroInstrOpcode::CallIndirect:
+            case MicroInstrOpcode::TailCallIndirect:
                 appendRegister(out, ctx, ops[0].reg, regPrintMode, encoder);
                 appendSep(out);
                 appendColored(out, ctx, SyntaxColor::Type, callConvName(ops[1].callConv));
@@ -58,11 +58,9 @@ uint32_t MicroSsaState::findRegValue(const std::span<const RegValueEntry> entrie
 
 void MicroSsaState::build(MicroBuilder& builder, MicroStorage& storage, MicroOperandStorage& operands, const Encoder* encoder)
 {
-#if SWC_HAS_STATS
     if (Stats::enabledRuntime())
-        Stats::get().numMicroSsaBuilds.fetch_add(1, std::memory_order_relaxed);
+        Stats::get().numMicroSsaBuilds.add(1);
     const Timer buildTimer(Stats::timedMetric(Stats::get().timeMicroSsaBuild));
-#endif
 
     resetForBuild(builder, storage, operands, encoder);
 
@@ -139,27 +137,19 @@ void MicroSsaState::build(MicroBuilder& builder, MicroStorage& storage, MicroOpe
     }
 
     {
-#if SWC_HAS_STATS
         const Timer timer(Stats::timedMetric(Stats::get().timeMicroSsaBlocks));
-#endif
         buildBlocks(controlFlowGraph);
     }
     {
-#if SWC_HAS_STATS
         const Timer timer(Stats::timedMetric(Stats::get().timeMicroSsaDominators));
-#endif
         computeDominators();
     }
     {
-#if SWC_HAS_STATS
         const Timer timer(Stats::timedMetric(Stats::get().timeMicroSsaPhiPlacement));
-#endif
         placePhiNodes();
     }
     {
-#if SWC_HAS_STATS
         const Timer timer(Stats::timedMetric(Stats::get().timeMicroSsaRename));
-#endif
         renameIntoSsa();
     }
 
@@ -252,10 +242,8 @@ void MicroSsaState::clear()
 
 void MicroSsaState::invalidate()
 {
-#if SWC_HAS_STATS
     if (valid_ && Stats::enabledRuntime())
-        Stats::get().numMicroSsaInvalidations.fetch_add(1, std::memory_order_relaxed);
-#endif
+        Stats::get().numMicroSsaInvalidations.add(1);
 
     valid_ = false;
 }
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Backend/Micro/MicroUseDefMap.h"
 #include "Backend/Micro/MicroInstrInfo.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -44,7 +45,7 @@ void MicroUseDefMap::build(MicroStorage& storage, MicroOperandStorage& operands,
     reachingDefs_.clear();
     reachingDefs_.resize(instrCount);
 
-    std::unordered_map<MicroReg, MicroInstrRef> currentDefs;
+    ScratchUnorderedMap<MicroReg, MicroInstrRef> currentDefs;
     currentDefs.reserve(64);
 
     for (uint32_t orderIdx = 0; orderIdx < instrCount; ++orderIdx)
@@ -199,6 +199,7 @@ namespace
                 return 1;
 
             case MicroInstrOpcode::CallIndirect:
+            case MicroInstrOpcode::TailCallIndirect:
             case MicroInstrOpcode::SetCondReg:
             case MicroInstrOpcode::ClearReg:
             case MicroInstrOpcode::SanityInvalidate:
@@ -333,6 +334,7 @@ namespace
             case MicroInstrOpcode::CallLocal:
             case MicroInstrOpcode::CallExtern:
             case MicroInstrOpcode::CallIndirect:
+            case MicroInstrOpcode::TailCallIndirect:
                 if (!isValidCallConv(ops[MicroInstr::info(inst.op).callConvIndex].callConv))
                     return reportError(context, phase, std::format("call instruction #{} uses unsupported calling convention {}", instructionIndex, static_cast<uint32_t>(ops[MicroInstr::info(inst.op).callConvIndex].callConv)));
                 break;
@@ -650,7 +652,7 @@ uint64_t MicroVerify::computeStructuralHash(const MicroPassContext& context)
         for (uint32_t operandIndex = 0; operandIndex < inst.numOperands; ++operandIndex)
         {
             mixHash(hash, ops[operandIndex].valueU64);
-            mixHash(hash, ops[operandIndex].valueInt.hash());
+            mixHash(hash, ops[operandIndex].hasWideImmediateValue() ? ops[operandIndex].wideImmediateValue().hash() : 0);
         }
     }
 
@@ -791,7 +793,7 @@ Result MicroVerify::verify(const MicroPassContext& context, std::string_view pha
                 for (uint32_t operandIndex = 0; operandIndex < inst.numOperands; ++operandIndex)
                 {
                     mixHash(*outStructuralHash, ops[operandIndex].valueU64);
-                    mixHash(*outStructuralHash, ops[operandIndex].valueInt.hash());
+                    mixHash(*outStructuralHash, ops[operandIndex].hasWideImmediateValue() ? ops[operandIndex].wideImmediateValue().hash() : 0);
                 }
             }
         }
@@ -1075,7 +1075,7 @@ namespace
                     continue;
             }
             // A >64-bit immediate cannot be re-materialized from the stored word.
-            if (fromImm && bodyOps[2].valueInt.bitWidth() > 64)
+            if (fromImm && bodyOps[2].hasWideImmediateValue())
                 continue;
 
             const MicroInstrRef labelRef = storage.findNextInstructionRef(bodyRef);
@@ -1121,7 +1121,7 @@ namespace
                 MicroInstrOperand immOps[3];
                 immOps[0].reg    = srcReg;
                 immOps[1].opBits = bodyBits;
-                immOps[2].setImmediateValue(bodyOps[2].immediateValue());
+                immOps[2].copyImmediateFrom(bodyOps[2]);
                 storage.insertDerivedBefore(operands, conversion.jumpRef, MicroInstrOpcode::LoadRegImm, immOps);
             }
             else
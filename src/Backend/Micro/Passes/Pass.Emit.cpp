@@ -3,7 +3,9 @@
 #include "Backend/Micro/MicroBuilder.h"
 #include "Backend/Micro/MicroInstr.h"
 #include "Backend/Micro/MicroPassContext.h"
+#include "Main/Stats.h"
 #include "Support/Memory/MemoryProfile.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Report/Assert.h"
 
 // Final emission pass: converts legalized micro instructions to machine code.
@@ -21,7 +23,15 @@
 //      via bindAbs64RelocationOffset() so the linker can patch the absolute
 //      pointer at load time.
 //
-//   2. Branch patching. Now that every Label has a concrete offset, walk the
+//   2. Branch relaxation (when the context asks for it). Stage 1 encodes every
+//      label jump in its rel32 form. With the label offsets known, the jumps
+//      whose target ends up within rel8 reach are switched to the 2-byte form,
+//      and the function is encoded again. Shrinking a jump only ever brings
+//      other jumps closer to their targets, so the selection is safe; loop
+//      header padding can still push a short jump out of reach, in which case
+//      that jump goes back to rel32 and the function is encoded once more.
+//
+//   3. Branch patching. Now that every Label has a concrete offset, walk the
 //      pending jump list and patch each placeholder displacement.
 //
 // Debug info source ranges are attached during stage 1 whenever an instruction
@@ -29,6 +39,19 @@
 
 SWC_BEGIN_NAMESPACE();
 
+namespace
+{
+    constexpr uint32_t SHORT_JUMP_SIZE         = 2;
+    constexpr uint32_t MAX_RELAXATION_ROUNDS   = 8;
+    constexpr uint32_t LOOP_HEADER_ALIGNMENT   = 16;
+    constexpr uint32_t LOOP_HEADER_MAX_PADDING = 7;
+
+    bool fitsShortJump(const int64_t displacement)
+    {
+        return displacement >= std::numeric_limits<int8_t>::min() && displacement <= std::numeric_limits<int8_t>::max();
+    }
+}
+
 void MicroEmitPass::bindAbs64RelocationOffset(const MicroPassContext& context, MicroInstrRef instructionRef, uint32_t codeStartOffset, uint32_t codeEndOffset) const
 {
     // Relocation-backed absolute pointer loads embed a trailing 64-bit immediate.
@@ -73,20 +96,39 @@ void MicroEmitPass::encodeInstruction(const MicroPassContext& context, MicroInst
             break;
 
         case MicroInstrOpcode::Label:
+        {
             // Record concrete code offset so pending branch patches can resolve target.
             SWC_ASSERT(ops[0].valueU64 <= std::numeric_limits<uint32_t>::max());
-            labelOffsets_[MicroLabelRef(static_cast<uint32_t>(ops[0].valueU64))] = encoder.currentOffset();
+            const MicroLabelRef labelRef(static_cast<uint32_t>(ops[0].valueU64));
+            if (alignLoopHeaders_ && loopHeaders_.contains(labelRef))
+            {
+                const uint32_t padding = (LOOP_HEADER_ALIGNMENT - encoder.size() % LOOP_HEADER_ALIGNMENT) % LOOP_HEADER_ALIGNMENT;
+                if (padding && padding <= LOOP_HEADER_MAX_PADDING)
+                    encoder.encodeNopPadding(padding);
+            }
+
+            labelOffsets_[labelRef] = encoder.currentOffset();
             break;
+        }
         case MicroInstrOpcode::JumpCond:
         {
             // Emit jump with placeholder displacement; patch after all labels are seen.
+            PendingLabelJump pendingJump;
+            MicroOpBits      opBits = ops[1].opBits;
+            if (relaxBranches_ && opBits == MicroOpBits::B32)
+            {
+                pendingJump.relaxIndex = numRelaxableJumps_++;
+                if (pendingJump.relaxIndex < shortJumps_.size() && shortJumps_[pendingJump.relaxIndex])
+                    opBits = MicroOpBits::B8;
+            }
+
             MicroJump jump;
-            encoder.encodeJump(jump, ops[0].cpuCond, ops[1].opBits);
+            encoder.encodeJump(jump, ops[0].cpuCond, opBits);
             jump.valid = true;
             SWC_ASSERT(ops[2].valueU64 <= std::numeric_limits<uint32_t>::max());
-            PendingLabelJump pendingJump;
-            pendingJump.jump     = jump;
-            pendingJump.labelRef = MicroLabelRef(static_cast<uint32_t>(ops[2].valueU64));
+            pendingJump.jump      = jump;
+            pendingJump.labelRef  = MicroLabelRef(static_cast<uint32_t>(ops[2].valueU64));
+            pendingJump.codeStart = instructionCodeStartOffset;
             pendingLabelJumps_.push_back(pendingJump);
             break;
         }
@@ -155,6 +197,10 @@ void MicroEmitPass::encodeInstruction(const MicroPassContext& context, MicroInst
             // Call target is already materialized in ops[0] by earlier lowering stages.
             encoder.encodeCallReg(ops[0].reg, ops[1].callConv);
             break;
+        case MicroInstrOpcode::TailCallIndirect:
+            // The epilogue is already behind us: the callee returns straight to our caller.
+            encoder.encodeTailJumpReg(ops[0].reg);
+            break;
         case MicroInstrOpcode::JumpReg:
             encoder.encodeJumpReg(ops[0].reg);
             break;
@@ -323,13 +369,31 @@ Result MicroEmitPass::run(MicroPassContext& context)
         relocationByInstructionRef_[reloc.instructionRef] = idx;
     }
 
+    prepareRelaxation(context);
+    shortJumps_.clear();
+
     // Single forward pass emits bytes and accumulates unresolved label jumps.
-    for (auto it = context.instructions->view().begin(); it != context.instructions->view().end(); ++it)
+    encodeFunction(context);
+
+    // Shorten what the first pass proved close, then encode again with those choices until
+    // every short jump reaches its label.
+    if (relaxBranches_ && selectShortJumps())
     {
-        encodeInstruction(context, it.current, *it);
+        do
+        {
+            encoder.resetCode();
+            encodeFunction(context);
+        } while (demoteOutOfRangeJumps());
     }
 
-    // Second pass patches all label-relative branches now that offsets are known.
+    if (Stats::enabledRuntime() && relaxBranches_)
+    {
+        const auto numShort = static_cast<size_t>(std::ranges::count(shortJumps_, uint8_t{1}));
+        Stats::get().numMicroShortJumps.add(numShort);
+        Stats::get().numMicroNearJumps.add(numRelaxableJumps_ - numShort);
+    }
+
+    // Last pass patches all label-relative branches now that offsets are known.
     for (const auto& pending : pendingLabelJumps_)
     {
         const auto it = labelOffsets_.find(pending.labelRef);
@@ -343,4 +407,148 @@ Result MicroEmitPass::run(MicroPassContext& context)
     return Result::Continue;
 }
 
+void MicroEmitPass::prepareRelaxation(const MicroPassContext& context)
+{
+    // Relaxation encodes the function more than once, so it must own the encoder from the
+    // first byte. A jump to a raw code offset was computed against the plain layout, which
+    // neither relaxation nor padding may change.
+    relaxBranches_    = context.relaxBranches && context.encoder->size() == 0;
+    alignLoopHeaders_ = context.alignLoopHeaders;
+    loopHeaders_.clear();
+    if (!relaxBranches_ && !alignLoopHeaders_)
+        return;
+
+    ScratchUnorderedSet<MicroLabelRef> placedLabels;
+    for (const MicroInstr& inst : context.instructions->view())
+    {
+        if (inst.op == MicroInstrOpcode::JumpCondImm)
+        {
+            relaxBranches_    = false;
+            alignLoopHeaders_ = false;
+            loopHeaders_.clear();
+            return;
+        }
+
+        if (!alignLoopHeaders_)
+            continue;
+
+        // A label some later jump goes back to heads a loop.
+        const MicroInstrOperand* ops = inst.ops(*context.operands);
+        if (inst.op == MicroInstrOpcode::Label)
+            placedLabels.insert(MicroLabelRef(static_cast<uint32_t>(ops[0].valueU64)));
+        else if (inst.op == MicroInstrOpcode::JumpCond)
+        {
+            const MicroLabelRef labelRef(static_cast<uint32_t>(ops[2].valueU64));
+            if (placedLabels.contains(labelRef))
+                loopHeaders_.insert(labelRef);
+        }
+    }
+}
+
+void MicroEmitPass::encodeFunction(const MicroPassContext& context)
+{
+    labelOffsets_.clear();
+    pendingLabelJumps_.clear();
+    numRelaxableJumps_ = 0;
+
+    if (context.reserveJitEntryPatch)
+    {
+        SWC_ASSERT(context.encoder->size() == 0);
+        context.encoder->encodeNopPadding(MicroPassContext::K_JIT_ENTRY_PATCH_SIZE);
+    }
+
+    for (auto it = context.instructions->view().begin(); it != context.instructions->view().end(); ++it)
+        encodeInstruction(context, it.current, *it);
+}
+
+// Picks the jumps of the all-rel32 encoding that can use rel8. An offset in the relaxed layout
+// is its offset in the first encoding minus what the short jumps before it saved. Every jump
+// made short shrinks the distances it lies between, so a jump that fits stays fitting as more
+// are added: each round only considers the remaining ones, until none is added.
+bool MicroEmitPass::selectShortJumps()
+{
+    shortJumps_.assign(numRelaxableJumps_, 0);
+
+    ScratchVector<const PendingLabelJump*> jumps;
+    ScratchVector<uint64_t>                jumpEnds;
+    ScratchVector<int64_t>                 targets;
+    for (const PendingLabelJump& pending : pendingLabelJumps_)
+    {
+        if (pending.relaxIndex == K_NOT_RELAXABLE)
+            continue;
+
+        const auto it = labelOffsets_.find(pending.labelRef);
+        jumps.push_back(&pending);
+        jumpEnds.push_back(pending.jump.offsetStart);
+        targets.push_back(it == labelOffsets_.end() ? -1 : static_cast<int64_t>(it->second));
+    }
+
+    ScratchVector<uint64_t> savedBefore(jumps.size() + 1, 0);
+    const auto              relaxedOffset = [&](const uint64_t offset) {
+        const auto numBefore = std::ranges::upper_bound(jumpEnds, offset) - jumpEnds.begin();
+        return static_cast<int64_t>(offset - savedBefore[numBefore]);
+    };
+
+    bool anyShort = false;
+    for (uint32_t round = 0; round < MAX_RELAXATION_ROUNDS; ++round)
+    {
+        for (size_t i = 0; i < jumps.size(); ++i)
+        {
+            const uint64_t saving = shortJumps_[jumps[i]->relaxIndex] ? jumps[i]->jump.offsetStart - jumps[i]->codeStart - SHORT_JUMP_SIZE : 0;
+            savedBefore[i + 1]    = savedBefore[i] + saving;
+        }
+
+        bool changed = false;
+        for (size_t i = 0; i < jumps.size(); ++i)
+        {
+            const PendingLabelJump& jump = *jumps[i];
+            if (shortJumps_[jump.relaxIndex] || targets[i] < 0)
+                continue;
+
+            // A forward target also moves by what this very jump would save.
+            const uint64_t saving   = jump.jump.offsetStart - jump.codeStart - SHORT_JUMP_SIZE;
+            const int64_t  shortEnd = relaxedOffset(jump.codeStart) + SHORT_JUMP_SIZE;
+            int64_t        target   = relaxedOffset(static_cast<uint64_t>(targets[i]));
+            if (static_cast<uint64_t>(targets[i]) >= jump.jump.offsetStart)
+                target -= static_cast<int64_t>(saving);
+
+            if (fitsShortJump(target - shortEnd))
+            {
+                shortJumps_[jump.relaxIndex] = 1;
+                changed                      = true;
+                anyShort                     = true;
+            }
+        }
+
+        if (!changed)
+            break;
+    }
+
+    return anyShort;
+}
+
+// After encoding with the selected short jumps: sends back to rel32 any short jump that loop
+// header padding pushed out of reach. Returns true if the function must be encoded again.
+bool MicroEmitPass::demoteOutOfRangeJumps()
+{
+    bool demoted = false;
+    for (const PendingLabelJump& pending : pendingLabelJumps_)
+    {
+        if (pending.relaxIndex == K_NOT_RELAXABLE || pending.jump.opBits != MicroOpBits::B8)
+            continue;
+
+        const auto it = labelOffsets_.find(pending.labelRef);
+        if (it == labelOffsets_.end())
+            continue;
+
+        if (!fitsShortJump(static_cast<int64_t>(it->second) - static_cast<int64_t>(pending.jump.offsetStart)))
+        {
+            shortJumps_[pending.relaxIndex] = 0;
+            demoted                         = true;
+        }
+    }
+
+    return demoted;
+}
+
 SWC_END_NAMESPACE();
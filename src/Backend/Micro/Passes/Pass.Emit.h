@@ -13,19 +13,32 @@ public:
     Result           run(MicroPassContext& context) override;
 
 private:
+    static constexpr uint32_t K_NOT_RELAXABLE = std::numeric_limits<uint32_t>::max();
+
     struct PendingLabelJump
     {
         MicroJump     jump;
-        MicroLabelRef labelRef = MicroLabelRef::invalid();
+        MicroLabelRef labelRef   = MicroLabelRef::invalid();
+        uint32_t      codeStart  = 0;
+        uint32_t      relaxIndex = K_NOT_RELAXABLE;
     };
 
+    void prepareRelaxation(const MicroPassContext& context);
+    void encodeFunction(const MicroPassContext& context);
     void encodeInstruction(const MicroPassContext& context, MicroInstrRef instructionRef, const MicroInstr& inst);
+    bool selectShortJumps();
+    bool demoteOutOfRangeJumps();
     void bindAbs64RelocationOffset(const MicroPassContext& context, MicroInstrRef instructionRef, uint32_t codeStartOffset, uint32_t codeEndOffset) const;
     void bindRel32RelocationOffset(const MicroPassContext& context, MicroInstrRef instructionRef, uint32_t codeStartOffset, uint32_t codeEndOffset) const;
 
     std::unordered_map<MicroLabelRef, uint64_t> labelOffsets_;
     std::vector<PendingLabelJump>               pendingLabelJumps_;
     std::unordered_map<MicroInstrRef, uint32_t> relocationByInstructionRef_;
+    std::unordered_set<MicroLabelRef>           loopHeaders_;
+    std::vector<uint8_t>                        shortJumps_; // per relaxable jump, in stream order
+    uint32_t                                    numRelaxableJumps_ = 0;
+    bool                                        relaxBranches_     = false;
+    bool                                        alignLoopHeaders_  = false;
 };
 
 SWC_END_NAMESPACE();
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Backend/Micro/Passes/Pass.PrologEpilog.h"
+#include "Backend/Micro/MicroBuilder.h"
 #include "Backend/Micro/MicroInstr.h"
 #include "Backend/Micro/MicroPassContext.h"
 #include "Support/Math/Helpers.h"
@@ -32,6 +33,16 @@
 //        front of the body: the frame pointer anchored right after it (see
 //        the sanitize pass) is what keeps the frame walkable, so the body's
 //        own stack motion stays out of the unwind description.
+//
+//   4. rewriteTailCalls
+//        Optimization: a call codegen marked as being in tail position, and
+//        followed by nothing but its own stack cleanup and return-register
+//        copies, is replaced by the epilogue plus a jump to the callee. The
+//        callee then returns straight to our caller and recursion in tail
+//        position runs in constant stack. Runs before step 3 places the
+//        regular epilogues, and is skipped entirely for a function that lets
+//        an address inside its frame reach a call or memory: after the jump
+//        that frame no longer exists.
 
 SWC_BEGIN_NAMESPACE();
 
@@ -310,6 +321,211 @@ namespace
 
         return remapped;
     }
+
+    bool isTailCallCandidateOpcode(MicroInstrOpcode op)
+    {
+        return op == MicroInstrOpcode::CallLocal ||
+               op == MicroInstrOpcode::CallExtern ||
+               op == MicroInstrOpcode::CallIndirect;
+    }
+
+    bool isMemoryAddressOperand(const MicroInstr& inst, const MicroInstrOperand* ops, const MicroReg* reg)
+    {
+        if (!ops)
+            return false;
+
+        const MicroInstrDef& def = MicroInstr::info(inst.op);
+        if (def.flags.has(MicroInstrFlagsE::HasMemBaseOffsetOperands))
+            return reg == &ops[def.memBaseOperandIndex].reg;
+
+        switch (inst.op)
+        {
+            case MicroInstrOpcode::LoadAmcRegMem:
+            case MicroInstrOpcode::LoadSignedExtAmcRegMem:
+            case MicroInstrOpcode::LoadZeroExtAmcRegMem:
+            case MicroInstrOpcode::LoadAddrAmcRegMem:
+                return reg == &ops[1].reg || reg == &ops[2].reg;
+
+            case MicroInstrOpcode::LoadAmcMemReg:
+            case MicroInstrOpcode::LoadAmcMemImm:
+            case MicroInstrOpcode::CmpAmcImm:
+                return reg == &ops[0].reg || reg == &ops[1].reg;
+
+            default:
+                return false;
+        }
+    }
+
+    // Flow-insensitive over physical registers: once a register holds an
+    // address inside this frame anywhere, it is treated as holding one
+    // everywhere. A value loaded from memory is never frame-derived, which is
+    // only sound because storing a frame-derived value is itself an escape.
+    bool frameAddressMayEscape(const MicroPassContext& context, const CallConv& conv)
+    {
+        SWC_ASSERT(context.instructions);
+        SWC_ASSERT(context.operands);
+
+        std::unordered_set<MicroReg> frameRegs;
+        frameRegs.insert(conv.stackPointer);
+        if (conv.framePointer.isValid())
+            frameRegs.insert(conv.framePointer);
+
+        auto& operands = *context.operands;
+        bool  grew     = true;
+        while (grew)
+        {
+            grew = false;
+            for (const auto& inst : context.instructions->view())
+            {
+                if (MicroInstr::info(inst.op).flags.has(MicroInstrFlagsE::IsCallInstruction))
+                    continue;
+
+                const MicroInstrOperand* ops = inst.ops(operands);
+                const bool formsAddress      = inst.op == MicroInstrOpcode::LoadAddrRegMem || inst.op == MicroInstrOpcode::LoadAddrAmcRegMem;
+
+                SmallVector<MicroInstrRegOperandRef> refs;
+                inst.collectRegOperands(operands, refs, context.encoder);
+
+                bool derives = false;
+                for (const MicroInstrRegOperandRef& ref : refs)
+                {
+                    if (!ref.reg || !ref.use || !frameRegs.contains(*ref.reg))
+                        continue;
+                    if (!formsAddress && isMemoryAddressOperand(inst, ops, ref.reg))
+                        continue;
+                    derives = true;
+                    break;
+                }
+
+                if (!derives)
+                    continue;
+
+                for (const MicroInstrRegOperandRef& ref : refs)
+                {
+                    if (ref.reg && ref.def && frameRegs.insert(*ref.reg).second)
+                        grew = true;
+                }
+            }
+        }
+
+        for (const auto& inst : context.instructions->view())
+        {
+            const MicroInstrDef& def = MicroInstr::info(inst.op);
+            if (def.flags.has(MicroInstrFlagsE::IsCallInstruction))
+            {
+                const MicroInstrUseDef useDef = inst.collectUseDef(operands, context.encoder);
+                for (const MicroReg reg : useDef.uses)
+                {
+                    if (frameRegs.contains(reg))
+                        return true;
+                }
+
+                continue;
+            }
+
+            if (!def.flags.has(MicroInstrFlagsE::WritesMemory))
+                continue;
+
+            const MicroInstrOperand*             ops = inst.ops(operands);
+            SmallVector<MicroInstrRegOperandRef> refs;
+            inst.collectRegOperands(operands, refs, context.encoder);
+            for (const MicroInstrRegOperandRef& ref : refs)
+            {
+                if (!ref.reg || !ref.use || !frameRegs.contains(*ref.reg))
+                    continue;
+                if (isMemoryAddressOperand(inst, ops, ref.reg))
+                    continue;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    struct TailCallSite
+    {
+        MicroInstrRef              callRef;
+        MicroInstrRef              retRef;
+        uint64_t                   stackAdjust = 0;
+        SmallVector<MicroInstrRef> betweenRefs;
+    };
+
+    // Between the call and its return, codegen only undoes the call's stack
+    // adjust and the local frame, and moves the result towards the return
+    // register. Once the callee returns to our caller directly those moves
+    // have nothing left to do: its result is already where ours would be.
+    bool tryMatchTailCallSite(const MicroPassContext& context, const CallConv& conv, MicroInstrRef callRef, TailCallSite& outSite)
+    {
+        const MicroInstr* callInst = context.instructions->ptr(callRef);
+        if (!callInst)
+            return false;
+
+        const auto&              operands = *context.operands;
+        const MicroInstrOperand* callOps  = callInst->ops(operands);
+        if (!callOps)
+            return false;
+        if (callOps[MicroInstr::info(callInst->op).callConvIndex].callConv != context.callConvKind)
+            return false;
+        if (callInst->op == MicroInstrOpcode::CallIndirect && (callOps[0].reg == conv.stackPointer || callOps[0].reg == conv.framePointer))
+            return false;
+
+        std::unordered_set<MicroReg> resultRegs;
+        resultRegs.insert(conv.intReturn);
+        resultRegs.insert(conv.floatReturn);
+
+        outSite             = {};
+        outSite.callRef     = callRef;
+        outSite.stackAdjust = 0;
+        for (MicroInstrRef ref = context.instructions->findNextInstructionRef(callRef); ref.isValid(); ref = context.instructions->findNextInstructionRef(ref))
+        {
+            const MicroInstr* inst = context.instructions->ptr(ref);
+            if (!inst)
+                return false;
+
+            if (inst->op == MicroInstrOpcode::Ret)
+            {
+                outSite.retRef = ref;
+                return true;
+            }
+
+            const MicroInstrOperand* ops = inst->ops(operands);
+            switch (inst->op)
+            {
+                case MicroInstrOpcode::Nop:
+                    break;
+
+                case MicroInstrOpcode::OpBinaryRegImm:
+                {
+                    if (!ops || ops[0].reg != conv.stackPointer || ops[1].opBits != MicroOpBits::B64 || ops[2].microOp != MicroOp::Add)
+                        return false;
+                    const ApInt immediate = ops[3].immediateValue(64);
+                    if (!immediate.fit64() || immediate.as64() > std::numeric_limits<uint64_t>::max() - outSite.stackAdjust)
+                        return false;
+                    outSite.stackAdjust += immediate.as64();
+                    break;
+                }
+
+                case MicroInstrOpcode::LoadRegReg:
+                case MicroInstrOpcode::LoadZeroExtRegReg:
+                case MicroInstrOpcode::LoadSignedExtRegReg:
+                    if (!ops || !resultRegs.contains(ops[1].reg))
+                        return false;
+                    if (ops[0].reg == conv.stackPointer || ops[0].reg == conv.framePointer)
+                        return false;
+                    if (ops[0].reg.isFloat() != ops[1].reg.isFloat())
+                        return false;
+                    resultRegs.insert(ops[0].reg);
+                    break;
+
+                default:
+                    return false;
+            }
+
+            outSite.betweenRefs.push_back(ref);
+        }
+
+        return false;
+    }
 }
 
 Result MicroPrologEpilogPass::run(MicroPassContext& context)
@@ -331,20 +547,25 @@ Result MicroPrologEpilogPass::run(MicroPassContext& context)
     const CallConv& conv                              = CallConv::get(context.callConvKind);
     const bool      remappedPersistentRegsToTransient = remapPersistentIntRegsToUnusedTransient(context, conv);
     buildSavedRegsPlan(context, conv);
+    const bool rewroteTailCalls = rewriteTailCalls(context, conv);
     if (pushedRegs_.empty() && !savedRegsStackSubSize_ && !useFramePointer_)
     {
-        context.passChanged = remappedPersistentRegsToTransient;
+        context.passChanged = remappedPersistentRegsToTransient || rewroteTailCalls;
         return Result::Continue;
     }
 
-    MicroInstrRef firstRef = MicroInstrRef::invalid();
+    // A Ret right behind a tail call is never reached: the epilogue already
+    // ran in front of the jump.
+    MicroInstrRef    firstRef = MicroInstrRef::invalid();
+    MicroInstrOpcode prevOp   = MicroInstrOpcode::End;
     retRefs_.clear();
     for (auto it = context.instructions->view().begin(); it != context.instructions->view().end(); ++it)
     {
         if (firstRef.isInvalid())
             firstRef = it.current;
-        if (it->op == MicroInstrOpcode::Ret)
+        if (it->op == MicroInstrOpcode::Ret && prevOp != MicroInstrOpcode::TailCallIndirect)
             retRefs_.push_back(it.current);
+        prevOp = it->op;
     }
 
     if (firstRef.isValid())
@@ -352,10 +573,112 @@ Result MicroPrologEpilogPass::run(MicroPassContext& context)
     for (const MicroInstrRef retRef : retRefs_)
         insertSavedRegsEpilogue(context, conv, retRef);
 
-    context.passChanged = firstRef.isValid() || remappedPersistentRegsToTransient;
+    context.passChanged = firstRef.isValid() || remappedPersistentRegsToTransient || rewroteTailCalls;
     return Result::Continue;
 }
 
+bool MicroPrologEpilogPass::rewriteTailCalls(MicroPassContext& context, const CallConv& conv) const
+{
+    SWC_ASSERT(context.instructions);
+    SWC_ASSERT(context.operands);
+
+    MicroBuilder* builder = context.builder;
+    if (!builder)
+        return false;
+
+    SmallVector<TailCallSite> sites;
+    for (auto it = context.instructions->view().begin(); it != context.instructions->view().end(); ++it)
+    {
+        if (!isTailCallCandidateOpcode(it->op) || !builder->isTailCallCandidate(it.current))
+            continue;
+
+        TailCallSite site;
+        if (tryMatchTailCallSite(context, conv, it.current, site))
+            sites.push_back(std::move(site));
+    }
+
+    if (sites.empty() || frameAddressMayEscape(context, conv))
+        return false;
+
+    auto& instructions = *context.instructions;
+    auto& operands     = *context.operands;
+    bool  rewritten    = false;
+    for (const TailCallSite& site : sites)
+    {
+        const MicroInstr* callInst = instructions.ptr(site.callRef);
+        SWC_ASSERT(callInst);
+        const MicroInstrOperand* callOps    = callInst->ops(operands);
+        const bool               isIndirect = callInst->op == MicroInstrOpcode::CallIndirect;
+
+        MicroRelocation* targetReloc = nullptr;
+        if (!isIndirect)
+        {
+            for (MicroRelocation& reloc : builder->codeRelocations())
+            {
+                if (reloc.instructionRef == site.callRef)
+                {
+                    targetReloc = &reloc;
+                    break;
+                }
+            }
+
+            if (!targetReloc)
+                continue;
+        }
+
+        // Copied out up front: inserting may move both the instruction and
+        // its operands.
+        const DebugSourceInfo callDebugInfo    = callInst->debugSourceInfo;
+        const MicroReg        targetReg        = isIndirect ? callOps[0].reg : MicroReg{};
+        const MicroInstrRef   firstInsertedRef = instructions.findPreviousInstructionRef(site.retRef);
+        const uint32_t        maskIndex        = isIndirect ? 2 : 1;
+
+        MicroInstrOperand tailOps[4];
+        tailOps[0].reg      = conv.intReturn;
+        tailOps[1].callConv = callOps[MicroInstr::info(callInst->op).callConvIndex].callConv;
+        tailOps[2].valueU32 = callOps[maskIndex].valueU32;
+        tailOps[3].valueU32 = callOps[maskIndex + 1].valueU32;
+
+        // The target goes to the return register: it is free until the callee
+        // writes its result, and the epilogue below may restore whichever
+        // persistent register held it.
+        if (targetReloc)
+        {
+            MicroInstrOperand loadOps[3];
+            loadOps[0].reg              = conv.intReturn;
+            loadOps[1].opBits           = MicroOpBits::B64;
+            loadOps[2].valueU64         = targetReloc->targetAddress;
+            targetReloc->instructionRef = instructions.insertSyntheticBefore(operands, site.retRef, MicroInstrOpcode::LoadRegPtrReloc, loadOps);
+        }
+        else if (targetReg != conv.intReturn)
+        {
+            MicroInstrOperand moveOps[3];
+            moveOps[0].reg    = conv.intReturn;
+            moveOps[1].reg    = targetReg;
+            moveOps[2].opBits = MicroOpBits::B64;
+            instructions.insertSyntheticBefore(operands, site.retRef, MicroInstrOpcode::LoadRegReg, moveOps);
+        }
+
+        if (site.stackAdjust)
+            insertStackAdjust(context, site.retRef, conv.stackPointer, MicroOp::Add, site.stackAdjust);
+        insertSavedRegsEpilogue(context, conv, site.retRef);
+        instructions.insertSyntheticBefore(operands, site.retRef, MicroInstrOpcode::TailCallIndirect, tailOps);
+
+        // Stepping lands on the call's line once, before the frame goes away.
+        const MicroInstrRef stepRef = instructions.findNextInstructionRef(firstInsertedRef);
+        instructions.ptr(stepRef)->debugSourceInfo = callDebugInfo;
+
+        instructions.erase(site.callRef);
+        for (const MicroInstrRef ref : site.betweenRefs)
+            instructions.erase(ref);
+
+        ++context.statsTailCalls;
+        rewritten = true;
+    }
+
+    return rewritten;
+}
+
 bool MicroPrologEpilogPass::containsSavedSlot(MicroReg reg) const
 {
     for (const SavedRegSlot& slot : savedRegSlots_)
@@ -23,6 +23,7 @@ private:
     void buildSavedRegsPlan(const MicroPassContext& context, const CallConv& conv);
     void insertSavedRegsPrologue(const MicroPassContext& context, const CallConv& conv, MicroInstrRef insertBeforeRef) const;
     void insertSavedRegsEpilogue(const MicroPassContext& context, const CallConv& conv, MicroInstrRef insertBeforeRef) const;
+    bool rewriteTailCalls(MicroPassContext& context, const CallConv& conv) const;
     bool containsSavedSlot(MicroReg reg) const;
 
     uint64_t                   savedRegsStackSubSize_ = 0;
@@ -29,7 +29,7 @@
 //
 //   sanitizeEpilogueStackAdjustments
 //       Same coalescing as the prologue version but applied backwards from
-//       each Ret over the run of epilogue instructions.
+//       each Ret (or tail-call jump) over the run of epilogue instructions.
 
 SWC_BEGIN_NAMESPACE();
 
@@ -154,13 +154,13 @@ namespace
         if (firstImmediate > std::numeric_limits<uint64_t>::max() - secondImmediate)
             return false;
 
-        const ApInt    originalImmediate = firstOps[3].immediateValue(64);
-        const uint64_t mergedImmediate   = firstImmediate + secondImmediate;
+        const MicroInstrOperand originalImmediate = firstOps[3];
+        const uint64_t          mergedImmediate   = firstImmediate + secondImmediate;
         firstOps[3].setImmediateValue(ApInt(mergedImmediate, 64));
 
         if (MicroPassHelpers::violatesEncoderConformance(context, *firstInst, firstOps))
         {
-            firstOps[3].setImmediateValue(originalImmediate);
+            firstOps[3].copyImmediateFrom(originalImmediate);
             return false;
         }
 
@@ -406,7 +406,7 @@ namespace
         std::vector<MicroInstrRef> retRefs;
         for (auto it = context.instructions->view().begin(); it != context.instructions->view().end(); ++it)
         {
-            if (it->op == MicroInstrOpcode::Ret)
+            if (it->op == MicroInstrOpcode::Ret || it->op == MicroInstrOpcode::TailCallIndirect)
                 retRefs.push_back(it.current);
         }
 
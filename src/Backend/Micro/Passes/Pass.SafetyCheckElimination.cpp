@@ -0,0 +1,1048 @@
+#include "pch.h"
+#include "Backend/Micro/Passes/Pass.SafetyCheckElimination.h"
+#include "Backend/Micro/MicroBuilder.h"
+#include "Backend/Micro/MicroControlFlowGraph.h"
+#include "Backend/Micro/MicroInstr.h"
+#include "Backend/Micro/MicroPassContext.h"
+#include "Backend/Micro/MicroPassHelpers.h"
+#include "Backend/Micro/MicroSsaState.h"
+#include "Backend/Micro/MicroStorage.h"
+#include "Support/Memory/MemoryProfile.h"
+#include "Support/Report/Assert.h"
+
+// Guard elimination. See the header for the high-level contract.
+//
+// Everything is phrased as a claim: a relation between two operands at one
+// compare width, where an operand is an SSA value (seen through plain copies,
+// like value numbering sees it) or a constant. A guard's claim is the one its
+// jump needs to be always taken; a branch edge's claim is the one it
+// establishes. Claims name values, never registers, so a claim found on an
+// edge still holds anywhere that edge dominates.
+//
+// At a join the goal is split along the incoming edges, each one naming the
+// value the phi receives there. A goal that comes back to the join it is being
+// proven at is taken as holding: every such use looks at an earlier arrival at
+// the join, so the proof is an induction over the arrivals, and the base case is
+// the entry edge, which has to stand on its own. That is what lets the index of
+// a counted loop be proven non-negative and below its bound at the header.
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    constexpr uint32_t K_INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    // Steps one guard may spend in the CFG and in its sub-proofs before it is
+    // left in place. A loop index needs a few dozen.
+    constexpr uint32_t K_PROOF_BUDGET = 512;
+    constexpr uint32_t K_RANGE_DEPTH  = 6;
+    constexpr uint32_t K_COPY_DEPTH   = 8;
+    constexpr uint32_t K_FLAGS_SCAN   = 8;
+
+    enum class Relation : uint8_t
+    {
+        ULt,
+        ULe,
+        SLt,
+        SLe,
+        Eq,
+        Ne,
+    };
+
+    struct Operand
+    {
+        MicroReg reg     = MicroReg::invalid();
+        uint32_t valueId = MicroSsaState::K_INVALID_VALUE;
+        bool     isConst = false;
+        uint64_t cst     = 0;
+
+        bool valid() const { return isConst || valueId != MicroSsaState::K_INVALID_VALUE; }
+
+        static Operand constant(const uint64_t value) { return {.isConst = true, .cst = value}; }
+    };
+
+    bool sameOperand(const Operand& a, const Operand& b)
+    {
+        if (a.isConst != b.isConst)
+            return false;
+        return a.isConst ? a.cst == b.cst : a.valueId == b.valueId;
+    }
+
+    struct Claim
+    {
+        Relation    rel  = Relation::ULt;
+        Operand     lhs;
+        Operand     rhs;
+        MicroOpBits bits = MicroOpBits::B64;
+    };
+
+    bool sameClaim(const Claim& a, const Claim& b)
+    {
+        return a.rel == b.rel && a.bits == b.bits && sameOperand(a.lhs, b.lhs) && sameOperand(a.rhs, b.rhs);
+    }
+
+    // The claim a taken `cmp a, b; jcc` establishes.
+    bool claimFromCond(Claim& out, const MicroCond cond, const Operand& a, const Operand& b, const MicroOpBits bits)
+    {
+        switch (cond)
+        {
+            case MicroCond::Below: out = {Relation::ULt, a, b, bits}; return true;
+            case MicroCond::BelowOrEqual:
+            case MicroCond::NotAbove: out = {Relation::ULe, a, b, bits}; return true;
+            case MicroCond::Above: out = {Relation::ULt, b, a, bits}; return true;
+            case MicroCond::AboveOrEqual: out = {Relation::ULe, b, a, bits}; return true;
+            case MicroCond::Less: out = {Relation::SLt, a, b, bits}; return true;
+            case MicroCond::LessOrEqual: out = {Relation::SLe, a, b, bits}; return true;
+            case MicroCond::Greater: out = {Relation::SLt, b, a, bits}; return true;
+            case MicroCond::GreaterOrEqual: out = {Relation::SLe, b, a, bits}; return true;
+            case MicroCond::Equal:
+            case MicroCond::Zero: out = {Relation::Eq, a, b, bits}; return true;
+            case MicroCond::NotEqual:
+            case MicroCond::NotZero: out = {Relation::Ne, a, b, bits}; return true;
+            default: return false;
+        }
+    }
+
+    // The condition that holds on the fall-through edge of a jump on `cond`.
+    bool negateCond(const MicroCond cond, MicroCond& outNegated)
+    {
+        switch (cond)
+        {
+            case MicroCond::Below: outNegated = MicroCond::AboveOrEqual; return true;
+            case MicroCond::AboveOrEqual: outNegated = MicroCond::Below; return true;
+            case MicroCond::BelowOrEqual:
+            case MicroCond::NotAbove: outNegated = MicroCond::Above; return true;
+            case MicroCond::Above: outNegated = MicroCond::BelowOrEqual; return true;
+            case MicroCond::Less: outNegated = MicroCond::GreaterOrEqual; return true;
+            case MicroCond::GreaterOrEqual: outNegated = MicroCond::Less; return true;
+            case MicroCond::LessOrEqual: outNegated = MicroCond::Greater; return true;
+            case MicroCond::Greater: outNegated = MicroCond::LessOrEqual; return true;
+            case MicroCond::Equal: outNegated = MicroCond::NotEqual; return true;
+            case MicroCond::NotEqual: outNegated = MicroCond::Equal; return true;
+            case MicroCond::Zero: outNegated = MicroCond::NotZero; return true;
+            case MicroCond::NotZero: outNegated = MicroCond::Zero; return true;
+            default: return false;
+        }
+    }
+
+    uint64_t signBitOf(const MicroOpBits bits)
+    {
+        return uint64_t{1} << (getNumBits(bits) - 1);
+    }
+
+    int64_t toSigned(uint64_t value, const MicroOpBits bits)
+    {
+        const uint64_t mask = getBitsMask(bits);
+        value &= mask;
+        if (value & signBitOf(bits))
+            value |= ~mask;
+        return static_cast<int64_t>(value);
+    }
+
+    // What a value may hold at one width, as an unsigned and a signed interval.
+    // The two are kept consistent with each other by `tighten`.
+    struct Bounds
+    {
+        uint64_t ulo = 0;
+        uint64_t uhi = 0;
+        int64_t  slo = 0;
+        int64_t  shi = 0;
+
+        bool empty() const { return ulo > uhi || slo > shi; }
+    };
+
+    Bounds fullBounds(const MicroOpBits bits)
+    {
+        return {.ulo = 0, .uhi = getBitsMask(bits), .slo = toSigned(signBitOf(bits), bits), .shi = toSigned(signBitOf(bits) - 1, bits)};
+    }
+
+    void tighten(Bounds& b, const MicroOpBits bits)
+    {
+        if (b.empty())
+            return;
+
+        // An unsigned interval on one side of the sign bit is a signed one too.
+        const uint64_t signBit = signBitOf(bits);
+        if (b.uhi < signBit || b.ulo >= signBit)
+        {
+            b.slo = std::max(b.slo, toSigned(b.ulo, bits));
+            b.shi = std::min(b.shi, toSigned(b.uhi, bits));
+        }
+
+        if (b.empty())
+            return;
+
+        if (b.slo >= 0 || b.shi < 0)
+        {
+            b.ulo = std::max(b.ulo, static_cast<uint64_t>(b.slo) & getBitsMask(bits));
+            b.uhi = std::min(b.uhi, static_cast<uint64_t>(b.shi) & getBitsMask(bits));
+        }
+    }
+
+    Bounds boundsFromUnsigned(const uint64_t lo, const uint64_t hi, const MicroOpBits bits)
+    {
+        Bounds b = fullBounds(bits);
+        b.ulo    = lo;
+        b.uhi    = hi;
+        tighten(b, bits);
+        return b;
+    }
+
+    bool holdsBetween(const Relation rel, const Bounds& lhs, const Bounds& rhs)
+    {
+        switch (rel)
+        {
+            case Relation::ULt: return lhs.uhi < rhs.ulo;
+            case Relation::ULe: return lhs.uhi <= rhs.ulo;
+            case Relation::SLt: return lhs.shi < rhs.slo;
+            case Relation::SLe: return lhs.shi <= rhs.slo;
+            case Relation::Eq: return lhs.ulo == lhs.uhi && rhs.ulo == rhs.uhi && lhs.ulo == rhs.ulo;
+            case Relation::Ne: return lhs.uhi < rhs.ulo || rhs.uhi < lhs.ulo;
+        }
+
+        SWC_UNREACHABLE();
+    }
+
+    // The relations a claim implies between the same two operands, in the same order.
+    bool impliesSameOrder(const Relation fact, const Relation goal)
+    {
+        if (fact == goal)
+            return true;
+        switch (fact)
+        {
+            case Relation::ULt: return goal == Relation::ULe || goal == Relation::Ne;
+            case Relation::SLt: return goal == Relation::SLe || goal == Relation::Ne;
+            case Relation::Eq: return goal == Relation::ULe || goal == Relation::SLe;
+            default: return false;
+        }
+    }
+
+    struct GuardPlan
+    {
+        MicroInstrRef jumpRef = MicroInstrRef::invalid();
+        MicroInstrRef cmpRef  = MicroInstrRef::invalid();
+    };
+
+    class GuardProver
+    {
+    public:
+        GuardProver(const MicroControlFlowGraph& cfg, const MicroPassHelpers::MicroDomTree& dom, const MicroSsaState& ssa, const MicroStorage& storage, const MicroOperandStorage& operands, std::span<const MicroRelocation> relocations, const Symbol* panicFunction) :
+            cfg_(cfg),
+            dom_(dom),
+            ssa_(ssa),
+            storage_(storage),
+            operands_(operands),
+            instrRefs_(cfg.instructionRefs())
+        {
+            indexBySlot_.assign(storage.slotCount(), K_INVALID_INDEX);
+            for (uint32_t i = 0; i < instrRefs_.size(); ++i)
+                indexBySlot_[instrRefs_[i].get()] = i;
+
+            // A direct call names its target in its relocation.
+            panicCalls_.assign(instrRefs_.size(), false);
+            for (const MicroRelocation& relocation : relocations)
+            {
+                if (relocation.targetSymbol != panicFunction)
+                    continue;
+                if (relocation.kind != MicroRelocation::Kind::LocalFunctionAddress && relocation.kind != MicroRelocation::Kind::ForeignFunctionAddress)
+                    continue;
+
+                const uint32_t index = indexOf(relocation.instructionRef);
+                if (index != K_INVALID_INDEX)
+                    panicCalls_[index] = true;
+            }
+        }
+
+        // A guard: a conditional jump whose fall-through block calls the
+        // safety panic helper and nothing else, then reaches the jump's own
+        // target without any other way in or out. A branch over any other
+        // call is the user's own code, whatever its condition looks like.
+        bool isGuardJump(const uint32_t index) const
+        {
+            const MicroInstr* inst = storage_.ptr(instrRefs_[index]);
+            if (!inst || inst->op != MicroInstrOpcode::JumpCond)
+                return false;
+            const MicroInstrOperand* ops = inst->ops(operands_);
+            if (!ops || ops[0].cpuCond == MicroCond::Unconditional)
+                return false;
+
+            const auto& succs = cfg_.successors(index);
+            if (succs.size() != 2 || succs[0] <= index + 1)
+                return false;
+
+            bool hasPanicCall = false;
+            for (uint32_t i = index + 1; i < succs[0]; ++i)
+            {
+                const MicroInstr* blockInst = storage_.ptr(instrRefs_[i]);
+                if (!blockInst || blockInst->op == MicroInstrOpcode::Label)
+                    return false;
+                const MicroInstrDef& info = MicroInstr::info(blockInst->op);
+                if (info.flags.has(MicroInstrFlagsE::JumpInstruction) || info.flags.has(MicroInstrFlagsE::TerminatorInstruction))
+                    return false;
+                if (!info.flags.has(MicroInstrFlagsE::IsCallInstruction))
+                    continue;
+                if (!panicCalls_[i])
+                    return false;
+                hasPanicCall = true;
+            }
+
+            return hasPanicCall;
+        }
+
+        // The instruction whose flags a jump reads, in the straight line before it.
+        uint32_t flagsDefinitionOf(const uint32_t jumpIndex) const
+        {
+            for (uint32_t step = 1; step <= K_FLAGS_SCAN && step <= jumpIndex; ++step)
+            {
+                const MicroInstr* inst = storage_.ptr(instrRefs_[jumpIndex - step]);
+                if (!inst || inst->op == MicroInstrOpcode::Label)
+                    return K_INVALID_INDEX;
+                const MicroInstrDef& info = MicroInstr::info(inst->op);
+                if (info.flags.has(MicroInstrFlagsE::IsCallInstruction) || info.flags.has(MicroInstrFlagsE::JumpInstruction))
+                    return K_INVALID_INDEX;
+                if (info.flags.has(MicroInstrFlagsE::DefinesCpuFlags))
+                    return jumpIndex - step;
+            }
+
+            return K_INVALID_INDEX;
+        }
+
+        bool proveGuard(const uint32_t jumpIndex, const uint32_t flagsIndex)
+        {
+            budget_ = K_PROOF_BUDGET;
+            assumed_.clear();
+
+            const MicroInstr*        jump     = storage_.ptr(instrRefs_[jumpIndex]);
+            const MicroInstr*        flagsDef = storage_.ptr(instrRefs_[flagsIndex]);
+            const MicroInstrOperand* jumpOps  = jump->ops(operands_);
+            const MicroInstrOperand* ops      = flagsDef->ops(operands_);
+            if (!jumpOps || !ops)
+                return false;
+
+            const MicroCond cond = jumpOps[0].cpuCond;
+            if (flagsDef->op == MicroInstrOpcode::CmpRegReg || flagsDef->op == MicroInstrOpcode::CmpRegImm)
+            {
+                Claim goal;
+                if (!compareClaim(goal, flagsIndex, cond))
+                    return false;
+                return prove(flagsIndex, goal);
+            }
+
+            return proveNoOverflow(flagsIndex, *flagsDef, ops, cond);
+        }
+
+    private:
+        MicroInstrRef refAt(const uint32_t index) const { return instrRefs_[index]; }
+
+        bool isJump(const uint32_t index) const
+        {
+            const MicroInstr* inst = storage_.ptr(instrRefs_[index]);
+            return inst && MicroInstr::info(inst->op).flags.has(MicroInstrFlagsE::JumpInstruction);
+        }
+
+        uint32_t indexOf(const MicroInstrRef ref) const
+        {
+            return ref.get() < indexBySlot_.size() ? indexBySlot_[ref.get()] : K_INVALID_INDEX;
+        }
+
+        // A value seen through the plain copies that forward it, as far as the
+        // copies move at least the bits the consumer reads. A constant load
+        // becomes the constant.
+        Operand operandOfValue(MicroReg reg, uint32_t valueId, const MicroOpBits bits) const
+        {
+            if (valueId == MicroSsaState::K_INVALID_VALUE)
+                return {};
+
+            for (uint32_t depth = 0; depth < K_COPY_DEPTH; ++depth)
+            {
+                const MicroSsaState::ValueInfo* info = ssa_.valueInfo(valueId);
+                if (!info || info->isPhi())
+                    break;
+                const MicroInstr* inst = storage_.ptr(info->instRef);
+                if (!inst)
+                    break;
+                const MicroInstrOperand* ops = inst->ops(operands_);
+                if (!ops)
+                    break;
+
+                if (inst->op == MicroInstrOpcode::LoadRegImm && getNumBits(ops[1].opBits) >= getNumBits(bits) && !ops[2].hasWideImmediateValue())
+                    return Operand::constant(ops[2].valueU64 & getBitsMask(bits));
+                if (inst->op == MicroInstrOpcode::ClearReg && getNumBits(ops[1].opBits) >= getNumBits(bits))
+                    return Operand::constant(0);
+                if (inst->op != MicroInstrOpcode::LoadRegReg || getNumBits(ops[2].opBits) < getNumBits(bits) || !ops[1].reg.isVirtual())
+                    break;
+
+                const MicroSsaState::ReachingDef src = ssa_.reachingDef(ops[1].reg, info->instRef);
+                if (!src.valid())
+                    break;
+                reg     = ops[1].reg;
+                valueId = src.valueId;
+            }
+
+            return {.reg = reg, .valueId = valueId};
+        }
+
+        Operand operandAt(const MicroReg reg, const MicroInstrRef atRef, const MicroOpBits bits) const
+        {
+            if (!reg.isVirtual())
+                return {};
+            return operandOfValue(reg, ssa_.reachingDef(reg, atRef).valueId, bits);
+        }
+
+        // The value a register holds once an instruction has run.
+        uint32_t valueAfter(const MicroReg reg, const MicroInstrRef instRef) const
+        {
+            uint32_t valueId = MicroSsaState::K_INVALID_VALUE;
+            if (ssa_.defValue(reg, instRef, valueId))
+                return valueId;
+            return ssa_.reachingDef(reg, instRef).valueId;
+        }
+
+        const MicroInstr* definitionOf(const Operand& operand, MicroInstrRef& outRef) const
+        {
+            if (operand.isConst)
+                return nullptr;
+            const MicroSsaState::ValueInfo* info = ssa_.valueInfo(operand.valueId);
+            if (!info || info->isPhi())
+                return nullptr;
+            outRef = info->instRef;
+            return storage_.ptr(info->instRef);
+        }
+
+        // What a value may hold, from the way it is computed alone.
+        Bounds boundsOf(const Operand& operand, const MicroOpBits bits, const uint32_t depth) const
+        {
+            const uint64_t mask = getBitsMask(bits);
+            if (operand.isConst)
+                return boundsFromUnsigned(operand.cst & mask, operand.cst & mask, bits);
+
+            const Bounds full = fullBounds(bits);
+            if (!operand.valid() || !depth)
+                return full;
+
+            const MicroSsaState::ValueInfo* info = ssa_.valueInfo(operand.valueId);
+            if (!info)
+                return full;
+
+            if (info->isPhi())
+            {
+                const MicroSsaState::PhiInfo* phi = ssa_.phiInfo(info->phiIndex);
+                if (!phi || phi->incomingValueIds.empty())
+                    return full;
+
+                Bounds merged{.ulo = mask, .uhi = 0, .slo = full.shi, .shi = full.slo};
+                for (const uint32_t incoming : phi->incomingValueIds)
+                {
+                    const Bounds b = boundsOf(operandOfValue(phi->reg, incoming, bits), bits, depth - 1);
+                    merged.ulo     = std::min(merged.ulo, b.ulo);
+                    merged.uhi     = std::max(merged.uhi, b.uhi);
+                    merged.slo     = std::min(merged.slo, b.slo);
+                    merged.shi     = std::max(merged.shi, b.shi);
+                }
+
+                return merged;
+            }
+
+            const MicroInstr* inst = storage_.ptr(info->instRef);
+            if (!inst)
+                return full;
+            const MicroInstrOperand* ops = inst->ops(operands_);
+            if (!ops)
+                return full;
+
+            switch (inst->op)
+            {
+                case MicroInstrOpcode::LoadZeroExtRegReg:
+                case MicroInstrOpcode::LoadZeroExtRegMem:
+                {
+                    // ops: [0] dst, [1] src/base, [2] dstBits, [3] srcBits
+                    if (getNumBits(ops[2].opBits) < getNumBits(bits))
+                        return full;
+                    Bounds b = boundsFromUnsigned(0, std::min(mask, getBitsMask(ops[3].opBits)), bits);
+                    if (inst->op == MicroInstrOpcode::LoadZeroExtRegReg)
+                    {
+                        const Bounds src = boundsOf(operandAt(ops[1].reg, info->instRef, ops[3].opBits), ops[3].opBits, depth - 1);
+                        b                = boundsFromUnsigned(src.ulo, src.uhi, bits);
+                    }
+                    return b;
+                }
+
+                case MicroInstrOpcode::OpBinaryRegImm:
+                {
+                    // ops: [0] dst (read-modify-write), [1] opBits, [2] microOp, [3] imm
+                    if (ops[3].hasWideImmediateValue())
+                        return full;
+                    const uint64_t imm = ops[3].valueU64 & mask;
+                    const bool     same = ops[1].opBits == bits;
+                    if (ops[2].microOp == MicroOp::And && getNumBits(ops[1].opBits) >= getNumBits(bits))
+                    {
+                        const Bounds in = boundsOf(operandAt(ops[0].reg, info->instRef, bits), bits, depth - 1);
+                        return boundsFromUnsigned(0, std::min(in.uhi, imm), bits);
+                    }
+                    if (!same)
+                        return full;
+                    if (ops[2].microOp == MicroOp::ModuloUnsigned && imm)
+                        return boundsFromUnsigned(0, imm - 1, bits);
+                    if (ops[2].microOp == MicroOp::ShiftRight && imm < getNumBits(bits))
+                    {
+                        const Bounds in = boundsOf(operandAt(ops[0].reg, info->instRef, bits), bits, depth - 1);
+                        return boundsFromUnsigned(in.ulo >> imm, in.uhi >> imm, bits);
+                    }
+                    if (ops[2].microOp == MicroOp::Add)
+                    {
+                        const Bounds in = boundsOf(operandAt(ops[0].reg, info->instRef, bits), bits, depth - 1);
+                        if (in.uhi <= mask - imm)
+                            return boundsFromUnsigned(in.ulo + imm, in.uhi + imm, bits);
+                    }
+                    return full;
+                }
+
+                case MicroInstrOpcode::OpBinaryRegReg:
+                {
+                    // ops: [0] dst (read-modify-write), [1] src, [2] opBits, [3] microOp
+                    if (ops[3].microOp != MicroOp::And || getNumBits(ops[2].opBits) < getNumBits(bits))
+                        return full;
+                    const Bounds lhs = boundsOf(operandAt(ops[0].reg, info->instRef, bits), bits, depth - 1);
+                    const Bounds rhs = boundsOf(operandAt(ops[1].reg, info->instRef, bits), bits, depth - 1);
+                    return boundsFromUnsigned(0, std::min(lhs.uhi, rhs.uhi), bits);
+                }
+
+                default:
+                    return full;
+            }
+        }
+
+        Bounds boundsOf(const Operand& operand, const MicroOpBits bits) const { return boundsOf(operand, bits, K_RANGE_DEPTH); }
+
+        // The claim of `cmp` at `flagsIndex` followed by a jump taken on `cond`.
+        bool compareClaim(Claim& out, const uint32_t flagsIndex, const MicroCond cond) const
+        {
+            const MicroInstrRef      cmpRef = refAt(flagsIndex);
+            const MicroInstr*        inst   = storage_.ptr(cmpRef);
+            const MicroInstrOperand* ops    = inst ? inst->ops(operands_) : nullptr;
+            if (!ops)
+                return false;
+
+            Operand     lhs;
+            Operand     rhs;
+            MicroOpBits bits;
+            if (inst->op == MicroInstrOpcode::CmpRegReg)
+            {
+                // ops: [0] lhs, [1] rhs, [2] opBits
+                bits = ops[2].opBits;
+                lhs  = operandAt(ops[0].reg, cmpRef, bits);
+                rhs  = operandAt(ops[1].reg, cmpRef, bits);
+            }
+            else if (inst->op == MicroInstrOpcode::CmpRegImm)
+            {
+                // ops: [0] lhs, [1] opBits, [2] imm
+                if (ops[2].hasWideImmediateValue())
+                    return false;
+                bits = ops[1].opBits;
+                lhs  = operandAt(ops[0].reg, cmpRef, bits);
+                rhs  = Operand::constant(ops[2].valueU64 & getBitsMask(bits));
+            }
+            else
+            {
+                return false;
+            }
+
+            if (getBitsMask(bits) == 0 || !lhs.valid() || !rhs.valid())
+                return false;
+            return claimFromCond(out, cond, lhs, rhs, bits);
+        }
+
+        // The claim that holds once control crossed the edge pred -> succ.
+        bool edgeClaim(Claim& out, const uint32_t pred, const uint32_t succ) const
+        {
+            const MicroInstr* inst = storage_.ptr(refAt(pred));
+            if (!inst || inst->op != MicroInstrOpcode::JumpCond)
+                return false;
+            const MicroInstrOperand* ops = inst->ops(operands_);
+            if (!ops || ops[0].cpuCond == MicroCond::Unconditional)
+                return false;
+
+            const auto& succs = cfg_.successors(pred);
+            if (succs.size() != 2)
+                return false;
+
+            MicroCond cond = ops[0].cpuCond;
+            if (succ != succs[0] && !negateCond(cond, cond))
+                return false;
+
+            const uint32_t flagsIndex = flagsDefinitionOf(pred);
+            if (flagsIndex == K_INVALID_INDEX)
+                return false;
+            return compareClaim(out, flagsIndex, cond);
+        }
+
+        bool prove(const uint32_t index, const Claim& goal)
+        {
+            if (!budget_)
+                return false;
+            --budget_;
+
+            if (holdsBetween(goal.rel, boundsOf(goal.lhs, goal.bits), boundsOf(goal.rhs, goal.bits)))
+                return true;
+            if (proveByDefinition(index, goal))
+                return true;
+            return proveByDominatingEdges(index, goal);
+        }
+
+        bool proveNonNegative(const uint32_t index, const Operand& operand, const MicroOpBits bits)
+        {
+            return prove(index, {Relation::SLe, Operand::constant(0), operand, bits});
+        }
+
+        // Goals that follow from how one of their operands is computed, through
+        // sub-goals on its input.
+        bool proveByDefinition(const uint32_t index, const Claim& goal)
+        {
+            MicroInstrRef     defRef = MicroInstrRef::invalid();
+            const MicroInstr* def    = definitionOf(goal.rhs, defRef);
+
+            // An index that only counts up from a non-negative start stays
+            // non-negative as long as the step cannot wrap it around, and a
+            // value that is below anything cannot wrap when it steps by one.
+            if (goal.rel == Relation::SLe && goal.lhs.isConst && goal.lhs.cst == 0 && def && def->op == MicroInstrOpcode::OpBinaryRegImm)
+            {
+                const MicroInstrOperand* ops = def->ops(operands_);
+                const uint32_t           at  = indexOf(defRef);
+                if (ops && at != K_INVALID_INDEX && ops[1].opBits == goal.bits && ops[2].microOp == MicroOp::Add && !ops[3].hasWideImmediateValue())
+                {
+                    const uint64_t step = ops[3].valueU64 & getBitsMask(goal.bits);
+                    if (step && step < signBitOf(goal.bits))
+                    {
+                        const Operand input = operandAt(ops[0].reg, defRef, goal.bits);
+                        const Operand limit = Operand::constant(signBitOf(goal.bits) - 1 - step);
+                        return input.valid() &&
+                               proveNonNegative(at, input, goal.bits) &&
+                               prove(at, {Relation::SLe, input, limit, goal.bits});
+                    }
+                }
+            }
+
+            def = definitionOf(goal.lhs, defRef);
+            if (!def || !goal.rhs.isConst)
+                return false;
+
+            const MicroInstrOperand* ops = def->ops(operands_);
+            if (!ops)
+                return false;
+
+            // A sign-extended index below a positive bound: the narrow value is
+            // non-negative and below the same bound.
+            if (def->op == MicroInstrOpcode::LoadSignedExtRegReg && ops[2].opBits == goal.bits && getNumBits(ops[3].opBits) < getNumBits(goal.bits))
+            {
+                const MicroOpBits narrow  = ops[3].opBits;
+                const Operand     input   = operandAt(ops[1].reg, defRef, narrow);
+                const uint64_t    bound   = goal.rhs.cst;
+                const uint64_t    signBit = signBitOf(narrow);
+                if (!input.valid())
+                    return false;
+
+                if (goal.rel == Relation::ULt || goal.rel == Relation::ULe)
+                {
+                    if (!proveNonNegative(index, input, narrow))
+                        return false;
+                    if (bound >= signBit)
+                        return true;
+                    const Relation rel = goal.rel == Relation::ULt ? Relation::SLt : Relation::SLe;
+                    return prove(index, {rel, input, Operand::constant(bound), narrow});
+                }
+            }
+
+            // A zero-extended index below a bound the narrow width can hold.
+            if (def->op == MicroInstrOpcode::LoadZeroExtRegReg && ops[2].opBits == goal.bits && getNumBits(ops[3].opBits) < getNumBits(goal.bits))
+            {
+                const MicroOpBits narrow = ops[3].opBits;
+                const Operand     input  = operandAt(ops[1].reg, defRef, narrow);
+                if (input.valid() && (goal.rel == Relation::ULt || goal.rel == Relation::ULe) && goal.rhs.cst <= getBitsMask(narrow))
+                    return prove(index, {goal.rel, input, goal.rhs, narrow});
+            }
+
+            return false;
+        }
+
+        bool mentionsPhiAt(const uint32_t join, const Operand& operand) const
+        {
+            if (operand.isConst)
+                return false;
+            const MicroSsaState::ReachingDef reach = ssa_.reachingDef(operand.reg, refAt(join));
+            return reach.valid() && reach.valueId == operand.valueId && reach.isPhi;
+        }
+
+        // The operand as it flows into `join` from `pred`: the phi input when
+        // the operand is the join's phi, itself when it was already live.
+        bool substituteAlongEdge(Operand& inOut, const uint32_t join, const uint32_t pred, const MicroOpBits bits) const
+        {
+            if (inOut.isConst)
+                return true;
+
+            const MicroSsaState::ReachingDef reach = ssa_.reachingDef(inOut.reg, refAt(join));
+            if (!reach.valid() || reach.valueId != inOut.valueId)
+                return false;
+
+            inOut = operandOfValue(inOut.reg, valueAfter(inOut.reg, refAt(pred)), bits);
+            return inOut.valid();
+        }
+
+        bool proveAtJoin(const uint32_t join, const Claim& goal)
+        {
+            for (const auto& [assumedJoin, assumedGoal] : assumed_)
+            {
+                if (assumedJoin == join && sameClaim(assumedGoal, goal))
+                    return true;
+            }
+
+            assumed_.emplace_back(join, goal);
+            bool proven = true;
+            for (const uint32_t pred : cfg_.predecessors(join))
+            {
+                // An edge that is never taken has nothing to prove.
+                if (!dom_.reachable(pred))
+                    continue;
+
+                Claim edgeGoal = goal;
+                if (!substituteAlongEdge(edgeGoal.lhs, join, pred, goal.bits) ||
+                    !substituteAlongEdge(edgeGoal.rhs, join, pred, goal.bits) ||
+                    !proveAlongEdge(pred, join, edgeGoal))
+                {
+                    proven = false;
+                    break;
+                }
+            }
+
+            assumed_.pop_back();
+            return proven;
+        }
+
+        bool proveAlongEdge(const uint32_t pred, const uint32_t succ, const Claim& goal)
+        {
+            Claim fact;
+            if (edgeClaim(fact, pred, succ) && implies(succ, fact, goal))
+                return true;
+            return prove(pred, goal);
+        }
+
+        bool proveByDominatingEdges(const uint32_t index, const Claim& goal)
+        {
+            // Straight-line steps are free: from a reachable instruction they
+            // end at the entry or at a join. Branch edges and joins are not.
+            uint32_t cur = index;
+            while (budget_ && dom_.reachable(cur))
+            {
+                const auto& preds = cfg_.predecessors(cur);
+                if (preds.empty())
+                    return false;
+
+                if (preds.size() == 1)
+                {
+                    if (preds[0] + 1 != cur || isJump(preds[0]))
+                    {
+                        --budget_;
+                        Claim fact;
+                        if (edgeClaim(fact, preds[0], cur) && implies(cur, fact, goal))
+                            return true;
+                    }
+
+                    cur = preds[0];
+                    continue;
+                }
+
+                --budget_;
+
+                if ((mentionsPhiAt(cur, goal.lhs) || mentionsPhiAt(cur, goal.rhs)) && proveAtJoin(cur, goal))
+                    return true;
+
+                const uint32_t idom = cur < dom_.idom.size() ? dom_.idom[cur] : MicroPassHelpers::MicroDomTree::K_INVALID_NODE;
+                if (idom == MicroPassHelpers::MicroDomTree::K_INVALID_NODE || idom == cur)
+                    return false;
+                cur = idom;
+            }
+
+            return false;
+        }
+
+        // Narrows what `operand` may hold with what `fact` says about it. A fact
+        // that cannot hold leaves the bounds empty.
+        void narrowWithFact(Bounds& b, const Claim& fact, const Operand& operand) const
+        {
+            const MicroOpBits bits    = fact.bits;
+            const Bounds      full    = fullBounds(bits);
+            const bool        isLhs   = sameOperand(fact.lhs, operand);
+            const Bounds      other   = boundsOf(isLhs ? fact.rhs : fact.lhs, bits);
+            const Operand&    otherOp = isLhs ? fact.rhs : fact.lhs;
+
+            switch (fact.rel)
+            {
+                case Relation::ULt:
+                    if (isLhs ? other.uhi == 0 : other.ulo == full.uhi)
+                        b.uhi = 0, b.ulo = 1;
+                    else if (isLhs)
+                        b.uhi = std::min(b.uhi, other.uhi - 1);
+                    else
+                        b.ulo = std::max(b.ulo, other.ulo + 1);
+                    break;
+
+                case Relation::ULe:
+                    if (isLhs)
+                        b.uhi = std::min(b.uhi, other.uhi);
+                    else
+                        b.ulo = std::max(b.ulo, other.ulo);
+                    break;
+
+                case Relation::SLt:
+                    if (isLhs ? other.shi == full.slo : other.slo == full.shi)
+                        b.shi = full.slo, b.slo = full.shi;
+                    else if (isLhs)
+                        b.shi = std::min(b.shi, other.shi - 1);
+                    else
+                        b.slo = std::max(b.slo, other.slo + 1);
+                    break;
+
+                case Relation::SLe:
+                    if (isLhs)
+                        b.shi = std::min(b.shi, other.shi);
+                    else
+                        b.slo = std::max(b.slo, other.slo);
+                    break;
+
+                case Relation::Eq:
+                    b.ulo = std::max(b.ulo, other.ulo);
+                    b.uhi = std::min(b.uhi, other.uhi);
+                    b.slo = std::max(b.slo, other.slo);
+                    b.shi = std::min(b.shi, other.shi);
+                    break;
+
+                case Relation::Ne:
+                    // Only an excluded end of the interval narrows it.
+                    if (otherOp.isConst && b.ulo < b.uhi)
+                    {
+                        if (b.ulo == otherOp.cst)
+                            ++b.ulo;
+                        else if (b.uhi == otherOp.cst)
+                            --b.uhi;
+                    }
+                    break;
+            }
+
+            tighten(b, bits);
+        }
+
+        // Whether `fact`, holding at `index`, implies `goal` there.
+        bool implies(const uint32_t index, const Claim& fact, const Claim& goal)
+        {
+            if (fact.bits != goal.bits)
+                return false;
+
+            if (sameOperand(fact.lhs, goal.lhs) && sameOperand(fact.rhs, goal.rhs))
+            {
+                if (impliesSameOrder(fact.rel, goal.rel))
+                    return true;
+
+                // Signed and unsigned order agree on non-negative values: below
+                // a non-negative bound, a value is non-negative too.
+                if ((fact.rel == Relation::SLt && goal.rel == Relation::ULt) || (fact.rel == Relation::SLe && goal.rel == Relation::ULe))
+                    return proveNonNegative(index, goal.lhs, goal.bits);
+                if ((fact.rel == Relation::ULt && goal.rel == Relation::SLt) || (fact.rel == Relation::ULe && goal.rel == Relation::SLe))
+                    return proveNonNegative(index, goal.rhs, goal.bits);
+            }
+
+            if (sameOperand(fact.lhs, goal.rhs) && sameOperand(fact.rhs, goal.lhs))
+            {
+                if (goal.rel == Relation::Ne && (fact.rel == Relation::ULt || fact.rel == Relation::SLt || fact.rel == Relation::Ne))
+                    return true;
+                if (goal.rel == Relation::Eq && fact.rel == Relation::Eq)
+                    return true;
+            }
+
+            // The fact bounds one operand of the goal; the goal may follow from
+            // that bound and what is known of the other operand.
+            for (const bool onLhs : {true, false})
+            {
+                const Operand& operand = onLhs ? goal.lhs : goal.rhs;
+                if (operand.isConst || (!sameOperand(fact.lhs, operand) && !sameOperand(fact.rhs, operand)))
+                    continue;
+
+                Bounds narrowed = boundsOf(operand, goal.bits);
+                narrowWithFact(narrowed, fact, operand);
+                if (narrowed.empty())
+                    continue;
+
+                const Bounds other = boundsOf(onLhs ? goal.rhs : goal.lhs, goal.bits);
+                if (onLhs ? holdsBetween(goal.rel, narrowed, other) : holdsBetween(goal.rel, other, narrowed))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Overflow guards: `op; jae` (no carry, no borrow) and `op; jno`.
+        bool proveNoOverflow(const uint32_t flagsIndex, const MicroInstr& def, const MicroInstrOperand* ops, const MicroCond cond)
+        {
+            if (cond != MicroCond::AboveOrEqual && cond != MicroCond::NotOverflow)
+                return false;
+
+            const MicroInstrRef defRef = refAt(flagsIndex);
+            if (def.op == MicroInstrOpcode::OpBinaryRegImm)
+            {
+                // ops: [0] dst (read-modify-write), [1] opBits, [2] microOp, [3] imm
+                const MicroOpBits bits = ops[1].opBits;
+                if (getBitsMask(bits) == 0 || ops[3].hasWideImmediateValue())
+                    return false;
+
+                const Operand  input   = operandAt(ops[0].reg, defRef, bits);
+                const uint64_t mask    = getBitsMask(bits);
+                const uint64_t imm     = ops[3].valueU64 & mask;
+                const uint64_t signBit = signBitOf(bits);
+                if (!input.valid())
+                    return false;
+
+                switch (ops[2].microOp)
+                {
+                    case MicroOp::Add:
+                        if (cond == MicroCond::AboveOrEqual)
+                            return prove(flagsIndex, {Relation::ULe, input, Operand::constant(mask - imm), bits});
+                        if (imm < signBit)
+                            return prove(flagsIndex, {Relation::SLe, input, Operand::constant(signBit - 1 - imm), bits});
+                        return false;
+
+                    case MicroOp::Subtract:
+                        if (cond == MicroCond::AboveOrEqual)
+                            return prove(flagsIndex, {Relation::ULe, Operand::constant(imm), input, bits});
+                        if (imm < signBit)
+                            return prove(flagsIndex, {Relation::SLe, Operand::constant(signBit + imm), input, bits});
+                        return false;
+
+                    default:
+                        return false;
+                }
+            }
+
+            if (def.op == MicroInstrOpcode::OpBinaryRegReg)
+            {
+                // ops: [0] dst (read-modify-write), [1] src, [2] opBits, [3] microOp
+                const MicroOpBits bits = ops[2].opBits;
+                if (getBitsMask(bits) == 0)
+                    return false;
+
+                const Operand lhs = operandAt(ops[0].reg, defRef, bits);
+                const Operand rhs = operandAt(ops[1].reg, defRef, bits);
+                if (!lhs.valid() || !rhs.valid())
+                    return false;
+
+                // Unsigned subtraction does not borrow when the subtrahend is no
+                // larger, which a dominating compare often says outright.
+                if (ops[3].microOp == MicroOp::Subtract && cond == MicroCond::AboveOrEqual)
+                    return prove(flagsIndex, {Relation::ULe, rhs, lhs, bits});
+
+                const Bounds   a       = boundsOf(lhs, bits);
+                const Bounds   b       = boundsOf(rhs, bits);
+                const uint64_t signBit = signBitOf(bits);
+                switch (ops[3].microOp)
+                {
+                    case MicroOp::Add:
+                        if (cond == MicroCond::AboveOrEqual)
+                            return a.uhi <= getBitsMask(bits) - b.uhi;
+                        return a.slo >= 0 && b.slo >= 0 && a.uhi < signBit && b.uhi < signBit - a.uhi;
+
+                    case MicroOp::Subtract:
+                        return a.slo >= 0 && b.slo >= 0;
+
+                    case MicroOp::MultiplySigned:
+                    case MicroOp::MultiplyUnsigned:
+                        return a.slo >= 0 && b.slo >= 0 && (a.uhi == 0 || b.uhi < signBit / a.uhi);
+
+                    default:
+                        return false;
+                }
+            }
+
+            return false;
+        }
+
+        const MicroControlFlowGraph&        cfg_;
+        const MicroPassHelpers::MicroDomTree& dom_;
+        const MicroSsaState&                ssa_;
+        const MicroStorage&                 storage_;
+        const MicroOperandStorage&          operands_;
+        std::span<const MicroInstrRef>      instrRefs_;
+        std::vector<uint32_t>               indexBySlot_;
+        std::vector<bool>                   panicCalls_;
+        std::vector<std::pair<uint32_t, Claim>> assumed_;
+        uint32_t                            budget_ = 0;
+    };
+}
+
+Result MicroSafetyCheckEliminationPass::run(MicroPassContext& context)
+{
+    SWC_MEM_SCOPE("Backend/MicroLower/SafetyCheckElim");
+    SWC_ASSERT(context.instructions != nullptr);
+    SWC_ASSERT(context.operands != nullptr);
+    if (!context.safetyPanicFunction)
+        return Result::Continue;
+
+    MicroStorage&        storage  = *context.instructions;
+    MicroOperandStorage& operands = *context.operands;
+
+    MicroSsaState        localSsaState;
+    const MicroSsaState* ssaState = MicroSsaState::ensureFor(context, localSsaState);
+    if (!ssaState || !ssaState->isValid())
+        return Result::Continue;
+
+    const MicroControlFlowGraph& cfg = context.builder->controlFlowGraph();
+    if (cfg.hasUnsupportedControlFlowForCfgLiveness() || !cfg.supportsDeadCodeLiveness())
+        return Result::Continue;
+
+    const uint32_t n = cfg.instructionCount();
+    if (n == 0)
+        return Result::Continue;
+
+    const uint32_t entry = MicroPassHelpers::findSingleCfgEntry(cfg);
+    if (entry == MicroPassHelpers::MicroDomTree::K_INVALID_NODE)
+        return Result::Continue;
+
+    const MicroPassHelpers::MicroDomTree dom = MicroPassHelpers::computeInstructionDominators(cfg, entry);
+    const auto                           instrRefs = cfg.instructionRefs();
+
+    GuardProver            prover(cfg, dom, *ssaState, storage, operands, context.builder->codeRelocations(), context.safetyPanicFunction);
+    std::vector<GuardPlan> plans;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (!dom.reachable(i) || !prover.isGuardJump(i))
+            continue;
+
+        const uint32_t flagsIndex = prover.flagsDefinitionOf(i);
+        if (flagsIndex == K_INVALID_INDEX || !prover.proveGuard(i, flagsIndex))
+            continue;
+
+        // A compare that only feeds this jump goes with it. The jump's target is
+        // otherwise reached through the panic call, which clobbers the flags, so
+        // nothing past it can be reading them.
+        GuardPlan         plan;
+        const MicroInstr* flagsDef = storage.ptr(instrRefs[flagsIndex]);
+        plan.jumpRef               = instrRefs[i];
+        if (flagsIndex + 1 == i && (flagsDef->op == MicroInstrOpcode::CmpRegReg || flagsDef->op == MicroInstrOpcode::CmpRegImm))
+            plan.cmpRef = instrRefs[flagsIndex];
+        plans.push_back(plan);
+    }
+
+    if (plans.empty())
+        return Result::Continue;
+
+    for (const GuardPlan& plan : plans)
+    {
+        MicroInstr&        jump = *storage.ptr(plan.jumpRef);
+        MicroInstrOperand* ops  = jump.ops(operands);
+        ops[0].cpuCond          = MicroCond::Unconditional;
+        if (plan.cmpRef.isValid())
+            storage.erase(plan.cmpRef);
+    }
+
+    context.statsSafetyGuardsRemoved += plans.size();
+    context.passChanged = true;
+    return Result::Continue;
+}
+
+SWC_END_NAMESPACE();
@@ -0,0 +1,32 @@
+#pragma once
+#include "Backend/Micro/MicroPass.h"
+#include "Support/Core/Result.h"
+
+SWC_BEGIN_NAMESPACE();
+
+// Pre-RA removal of runtime-safety guards the IR already proves.
+//
+// A guard is the shape CodeGenSafety emits for bound, null and overflow
+// checks: a conditional jump over a block whose only call is the safety panic
+// helper (`MicroPassContext::safetyPanicFunction`), to the label that block
+// falls into. When the jump's condition is proven true the
+// jump becomes unconditional, and branch simplification then drops the panic
+// block as unreachable.
+//
+// A condition is proven from the values it compares, never from the panic
+// itself (a panic returns when the user installed a hook):
+//   - by value ranges: constants, masks, zero-extensions, shifts and moduli;
+//   - by the branches the guard sits behind: walking up the dominator tree,
+//     every edge reached through a single predecessor carries the condition of
+//     its jump, and at a join the goal is proven along every incoming edge,
+//     through the phis of the values it names. The loop header is such a join:
+//     the pre-test proves `i < n` on entry and the rotated latch test on the back
+//     edge, so a `for i in 0..<n` index is bound-checked once, by the loop itself.
+class MicroSafetyCheckEliminationPass final : public MicroPass
+{
+public:
+    std::string_view name() const override { return "safety-check-elim"; }
+    Result           run(MicroPassContext& context) override;
+};
+
+SWC_END_NAMESPACE();
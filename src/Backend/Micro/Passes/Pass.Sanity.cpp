@@ -11,7 +11,9 @@
 #include "Backend/Sanitizer/Checks/Check.UseAfterFree.h"
 #include "Backend/Sanitizer/Checks/Check.UseAfterMove.h"
 #include "Backend/Sanitizer/Sanitizer.h"
+#include "Main/Stats.h"
 #include "Support/Core/SmallVector.h"
+#include "Support/Core/Timer.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -49,10 +51,21 @@ Result MicroSanityPass::run(MicroPassContext& context)
     // The reported error fails the build (or is matched by a test's expected-error
     // marker); a function that legitimately produced no code because it errored is
     // skipped by the backend's missing-code validation.
-    Sanitizer sanitizer(context);
-    if (sanitizer.run(enabledChecks.span()))
-        return Result::Error;
-    return Result::Continue;
+    const Timer::Tick startTick = Stats::enabledRuntime() ? Timer::Clock::now() : Timer::Tick{};
+
+    Sanitizer  sanitizer(context);
+    const bool found = sanitizer.run(enabledChecks.span());
+
+    if (Stats::enabledRuntime())
+    {
+        const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count();
+        Stats&         stats      = Stats::get();
+        stats.numSanitizedFunctions.add(1);
+        stats.timeSanitizer.add(durationNs);
+        Stats::setMax(durationNs, stats.timeSanitizerMaxFunction);
+    }
+
+    return found ? Result::Error : Result::Continue;
 }
 
 SWC_END_NAMESPACE();
@@ -430,7 +430,7 @@ Result MicroValueNumberingPass::run(MicroPassContext& context)
             continue;
 
         // A >64-bit immediate would need extra key words; too rare to matter.
-        if (shape.hasImmediate && ops[shape.immediateSlot].valueInt.bitWidth() > 64)
+        if (shape.hasImmediate && ops[shape.immediateSlot].hasWideImmediateValue())
             continue;
 
         // A load through the frame is mem2reg's, and a RIP-relative one reads
@@ -714,13 +714,7 @@ Result NativeBackendBuilder::run()
             stage.emplace(ctx_, ScopedTimedLog::Stage::Build);
 
         SWC_RESULT(prepare());
-        if (stage)
-        {
-            Utf8 buildStat = ScopedTimedLog::formatStatCount(ctx_, compiler_->nativeCodeSegment().size(), "function");
-            if (!compiler_->lastArtifactLabel().empty())
-                buildStat = ScopedTimedLog::joinStatItems(ctx_, {buildStat, ScopedTimedLog::formatStatName(ctx_, compiler_->lastArtifactLabel())});
-            stage->setStat(std::move(buildStat));
-        }
+        reportPreparedCode(stage ? &*stage : nullptr);
         SWC_RESULT(artifactBuilder.build());
         SWC_RESULT(buildObjects());
 
@@ -753,13 +747,7 @@ Result NativeBackendBuilder::prepareForLink()
         if (ScopedTimedLog::isOutputEnabled(ctx_, ScopedTimedLog::Stage::Build))
             stage.emplace(ctx_, ScopedTimedLog::Stage::Build);
         SWC_RESULT(prepare());
-        if (stage)
-        {
-            Utf8 buildStat = ScopedTimedLog::formatStatCount(ctx_, compiler_->nativeCodeSegment().size(), "function");
-            if (!compiler_->lastArtifactLabel().empty())
-                buildStat = ScopedTimedLog::joinStatItems(ctx_, {buildStat, ScopedTimedLog::formatStatName(ctx_, compiler_->lastArtifactLabel())});
-            stage->setStat(std::move(buildStat));
-        }
+        reportPreparedCode(stage ? &*stage : nullptr);
         SWC_RESULT(artifactBuilder.build());
         SWC_RESULT(buildObjects());
     }
@@ -808,6 +796,28 @@ Result NativeBackendBuilder::runExistingArtifact()
     return runGeneratedArtifact();
 }
 
+// The stage line names the artifact and how much machine code goes into it, so that a change in
+// code generation shows up per module.
+void NativeBackendBuilder::reportPreparedCode(ScopedTimedLog* stage) const
+{
+    size_t codeSize = 0;
+    for (const NativeFunctionInfo& info : functionInfos)
+        codeSize += info.machineCode ? info.machineCode->bytes.size() : 0;
+
+    if (Stats::enabledRuntime())
+        Stats::get().numNativeCodeBytes.add(codeSize);
+
+    if (!stage)
+        return;
+
+    std::vector<Utf8> items;
+    items.push_back(ScopedTimedLog::formatStatCount(ctx_, compiler_->nativeCodeSegment().size(), "function"));
+    items.push_back(ScopedTimedLog::formatStatSize(ctx_, codeSize, "code"));
+    if (!compiler_->lastArtifactLabel().empty())
+        items.push_back(ScopedTimedLog::formatStatName(ctx_, compiler_->lastArtifactLabel()));
+    stage->setStat(ScopedTimedLog::joinStatItems(ctx_, items));
+}
+
 Result NativeBackendBuilder::prepare()
 {
     runtimeDependencies.clear();
@@ -243,6 +243,7 @@ private:
     Result      buildObjects();
     Result      runGeneratedArtifact();
     Result      runAfterLink();
+    void        reportPreparedCode(ScopedTimedLog* stage) const;
 
     TaskContext             ctx_;
     CompilerInstance*       compiler_       = nullptr;
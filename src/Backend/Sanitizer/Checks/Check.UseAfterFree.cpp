@@ -32,8 +32,8 @@ void UseAfterFreeCheck::run(Sanitizer& sanitizer, const SanitizerState& state, c
             if (!((freesMask >> i) & 1))
                 continue;
 
-            const SanitizerRegInfo* argInfo = Sanitizer::regInfo(state, callConv.intArgRegs[i]);
-            if (argInfo && argInfo->hasOriginSlot && state.freedPtrSlots.contains(argInfo->originSlot))
+            const SanitizerRegInfo* argInfo = sanitizer.regInfo(state, callConv.intArgRegs[i]);
+            if (argInfo && argInfo->hasOriginSlot && sanitizer.isFreedPtrSlot(state, argInfo->originSlot))
             {
                 sanitizer.report(inst, DiagnosticId::sanity_err_double_free);
                 return;
@@ -50,8 +50,8 @@ void UseAfterFreeCheck::run(Sanitizer& sanitizer, const SanitizerState& state, c
     if (inst.op == MicroInstrOpcode::LoadAddrRegMem || inst.op == MicroInstrOpcode::LoadAddrAmcRegMem)
         return;
 
-    const SanitizerRegInfo* baseInfo = Sanitizer::regInfo(state, ops[def.memBaseOperandIndex].reg);
-    if (baseInfo && baseInfo->hasOriginSlot && state.freedPtrSlots.contains(baseInfo->originSlot))
+    const SanitizerRegInfo* baseInfo = sanitizer.regInfo(state, ops[def.memBaseOperandIndex].reg);
+    if (baseInfo && baseInfo->hasOriginSlot && sanitizer.isFreedPtrSlot(state, baseInfo->originSlot))
         sanitizer.report(inst, DiagnosticId::sanity_err_use_after_free);
 }
 
@@ -63,6 +63,9 @@ bool Sanitizer::run(std::span<SanitizerCheck* const> checks)
 
     cfg_ = &cfg;
     inState_.assign(n, {});
+    regIndex_.clear();
+    slotIndices_.clear();
+    slotOffsets_.clear();
     reached_.assign(n, 0);
     inWorklist_.assign(n, 0);
 
@@ -143,7 +146,7 @@ bool Sanitizer::run(std::span<SanitizerCheck* const> checks)
         worklist.pop_back();
         inWorklist_[head] = 0;
 
-        walkChain(head, inState_[head], {}, &worklist, steps);
+        walkChain(head, {}, &worklist, steps);
     }
 
     // Apply the checks only on the converged states, walking each reached chain with
@@ -157,17 +160,22 @@ bool Sanitizer::run(std::span<SanitizerCheck* const> checks)
     for (uint32_t i = 0; i < n; i++)
     {
         if (isHead_[i] && reached_[i])
-            walkChain(i, inState_[i], checks, nullptr, checkSteps);
+            walkChain(i, checks, nullptr, checkSteps);
     }
 
     return reported_;
 }
 
-void Sanitizer::walkChain(uint32_t head, SanitizerState cur, std::span<SanitizerCheck* const> checks, std::vector<uint32_t>* worklist, uint64_t& steps)
+void Sanitizer::walkChain(uint32_t head, std::span<SanitizerCheck* const> checks, std::vector<uint32_t>* worklist, uint64_t& steps)
 {
     const MicroControlFlowGraph& cfg   = *cfg_;
     uint32_t                     index = head;
 
+    // Walk on a copy: propagating to a loop header can join into the head being walked.
+    // Assigning into the member state reuses its storage from the previous chain.
+    chainState_         = inState_[head];
+    SanitizerState& cur = chainState_;
+
     for (;;)
     {
         steps++;
@@ -228,10 +236,10 @@ void Sanitizer::walkChain(uint32_t head, SanitizerState cur, std::span<Sanitizer
         {
             if (!worklist)
                 continue;
-            SanitizerState edge = cur;
-            dropZeros(edge);
-            edge.flagsSubject = MicroReg::invalid();
-            propagate(edge, s, *worklist);
+            edgeState_ = cur;
+            dropZeros(edgeState_);
+            edgeState_.flagsSubject = MicroReg::invalid();
+            propagate(edgeState_, s, *worklist);
         }
         return;
     }
@@ -253,26 +261,58 @@ SanitizerValue Sanitizer::getReg(const SanitizerState& state, MicroReg reg) cons
 {
     if (stackBaseReg_.isValid() && reg == stackBaseReg_)
         return SanitizerValue::makeStackAddr(0);
-    const auto it = state.regs.find(reg.packed);
-    return it == state.regs.end() ? SanitizerValue{} : it->second.value;
+    const SanitizerRegInfo* info = findReg(state, reg);
+    return info ? info->value : SanitizerValue{};
 }
 
-const SanitizerRegInfo* Sanitizer::findReg(const SanitizerState& state, MicroReg reg)
+const SanitizerRegInfo* Sanitizer::findReg(const SanitizerState& state, MicroReg reg) const
 {
-    const auto it = state.regs.find(reg.packed);
-    return it == state.regs.end() ? nullptr : &it->second;
+    const uint32_t index = regIndex_.find(reg);
+    return index == MicroDenseRegIndex::K_INVALID_INDEX ? nullptr : state.regs.find(index);
 }
 
 void Sanitizer::setReg(SanitizerState& state, MicroReg reg, const SanitizerRegInfo& info)
 {
     if (reg.isValid())
-        state.regs[reg.packed] = info;
+        state.regs.set(regIndex_.ensure(reg), info);
 }
 
 void Sanitizer::setRegValue(SanitizerState& state, MicroReg reg, const SanitizerValue& value)
 {
     if (reg.isValid())
-        state.regs[reg.packed] = SanitizerRegInfo{value};
+        state.regs.set(regIndex_.ensure(reg), SanitizerRegInfo{value});
+}
+
+uint32_t Sanitizer::findSlot(int64_t slot) const
+{
+    const auto it = slotIndices_.find(slot);
+    return it == slotIndices_.end() ? MicroDenseRegIndex::K_INVALID_INDEX : it->second;
+}
+
+uint32_t Sanitizer::ensureSlot(int64_t slot)
+{
+    const auto [it, inserted] = slotIndices_.try_emplace(slot, static_cast<uint32_t>(slotOffsets_.size()));
+    if (inserted)
+        slotOffsets_.push_back(slot);
+    return it->second;
+}
+
+SanitizerValue Sanitizer::getSlot(const SanitizerState& state, int64_t slot) const
+{
+    const uint32_t        index = findSlot(slot);
+    const SanitizerValue* value = index == MicroDenseRegIndex::K_INVALID_INDEX ? nullptr : state.stack.find(index);
+    return value ? *value : SanitizerValue{};
+}
+
+void Sanitizer::setSlot(SanitizerState& state, int64_t slot, const SanitizerValue& value)
+{
+    state.stack.set(ensureSlot(slot), value);
+}
+
+bool Sanitizer::isFreedPtrSlot(const SanitizerState& state, int64_t slot) const
+{
+    const uint32_t index = findSlot(slot);
+    return index != MicroDenseRegIndex::K_INVALID_INDEX && state.freedPtrSlots.contains(index);
 }
 
 bool Sanitizer::resolveStackSlot(const SanitizerState& state, MicroReg base, uint64_t offset, int64_t& outSlot) const
@@ -308,66 +348,11 @@ void Sanitizer::propagate(const SanitizerState& edge, uint32_t index, std::vecto
 
 bool Sanitizer::joinInto(SanitizerState& into, const SanitizerState& from)
 {
-    bool changed = false;
-
-    for (auto it = into.stack.begin(); it != into.stack.end();)
-    {
-        const auto f = from.stack.find(it->first);
-        if (f == from.stack.end() || f->second != it->second)
-        {
-            it      = into.stack.erase(it);
-            changed = true;
-        }
-        else
-            ++it;
-    }
-
-    for (auto it = into.regs.begin(); it != into.regs.end();)
-    {
-        const auto f = from.regs.find(it->first);
-        if (f == from.regs.end() || f->second != it->second)
-        {
-            it      = into.regs.erase(it);
-            changed = true;
-        }
-        else
-            ++it;
-    }
-
-    for (auto it = into.movedFrom.begin(); it != into.movedFrom.end();)
-    {
-        const auto f = from.movedFrom.find(it->first);
-        if (f == from.movedFrom.end() || f->second != it->second)
-        {
-            it      = into.movedFrom.erase(it);
-            changed = true;
-        }
-        else
-            ++it;
-    }
-
-    for (auto it = into.freedPtrSlots.begin(); it != into.freedPtrSlots.end();)
-    {
-        if (!from.freedPtrSlots.contains(*it))
-        {
-            it      = into.freedPtrSlots.erase(it);
-            changed = true;
-        }
-        else
-            ++it;
-    }
-
-    for (auto it = into.undefinedInit.begin(); it != into.undefinedInit.end();)
-    {
-        const auto f = from.undefinedInit.find(it->first);
-        if (f == from.undefinedInit.end() || f->second != it->second)
-        {
-            it      = into.undefinedInit.erase(it);
-            changed = true;
-        }
-        else
-            ++it;
-    }
+    bool changed = into.stack.intersectWith(from.stack);
+    changed |= into.regs.intersectWith(from.regs);
+    changed |= into.movedFrom.intersectWith(from.movedFrom);
+    changed |= into.freedPtrSlots.intersectWith(from.freedPtrSlots);
+    changed |= into.undefinedInit.intersectWith(from.undefinedInit);
 
     if (into.flagsSubject.isValid() && into.flagsSubject != from.flagsSubject)
     {
@@ -385,35 +370,19 @@ namespace
     // width is not always recoverable from the operands, so overlap is tested against a
     // conservative maximal store size.
     constexpr uint64_t K_ASSUMED_STORE_SIZE = 16;
+}
 
-    void clearMovedFromOverlaps(SanitizerState& state, const int64_t slot)
-    {
-        for (auto it = state.movedFrom.begin(); it != state.movedFrom.end();)
-        {
-            const int64_t rangeStart = it->first;
-            const int64_t rangeEnd   = rangeStart + static_cast<int64_t>(it->second);
-            if (slot + static_cast<int64_t>(K_ASSUMED_STORE_SIZE) > rangeStart && slot < rangeEnd)
-                it = state.movedFrom.erase(it);
-            else
-                ++it;
-        }
-    }
-
-    void clearUndefinedInitOverlaps(SanitizerState& state, const int64_t slot)
-    {
-        for (auto it = state.undefinedInit.begin(); it != state.undefinedInit.end();)
-        {
-            const int64_t rangeStart = it->first;
-            const int64_t rangeEnd   = rangeStart + static_cast<int64_t>(it->second);
-            if (slot + static_cast<int64_t>(K_ASSUMED_STORE_SIZE) > rangeStart && slot < rangeEnd)
-                it = state.undefinedInit.erase(it);
-            else
-                ++it;
-        }
-    }
+void Sanitizer::clearStoreOverlaps(SanitizerDenseMap<uint64_t>& ranges, const int64_t slot) const
+{
+    ranges.forEach([&](const uint32_t index, const uint64_t rangeSize) {
+        const int64_t rangeStart = slotOffsets_[index];
+        const int64_t rangeEnd   = rangeStart + static_cast<int64_t>(rangeSize);
+        if (slot + static_cast<int64_t>(K_ASSUMED_STORE_SIZE) > rangeStart && slot < rangeEnd)
+            ranges.erase(index);
+    });
 }
 
-void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops) const
+void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops)
 {
     if (!state.movedFrom.empty() && inst.op != MicroInstrOpcode::SanityInvalidate)
     {
@@ -427,7 +396,7 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
             int64_t slot = 0;
             if (def.flags.has(MicroInstrFlagsE::HasMemBaseOffsetOperands) &&
                 resolveStackSlot(state, ops[def.memBaseOperandIndex].reg, ops[def.memOffsetOperandIndex].valueU64, slot))
-                clearMovedFromOverlaps(state, slot);
+                clearStoreOverlaps(state.movedFrom, slot);
             else
                 state.movedFrom.clear();
         }
@@ -447,7 +416,7 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
             int64_t slot = 0;
             if (def.flags.has(MicroInstrFlagsE::HasMemBaseOffsetOperands) &&
                 resolveStackSlot(state, ops[def.memBaseOperandIndex].reg, ops[def.memOffsetOperandIndex].valueU64, slot))
-                clearUndefinedInitOverlaps(state, slot);
+                clearStoreOverlaps(state.undefinedInit, slot);
             else
                 state.undefinedInit.clear();
         }
@@ -462,13 +431,11 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
         if (def.flags.has(MicroInstrFlagsE::HasMemBaseOffsetOperands) &&
             resolveStackSlot(state, ops[def.memBaseOperandIndex].reg, ops[def.memOffsetOperandIndex].valueU64, slot))
         {
-            for (auto it = state.freedPtrSlots.begin(); it != state.freedPtrSlots.end();)
-            {
-                if (slot + static_cast<int64_t>(K_ASSUMED_STORE_SIZE) > *it && slot < *it + static_cast<int64_t>(sizeof(void*)))
-                    it = state.freedPtrSlots.erase(it);
-                else
-                    ++it;
-            }
+            state.freedPtrSlots.forEach([&](const uint32_t index) {
+                const int64_t freedSlot = slotOffsets_[index];
+                if (slot + static_cast<int64_t>(K_ASSUMED_STORE_SIZE) > freedSlot && slot < freedSlot + static_cast<int64_t>(sizeof(void*)))
+                    state.freedPtrSlots.erase(index);
+            });
         }
         else
             state.freedPtrSlots.clear();
@@ -480,14 +447,14 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
         {
             int64_t slot = 0;
             if (resolveStackSlot(state, ops[0].reg, 0, slot) && ops[1].valueU64 > 0)
-                state.movedFrom[slot] = ops[1].valueU64;
+                state.movedFrom.set(ensureSlot(slot), ops[1].valueU64);
             return;
         }
         case MicroInstrOpcode::SanityUndefined:
         {
             int64_t slot = 0;
             if (resolveStackSlot(state, ops[0].reg, 0, slot) && ops[1].valueU64 > 0)
-                state.undefinedInit[slot] = ops[1].valueU64;
+                state.undefinedInit.set(ensureSlot(slot), ops[1].valueU64);
             return;
         }
         case MicroInstrOpcode::LoadRegImm:
@@ -573,9 +540,8 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
             int64_t slot = 0;
             if (resolveStackSlot(state, ops[def.memBaseOperandIndex].reg, ops[def.memOffsetOperandIndex].valueU64, slot))
             {
-                const auto       it = state.stack.find(slot);
                 SanitizerRegInfo info;
-                info.value         = it != state.stack.end() ? it->second : SanitizerValue{};
+                info.value         = getSlot(state, slot);
                 info.hasOriginSlot = true;
                 info.originSlot    = slot;
 
@@ -603,7 +569,7 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
         {
             int64_t slot = 0;
             if (resolveStackSlot(state, ops[0].reg, ops[3].valueU64, slot))
-                state.stack[slot] = getReg(state, ops[1].reg);
+                setSlot(state, slot, getReg(state, ops[1].reg));
             return;
         }
 
@@ -611,7 +577,7 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
         {
             int64_t slot = 0;
             if (resolveStackSlot(state, ops[0].reg, ops[2].valueU64, slot))
-                state.stack[slot] = SanitizerValue::makeConstant(ops[3].valueU64);
+                setSlot(state, slot, SanitizerValue::makeConstant(ops[3].valueU64));
             return;
         }
 
@@ -733,7 +699,7 @@ void Sanitizer::applyValueEffects(SanitizerState& state, const MicroInstr& inst,
         state.freedPtrSlots.clear();
         state.flagsSubject = MicroReg::invalid();
         for (const int64_t slot : newlyFreed)
-            state.freedPtrSlots.insert(slot);
+            state.freedPtrSlots.insert(ensureSlot(slot));
         return;
     }
 
@@ -788,10 +754,10 @@ void Sanitizer::propagateConditionalBranch(const SanitizerState& state, const Mi
         if (provenZero || provenNonZero)
         {
             // successors = [taken (cond true), fallthrough (cond false)].
-            const bool     condIsTrue = condTrueIfSubjectZero == provenZero;
-            SanitizerState edge       = state;
-            edge.flagsSubject         = MicroReg::invalid();
-            propagate(edge, succs[condIsTrue ? 0 : 1], worklist);
+            const bool condIsTrue   = condTrueIfSubjectZero == provenZero;
+            edgeState_              = state;
+            edgeState_.flagsSubject = MicroReg::invalid();
+            propagate(edgeState_, succs[condIsTrue ? 0 : 1], worklist);
             return;
         }
     }
@@ -816,11 +782,11 @@ void Sanitizer::propagateConditionalBranch(const SanitizerState& state, const Mi
     const bool dropAcrossEdge = state.flagsSubject.isValid();
     for (const uint32_t s : succs)
     {
-        SanitizerState edge = state;
+        edgeState_ = state;
         if (dropAcrossEdge)
-            dropZeros(edge);
-        edge.flagsSubject = MicroReg::invalid();
-        propagate(edge, s, worklist);
+            dropZeros(edgeState_);
+        edgeState_.flagsSubject = MicroReg::invalid();
+        propagate(edgeState_, s, worklist);
     }
 }
 
@@ -845,31 +811,32 @@ bool Sanitizer::resolveGuardSlot(const SanitizerRegInfo& subject, int64_t& outSl
 
 void Sanitizer::queueRefined(const SanitizerState& state, uint32_t index, int64_t slot, bool slotIsZero, std::vector<uint32_t>& worklist)
 {
-    const auto           it      = state.stack.find(slot);
-    const SanitizerValue current = it != state.stack.end() ? it->second : SanitizerValue{};
+    const SanitizerValue current = getSlot(state, slot);
 
     if (slotIsZero && current.isKnownNonZero())
         return; // infeasible
     if (!slotIsZero && current.isZero())
         return; // infeasible
 
-    SanitizerState edge = state;
-    edge.stack[slot]    = slotIsZero ? SanitizerValue::makeConstant(0) : SanitizerValue::makeNonZero();
-    edge.flagsSubject   = MicroReg::invalid();
-    propagate(edge, index, worklist);
+    edgeState_ = state;
+    setSlot(edgeState_, slot, slotIsZero ? SanitizerValue::makeConstant(0) : SanitizerValue::makeNonZero());
+    edgeState_.flagsSubject = MicroReg::invalid();
+    propagate(edgeState_, index, worklist);
 }
 
 void Sanitizer::dropZeros(SanitizerState& state)
 {
-    for (auto& info : state.regs | std::views::values)
+    state.regs.forEach([](uint32_t, SanitizerRegInfo& info) {
         if (info.value.isZero())
             info.value = {};
-    for (auto& value : state.stack | std::views::values)
+    });
+    state.stack.forEach([](uint32_t, SanitizerValue& value) {
         if (value.isZero())
             value = {};
+    });
 }
 
-void Sanitizer::reportLoadFromPoisonedRange(const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops, const SanitizerState& state, const std::unordered_map<int64_t, uint64_t>& poisoned, DiagnosticId id)
+void Sanitizer::reportLoadFromPoisonedRange(const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops, const SanitizerState& state, const SanitizerDenseMap<uint64_t>& poisoned, DiagnosticId id)
 {
     if (poisoned.empty())
         return;
@@ -889,14 +856,14 @@ void Sanitizer::reportLoadFromPoisonedRange(const MicroInstr& inst, const MicroI
     if (!resolveStackSlot(state, ops[def.memBaseOperandIndex].reg, ops[def.memOffsetOperandIndex].valueU64, slot))
         return;
 
-    for (const auto& [rangeStart, rangeSize] : poisoned)
-    {
-        if (slot >= rangeStart && slot < rangeStart + static_cast<int64_t>(rangeSize))
-        {
-            report(inst, id);
-            return;
-        }
-    }
+    bool inRange = false;
+    poisoned.forEach([&](const uint32_t index, const uint64_t rangeSize) {
+        const int64_t rangeStart = slotOffsets_[index];
+        inRange |= slot >= rangeStart && slot < rangeStart + static_cast<int64_t>(rangeSize);
+    });
+
+    if (inRange)
+        report(inst, id);
 }
 
 void Sanitizer::report(const MicroInstr& inst, DiagnosticId id)
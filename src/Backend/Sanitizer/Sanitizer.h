@@ -1,5 +1,6 @@
 #pragma once
 #include "Backend/Micro/MicroControlFlowGraph.h"
+#include "Backend/Micro/MicroDenseRegIndex.h"
 #include "Backend/Sanitizer/SanitizerState.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -28,6 +29,10 @@ class TaskContext;
 // `run` computes the fixpoint, then applies each check to every reachable instruction
 // against its converged incoming state — reporting during the fixpoint would flag a
 // transient pre-join state that a later merge widens back to Unknown.
+//
+// States are dense: registers and stack slots are numbered once per run and every
+// state indexes the same numbering, so joins and copies touch flat arrays instead of
+// hash tables.
 class Sanitizer
 {
 public:
@@ -37,11 +42,12 @@ public:
     bool run(std::span<SanitizerCheck* const> checks);
 
     // Queries usable by checks against a converged state.
-    SanitizerValue                 getReg(const SanitizerState& state, MicroReg reg) const;
-    static const SanitizerRegInfo* regInfo(const SanitizerState& state, MicroReg reg) { return findReg(state, reg); }
-    bool                           resolveStackSlot(const SanitizerState& state, MicroReg base, uint64_t offset, int64_t& outSlot) const;
-    TaskContext&                   ctx() const;
-    const MicroPassContext&        passContext() const { return context_; }
+    SanitizerValue          getReg(const SanitizerState& state, MicroReg reg) const;
+    const SanitizerRegInfo* regInfo(const SanitizerState& state, MicroReg reg) const { return findReg(state, reg); }
+    bool                    resolveStackSlot(const SanitizerState& state, MicroReg base, uint64_t offset, int64_t& outSlot) const;
+    bool                    isFreedPtrSlot(const SanitizerState& state, int64_t slot) const;
+    TaskContext&            ctx() const;
+    const MicroPassContext& passContext() const { return context_; }
 
     // Extents of the declared variable (local or spilled parameter) whose storage
     // contains 'offset' (relative to the debug stack base). False for compiler
@@ -65,13 +71,18 @@ public:
     // poisoned ranges. Address computations and indexed forms are left alone: the first is a
     // legitimate way to (re)initialize through an out-parameter, the second cannot prove the
     // range it touches.
-    void reportLoadFromPoisonedRange(const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops, const SanitizerState& state, const std::unordered_map<int64_t, uint64_t>& poisoned, DiagnosticId id);
+    void reportLoadFromPoisonedRange(const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops, const SanitizerState& state, const SanitizerDenseMap<uint64_t>& poisoned, DiagnosticId id);
 
 private:
     // Register / slot access.
-    static const SanitizerRegInfo* findReg(const SanitizerState& state, MicroReg reg);
-    static void                    setReg(SanitizerState& state, MicroReg reg, const SanitizerRegInfo& info);
-    static void                    setRegValue(SanitizerState& state, MicroReg reg, const SanitizerValue& value);
+    const SanitizerRegInfo* findReg(const SanitizerState& state, MicroReg reg) const;
+    void                    setReg(SanitizerState& state, MicroReg reg, const SanitizerRegInfo& info);
+    void                    setRegValue(SanitizerState& state, MicroReg reg, const SanitizerValue& value);
+    uint32_t                findSlot(int64_t slot) const;
+    uint32_t                ensureSlot(int64_t slot);
+    SanitizerValue          getSlot(const SanitizerState& state, int64_t slot) const;
+    void                    setSlot(SanitizerState& state, int64_t slot, const SanitizerValue& value);
+    void                    clearStoreOverlaps(SanitizerDenseMap<uint64_t>& ranges, int64_t slot) const;
 
     // Join + propagation.
     void        propagate(const SanitizerState& edge, uint32_t index, std::vector<uint32_t>& worklist);
@@ -81,11 +92,11 @@ private:
     // states are only stored (and joined) at chain heads, everything in between is
     // recomputed on the fly. With a worklist it propagates the fixpoint; with checks
     // it applies them to each instruction's pre-state.
-    void walkChain(uint32_t head, SanitizerState cur, std::span<SanitizerCheck* const> checks, std::vector<uint32_t>* worklist, uint64_t& steps);
+    void walkChain(uint32_t head, std::span<SanitizerCheck* const> checks, std::vector<uint32_t>* worklist, uint64_t& steps);
 
     // Instruction effects (the transfer function).
-    void        applyValueEffects(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops) const;
-    static void invalidateDefs(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops);
+    void        applyValueEffects(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops);
+    void        invalidateDefs(SanitizerState& state, const MicroInstr& inst, const MicroInstrDef& def, const MicroInstrOperand* ops);
     static bool condIsZeroTest(MicroCond cond, bool& outTrueIfZero);
 
     // Conditional branch handling: guard narrowing + feasibility pruning.
@@ -116,12 +127,17 @@ private:
     bool                         reported_           = false;
     bool                         converged_          = true;
     std::vector<SanitizerState>  inState_; // populated only at chain heads
+    SanitizerState               chainState_;
+    SanitizerState               edgeState_;
+    MicroDenseRegIndex           regIndex_;
+    std::vector<int64_t>         slotOffsets_;
     std::vector<char>            isHead_;
     std::vector<char>            reached_;
     std::vector<char>            inWorklist_;
     std::unordered_set<uint64_t> reportedLocations_;
 
     std::unordered_map<uint32_t, const Symbol*> callTargets_;
+    std::unordered_map<int64_t, uint32_t>       slotIndices_;
 };
 
 SWC_END_NAMESPACE();
@@ -29,33 +29,182 @@ struct SanitizerRegInfo
     }
 };
 
+// Set of dense indices, one bit each. The indices are the sanitizer's numbering of the
+// registers and stack slots of the function being analysed, shared by every state, so
+// that joining two states is a loop over words. Clearing keeps the words allocated:
+// states are copied over each other during the fixpoint and then reuse their storage.
+class SanitizerDenseSet
+{
+public:
+    bool contains(uint32_t index) const
+    {
+        const uint32_t word = index / 64;
+        return word < words_.size() && (words_[word] >> (index % 64)) & 1;
+    }
+
+    void insert(uint32_t index)
+    {
+        const uint32_t word = index / 64;
+        if (word >= words_.size())
+            words_.resize(word + 1, 0);
+        words_[word] |= 1ULL << (index % 64);
+    }
+
+    void erase(uint32_t index)
+    {
+        const uint32_t word = index / 64;
+        if (word < words_.size())
+            words_[word] &= ~(1ULL << (index % 64));
+    }
+
+    void clear()
+    {
+        std::ranges::fill(words_, 0);
+    }
+
+    bool empty() const
+    {
+        return std::ranges::all_of(words_, [](const uint64_t word) { return word == 0; });
+    }
+
+    // Erasing the index being visited is allowed.
+    template<typename FN>
+    void forEach(FN&& fn) const
+    {
+        for (uint32_t word = 0; word < words_.size(); ++word)
+        {
+            for (uint64_t bits = words_[word]; bits; bits &= bits - 1)
+                fn(word * 64 + static_cast<uint32_t>(std::countr_zero(bits)));
+        }
+    }
+
+    // Keeps the indices that are also in 'other' and for which 'keep' holds. Returns
+    // true if anything was removed.
+    template<typename KEEP>
+    bool intersectWith(const SanitizerDenseSet& other, KEEP&& keep)
+    {
+        bool changed = false;
+        for (uint32_t word = 0; word < words_.size(); ++word)
+        {
+            const uint64_t before = words_[word];
+            uint64_t       after  = word < other.words_.size() ? before & other.words_[word] : 0;
+            for (uint64_t bits = after; bits; bits &= bits - 1)
+            {
+                const uint32_t bit = static_cast<uint32_t>(std::countr_zero(bits));
+                if (!keep(word * 64 + bit))
+                    after &= ~(1ULL << bit);
+            }
+
+            if (after != before)
+            {
+                words_[word] = after;
+                changed      = true;
+            }
+        }
+
+        return changed;
+    }
+
+    bool intersectWith(const SanitizerDenseSet& other)
+    {
+        return intersectWith(other, [](uint32_t) { return true; });
+    }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+// Values keyed by a dense index. A value is only meaningful while its key is in the set:
+// erasing leaves the slot as is, to be overwritten by the next insertion.
+template<typename T>
+class SanitizerDenseMap
+{
+public:
+    const T* find(uint32_t index) const
+    {
+        return keys_.contains(index) ? &values_[index] : nullptr;
+    }
+
+    bool contains(uint32_t index) const
+    {
+        return keys_.contains(index);
+    }
+
+    void set(uint32_t index, const T& value)
+    {
+        if (index >= values_.size())
+            values_.resize(index + 1);
+        values_[index] = value;
+        keys_.insert(index);
+    }
+
+    void erase(uint32_t index)
+    {
+        keys_.erase(index);
+    }
+
+    void clear()
+    {
+        keys_.clear();
+    }
+
+    bool empty() const
+    {
+        return keys_.empty();
+    }
+
+    template<typename FN>
+    void forEach(FN&& fn) const
+    {
+        keys_.forEach([&](const uint32_t index) { fn(index, values_[index]); });
+    }
+
+    template<typename FN>
+    void forEach(FN&& fn)
+    {
+        keys_.forEach([&](const uint32_t index) { fn(index, values_[index]); });
+    }
+
+    // Join: keeps the entries both maps hold with the same value. Returns true if
+    // anything was removed.
+    bool intersectWith(const SanitizerDenseMap& other)
+    {
+        return keys_.intersectWith(other.keys_, [&](const uint32_t index) { return values_[index] == other.values_[index]; });
+    }
+
+private:
+    SanitizerDenseSet keys_;
+    std::vector<T>    values_;
+};
+
 // Abstract machine state at one program point: the tracked value of every virtual
 // register and simulated local stack slot, plus which register the CPU flags encode a
-// comparison of against zero.
+// comparison of against zero. Registers are keyed by their index in the sanitizer's
+// MicroDenseRegIndex, stack slots by the index the sanitizer gave their frame offset.
 struct SanitizerState
 {
-    std::unordered_map<uint32_t, SanitizerRegInfo> regs;  // key: MicroReg.packed
-    std::unordered_map<int64_t, SanitizerValue>    stack; // key: stack slot offset
+    SanitizerDenseMap<SanitizerRegInfo> regs;
+    SanitizerDenseMap<SanitizerValue>   stack;
 
     // Frame ranges abandoned by a '#move'/'#relocate' (moved-from, not reset), set by a
-    // 'SanityInvalidate' marker: key = slot offset, value = size in bytes. A range is
-    // moved-from only when it is on *every* path (join = intersection); any store into
-    // the range revalidates it, and calls conservatively clear the whole set.
-    std::unordered_map<int64_t, uint64_t> movedFrom;
+    // 'SanityInvalidate' marker: key = slot of the range start, value = size in bytes.
+    // A range is moved-from only when it is on *every* path (join = intersection); any
+    // store into the range revalidates it, and calls conservatively clear the whole set.
+    SanitizerDenseMap<uint64_t> movedFrom;
 
     // Slots holding a pointer that was handed to a FREEING callee (freesParamsMask):
     // dereferencing that pointer again is a use-after-free, freeing it again a double
     // free. Same discipline as movedFrom: join = intersection, any store that could
     // alias the slot revalidates it, calls conservatively clear the set (the freeing
     // call itself re-marks its arguments afterwards).
-    std::unordered_set<int64_t> freedPtrSlots;
+    SanitizerDenseSet freedPtrSlots;
 
     // Frame ranges declared with an explicit 'undefined' initializer and not yet
-    // written, set by a 'SanityUndefined' marker: key = slot offset, value = size in
-    // bytes. Reading such a range is a proven read of uninitialized storage. Same
-    // discipline as movedFrom: join = intersection, any store that could alias the
+    // written, set by a 'SanityUndefined' marker: key = slot of the range start, value
+    // = size in bytes. Reading such a range is a proven read of uninitialized storage.
+    // Same discipline as movedFrom: join = intersection, any store that could alias the
     // range initializes it, calls conservatively clear the set (out-parameters).
-    std::unordered_map<int64_t, uint64_t> undefinedInit;
+    SanitizerDenseMap<uint64_t> undefinedInit;
 
     MicroReg flagsSubject = MicroReg::invalid();
 };
@@ -1583,7 +1583,9 @@ namespace
             emitLoadInterfaceMethodTableAddress(itableReg, codeGen, interfaceTableCstRef);
             builder.emitLoadMemReg(runtimeItfReg, offsetof(Runtime::Interface, itable), itableReg, MicroOpBits::B64);
 
-            codeGen.setPayloadAddressReg(codeGen.curNodeRef(), runtimeItfReg, dstTypeRef);
+            // The method table is known here: a method called right on this value is a direct call.
+            CodeGenNodePayload& payload = codeGen.setPayloadAddressReg(codeGen.curNodeRef(), runtimeItfReg, dstTypeRef);
+            payload.interfaceImpl       = castInfo.implSym;
             return Result::Continue;
         }
 
@@ -579,6 +579,13 @@ namespace
             spillParametersToDebugSlots(codeGen, symbolFunc);
         }
 
+        if (symbolFunc.usesJitTiering(codeGen.ctx()))
+        {
+            MicroBuilder&           builder = codeGen.builder();
+            const ScopedDebugNoStep noStep(builder, true);
+            CodeGenFunctionHelpers::emitJitTierUpProbe(codeGen);
+        }
+
         codeGen.pushDeferScope(declRef);
         codeGen.registerImplicitParameterDrops();
 
@@ -397,6 +397,24 @@ namespace
         CodeGenNodePayload&      payload       = codeGen.setPayload(codeGen.curNodeRef(), symVar.typeRef());
         payload.reg                            = symbolPayload.reg;
         payload.storageKind                    = symbolPayload.storageKind;
+
+        // A 'let' still holds the value it was built with; a 'var' may have been reassigned, so
+        // its implementation is only a guess the call checks against the method table.
+        payload.interfaceImpl        = codeGen.interfaceLocalImpl(symVar);
+        payload.interfaceImplGuessed = payload.interfaceImpl && !symVar.hasExtraFlag(SymbolVariableFlagsE::Let);
+    }
+
+    void recordInterfaceLocalImpl(CodeGen& codeGen, const SymbolVariable& symVar, AstNodeRef initRef)
+    {
+        const SymbolImpl* implSym = nullptr;
+        if (initRef.isValid() && symVar.typeRef().isValid() && codeGen.typeMgr().get(symVar.typeRef()).isInterface())
+        {
+            const CodeGenNodePayload* initPayload = codeGen.safePayload(initRef);
+            if (initPayload && !initPayload->interfaceImplGuessed)
+                implSym = initPayload->interfaceImpl;
+        }
+
+        codeGen.setInterfaceLocalImpl(symVar, implSym);
     }
 
     void codeGenIdentifierFromSymbol(CodeGen& codeGen, const Symbol& symbol)
@@ -827,6 +845,7 @@ Result AstSingleVarDecl::codeGenPostNode(CodeGen& codeGen) const
         else
         {
             SWC_RESULT(materializeSingleVarFromInit(codeGen, symVar, nodeInitRef));
+            recordInterfaceLocalImpl(codeGen, symVar, nodeInitRef);
         }
         codeGen.registerImplicitDrop(symVar);
     }
@@ -381,11 +381,27 @@ namespace
         const auto& methodFunc = methodSym->cast<SymbolFunction>();
         SWC_ASSERT(methodFunc.hasInterfaceMethodSlot());
 
-        const CodeGenNodePayload& payload = codeGen.setPayloadValue(codeGen.curNodeRef());
-        const MicroReg            leftReg = leftPayload.reg;
-        const MicroReg            dstReg  = payload.reg;
-        builder.emitLoadRegMem(dstReg, leftReg, offsetof(Runtime::Interface, itable), MicroOpBits::B64);
-        builder.emitLoadRegMem(dstReg, dstReg, (methodFunc.interfaceMethodSlot() + 1) * sizeof(void*), MicroOpBits::B64);
+        const MicroReg      leftReg   = leftPayload.reg;
+        const SymbolImpl*   implSym   = leftPayload.interfaceImpl;
+        const bool          implGuess = leftPayload.interfaceImplGuessed;
+        CodeGenNodePayload& payload   = codeGen.setPayloadValue(codeGen.curNodeRef());
+        const MicroReg      dstReg    = payload.reg;
+        const MicroReg      itableReg = codeGen.nextVirtualIntRegister();
+        builder.emitLoadRegMem(itableReg, leftReg, offsetof(Runtime::Interface, itable), MicroOpBits::B64);
+        builder.emitLoadRegMem(dstReg, itableReg, (methodFunc.interfaceMethodSlot() + 1) * sizeof(void*), MicroOpBits::B64);
+
+        // Let the call bind the method directly: for sure when the receiver was built from a known
+        // struct and cannot have changed since, behind a compare of 'itableReg' when it may have.
+        if (implSym && !implGuess)
+        {
+            payload.interfaceImpl = implSym;
+        }
+        else if (implSym && builder.backendBuildCfg().optimize)
+        {
+            payload.interfaceImpl     = implSym;
+            payload.interfaceTableReg = itableReg;
+        }
+
         return Result::Continue;
     }
 
@@ -43,6 +43,7 @@ namespace
         TypeRef                                                  compareTypeRef     = TypeRef::invalid();
         CodeGenNodePayload                                       switchValuePayload = {};
         MicroReg                                                 switchValueReg;
+        MicroReg                                                 stringLengthReg;
         MicroReg                                                 dynamicSourceTypeReg;
         MicroReg                                                 dynamicSourcePtrReg;
         MicroOpBits                                              compareOpBits       = MicroOpBits::B64;
@@ -55,9 +56,24 @@ namespace
         bool                                                     useUnsignedCond     = false;
         bool                                                     dynamicStructSwitch = false;
         bool                                                     isAnySwitch         = false;
+        bool                                                     useDispatchTree     = false;
         std::unordered_map<AstNodeRef, SwitchCaseCodeGenPayload> caseStates;
     };
 
+    // Below this many case values the case-by-case test chain is as short as a search tree, and
+    // keeps the test of each case next to its body. Dense switches take the tree too: a jump table
+    // needs a Micro terminator that names every case label (T-560).
+    constexpr size_t SWITCH_TREE_MIN_VALUES = 8;
+    // A subtree this small is tested value by value.
+    constexpr size_t SWITCH_TREE_LEAF_VALUES = 3;
+
+    struct SwitchTreeEntry
+    {
+        uint64_t      orderKey  = 0;
+        uint64_t      valueBits = 0;
+        MicroLabelRef bodyLabel = MicroLabelRef::invalid();
+    };
+
     SwitchStmtCodeGenPayload* switchStmtCodeGenPayload(CodeGen& codeGen, AstNodeRef nodeRef)
     {
         return codeGen.safeNodePayload<SwitchStmtCodeGenPayload>(nodeRef);
@@ -221,7 +237,24 @@ namespace
         return caseNode.spanExprRef.isValid();
     }
 
-    Result emitStringCompareEqualsJump(CodeGen& codeGen, const SwitchStmtCodeGenPayload& switchState, const CodeGenNodePayload& casePayload, MicroLabelRef successLabel)
+    // Length of a constant string case, which decides most mismatches without calling the runtime.
+    bool constantStringCaseLength(CodeGen& codeGen, AstNodeRef caseExprRef, uint64_t& outLength)
+    {
+        const SemaNodeView caseView = codeGen.viewConstant(caseExprRef);
+        if (!caseView.hasConstant())
+            return false;
+
+        const ConstantValue* cst = &codeGen.cstMgr().get(caseView.cstRef());
+        if (cst->isEnumValue())
+            cst = &codeGen.cstMgr().get(cst->getEnumValue());
+        if (!cst->isString())
+            return false;
+
+        outLength = cst->getString().size();
+        return true;
+    }
+
+    Result emitStringCompareEqualsJump(CodeGen& codeGen, const SwitchStmtCodeGenPayload& switchState, AstNodeRef caseExprRef, const CodeGenNodePayload& casePayload, MicroLabelRef successLabel)
     {
         SymbolFunction* stringCmpSymbol = switchState.stringCmpFunction;
         if (!stringCmpSymbol)
@@ -233,6 +266,18 @@ namespace
 
         codeGen.function().addCallDependency(stringCmpSymbol);
 
+        // Strings of different lengths never compare equal, so only a case of the right length
+        // pays for the runtime call.
+        MicroBuilder& builder        = codeGen.builder();
+        MicroLabelRef otherCaseLabel = MicroLabelRef::invalid();
+        uint64_t      caseLength     = 0;
+        if (switchState.stringLengthReg.isValid() && constantStringCaseLength(codeGen, caseExprRef, caseLength))
+        {
+            otherCaseLabel = builder.createLabel();
+            builder.emitCmpRegImm(switchState.stringLengthReg, ApInt(caseLength, 64), MicroOpBits::B64);
+            builder.emitJumpToLabel(MicroCond::NotEqual, MicroOpBits::B32, otherCaseLabel);
+        }
+
         auto&                             stringCmpFunction = *stringCmpSymbol;
         const CallConvKind                callConvKind      = stringCmpFunction.callConvKind();
         const CallConv&                   callConv          = CallConv::get(callConvKind);
@@ -248,7 +293,6 @@ namespace
 
         CodeGenCallHelpers::isolatePreparedRegisterArgSources(codeGen, callConv, preparedArgs);
 
-        MicroBuilder&               builder      = codeGen.builder();
         const ABICall::PreparedCall preparedCall = ABICall::prepareArgs(builder, callConvKind, preparedArgs.span());
         if (stringCmpFunction.isForeign())
             ABICall::callExtern(builder, callConvKind, &stringCmpFunction, preparedCall);
@@ -264,6 +308,8 @@ namespace
         ABICall::materializeReturnToReg(builder, compareReg, callConvKind, normalizedRet);
         builder.emitCmpRegImm(compareReg, ApInt(0, 64), MicroOpBits::B8);
         builder.emitJumpToLabel(MicroCond::NotEqual, MicroOpBits::B32, successLabel);
+        if (otherCaseLabel.isValid())
+            builder.placeLabel(otherCaseLabel);
         return Result::Continue;
     }
 
@@ -285,7 +331,7 @@ namespace
     {
         const CodeGenNodePayload& casePayload = codeGen.payload(caseExprRef);
         if (switchState.useStringCompare)
-            return emitStringCompareEqualsJump(codeGen, switchState, casePayload, successLabel);
+            return emitStringCompareEqualsJump(codeGen, switchState, caseExprRef, casePayload, successLabel);
         if (switchState.useTypeInfoCompare)
             return emitTypeInfoCompareEqualsJump(codeGen, switchState, casePayload, successLabel);
 
@@ -352,6 +398,106 @@ namespace
         return caseExprRefs;
     }
 
+    // The case value as the switch register holds it: truncated to the compare width. The order
+    // key sorts the values the way the compare condition does, signed or unsigned.
+    bool switchTreeEntryFromCase(CodeGen& codeGen, const SwitchStmtCodeGenPayload& switchState, AstNodeRef caseExprRef, SwitchTreeEntry& outEntry)
+    {
+        const SemaNodeView caseView = codeGen.viewConstant(caseExprRef);
+        if (!caseView.hasConstant())
+            return false;
+
+        const ConstantValue* cst = &codeGen.cstMgr().get(caseView.cstRef());
+        if (cst->isEnumValue())
+            cst = &codeGen.cstMgr().get(cst->getEnumValue());
+        if (!cst->isInt() && !cst->isChar() && !cst->isRune())
+            return false;
+
+        const ApsInt value = cst->getIntLike();
+        if (!value.fits64())
+            return false;
+
+        const uint32_t numBits = getNumBits(switchState.compareOpBits);
+        const uint64_t mask    = numBits >= 64 ? ~uint64_t{0} : (uint64_t{1} << numBits) - 1;
+        outEntry.valueBits     = static_cast<uint64_t>(value.asI64()) & mask;
+        if (switchState.useUnsignedCond)
+        {
+            outEntry.orderKey = outEntry.valueBits;
+        }
+        else
+        {
+            const uint64_t signBit = uint64_t{1} << (numBits - 1);
+            const uint64_t widened = (outEntry.valueBits ^ signBit) - signBit;
+            outEntry.orderKey      = widened ^ (uint64_t{1} << 63);
+        }
+
+        return true;
+    }
+
+    // A switch on integer constants, with no range and no 'where', can find its case by binary
+    // search instead of testing every case in turn. Only the cases before the first 'default' are
+    // ever tested, and the first case wins when two share a value, as in the sequential chain.
+    bool collectSwitchTreeEntries(CodeGen& codeGen, const SwitchStmtCodeGenPayload& switchState, const AstSwitchStmt& switchNode, SmallVector<SwitchTreeEntry>& outEntries, MicroLabelRef& outFailLabel)
+    {
+        outFailLabel = switchState.noMatchLabel.isValid() ? switchState.noMatchLabel : switchState.doneLabel;
+        for (const AstNodeRef caseRef : collectSwitchCaseRefs(codeGen, switchNode))
+        {
+            const auto& caseNode = codeGen.node(caseRef).cast<AstSwitchCaseStmt>();
+            if (caseNode.nodeWhereRef.isValid())
+                return false;
+
+            const auto itCase = switchState.caseStates.find(caseRef);
+            SWC_ASSERT(itCase != switchState.caseStates.end());
+            if (!caseNode.spanExprRef.isValid())
+            {
+                outFailLabel = itCase->second.bodyLabel;
+                break;
+            }
+
+            for (const AstNodeRef caseExprRef : collectSwitchCaseExprRefs(codeGen, caseNode))
+            {
+                if (codeGen.node(caseExprRef).is(AstNodeId::RangeExpr))
+                    return false;
+
+                SwitchTreeEntry entry;
+                if (!switchTreeEntryFromCase(codeGen, switchState, caseExprRef, entry))
+                    return false;
+                entry.bodyLabel = itCase->second.bodyLabel;
+                outEntries.push_back(entry);
+            }
+        }
+
+        std::ranges::stable_sort(outEntries, {}, &SwitchTreeEntry::orderKey);
+        const auto duplicates = std::ranges::unique(outEntries, {}, &SwitchTreeEntry::orderKey);
+        outEntries.resize(static_cast<size_t>(duplicates.begin() - outEntries.begin()));
+        return outEntries.size() >= SWITCH_TREE_MIN_VALUES;
+    }
+
+    void emitSwitchTree(CodeGen& codeGen, const SwitchStmtCodeGenPayload& switchState, std::span<const SwitchTreeEntry> entries, MicroLabelRef failLabel)
+    {
+        MicroBuilder& builder = codeGen.builder();
+        if (entries.size() <= SWITCH_TREE_LEAF_VALUES)
+        {
+            for (const SwitchTreeEntry& entry : entries)
+            {
+                builder.emitCmpRegImm(switchState.switchValueReg, ApInt(entry.valueBits, 64), switchState.compareOpBits);
+                builder.emitJumpToLabel(MicroCond::Equal, MicroOpBits::B32, entry.bodyLabel);
+            }
+
+            builder.emitJumpToLabel(MicroCond::Unconditional, MicroOpBits::B32, failLabel);
+            return;
+        }
+
+        const size_t           mid        = entries.size() / 2;
+        const SwitchTreeEntry& pivot      = entries[mid];
+        const MicroLabelRef    lowerLabel = builder.createLabel();
+        builder.emitCmpRegImm(switchState.switchValueReg, ApInt(pivot.valueBits, 64), switchState.compareOpBits);
+        builder.emitJumpToLabel(CodeGenCompareHelpers::lessCond(switchState.useUnsignedCond), MicroOpBits::B32, lowerLabel);
+        builder.emitJumpToLabel(MicroCond::Equal, MicroOpBits::B32, pivot.bodyLabel);
+        emitSwitchTree(codeGen, switchState, entries.subspan(mid + 1), failLabel);
+        builder.placeLabel(lowerLabel);
+        emitSwitchTree(codeGen, switchState, entries.first(mid), failLabel);
+    }
+
     void emitSwitchCaseWhereFalseJump(CodeGen& codeGen, AstNodeRef whereRef, MicroLabelRef failLabel)
     {
         if (!whereRef.isValid())
@@ -531,6 +677,21 @@ Result AstSwitchStmt::codeGenPostNodeChild(CodeGen& codeGen, const AstNodeRef& c
         switchState->useUnsignedCond    = compareType.usesUnsignedConditions();
         if (useStringCompare)
             switchState->stringCmpFunction = runtimeStringCompareFunction(codeGen);
+        if (useStringCompare && compareType.isString())
+        {
+            switchState->stringLengthReg = codeGen.nextVirtualIntRegister();
+            builder.emitLoadRegMem(switchState->stringLengthReg, exprPayload.reg, offsetof(Runtime::String, length), MicroOpBits::B64);
+        }
+
+        // Route every case value from here; the cases then only place their bodies.
+        SmallVector<SwitchTreeEntry> treeEntries;
+        MicroLabelRef                treeFailLabel = MicroLabelRef::invalid();
+        if (compareType.isIntLike() && !switchState->useTypeInfoCompare && collectSwitchTreeEntries(codeGen, *switchState, *this, treeEntries, treeFailLabel))
+        {
+            switchState->useDispatchTree = true;
+            emitSwitchTree(codeGen, *switchState, treeEntries.span(), treeFailLabel);
+        }
+
         return Result::Continue;
     }
 
@@ -613,6 +774,13 @@ Result AstSwitchCaseStmt::codeGenPreNodeChild(CodeGen& codeGen, const AstNodeRef
     if (childRef != nodeBodyRef)
         return Result::Continue;
 
+    if (switchState->useDispatchTree)
+    {
+        builder.placeLabel(caseState.bodyLabel);
+        codeGen.pushDeferScope(AstNodeRef::invalid(), switchRef, codeGen.curNodeRef());
+        return Result::Continue;
+    }
+
     if (switchState->hasExpression)
     {
         if (spanExprRef.isValid())
@@ -509,6 +509,7 @@ Result CodeGen::exec(SymbolFunction& symbolFunc, AstNodeRef root)
         variablePayloads_.clear();
         moveElisionVars_.clear();
         elidedImplicitDrops_.clear();
+        interfaceLocalImpls_.clear();
         temporaryDrops_.clear();
         returnMoveOutVar_    = nullptr;
         moveElisionAnalyzed_ = false;
@@ -816,6 +817,20 @@ const CodeGenNodePayload* CodeGen::variablePayload(const SymbolVariable& sym) co
     return &symbolPayload.payload;
 }
 
+void CodeGen::setInterfaceLocalImpl(const SymbolVariable& symVar, const SymbolImpl* implSym)
+{
+    if (implSym)
+        interfaceLocalImpls_[&symVar] = implSym;
+    else
+        interfaceLocalImpls_.erase(&symVar);
+}
+
+const SymbolImpl* CodeGen::interfaceLocalImpl(const SymbolVariable& symVar) const
+{
+    const auto it = interfaceLocalImpls_.find(&symVar);
+    return it != interfaceLocalImpls_.end() ? it->second : nullptr;
+}
+
 CodeGenNodePayload& CodeGen::inheritPayload(AstNodeRef dstNodeRef, AstNodeRef srcNodeRef, TypeRef typeRef)
 {
     CodeGenNodePayload srcPayloadCopy;
@@ -21,6 +21,7 @@ class TypeManager;
 class TypeGen;
 class IdentifierManager;
 class SourceView;
+class SymbolImpl;
 class SymbolVariable;
 struct ResolvedCallArgument;
 struct Token;
@@ -450,6 +451,11 @@ public:
     void                                                              markImplicitDropElided(const SymbolVariable& symVar) { elidedImplicitDrops_.insert(&symVar); }
     bool                                                              isImplicitDropElided(const SymbolVariable& symVar) const { return elidedImplicitDrops_.contains(&symVar); }
 
+    // Interface locals initialized from a known struct: the implementation behind their method
+    // table, so member calls on them can bind the method directly (see CodeGen.Member).
+    void              setInterfaceLocalImpl(const SymbolVariable& symVar, const SymbolImpl* implSym);
+    const SymbolImpl* interfaceLocalImpl(const SymbolVariable& symVar) const;
+
     // Local moved out by the return being emitted: its drop is skipped for this return's
     // deferred actions only, so drops emitted for other control paths are unaffected.
     const SymbolVariable* returnMoveOutVar() const { return returnMoveOutVar_; }
@@ -498,6 +504,7 @@ private:
     std::unordered_map<const SymbolVariable*, VariablePayloadState>  variablePayloads_;
     std::unordered_map<const SymbolVariable*, CodeGenMoveElisionVar> moveElisionVars_;
     std::unordered_set<const SymbolVariable*>                        elidedImplicitDrops_;
+    std::unordered_map<const SymbolVariable*, const SymbolImpl*>     interfaceLocalImpls_;
     const SymbolVariable*                                            returnMoveOutVar_    = nullptr;
     bool                                                             moveElisionAnalyzed_ = false;
     SymbolFunction*                                                  function_            = nullptr;
@@ -7,6 +7,7 @@
 #include "Backend/Runtime.h"
 #include "Compiler/CodeGen/Core/CodeGen.h"
 #include "Compiler/CodeGen/Core/CodeGenFunctionHelpers.h"
+#include "Compiler/CodeGen/Core/CodeGenInterfaceHelpers.h"
 #include "Compiler/CodeGen/Core/CodeGenMemoryHelpers.h"
 #include "Compiler/CodeGen/Core/CodeGenReferenceHelpers.h"
 #include "Compiler/CodeGen/Core/CodeGenSafety.h"
@@ -1227,6 +1228,92 @@ namespace
         return targetReg;
     }
 
+    bool isTailCallPosition(CodeGen& codeGen, AstNodeRef declRef)
+    {
+        // A 'return' inside an inlined body leaves the expansion, not the function.
+        if (codeGen.frame().hasCurrentInlineContext())
+        {
+            const CodeGenFrame::InlineContext& inlineCtx = codeGen.frame().currentInlineContext();
+            SWC_ASSERT(inlineCtx.payload != nullptr);
+            if (!inlineCtx.payload->returnsToCallerSite())
+                return false;
+        }
+
+        const AstNodeRef resolvedNodeRef = codeGen.viewZero(codeGen.curNodeRef()).nodeRef();
+        if (!resolvedNodeRef.isValid())
+            return false;
+
+        for (size_t parentIndex = 0;; ++parentIndex)
+        {
+            const AstNodeRef parentRef = codeGen.visit().parentNodeRef(parentIndex);
+            if (!parentRef.isValid())
+                return false;
+
+            const AstNode& parent = codeGen.node(parentRef);
+            if (parent.is(AstNodeId::ParenExpr))
+                continue;
+
+            if (parent.is(AstNodeId::ReturnStmt))
+                return codeGen.viewZero(parent.cast<AstReturnStmt>().nodeExprRef).nodeRef() == resolvedNodeRef;
+
+            if (parentRef == declRef && parent.is(AstNodeId::FunctionDecl))
+            {
+                const auto& funcDecl = parent.cast<AstFunctionDecl>();
+                return funcDecl.hasFlag(AstFunctionFlagsE::Short) && codeGen.viewZero(funcDecl.nodeBodyRef).nodeRef() == resolvedNodeRef;
+            }
+
+            return false;
+        }
+    }
+
+    // Only marks the call. The prolog/epilog pass still requires nothing but the return
+    // sequence behind it after register allocation, and no frame address escaping, before
+    // it turns the call into a jump.
+    bool isTailCallCandidate(CodeGen& codeGen, const SymbolFunction& calledFunction, const ABITypeNormalize::NormalizedType& normalizedRet, const PreparedCallArguments& preparedArgs, MicroReg hiddenRetStorageReg)
+    {
+        if (!codeGen.builder().backendBuildCfg().optimize)
+            return false;
+
+        const SymbolFunction& currentFunction = codeGen.function();
+        if (currentFunction.attributes().hasRtFlag(RtAttributeFlagsE::NoTailCall))
+            return false;
+        if (calledFunction.isFallible() || calledFunction.callConvKind() != currentFunction.callConvKind())
+            return false;
+        if (codeGen.hasDeferredStatements() || codeGen.inDeferredEmission())
+            return false;
+
+        // The callee returns straight to our caller, so it must hand back the same value in the
+        // same register. Arguments on the stack would have to be written over our own incoming
+        // area, which is not done here.
+        if (normalizedRet.isIndirect || hiddenRetStorageReg.isValid())
+            return false;
+        if (preparedArgs.transientStackSize || !preparedArgs.postCallDrops.empty())
+            return false;
+
+        const AstNodeRef declRef = currentFunction.declNodeRef();
+        if (!declRef.isValid())
+            return false;
+        const AstNode& declNode = codeGen.node(declRef);
+        if (declNode.is(AstNodeId::CompilerFunc) || declNode.is(AstNodeId::CompilerRunBlock))
+            return false;
+
+        const CallConv&                        callConv   = CallConv::get(calledFunction.callConvKind());
+        const ABITypeNormalize::NormalizedType currentRet = ABITypeNormalize::normalize(codeGen.ctx(), callConv, currentFunction.returnTypeRef(), ABITypeNormalize::Usage::Return);
+        if (currentRet.isIndirect || currentRet.isVoid != normalizedRet.isVoid)
+            return false;
+        if (!currentRet.isVoid && (currentRet.isFloat != normalizedRet.isFloat || currentRet.numBits != normalizedRet.numBits))
+            return false;
+
+        for (uint32_t i = 0; i < preparedArgs.args.size(); ++i)
+        {
+            const ABICall::PreparedArg& arg = preparedArgs.args[i];
+            if (!callConv.canPassArgInRegister(i, arg.isFloat, arg.numBits))
+                return false;
+        }
+
+        return isTailCallPosition(codeGen, declRef);
+    }
+
     void emitFunctionCall(CodeGen& codeGen, const SymbolFunction& calledFunction, const ABICall::PreparedCall& preparedCall, MicroReg callTargetReg)
     {
         MicroBuilder&      builder      = codeGen.builder();
@@ -1752,7 +1839,13 @@ Result CodeGenCallHelpers::codeGenCallExprCommon(CodeGen& codeGen, AstNodeRef ca
     MicroReg                               callTargetReg     = MicroReg::invalid();
     MicroReg                               closureContextReg = MicroReg::invalid();
 
-    if (calleePayload)
+    // An interface method whose implementation is known is called directly; a likely one is
+    // called directly once the receiver's method table matches, and through the table otherwise.
+    CodeGenInterfaceHelpers::DevirtualizedCall devirtualized;
+    if (calleePayload && calledFunction->hasInterfaceMethodSlot())
+        SWC_RESULT(CodeGenInterfaceHelpers::resolveDevirtualizedCall(devirtualized, codeGen, *calleePayload, *calledFunction));
+
+    if (calleePayload && !devirtualized.isProven())
     {
         const ScopedDebugSource debugSource(builder, calleePayload->sourceCodeRef);
         CodeGenNodePayload      callablePayload = *calleePayload;
@@ -1793,9 +1886,7 @@ Result CodeGenCallHelpers::codeGenCallExprCommon(CodeGen& codeGen, AstNodeRef ca
             hiddenRetStorageReg = codeGen.runtimeStorageAddressReg(codeGen.curNodeRef());
     }
 
-    // prepareArgs handles register placement, stack slots, and hidden indirect return arg.
-    const ABICall::PreparedCall preparedCall       = ABICall::prepareArgs(builder, callConvKind, preparedArgs.args, normalizedRet, hiddenRetStorageReg);
-    TypeRef                     nodePayloadTypeRef = calledFunction->returnTypeRef();
+    TypeRef nodePayloadTypeRef = calledFunction->returnTypeRef();
     if (!nodePayloadTypeRef.isValid())
         nodePayloadTypeRef = currentTypeView.typeRef();
     CodeGenNodePayload& nodePayload = codeGen.setPayload(codeGen.curNodeRef(), nodePayloadTypeRef);
@@ -1805,7 +1896,43 @@ Result CodeGenCallHelpers::codeGenCallExprCommon(CodeGen& codeGen, AstNodeRef ca
         nodePayload.setRuntimeStorageSymbol(directVarInitStorageSym);
     else if (usesCurrentFunctionReturnStorage)
         nodePayload.setRuntimeStorageSymbol(nullptr);
-    emitFunctionCall(codeGen, *calledFunction, preparedCall, callTargetReg);
+
+    // The guarded form has two calls joining before the return, so neither is in tail position.
+    const bool tailCallCandidate = !devirtualized.isGuarded() && isTailCallCandidate(codeGen, *calledFunction, normalizedRet, preparedArgs, hiddenRetStorageReg);
+
+    // The guard's expected table is loaded before the arguments are placed, so only the compare
+    // and the branch sit between prepareArgs and either call.
+    MicroReg expectedTableReg;
+    if (devirtualized.isGuarded())
+        CodeGenInterfaceHelpers::emitLoadInterfaceMethodTableAddress(expectedTableReg, codeGen, devirtualized.tableCstRef);
+
+    // prepareArgs handles register placement, stack slots, and hidden indirect return arg.
+    const ABICall::PreparedCall preparedCall = ABICall::prepareArgs(builder, callConvKind, preparedArgs.args, normalizedRet, hiddenRetStorageReg);
+    if (devirtualized.isGuarded())
+    {
+        // Both calls consume the same placed arguments and return registers, so the paths only
+        // differ by the call instruction itself.
+        const MicroLabelRef labelSlow = builder.createLabel();
+        const MicroLabelRef labelDone = builder.createLabel();
+        builder.emitCmpRegReg(devirtualized.tableReg, expectedTableReg, MicroOpBits::B64);
+        builder.emitJumpToLabel(MicroCond::NotEqual, MicroOpBits::B32, labelSlow);
+        emitFunctionCall(codeGen, *devirtualized.target, preparedCall, MicroReg::invalid());
+        builder.emitJumpToLabel(MicroCond::Unconditional, MicroOpBits::B32, labelDone);
+        builder.placeLabel(labelSlow);
+        emitFunctionCall(codeGen, *calledFunction, preparedCall, callTargetReg);
+        builder.placeLabel(labelDone);
+    }
+    else if (devirtualized.isProven())
+    {
+        emitFunctionCall(codeGen, *devirtualized.target, preparedCall, MicroReg::invalid());
+    }
+    else
+    {
+        emitFunctionCall(codeGen, *calledFunction, preparedCall, callTargetReg);
+    }
+
+    if (tailCallCandidate)
+        builder.markLastCallTailCallCandidate();
     if (preparedArgs.transientStackSize)
         builder.emitOpBinaryRegImm(callConv.stackPointer, ApInt(preparedArgs.transientStackSize, 64), MicroOp::Add, MicroOpBits::B64);
 
@@ -1208,4 +1208,42 @@ void CodeGenFunctionHelpers::emitPersistCompilerRunValue(CodeGen& codeGen, TypeR
     ABICall::callReg(builder, callConvKind, targetReg, preparedCall);
 }
 
+// Counts down the calls of a baseline JIT function and asks for its optimized recompile when the
+// count reaches zero. The whole probe is erased again when the function is not lowered as baseline.
+void CodeGenFunctionHelpers::emitJitTierUpProbe(CodeGen& codeGen)
+{
+    constexpr auto callConvKind = CallConvKind::C;
+
+    SymbolFunction&     symbolFunc = codeGen.function();
+    MicroBuilder&       builder    = codeGen.builder();
+    const MicroLabelRef skipLabel  = builder.createLabel();
+    builder.beginJitTierUpProbe();
+
+    const MicroReg counterAddrReg = codeGen.nextVirtualIntRegister();
+    const MicroReg counterReg     = codeGen.nextVirtualIntRegister();
+    builder.emitLoadRegPtrImm(counterAddrReg, reinterpret_cast<uint64_t>(&symbolFunc.jitTierUpCounter()));
+    builder.emitLoadRegMem(counterReg, counterAddrReg, 0, MicroOpBits::B32);
+    builder.emitOpBinaryRegImm(counterReg, ApInt(1, 32), MicroOp::Subtract, MicroOpBits::B32);
+    builder.emitLoadMemReg(counterAddrReg, 0, counterReg, MicroOpBits::B32);
+    builder.emitCmpRegImm(counterReg, ApInt(0, 32), MicroOpBits::B32);
+    builder.emitJumpToLabel(MicroCond::NotZero, MicroOpBits::B32, skipLabel);
+
+    const MicroReg targetReg = codeGen.nextVirtualIntRegister();
+    builder.emitLoadRegPtrImm(targetReg, reinterpret_cast<uint64_t>(&SymbolFunction::onJitTierUpProbe));
+
+    const MicroReg functionReg = codeGen.nextVirtualIntRegister();
+    builder.emitLoadRegPtrImm(functionReg, reinterpret_cast<uint64_t>(&symbolFunc));
+
+    SmallVector<ABICall::PreparedArg> preparedArgs;
+    preparedArgs.push_back({.srcReg = functionReg, .numBits = 64});
+
+    const CallConv& callConv = CallConv::get(callConvKind);
+    CodeGenCallHelpers::isolatePreparedRegisterArgSources(codeGen, callConv, preparedArgs);
+    const ABICall::PreparedCall preparedCall = ABICall::prepareArgs(builder, callConvKind, preparedArgs.span());
+    ABICall::callReg(builder, callConvKind, targetReg, preparedCall);
+
+    builder.placeLabel(skipLabel);
+    builder.endJitTierUpProbe();
+}
+
 SWC_END_NAMESPACE();
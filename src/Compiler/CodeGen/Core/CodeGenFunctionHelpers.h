@@ -63,6 +63,7 @@ namespace CodeGenFunctionHelpers
     bool                  tryUseCurrentFunctionReturnStorageForDirectExpr(CodeGen& codeGen, AstNodeRef nodeRef, MicroReg& outStorageReg);
     bool                  needsPersistentCompilerRunReturn(const Sema& sema, TypeRef typeRef);
     void                  emitPersistCompilerRunValue(CodeGen& codeGen, TypeRef typeRef, MicroReg dstStorageReg, MicroReg srcStorageReg, MicroReg localStackBaseReg, uint32_t localStackSize);
+    void                  emitJitTierUpProbe(CodeGen& codeGen);
     Result                emitFallibleWrapperPreNode(CodeGen& codeGen, AstNodeRef nodeRef);
     Result                emitFallibleWrapperPostNode(CodeGen& codeGen, AstNodeRef nodeRef);
 }
@@ -2,6 +2,7 @@
 #include "Compiler/CodeGen/Core/CodeGenInterfaceHelpers.h"
 #include "Backend/Micro/MicroBuilder.h"
 #include "Compiler/CodeGen/Core/CodeGen.h"
+#include "Compiler/CodeGen/Core/CodeGenNodePayload.h"
 #include "Compiler/Sema/Constant/ConstantManager.h"
 #include "Compiler/Sema/Constant/ConstantValue.h"
 #include "Compiler/Sema/Symbol/Symbol.Function.h"
@@ -98,4 +99,31 @@ void CodeGenInterfaceHelpers::emitLoadInterfaceMethodTableAddress(MicroReg& outR
     codeGen.builder().emitLoadRegPtrReloc(outReg, reinterpret_cast<uint64_t>(tableCst.getArray().data()), tableCstRef);
 }
 
+Result CodeGenInterfaceHelpers::resolveDevirtualizedCall(DevirtualizedCall& outCall, CodeGen& codeGen, const CodeGenNodePayload& calleePayload, const SymbolFunction& interfaceMethod)
+{
+    outCall = {};
+    if (!calleePayload.interfaceImpl)
+        return Result::Continue;
+
+    const SymbolFunction* target = calleePayload.interfaceImpl->resolveInterfaceMethodTarget(codeGen.ctx(), interfaceMethod);
+    if (!target || target->isClosure() || target->callConvKind() != interfaceMethod.callConvKind())
+        return Result::Continue;
+
+    if (calleePayload.interfaceTableReg.isValid())
+    {
+        // The guard compares against the impl's own table, so it must exist by now. A table that
+        // cannot be built yet only costs the fast path, never the call.
+        InterfaceCastInfo castInfo;
+        castInfo.implSym = calleePayload.interfaceImpl;
+        SWC_RESULT(prepareInterfaceMethodTable(outCall.tableCstRef, codeGen, castInfo, true));
+        if (!outCall.tableCstRef.isValid())
+            return Result::Continue;
+        outCall.tableReg = calleePayload.interfaceTableReg;
+    }
+
+    codeGen.function().addCallDependency(target);
+    outCall.target = target;
+    return Result::Continue;
+}
+
 SWC_END_NAMESPACE();
@@ -5,7 +5,9 @@
 
 SWC_BEGIN_NAMESPACE();
 
+struct CodeGenNodePayload;
 class CodeGen;
+class SymbolFunction;
 class SymbolImpl;
 class SymbolInterface;
 class SymbolStruct;
@@ -21,9 +23,23 @@ namespace CodeGenInterfaceHelpers
         bool                  usingFieldIsPointer = false;
     };
 
+    // The concrete method an interface call reaches. Without 'tableReg' the target is proven and
+    // the call is direct; with it the target is the likely one, and the call compares the
+    // receiver's method table in 'tableReg' against 'tableCstRef' before calling it directly.
+    struct DevirtualizedCall
+    {
+        const SymbolFunction* target      = nullptr;
+        ConstantRef           tableCstRef = ConstantRef::invalid();
+        MicroReg              tableReg;
+
+        bool isProven() const { return target && !tableReg.isValid(); }
+        bool isGuarded() const { return target && tableReg.isValid(); }
+    };
+
     bool   resolveInterfaceCastInfo(CodeGen& codeGen, const SymbolStruct& srcStruct, const SymbolInterface& dstItf, InterfaceCastInfo& outInfo);
     Result prepareInterfaceMethodTable(ConstantRef& outRef, CodeGen& codeGen, const InterfaceCastInfo& castInfo, bool allowIncomplete = false);
     void   emitLoadInterfaceMethodTableAddress(MicroReg& outReg, CodeGen& codeGen, ConstantRef tableCstRef);
+    Result resolveDevirtualizedCall(DevirtualizedCall& outCall, CodeGen& codeGen, const CodeGenNodePayload& calleePayload, const SymbolFunction& interfaceMethod);
 }
 
 SWC_END_NAMESPACE();
@@ -6,11 +6,9 @@
 #include "Compiler/SourceFile.h"
 #include "Main/CompilerInstance.h"
 #include "Main/Stats.h"
+#include "Support/Core/Timer.h"
 #include "Support/Memory/MemoryProfile.h"
 #include "Support/Report/Assert.h"
-#if SWC_HAS_STATS
-#include "Support/Core/Timer.h"
-#endif
 
 SWC_BEGIN_NAMESPACE();
 
@@ -92,6 +90,13 @@ void CodeGenJob::initSemaAndCodeGen()
     codeGen_ = std::make_unique<CodeGen>(*ownedSema_);
 }
 
+void CodeGenJob::traceTarget(Utf8& outFile, Utf8& outSymbol) const
+{
+    if (const SourceFile* file = sema().file())
+        outFile = Utf8(file->path());
+    outSymbol = symbolFunc_->getFullScopedName(ctx());
+}
+
 JobResult CodeGenJob::exec()
 {
     SWC_MEM_SCOPE("Backend/CodeGen");
@@ -149,9 +154,7 @@ JobResult CodeGenJob::exec()
     if (!symbolFunc_->isCodeGenPreSolved())
     {
         SWC_ASSERT(root_.isValid());
-#if SWC_HAS_STATS
         Timer timeCodeGen(Stats::timedMetric(Stats::get().timeCodeGen));
-#endif
         const Result codeGenResult = codeGen_->exec(*symbolFunc_, root_);
         if (codeGenResult != Result::Continue)
             return abortCodeGen(ctx(), *symbolFunc_, codeGenResult);
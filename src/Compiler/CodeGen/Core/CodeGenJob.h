@@ -15,6 +15,7 @@ public:
 
     CodeGenJob(const TaskContext& ctx, Sema& sema, SymbolFunction& symbolFunc, AstNodeRef root);
     JobResult   exec() override;
+    void        traceTarget(Utf8& outFile, Utf8& outSymbol) const override;
     Sema&       sema() { return *ownedSema_; }
     const Sema& sema() const { return *ownedSema_; }
 
@@ -5,6 +5,8 @@
 
 SWC_BEGIN_NAMESPACE();
 
+class SymbolImpl;
+
 struct CodeGenNodePayload : CodeGenLoweringPayload
 {
     enum class StorageKind : uint8_t
@@ -25,6 +27,14 @@ struct CodeGenNodePayload : CodeGenLoweringPayload
     MicroLabelRef fallibleFunctionFailLabel    = MicroLabelRef::invalid();
     MicroLabelRef fallibleFunctionDoneLabel    = MicroLabelRef::invalid();
 
+    // Interface values and interface method callees: the implementation behind the receiver's
+    // method table. On a value it is a guess when 'interfaceImplGuessed' is set (a 'var' local
+    // that may have been reassigned since its cast). On a callee it is a guess when
+    // 'interfaceTableReg' is valid, and the call checks it against the table loaded there.
+    const SymbolImpl* interfaceImpl        = nullptr;
+    MicroReg          interfaceTableReg    = MicroReg::invalid();
+    bool              interfaceImplGuessed = false;
+
     void setIsValue() { storageKind = StorageKind::Value; }
     bool isValue() const { return storageKind == StorageKind::Value; }
     void setIsAddress() { storageKind = StorageKind::Address; }
@@ -2,32 +2,150 @@
 #include "Compiler/Lexer/LangSpec.h"
 #include "Compiler/Lexer/Token.h"
 #include "Support/Core/Utf8.h"
-#include "Support/Math/Hash.h"
-#include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
 
-void LangSpec::setup()
+namespace
 {
-    setupKeywords();
-    setupCharFlags();
-}
+    // Keyword recognition runs on every identifier the lexer meets, and the spellings are all
+    // known when the compiler is built. They get a hash-and-displace perfect hash: the bucket of
+    // a name gives a displacement, the displaced hash gives the one slot the name can live in,
+    // and a single compare settles it. The table is built and checked at compile time.
+    constexpr uint32_t KEYWORD_SLOTS          = 512;
+    constexpr uint32_t KEYWORD_BUCKETS        = 128;
+    constexpr uint32_t KEYWORD_MAX_PER_BUCKET = 16;
+    constexpr uint32_t KEYWORD_MAX_DISPLACE   = 0xFFFF;
+    constexpr uint8_t  KEYWORD_EMPTY_SLOT     = 0xFF;
 
-void LangSpec::setupKeywords()
-{
-#define SWC_TOKEN_DEF(__id, __name, __kind)                             \
-    if (Token::isSpecialWord(TokenId::__id))                            \
-    {                                                                   \
-        auto hash64 = Math::hash(__name);                               \
-        keywordMap_.insert_or_assign(__name, hash64, TokenId::__id);    \
-        keywordIdMap_[TokenId::__id] = __name;                          \
-        SWC_ASSERT(keywordMap_.contains(__name, hash64));               \
-        SWC_ASSERT(*keywordMap_.find(__name, hash64) == TokenId::__id); \
+    constexpr bool isSpecialWordInfo(const TokenIdInfo& info)
+    {
+        if (info.displayName.empty())
+            return false;
+        return info.kind.hasAny({TokenIdKindE::Keyword, TokenIdKindE::Compiler, TokenIdKindE::Intrinsic, TokenIdKindE::Type, TokenIdKindE::Modifier});
+    }
+
+    constexpr size_t countSpecialWords()
+    {
+        size_t count = 0;
+        for (const TokenIdInfo& info : TOKEN_ID_INFOS)
+        {
+            if (isSpecialWordInfo(info))
+                count++;
+        }
+
+        return count;
+    }
+
+    constexpr size_t KEYWORD_COUNT = countSpecialWords();
+    static_assert(KEYWORD_COUNT < KEYWORD_EMPTY_SLOT, "keyword slots store an 8-bit index");
+
+    constexpr uint32_t keywordHash(const std::string_view name)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char c : name)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    constexpr uint32_t keywordSlot(const uint32_t hash, const uint32_t displacement)
+    {
+        uint32_t x = hash ^ (displacement * 0x9E3779B9u);
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        return x & (KEYWORD_SLOTS - 1);
+    }
+
+    struct KeywordTable
+    {
+        std::array<TokenId, KEYWORD_COUNT>    ids{};
+        std::array<uint16_t, KEYWORD_BUCKETS> displacements{};
+        std::array<uint8_t, KEYWORD_SLOTS>    slots{};
+        bool                                  valid = false;
+    };
+
+    constexpr KeywordTable buildKeywordTable()
+    {
+        KeywordTable table;
+        table.slots.fill(KEYWORD_EMPTY_SLOT);
+
+        std::array<uint32_t, KEYWORD_COUNT> hashes{};
+        uint32_t                            numIds = 0;
+        for (size_t i = 0; i < TOKEN_ID_INFOS.size(); ++i)
+        {
+            if (!isSpecialWordInfo(TOKEN_ID_INFOS[i]))
+                continue;
+            table.ids[numIds] = static_cast<TokenId>(i);
+            hashes[numIds]    = keywordHash(TOKEN_ID_INFOS[i].displayName);
+            numIds++;
+        }
+
+        std::array<std::array<uint8_t, KEYWORD_MAX_PER_BUCKET>, KEYWORD_BUCKETS> buckets{};
+        std::array<uint32_t, KEYWORD_BUCKETS>                                    bucketSizes{};
+        for (uint32_t i = 0; i < numIds; ++i)
+        {
+            const uint32_t bucket = hashes[i] & (KEYWORD_BUCKETS - 1);
+            if (bucketSizes[bucket] == KEYWORD_MAX_PER_BUCKET)
+                return table;
+            buckets[bucket][bucketSizes[bucket]++] = static_cast<uint8_t>(i);
+        }
+
+        // Crowded buckets first, while most slots are still free.
+        std::array<uint32_t, KEYWORD_BUCKETS> order{};
+        for (uint32_t i = 0; i < KEYWORD_BUCKETS; ++i)
+            order[i] = i;
+        std::ranges::sort(order, [&](const uint32_t a, const uint32_t b) { return bucketSizes[a] > bucketSizes[b]; });
+
+        for (const uint32_t bucket : order)
+        {
+            const uint32_t size = bucketSizes[bucket];
+            if (!size)
+                break;
+
+            bool placed = false;
+            for (uint32_t displacement = 0; displacement <= KEYWORD_MAX_DISPLACE && !placed; ++displacement)
+            {
+                std::array<uint32_t, KEYWORD_MAX_PER_BUCKET> wanted{};
+                placed = true;
+                for (uint32_t k = 0; k < size && placed; ++k)
+                {
+                    wanted[k] = keywordSlot(hashes[buckets[bucket][k]], displacement);
+                    if (table.slots[wanted[k]] != KEYWORD_EMPTY_SLOT)
+                        placed = false;
+                    for (uint32_t j = 0; j < k && placed; ++j)
+                    {
+                        if (wanted[j] == wanted[k])
+                            placed = false;
+                    }
+                }
+
+                if (!placed)
+                    continue;
+
+                table.displacements[bucket] = static_cast<uint16_t>(displacement);
+                for (uint32_t k = 0; k < size; ++k)
+                    table.slots[wanted[k]] = buckets[bucket][k];
+            }
+
+            if (!placed)
+                return table;
+        }
+
+        table.valid = true;
+        return table;
     }
 
-#include "Compiler/Lexer/Tokens.Def.inc"
+    constexpr KeywordTable KEYWORD_TABLE = buildKeywordTable();
+    static_assert(KEYWORD_TABLE.valid, "no perfect hash for the keyword set: raise KEYWORD_SLOTS or KEYWORD_BUCKETS");
+}
 
-#undef SWC_TOKEN_DEF
+void LangSpec::setup()
+{
+    setupCharFlags();
 }
 
 void LangSpec::setupCharFlags()
@@ -117,17 +235,18 @@ void LangSpec::setupCharFlags()
     charFlags_['U'].add(CharFlagsE::Escape);
 }
 
-TokenId LangSpec::keyword(std::string_view name, uint32_t hash) const
+TokenId LangSpec::keyword(const std::string_view name) const
 {
-    const auto* ptr = keywordMap_.find(name, hash);
-    if (!ptr)
+    const uint32_t hash  = keywordHash(name);
+    const uint32_t slot  = keywordSlot(hash, KEYWORD_TABLE.displacements[hash & (KEYWORD_BUCKETS - 1)]);
+    const uint8_t  index = KEYWORD_TABLE.slots[slot];
+    if (index == KEYWORD_EMPTY_SLOT)
         return TokenId::Identifier;
-    return *ptr;
-}
 
-TokenId LangSpec::keyword(std::string_view name) const
-{
-    return keyword(name, Math::hash(name));
+    const TokenId id = KEYWORD_TABLE.ids[index];
+    if (TOKEN_ID_INFOS[static_cast<size_t>(id)].displayName != name)
+        return TokenId::Identifier;
+    return id;
 }
 
 bool LangSpec::isReservedNamespace(std::string_view ns)
@@ -1,6 +1,5 @@
 #pragma once
 #include "Support/Core/Flags.h"
-#include "Support/Core/StringMap.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -46,7 +45,7 @@ public:
     bool isEscape(uint32_t c) const { return c < 256 && charFlags_[c].has(CharFlagsE::Escape); }
     bool isOption(uint32_t c) const { return c < 256 && charFlags_[c].has(CharFlagsE::Option); }
 
-    TokenId keyword(std::string_view name, uint32_t hash) const;
+    // Keywords, compiler words, intrinsics, types and modifiers; anything else is an identifier.
     TokenId keyword(std::string_view name) const;
 
     static constexpr std::string_view VERIFY_COMMENT_OPTION   = "swc-option";
@@ -56,12 +55,9 @@ public:
     static bool isSpecOpName(std::string_view name);
 
 private:
-    CharFlags                                     charFlags_[256];
-    StringMap<TokenId>                            keywordMap_;
-    std::unordered_map<TokenId, std::string_view> keywordIdMap_;
+    CharFlags charFlags_[256];
 
     void setup();
-    void setupKeywords();
     void setupCharFlags();
 };
 
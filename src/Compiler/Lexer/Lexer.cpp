@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Compiler/Lexer/Lexer.h"
 #include "Compiler/Lexer/LangSpec.h"
+#include "Compiler/Lexer/LexerScan.h"
 #include "Main/Command/CommandLine.h"
 #include "Main/Global.h"
 #include "Main/Stats.h"
@@ -469,8 +470,13 @@ void Lexer::lexWhitespace()
     token_.id = TokenId::Whitespace;
 
     eatOne();
-    while (langSpec_->isWhiteSpace(buffer_[0]))
-        eatOne();
+    while (true)
+    {
+        buffer_ = LexerScan::skipBlanks(buffer_, endBuffer_);
+        if (!langSpec_->isEol(buffer_[0]))
+            break;
+        eatOneEol();
+    }
 
     pushToken();
 }
@@ -486,8 +492,12 @@ void Lexer::lexSingleLineStringLiteral()
     buffer_++;
 
     // Safe lookahead: zeros after endBuffer_ will stop the loop
-    while (buffer_ < endBuffer_ && buffer_[0] != '"' && buffer_[0] != '\n' && buffer_[0] != '\r')
+    while (true)
     {
+        buffer_ = LexerScan::findStringStop(buffer_, endBuffer_);
+        if (buffer_ >= endBuffer_ || buffer_[0] == '"' || buffer_[0] == '\n' || buffer_[0] == '\r')
+            break;
+
         // Check for null byte (invalid UTF-8)
         if (buffer_[0] == '\0')
         {
@@ -498,7 +508,7 @@ void Lexer::lexSingleLineStringLiteral()
 
         // Escaped char. A raw literal takes the backslash verbatim, so it never hides the
         // closing quote.
-        if (buffer_[0] == '\\' && !raw)
+        if (!raw)
         {
             token_.flags.add(TokenFlagsE::Escaped);
             lexEscape(TokenId::StringLine, false);
@@ -538,8 +548,12 @@ void Lexer::lexMultiLineStringLiteral()
 
     buffer_ += 3;
 
-    while (buffer_ < endBuffer_)
+    while (true)
     {
+        buffer_ = LexerScan::findStringStop(buffer_, endBuffer_);
+        if (buffer_ >= endBuffer_)
+            break;
+
         // Check for null byte (invalid UTF-8)
         if (buffer_[0] == '\0')
         {
@@ -588,9 +602,14 @@ void Lexer::lexRawStringLiteral()
 
     bool foundClosing = false;
 
-    // Safe to read buffer_[1] due to padding after endBuffer_
-    while (buffer_ < endBuffer_)
+    // Safe to read buffer_[1] due to padding after endBuffer_. A backslash stops the scan too,
+    // but means nothing here and is stepped over below.
+    while (true)
     {
+        buffer_ = LexerScan::findStringStop(buffer_, endBuffer_);
+        if (buffer_ >= endBuffer_)
+            break;
+
         // Check for null byte (invalid UTF-8)
         if (buffer_[0] == '\0')
         {
@@ -952,12 +971,31 @@ void Lexer::checkGlobalCompilerIfSkip() const
         srcView_->setMustSkip();
 }
 
+bool Lexer::skipsGlobalCompilerIf(const TaskContext& ctx, const SourceView& srcView, const LexerFlags flags)
+{
+    if (flags.has(LexerFlagsE::IgnoreGlobalCompilerIfSkip))
+        return false;
+
+    const LangSpec& langSpec = ctx.global().langSpec();
+    const auto*     base     = reinterpret_cast<const char8_t*>(srcView.stringView().data());
+    for (const Token& tok : srcView.tokens())
+    {
+        if (tok.id != TokenId::CompilerGlobal)
+            continue;
+
+        const char8_t* cursor = base + tok.byteStart + tok.byteLength;
+        skipBlanksRaw(langSpec, cursor);
+        if (evaluateRawGlobalIf(langSpec, ctx.cmdLine(), cursor) == GlobalIfValue::False)
+            return true;
+    }
+
+    return false;
+}
+
 void Lexer::lexIdentifier()
 {
     // Get identifier name
-    buffer_++;
-    while (langSpec_->isIdentifierPart(buffer_[0]))
-        buffer_++;
+    buffer_ = LexerScan::skipIdentifierPart(buffer_ + 1, endBuffer_);
 
     const auto name = std::string_view(reinterpret_cast<std::string_view::const_pointer>(startToken_), buffer_ - startToken_);
     if (name[0] == '#' && name.length() > 1 && name[1] >= 'A' && name[1] <= 'Z')
@@ -966,9 +1004,8 @@ void Lexer::lexIdentifier()
         token_.id = TokenId::Identifier;
     else
     {
-        // Is this a keyword?
-        const uint32_t hash32 = Math::hash(name);
-        token_.id             = ctx_->global().langSpec().keyword(name, hash32);
+        // Is this a keyword? Only a real identifier needs its hash.
+        token_.id = langSpec_->keyword(name);
         if (token_.id == TokenId::Identifier)
         {
             if (name[0] == '#')
@@ -980,7 +1017,7 @@ void Lexer::lexIdentifier()
                 raiseTokenError(DiagnosticId::lex_err_reserved_identifier, startTokenOffset_, static_cast<uint32_t>(name.size()));
 
             const auto idx = static_cast<uint32_t>(srcView_->identifiers().size());
-            srcView_->identifiers().push_back({.crc = hash32, .byteStart = token_.byteStart});
+            srcView_->identifiers().push_back({.crc = Math::hash(name), .byteStart = token_.byteStart});
             token_.byteStart = idx;
         }
 
@@ -1372,9 +1409,7 @@ void Lexer::lexSingleLineComment()
     buffer_ += 2;
 
     // Stop before EOL (LF or CR), do not consume it here.
-    // Safe lookahead: zeros after endBuffer_ will stop the loop
-    while (buffer_ < endBuffer_ && buffer_[0] != '\n' && buffer_[0] != '\r')
-        buffer_++;
+    buffer_ = LexerScan::findLineEnd(buffer_, endBuffer_);
 
     pushToken();
 }
@@ -1385,8 +1420,12 @@ void Lexer::lexMultiLineComment()
     buffer_ += 2;
 
     uint32_t depth = 1;
-    while (buffer_ < endBuffer_ && depth > 0)
+    while (depth > 0)
     {
+        buffer_ = LexerScan::findCommentStop(buffer_, endBuffer_);
+        if (buffer_ >= endBuffer_)
+            break;
+
         // Check for null byte (invalid UTF-8)
         if (buffer_[0] == '\0')
         {
@@ -1509,9 +1548,7 @@ void Lexer::tokenizeRaw(TaskContext& ctx, SourceView& srcView)
 void Lexer::tokenize(TaskContext& ctx, SourceView& srcView, LexerFlags flags)
 {
     SWC_MEM_SCOPE("Frontend/Lexer");
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeLexer));
-#endif
 
     srcView_ = &srcView;
     srcView_->tokens().clear();
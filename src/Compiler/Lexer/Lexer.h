@@ -28,6 +28,11 @@ class Lexer
 public:
     void tokenizeRaw(TaskContext& ctx, SourceView& srcView);
     void tokenize(TaskContext& ctx, SourceView& srcView, LexerFlags flags);
+    bool hasError() const { return hasFileError_; }
+
+    // Replays the '#global if' fast path on a view whose tokens did not come from this lexer,
+    // and tells whether the current command line would have skipped the file.
+    static bool skipsGlobalCompilerIf(const TaskContext& ctx, const SourceView& srcView, LexerFlags flags);
 
 private:
     Token token_     = {};
@@ -0,0 +1,352 @@
+#include "pch.h"
+#include "Compiler/Lexer/LexerCache.h"
+#include "Compiler/Lexer/SourceView.h"
+#include "Main/Command/CommandLine.h"
+#include "Main/FileSystem.h"
+#include "Main/Stats.h"
+#include "Main/TaskContext.h"
+#include "Main/Version.h"
+#include "Main/WorkspaceLayout.h"
+#include "Support/Core/Timer.h"
+#include "Support/Math/Sha256.h"
+#include "Support/Os/Os.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    constexpr std::string_view LEXER_CACHE_MAGIC   = "SWLX";
+    constexpr uint32_t         LEXER_CACHE_FORMAT  = 1;
+    constexpr std::string_view LEXER_CACHE_TMP_EXT = ".swctmp";
+
+    // Below this, opening and validating an entry costs about what lexing the file does.
+    constexpr size_t LEXER_CACHE_MIN_SOURCE_SIZE = 4 * 1024;
+
+    void countLookup(const bool hit)
+    {
+        if (Stats::enabledRuntime())
+            (hit ? Stats::get().numLexerCacheHits : Stats::get().numLexerCacheMisses).add(1);
+    }
+
+    std::array<uint8_t, 32> sha256Of(const std::string_view bytes)
+    {
+        return sha256(std::span{reinterpret_cast<const std::byte*>(bytes.data()), bytes.size()});
+    }
+
+    Utf8 digestToHex(const std::array<uint8_t, 32>& digest)
+    {
+        Utf8 result;
+        for (const uint8_t b : digest)
+            result += std::format("{:02x}", b);
+        return result;
+    }
+
+    class EntryWriter
+    {
+    public:
+        template<typename T>
+        void put(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* first = reinterpret_cast<const std::byte*>(&value);
+            bytes_.insert(bytes_.end(), first, first + sizeof(T));
+        }
+
+        void putToken(const Token& tok)
+        {
+            put(tok.byteStart);
+            put(tok.byteLength);
+            put(static_cast<uint16_t>(tok.id));
+            put(tok.flags.get());
+        }
+
+        const std::vector<std::byte>& bytes() const { return bytes_; }
+
+    private:
+        std::vector<std::byte> bytes_;
+    };
+
+    // Every read is bounds-checked: an entry is a file anybody can truncate or overwrite, and a
+    // bad one must read as a miss rather than as a token stream.
+    class EntryReader
+    {
+    public:
+        explicit EntryReader(const ByteArray& bytes) :
+            bytes_(&bytes)
+        {
+        }
+
+        template<typename T>
+        bool get(T& out)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (!bytes_->containsRange(offset_, sizeof(T)))
+                return false;
+            std::memcpy(&out, bytes_->data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return true;
+        }
+
+        bool getToken(Token& out)
+        {
+            uint16_t id    = 0;
+            uint16_t flags = 0;
+            if (!get(out.byteStart) || !get(out.byteLength) || !get(id) || !get(flags))
+                return false;
+            if (id >= static_cast<uint16_t>(TokenId::Count))
+                return false;
+            out.id    = static_cast<TokenId>(id);
+            out.flags = static_cast<TokenFlagsE>(flags);
+            return true;
+        }
+
+        // A count is only believed if that many records could still follow it.
+        bool getCount(uint32_t& out, const size_t recordSize)
+        {
+            if (!get(out))
+                return false;
+            return static_cast<size_t>(out) * recordSize <= bytes_->size() - offset_;
+        }
+
+        bool atEnd() const { return offset_ == bytes_->size(); }
+
+    private:
+        const ByteArray* bytes_  = nullptr;
+        size_t           offset_ = 0;
+    };
+
+    constexpr size_t TOKEN_RECORD_SIZE = sizeof(uint32_t) * 2 + sizeof(uint16_t) * 2;
+
+#if SWC_HAS_TOKEN_DEBUG_INFO
+    void restoreTokenDebugInfo(const TaskContext& ctx, SourceView& srcView, Token& tok)
+    {
+        const uint32_t offset = tok.id == TokenId::Identifier ? srcView.identifiers()[tok.byteStart].byteStart : tok.byteStart;
+        tok.dbgPtr            = reinterpret_cast<const char8_t*>(srcView.stringView().data()) + offset;
+        tok.dbgSrcView        = &srcView;
+        tok.dbgLoc.fromOffset(ctx, srcView, offset);
+    }
+#endif
+}
+
+LexerCache::LexerCache(const TaskContext& ctx, const SourceView& srcView, const LexerFlags flags) :
+    flags_(flags)
+{
+    const std::string_view content = srcView.stringView();
+    if (flags.has(LexerFlagsE::RawMode) || content.size() < LEXER_CACHE_MIN_SOURCE_SIZE)
+        return;
+
+    // The runtime files may use reserved identifiers, so the same bytes lex differently there.
+    Utf8 identity = std::format("swc {}.{}.{}\nformat={}\nflags={}\nruntime={}\ncontent=",
+                                SWC_VERSION,
+                                SWC_REVISION,
+                                SWC_BUILD_NUM,
+                                LEXER_CACHE_FORMAT,
+                                flags.get(),
+                                srcView.isRuntimeFile() ? 1 : 0);
+    identity += digestToHex(sha256Of(content));
+
+    identity_ = sha256Of(identity.view());
+    path_     = (WorkspaceLayout::lexerCacheRoot() / fs::path(digestToHex(identity_).c_str())).lexically_normal();
+    read_     = !ctx.cmdLine().rebuild;
+}
+
+bool LexerCache::load(TaskContext& ctx, SourceView& srcView) const
+{
+    Timer time(Stats::timedMetric(Stats::get().timeLexer));
+
+    if (!enabled())
+        return false;
+
+    ByteArray               bytes;
+    FileSystem::IoErrorInfo ioError;
+    if (!read_ || FileSystem::readBinaryFile(path_, bytes, ioError) != Result::Continue)
+    {
+        countLookup(false);
+        return false;
+    }
+
+    std::vector<Token>            tokens;
+    std::vector<uint32_t>         lines;
+    std::vector<SourceIdentifier> identifiers;
+    std::vector<SourceTrivia>     trivia;
+    std::vector<uint32_t>         triviaStart;
+    uint32_t                      sourceStartOffset = 0;
+
+    const auto readEntry = [&] {
+        EntryReader reader(bytes);
+
+        std::array<char, 4>     magic    = {};
+        uint32_t                format   = 0;
+        std::array<uint8_t, 32> identity = {};
+        if (!reader.get(magic) || std::string_view(magic.data(), magic.size()) != LEXER_CACHE_MAGIC)
+            return false;
+        if (!reader.get(format) || format != LEXER_CACHE_FORMAT)
+            return false;
+        if (!reader.get(identity) || identity != identity_)
+            return false;
+        if (!reader.get(sourceStartOffset))
+            return false;
+
+        uint32_t count = 0;
+        if (!reader.getCount(count, TOKEN_RECORD_SIZE))
+            return false;
+        tokens.resize(count);
+        for (Token& tok : tokens)
+        {
+            if (!reader.getToken(tok))
+                return false;
+        }
+
+        if (!reader.getCount(count, sizeof(uint32_t)))
+            return false;
+        lines.resize(count);
+        for (uint32_t& line : lines)
+        {
+            if (!reader.get(line))
+                return false;
+        }
+
+        if (!reader.getCount(count, sizeof(uint32_t) * 2))
+            return false;
+        identifiers.resize(count);
+        for (SourceIdentifier& ident : identifiers)
+        {
+            if (!reader.get(ident.crc) || !reader.get(ident.byteStart))
+                return false;
+        }
+
+        if (!reader.getCount(count, sizeof(uint32_t) + TOKEN_RECORD_SIZE))
+            return false;
+        trivia.resize(count);
+        for (SourceTrivia& entry : trivia)
+        {
+            uint32_t tokRef = 0;
+            if (!reader.get(tokRef) || !reader.getToken(entry.tok))
+                return false;
+            entry.tokRef = TokenRef{tokRef};
+        }
+
+        if (!reader.getCount(count, sizeof(uint32_t)))
+            return false;
+        triviaStart.resize(count);
+        for (uint32_t& start : triviaStart)
+        {
+            if (!reader.get(start))
+                return false;
+        }
+
+        if (!reader.atEnd() || tokens.empty() || lines.empty())
+            return false;
+
+        const size_t contentSize = srcView.stringView().size();
+        for (const Token& tok : tokens)
+        {
+            if (tok.id == TokenId::Identifier ? tok.byteStart >= identifiers.size() : tok.byteStart > contentSize)
+                return false;
+        }
+
+        return std::ranges::all_of(identifiers, [&](const SourceIdentifier& ident) { return ident.byteStart < contentSize; });
+    };
+
+    if (!readEntry())
+    {
+        countLookup(false);
+        return false;
+    }
+
+    srcView.tokens()      = std::move(tokens);
+    srcView.lines()       = std::move(lines);
+    srcView.identifiers() = std::move(identifiers);
+    srcView.trivia()      = std::move(trivia);
+    srcView.triviaStart() = std::move(triviaStart);
+    srcView.setSourceStartOffset(sourceStartOffset);
+
+#if SWC_HAS_TOKEN_DEBUG_INFO
+    for (Token& tok : srcView.tokens())
+        restoreTokenDebugInfo(ctx, srcView, tok);
+    for (SourceTrivia& entry : srcView.trivia())
+        restoreTokenDebugInfo(ctx, srcView, entry.tok);
+#endif
+
+    // The entry was stored before the command line had its say: a file this run skips is lexed
+    // again, so it stops where the lexer stops. The lexer only resets tokens and lines, so
+    // nothing of the entry may be left behind for it.
+    if (Lexer::skipsGlobalCompilerIf(ctx, srcView, flags_))
+    {
+        srcView.tokens().clear();
+        srcView.lines().clear();
+        srcView.identifiers().clear();
+        srcView.trivia().clear();
+        srcView.triviaStart().clear();
+        srcView.setSourceStartOffset(0);
+        countLookup(false);
+        return false;
+    }
+
+    Stats::get().numTokens.fetch_add(srcView.tokens().size(), std::memory_order_relaxed);
+    countLookup(true);
+    return true;
+}
+
+void LexerCache::store(const SourceView& srcView) const
+{
+    Timer time(Stats::timedMetric(Stats::get().timeLexer));
+
+    if (!enabled() || srcView.mustSkip())
+        return;
+
+    EntryWriter writer;
+    writer.put(std::array<char, 4>{LEXER_CACHE_MAGIC[0], LEXER_CACHE_MAGIC[1], LEXER_CACHE_MAGIC[2], LEXER_CACHE_MAGIC[3]});
+    writer.put(LEXER_CACHE_FORMAT);
+    writer.put(identity_);
+    writer.put(srcView.sourceStartOffset());
+
+    writer.put(static_cast<uint32_t>(srcView.tokens().size()));
+    for (const Token& tok : srcView.tokens())
+        writer.putToken(tok);
+
+    writer.put(static_cast<uint32_t>(srcView.lines().size()));
+    for (const uint32_t line : srcView.lines())
+        writer.put(line);
+
+    writer.put(static_cast<uint32_t>(srcView.identifiers().size()));
+    for (const SourceIdentifier& ident : srcView.identifiers())
+    {
+        writer.put(ident.crc);
+        writer.put(ident.byteStart);
+    }
+
+    writer.put(static_cast<uint32_t>(srcView.trivia().size()));
+    for (const SourceTrivia& entry : srcView.trivia())
+    {
+        writer.put(entry.tokRef.get());
+        writer.putToken(entry.tok);
+    }
+
+    writer.put(static_cast<uint32_t>(srcView.triviaStart().size()));
+    for (const uint32_t start : srcView.triviaStart())
+        writer.put(start);
+
+    // Written beside the entry under a name only this thread uses, then renamed into place, so
+    // a concurrent reader sees either the whole entry or none. A cache that cannot be written
+    // costs the next run a lex, nothing more, so failures are not reported.
+    std::error_code ec;
+    fs::create_directories(path_.parent_path(), ec);
+
+    fs::path tempPath = path_;
+    tempPath += std::format(".{}.{}{}", Os::currentProcessId(), Os::currentThreadId(), LEXER_CACHE_TMP_EXT);
+
+    FileSystem::IoErrorInfo ioError;
+    if (FileSystem::writeBinaryFile(tempPath, writer.bytes().data(), writer.bytes().size(), ioError) == Result::Continue)
+    {
+        ec.clear();
+        fs::rename(tempPath, path_, ec);
+        if (!ec)
+            return;
+    }
+
+    ec.clear();
+    fs::remove(tempPath, ec);
+}
+
+SWC_END_NAMESPACE();
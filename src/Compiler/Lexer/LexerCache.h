@@ -0,0 +1,31 @@
+#pragma once
+#include "Compiler/Lexer/Lexer.h"
+
+SWC_BEGIN_NAMESPACE();
+
+class TaskContext;
+
+// On-disk copy of what the lexer leaves in a source view: tokens, lines, identifiers and
+// trivia. An entry is named after the bytes it was lexed from, the compiler build and the
+// lexer flags, so it can only be found by a run that would have produced it again.
+//
+// Only a clean result is stored. A file that reports a lexer diagnostic is lexed every time,
+// which keeps the diagnostic, and a file skipped by '#global if' is too, because whether it
+// is skipped depends on the command line and not on its bytes.
+class LexerCache
+{
+public:
+    LexerCache(const TaskContext& ctx, const SourceView& srcView, LexerFlags flags);
+
+    bool enabled() const { return !path_.empty(); }
+    bool load(TaskContext& ctx, SourceView& srcView) const;
+    void store(const SourceView& srcView) const;
+
+private:
+    std::array<uint8_t, 32> identity_ = {};
+    fs::path                path_;
+    LexerFlags              flags_ = LexerFlagsE::Default;
+    bool                    read_  = false;
+};
+
+SWC_END_NAMESPACE();
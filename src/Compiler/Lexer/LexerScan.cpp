@@ -0,0 +1,189 @@
+#include "pch.h"
+#include "Compiler/Lexer/LexerScan.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define SWC_LEXER_SCAN_SSE2 1
+#include <emmintrin.h>
+#else
+#define SWC_LEXER_SCAN_SSE2 0
+#endif
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    bool isBlankByte(const char8_t c)
+    {
+        return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+    }
+
+    bool isIdentifierPartByte(const char8_t c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    bool isLineEndByte(const char8_t c)
+    {
+        return c == '\n' || c == '\r';
+    }
+
+    bool isStringStopByte(const char8_t c)
+    {
+        return c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\0';
+    }
+
+    bool isCommentStopByte(const char8_t c)
+    {
+        return c == '/' || c == '*' || c == '\n' || c == '\r' || c == '\0';
+    }
+
+    template<typename IS_STOP>
+    const char8_t* scanScalar(const char8_t* cur, const char8_t* end, IS_STOP isStop)
+    {
+        while (cur < end && !isStop(*cur))
+            cur++;
+        return cur;
+    }
+
+#if SWC_LEXER_SCAN_SSE2
+    __m128i eqByte(const __m128i block, const char c)
+    {
+        return _mm_cmpeq_epi8(block, _mm_set1_epi8(c));
+    }
+
+    // 'stopBits' maps sixteen bytes to a bit per byte that ends the scan. Whole blocks only: the
+    // tail shorter than a block goes through the scalar loop, so nothing past 'end' is read.
+    template<typename STOP_BITS, typename IS_STOP>
+    const char8_t* scanBlocks(const char8_t* cur, const char8_t* end, STOP_BITS stopBits, IS_STOP isStop)
+    {
+        while (end - cur >= 16)
+        {
+            const __m128i  block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+            const uint32_t bits  = stopBits(block);
+            if (bits)
+                return cur + std::countr_zero(bits);
+            cur += 16;
+        }
+
+        return scanScalar(cur, end, isStop);
+    }
+
+    uint32_t moveMask(const __m128i mask)
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+    }
+
+    // Signed compares: every byte from 0x80 up reads as negative and falls outside both ranges.
+    __m128i inRange(const __m128i block, const char lo, const char hi)
+    {
+        return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(lo - 1))), _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(hi + 1))));
+    }
+#endif
+}
+
+namespace LexerScan
+{
+    namespace Scalar
+    {
+        const char8_t* skipBlanks(const char8_t* cur, const char8_t* end)
+        {
+            return scanScalar(cur, end, [](const char8_t c) { return !isBlankByte(c); });
+        }
+
+        const char8_t* skipIdentifierPart(const char8_t* cur, const char8_t* end)
+        {
+            return scanScalar(cur, end, [](const char8_t c) { return !isIdentifierPartByte(c); });
+        }
+
+        const char8_t* findLineEnd(const char8_t* cur, const char8_t* end)
+        {
+            return scanScalar(cur, end, isLineEndByte);
+        }
+
+        const char8_t* findStringStop(const char8_t* cur, const char8_t* end)
+        {
+            return scanScalar(cur, end, isStringStopByte);
+        }
+
+        const char8_t* findCommentStop(const char8_t* cur, const char8_t* end)
+        {
+            return scanScalar(cur, end, isCommentStopByte);
+        }
+    }
+
+#if SWC_LEXER_SCAN_SSE2
+    const char8_t* skipBlanks(const char8_t* cur, const char8_t* end)
+    {
+        const auto stopBits = [](const __m128i block) {
+            const __m128i blank = _mm_or_si128(_mm_or_si128(eqByte(block, ' '), eqByte(block, '\t')), _mm_or_si128(eqByte(block, '\v'), eqByte(block, '\f')));
+            return ~moveMask(blank) & 0xFFFF;
+        };
+        return scanBlocks(cur, end, stopBits, [](const char8_t c) { return !isBlankByte(c); });
+    }
+
+    const char8_t* skipIdentifierPart(const char8_t* cur, const char8_t* end)
+    {
+        const auto stopBits = [](const __m128i block) {
+            const __m128i lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+            const __m128i part  = _mm_or_si128(_mm_or_si128(inRange(lower, 'a', 'z'), inRange(block, '0', '9')), eqByte(block, '_'));
+            return ~moveMask(part) & 0xFFFF;
+        };
+        return scanBlocks(cur, end, stopBits, [](const char8_t c) { return !isIdentifierPartByte(c); });
+    }
+
+    const char8_t* findLineEnd(const char8_t* cur, const char8_t* end)
+    {
+        const auto stopBits = [](const __m128i block) {
+            return moveMask(_mm_or_si128(eqByte(block, '\n'), eqByte(block, '\r')));
+        };
+        return scanBlocks(cur, end, stopBits, isLineEndByte);
+    }
+
+    const char8_t* findStringStop(const char8_t* cur, const char8_t* end)
+    {
+        const auto stopBits = [](const __m128i block) {
+            const __m128i quote = _mm_or_si128(eqByte(block, '"'), eqByte(block, '\\'));
+            const __m128i eol   = _mm_or_si128(eqByte(block, '\n'), eqByte(block, '\r'));
+            return moveMask(_mm_or_si128(_mm_or_si128(quote, eol), eqByte(block, '\0')));
+        };
+        return scanBlocks(cur, end, stopBits, isStringStopByte);
+    }
+
+    const char8_t* findCommentStop(const char8_t* cur, const char8_t* end)
+    {
+        const auto stopBits = [](const __m128i block) {
+            const __m128i nest = _mm_or_si128(eqByte(block, '/'), eqByte(block, '*'));
+            const __m128i eol  = _mm_or_si128(eqByte(block, '\n'), eqByte(block, '\r'));
+            return moveMask(_mm_or_si128(_mm_or_si128(nest, eol), eqByte(block, '\0')));
+        };
+        return scanBlocks(cur, end, stopBits, isCommentStopByte);
+    }
+#else
+    const char8_t* skipBlanks(const char8_t* cur, const char8_t* end)
+    {
+        return Scalar::skipBlanks(cur, end);
+    }
+
+    const char8_t* skipIdentifierPart(const char8_t* cur, const char8_t* end)
+    {
+        return Scalar::skipIdentifierPart(cur, end);
+    }
+
+    const char8_t* findLineEnd(const char8_t* cur, const char8_t* end)
+    {
+        return Scalar::findLineEnd(cur, end);
+    }
+
+    const char8_t* findStringStop(const char8_t* cur, const char8_t* end)
+    {
+        return Scalar::findStringStop(cur, end);
+    }
+
+    const char8_t* findCommentStop(const char8_t* cur, const char8_t* end)
+    {
+        return Scalar::findCommentStop(cur, end);
+    }
+#endif
+}
+
+SWC_END_NAMESPACE();
@@ -0,0 +1,31 @@
+#pragma once
+
+SWC_BEGIN_NAMESPACE();
+
+// Block scanners behind the lexer's inner loops. Each one returns the first byte in [cur, end)
+// the caller has to look at, or end when there is none. On x64 they test sixteen bytes per step
+// and never read at or past end; the scalar versions are the reference they are checked against.
+namespace LexerScan
+{
+    // Stops on anything but ' ', '\t', '\v' and '\f'.
+    const char8_t* skipBlanks(const char8_t* cur, const char8_t* end);
+    // Stops on anything but [A-Za-z0-9_], so on every non-ASCII byte too.
+    const char8_t* skipIdentifierPart(const char8_t* cur, const char8_t* end);
+    // Stops on '\n' and '\r'.
+    const char8_t* findLineEnd(const char8_t* cur, const char8_t* end);
+    // Stops on '"', '\\', '\n', '\r' and '\0'.
+    const char8_t* findStringStop(const char8_t* cur, const char8_t* end);
+    // Stops on '/', '*', '\n', '\r' and '\0'.
+    const char8_t* findCommentStop(const char8_t* cur, const char8_t* end);
+
+    namespace Scalar
+    {
+        const char8_t* skipBlanks(const char8_t* cur, const char8_t* end);
+        const char8_t* skipIdentifierPart(const char8_t* cur, const char8_t* end);
+        const char8_t* findLineEnd(const char8_t* cur, const char8_t* end);
+        const char8_t* findStringStop(const char8_t* cur, const char8_t* end);
+        const char8_t* findCommentStop(const char8_t* cur, const char8_t* end);
+    }
+}
+
+SWC_END_NAMESPACE();
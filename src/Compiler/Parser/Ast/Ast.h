@@ -105,10 +105,8 @@ public:
             local.second->setCodeRef(SourceCodeRef(activeSrcView.ref(), tokRef));
         }
 
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numAstNodes.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numAstNodes.add(1);
 
         std::pair<AstNodeRef, NodeType*> value{globalRef, local.second};
 #if SWC_HAS_REF_DEBUG_INFO
@@ -102,10 +102,8 @@ AstVisitResult AstVisit::stepPreStage(Frame& frame)
         SWC_ASSERT(frame.node->isNot(AstNodeId::Invalid));
         SWC_ASSERT(frame.node->id() < AstNodeId::Count);
 
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numVisitedAstNodes.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numVisitedAstNodes.add(1);
     }
 
     if (preNodeVisitor_ && frame.preNodeState != Frame::CallState::Done)
@@ -90,9 +90,7 @@ AstNodeRef Parser::parseGeneratedContent(const ParserGeneratedMode mode)
 AstNodeRef Parser::parseGenerated(TaskContext& ctx, Ast& ast, SourceView& srcView, const ParserGeneratedMode mode, const TokenRef startTokRef)
 {
     SWC_MEM_SCOPE("Frontend/Parser");
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeParser));
-#endif
 
     ctx_ = &ctx;
     ast_ = &ast;
@@ -537,9 +535,7 @@ void Parser::expectEndStatement()
 void Parser::parse(TaskContext& ctx, Ast& ast)
 {
     SWC_MEM_SCOPE("Frontend/Parser");
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeParser));
-#endif
 
     ctx_ = &ctx;
     ast_ = &ast;
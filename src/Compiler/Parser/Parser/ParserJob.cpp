@@ -1,11 +1,56 @@
 #include "pch.h"
 #include "Compiler/Parser/Parser/ParserJob.h"
+#include "Compiler/Lexer/LexerCache.h"
 #include "Compiler/Parser/Parser/Parser.h"
 #include "Compiler/SourceFile.h"
 #include "Compiler/Verify.h"
+#include "Main/CompilerInstance.h"
+#include "Main/Global.h"
+#include "Support/Thread/JobManager.h"
 
 SWC_BEGIN_NAMESPACE();
 
+namespace
+{
+    // Files a prefetch job claims at once. Mapping is cheap and the page reads it starts run in
+    // the background, so a job walks a few files before checking for the next batch.
+    constexpr uint32_t PREFETCH_BATCH = 4;
+
+    struct SourcePrefetchQueue
+    {
+        std::vector<SourceFile*> files;
+        std::atomic<uint32_t>    next = 0;
+    };
+
+    class SourcePrefetchJob : public Job
+    {
+    public:
+        static constexpr auto K = JobKind::SourcePrefetch;
+
+        SourcePrefetchJob(const TaskContext& ctx, std::shared_ptr<SourcePrefetchQueue> queue) :
+            Job(ctx, JobKind::SourcePrefetch),
+            queue_(std::move(queue))
+        {
+        }
+
+        JobResult exec() override
+        {
+            const uint32_t count = static_cast<uint32_t>(queue_->files.size());
+            for (uint32_t first = queue_->next.fetch_add(PREFETCH_BATCH, std::memory_order_relaxed); first < count; first = queue_->next.fetch_add(PREFETCH_BATCH, std::memory_order_relaxed))
+            {
+                const uint32_t last = std::min(first + PREFETCH_BATCH, count);
+                for (uint32_t i = first; i < last; ++i)
+                    queue_->files[i]->prefetchContent();
+            }
+
+            return JobResult::Done;
+        }
+
+    private:
+        std::shared_ptr<SourcePrefetchQueue> queue_;
+    };
+}
+
 ParserJob::ParserJob(const TaskContext& ctx, SourceFile* file, const ParserJobOptions options) :
     Job(ctx, JobKind::Parser),
     file_(file),
@@ -27,8 +72,15 @@ Result parseLoadedSourceFile(TaskContext& ctx, SourceFile& file, const ParserJob
     if (options.allowReservedIdentifiers)
         lexerFlags.add(LexerFlagsE::AllowReservedIdentifiers);
 
-    Lexer lexer;
-    lexer.tokenize(ctx, ast.srcView(), lexerFlags);
+    const LexerCache lexerCache(ctx, ast.srcView(), lexerFlags);
+    if (!lexerCache.load(ctx, ast.srcView()))
+    {
+        Lexer lexer;
+        lexer.tokenize(ctx, ast.srcView(), lexerFlags);
+        if (!lexer.hasError())
+            lexerCache.store(ast.srcView());
+    }
+
     if (ast.srcView().mustSkip())
         return Result::Continue;
 
@@ -41,6 +93,12 @@ Result parseLoadedSourceFile(TaskContext& ctx, SourceFile& file, const ParserJob
     return Result::Continue;
 }
 
+void ParserJob::traceTarget(Utf8& outFile, Utf8& outSymbol) const
+{
+    SWC_UNUSED(outSymbol);
+    outFile = Utf8(file_->path());
+}
+
 JobResult ParserJob::exec()
 {
     TaskContext& jobCtx = ctx();
@@ -50,4 +108,30 @@ JobResult ParserJob::exec()
     return toJobResult(jobCtx, parseLoadedSourceFile(jobCtx, *file_, options_));
 }
 
+void enqueueParserJobs(const CompilerInstance& compiler, const TaskContext& ctx, const std::span<SourceFile* const> files, const ParserJobOptions options)
+{
+    JobManager&       jobMgr   = ctx.global().jobMgr();
+    const JobClientId clientId = compiler.jobClientId();
+
+    // A quarter of the workers read ahead; the others start parsing right away and load
+    // whatever file the prefetch has not reached yet themselves.
+    const uint32_t numPrefetchJobs = jobMgr.isSingleThreaded() ? 0 : std::min(jobMgr.numWorkers() / 4, static_cast<uint32_t>(files.size()) / PREFETCH_BATCH);
+    if (numPrefetchJobs)
+    {
+        auto queue = std::make_shared<SourcePrefetchQueue>();
+        queue->files.assign(files.begin(), files.end());
+        for (uint32_t i = 0; i < numPrefetchJobs; ++i)
+        {
+            auto* job = compiler.makeJob<SourcePrefetchJob>(ctx, queue);
+            jobMgr.enqueue(*job, JobPriority::High, clientId);
+        }
+    }
+
+    for (SourceFile* file : files)
+    {
+        auto* job = compiler.makeJob<ParserJob>(ctx, file, options);
+        jobMgr.enqueue(*job, JobPriority::Normal, clientId);
+    }
+}
+
 SWC_END_NAMESPACE();
@@ -4,6 +4,7 @@
 
 SWC_BEGIN_NAMESPACE();
 
+class CompilerInstance;
 class SourceFile;
 
 struct ParserJobOptions
@@ -22,10 +23,15 @@ public:
     ParserJob(const TaskContext& ctx, SourceFile* file, ParserJobOptions options = {});
 
     JobResult exec() override;
+    void      traceTarget(Utf8& outFile, Utf8& outSymbol) const override;
 
 private:
     SourceFile*      file_ = nullptr;
     ParserJobOptions options_{};
 };
 
+// Enqueues one parser job per file, together with a few prefetch jobs that load the same files
+// in the same order at a higher priority, so that a parser job mostly finds its file in memory.
+void enqueueParserJobs(const CompilerInstance& compiler, const TaskContext& ctx, std::span<SourceFile* const> files, ParserJobOptions options = {});
+
 SWC_END_NAMESPACE();
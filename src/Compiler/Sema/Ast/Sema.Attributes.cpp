@@ -168,6 +168,8 @@ namespace
             {.name = IdentifierManager::PredefinedName::Compiler, .flag = RtAttributeFlagsE::Compiler},
             {.name = IdentifierManager::PredefinedName::Inline, .flag = RtAttributeFlagsE::Inline},
             {.name = IdentifierManager::PredefinedName::NoInline, .flag = RtAttributeFlagsE::NoInline},
+            {.name = IdentifierManager::PredefinedName::NoParallel, .flag = RtAttributeFlagsE::NoParallel},
+            {.name = IdentifierManager::PredefinedName::NoTailCall, .flag = RtAttributeFlagsE::NoTailCall},
             {.name = IdentifierManager::PredefinedName::PlaceHolder, .flag = RtAttributeFlagsE::PlaceHolder},
             {.name = IdentifierManager::PredefinedName::NoPrint, .flag = RtAttributeFlagsE::NoPrint},
             {.name = IdentifierManager::PredefinedName::Macro, .flag = RtAttributeFlagsE::Macro},
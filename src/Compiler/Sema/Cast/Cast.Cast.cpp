@@ -16,6 +16,7 @@
 #include "Compiler/Sema/Type/TypeGen.h"
 #include "Compiler/Sema/Type/TypeManager.h"
 #include "Support/Math/Helpers.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Report/Assert.h"
 #include "Support/Report/Diagnostic.h"
 
@@ -137,7 +138,7 @@ namespace
         return typeRef;
     }
 
-    Result collectAggregateStructConstantFieldValues(Sema& sema, SmallVector<ConstantRef>& outValues, ConstantRef srcCstRef, const TypeInfo& srcType)
+    Result collectAggregateStructConstantFieldValues(Sema& sema, ScratchSmallVector<ConstantRef>& outValues, ConstantRef srcCstRef, const TypeInfo& srcType)
     {
         const auto&          srcTypes = srcType.payloadAggregate().types;
         const ConstantValue& srcCst   = sema.cstMgr().get(srcCstRef);
@@ -206,11 +207,11 @@ namespace
         if (!castRequest.materializeConstantResult())
             return Result::Continue;
 
-        SmallVector<ConstantRef> srcValues;
+        ScratchSmallVector<ConstantRef> srcValues;
         SWC_RESULT(collectAggregateStructConstantFieldValues(sema, srcValues, castRequest.constantFoldingSrc(), srcType));
         SWC_ASSERT(srcValues.size() == srcAggregate.types.size());
 
-        SmallVector<ConstantRef> castedValues;
+        ScratchSmallVector<ConstantRef> castedValues;
         castedValues.reserve(srcValues.size());
         for (size_t i = 0; i < srcValues.size(); ++i)
         {
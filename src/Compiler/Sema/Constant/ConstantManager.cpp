@@ -12,57 +12,69 @@ namespace
 {
     void recordConstantBuiltinFastHit()
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstantBuiltinFastHits.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstantBuiltinFastHits.add(1);
     }
 
     void recordConstantSmallScalarCacheHit()
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstantSmallScalarCacheHits.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstantSmallScalarCacheHits.add(1);
     }
 
     void recordConstantSmallScalarCacheMiss()
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstantSmallScalarCacheMisses.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstantSmallScalarCacheMisses.add(1);
     }
 
     void recordConstantSlowPathCall()
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstantSlowPathCalls.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstantSlowPathCalls.add(1);
     }
 
     void recordConstantMaterializedPayloadFastPath()
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstantMaterializedPayloadFastPath.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstantMaterializedPayloadFastPath.add(1);
     }
 
-    uint32_t internStripeIndex(const ConstantValue& value)
+    void recordConstantFrontCacheHit()
     {
-        const uint32_t hash = Math::hash(value.hash());
-        return (hash >> ConstantManager::SHARD_BITS) & (ConstantManager::INTERN_STRIPE_COUNT - 1);
+        if (Stats::enabledRuntime())
+            Stats::get().numConstantFrontCacheHits.add(1);
     }
 
-    ConstantManager::InternStripe& internStripe(ConstantManager::Shard& shard, const ConstantValue& value)
+    void recordConstantInternRaceLost()
     {
-        return shard.internStripes[internStripeIndex(value)];
+        if (Stats::enabledRuntime())
+            Stats::get().numConstantInternRacesLost.add(1);
     }
+
+    // The type-keyed tables use the type ref itself as the hash, so a hash hit is a key hit.
+    constexpr auto MATCH_TYPE_KEY = [](uint32_t) { return true; };
+
+    // Each worker remembers where the constants it added last ended up, so a value it keeps
+    // asking for (a literal in a generic body, a default argument) is answered without touching
+    // the shared tables. An entry is only trusted after comparing the stored constant with the
+    // requested one; the owner tag keeps entries of a released manager out.
+    struct FrontCacheEntry
+    {
+        uint64_t owner = 0;
+        uint32_t hash  = 0;
+        uint32_t ref   = INVALID_REF;
+    };
+
+    constexpr uint32_t FRONT_CACHE_SIZE = 1024;
+
+    thread_local std::array<FrontCacheEntry, FRONT_CACHE_SIZE> t_frontCache;
+
+    std::atomic<uint64_t> g_nextInstanceId{1};
 }
 
-ConstantManager::ConstantManager()
+ConstantManager::ConstantManager() :
+    instanceId_(g_nextInstanceId.fetch_add(1, std::memory_order_relaxed))
 {
     for (auto& ref : smallScalarRefs_)
         ref.store(INVALID_REF, std::memory_order_relaxed);
@@ -214,10 +226,8 @@ namespace
 
     ConstantRef addCstFinalize(const ConstantManager& manager, ConstantRef cstRef)
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numConstants.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numConstants.add(1);
 
 #if SWC_HAS_REF_DEBUG_INFO
         cstRef.dbgPtr = &manager.get(cstRef);
@@ -225,85 +235,80 @@ namespace
         return cstRef;
     }
 
-    ConstantRef addCstSpanPayload(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const ConstantValue& value)
+    uint32_t addStoredConstant(ConstantManager::Shard& shard, const uint32_t shardIndex, const ConstantValue& stored)
     {
-        ConstantManager::InternStripe& stripe = internStripe(shard, value);
-        {
-            const std::shared_lock lk(stripe.mutex);
-            const auto             it = stripe.map.find(value);
-            if (it != stripe.map.end())
-                return it->second;
-        }
-
-        ConstantValue stored     = value;
-        uint32_t      localIndex = INVALID_REF;
-        ConstantRef   result;
-
-        const std::unique_lock lk(stripe.mutex);
-        const auto             existing = stripe.map.find(value);
-        if (existing != stripe.map.end())
-            return existing->second;
-
-        if (value.isStruct())
-        {
-            const auto [view, ref] = shard.dataSegment.addSpan(value.getStruct());
-            stored.setPayloadStruct(view);
-            stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
-        }
-        else if (value.isArray())
-        {
-            const auto [view, ref] = shard.dataSegment.addSpan(value.getArray());
-            stored                 = value;
-            stored.setPayloadArray(view);
-            stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
-        }
-        else
-        {
-            SWC_ASSERT(value.isSlice());
-            const auto [view, ref] = addStableSlicePayload(shard.dataSegment, value.getSlice(), value.getSliceCount());
-            stored                 = value;
-            stored.setPayloadSlice(view, value.getSliceCount());
-            stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
-        }
-
-        localIndex = shard.dataSegment.add(stored);
+        const uint32_t localIndex = shard.dataSegment.add(stored);
         SWC_ASSERT(localIndex < ConstantManager::LOCAL_MASK);
-        result = ConstantRef{(shardIndex << ConstantManager::LOCAL_BITS) | localIndex};
-        stripe.map.emplace(stored, result);
-        return addCstFinalize(manager, result);
+        return (shardIndex << ConstantManager::LOCAL_BITS) | localIndex;
+    }
+
+    // Returns the constant equal to `value`, or publishes the one `makeStored()` appends to the
+    // shard. When another worker publishes an equal constant first, ours stays in the segment
+    // unused: that is cheaper than making every insert wait on a lock.
+    template<typename MAKE>
+    ConstantRef internConstant(const ConstantManager& manager, ConstantManager::Shard& shard, const ConstantValue& value, const uint32_t hash, const MAKE& makeStored)
+    {
+        bool           made     = false;
+        bool           inserted = false;
+        const uint32_t ref      = shard.internTable.findOrInsert(
+            hash,
+            [&](const uint32_t candidate) { return manager.get(ConstantRef{candidate}) == value; },
+            [&] {
+                made = true;
+                return makeStored();
+            },
+            inserted);
+
+        if (inserted)
+            return addCstFinalize(manager, ConstantRef{ref});
+        if (made)
+            recordConstantInternRaceLost();
+
+        ConstantRef result{ref};
+#if SWC_HAS_REF_DEBUG_INFO
+        result.dbgPtr = &manager.get(result);
+#endif
+        return result;
     }
 
-    ConstantRef addCstString(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const TaskContext& ctx, const ConstantValue& value)
+    ConstantRef addCstSpanPayload(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const ConstantValue& value, const uint32_t hash)
     {
-        ConstantManager::InternStripe& stripe = internStripe(shard, value);
-        {
-            const std::shared_lock lk(stripe.mutex);
-            const auto             it = stripe.map.find(value);
-            if (it != stripe.map.end())
-                return it->second;
-        }
-
-        uint32_t    localIndex = INVALID_REF;
-        ConstantRef result;
+        return internConstant(manager, shard, value, hash, [&] {
+            ConstantValue stored = value;
+            if (value.isStruct())
+            {
+                const auto [view, ref] = shard.dataSegment.addSpan(value.getStruct());
+                stored.setPayloadStruct(view);
+                stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
+            }
+            else if (value.isArray())
+            {
+                const auto [view, ref] = shard.dataSegment.addSpan(value.getArray());
+                stored.setPayloadArray(view);
+                stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
+            }
+            else
+            {
+                SWC_ASSERT(value.isSlice());
+                const auto [view, ref] = addStableSlicePayload(shard.dataSegment, value.getSlice(), value.getSliceCount());
+                stored.setPayloadSlice(view, value.getSliceCount());
+                stored.setDataSegmentRef({.shardIndex = shardIndex, .offset = ref});
+            }
 
-        {
-            const std::unique_lock lk(stripe.mutex);
-            const auto             it = stripe.map.find(value);
-            if (it != stripe.map.end())
-                return it->second;
+            return addStoredConstant(shard, shardIndex, stored);
+        });
+    }
 
+    ConstantRef addCstString(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const TaskContext& ctx, const ConstantValue& value, const uint32_t hash)
+    {
+        return internConstant(manager, shard, value, hash, [&] {
             const std::pair<std::string_view, Ref> res      = shard.dataSegment.addString(value.getString());
             ConstantValue                          strValue = ConstantValue::makeString(ctx, res.first);
             if (ctx.typeMgr().get(value.typeRef()).isString())
                 strValue.setTypeRef(value.typeRef());
             strValue.setDataSegmentRef({.shardIndex = shardIndex, .offset = res.second});
-            localIndex = shard.dataSegment.add(strValue);
-            SWC_ASSERT(localIndex < ConstantManager::LOCAL_MASK);
-            result = ConstantRef{(shardIndex << ConstantManager::LOCAL_BITS) | localIndex};
-            stripe.map.emplace(strValue, result);
-        }
-
-        return addCstFinalize(manager, result);
+            return addStoredConstant(shard, shardIndex, strValue);
+        });
     }
 
     void updateStoredDataSegmentRef(ConstantManager::Shard& shard, const ConstantRef cstRef, const DataSegmentRef ref)
@@ -317,7 +322,8 @@ namespace
         if (!stored)
             return;
 
-        const DataSegmentRef storedRef = stored->dataSegmentRef();
+        const std::scoped_lock lock(shard.storedRefMutex);
+        const DataSegmentRef   storedRef = stored->dataSegmentRef();
         if (storedRef.isValid() && storedRef.shardIndex == ref.shardIndex && storedRef.offset == ref.offset)
             return;
 
@@ -340,7 +346,7 @@ namespace
             value.setDataSegmentRef(ref);
     }
 
-    ConstantRef addCstOther(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const ConstantValue& value)
+    ConstantRef addCstOther(const ConstantManager& manager, ConstantManager::Shard& shard, uint32_t shardIndex, const ConstantValue& value, const uint32_t hash)
     {
         ConstantValue stored                = value;
         bool          canDeduplicateByValue = true;
@@ -360,52 +366,12 @@ namespace
             }
         }
 
-        ConstantManager::InternStripe* stripe = canDeduplicateByValue ? &internStripe(shard, stored) : nullptr;
-        if (canDeduplicateByValue && stored.dataSegmentRef().isInvalid())
-        {
-            const std::shared_lock lk(stripe->mutex);
-            const auto             it = stripe->map.find(stored);
-            if (it != stripe->map.end())
-                return it->second;
-        }
-        else if (canDeduplicateByValue)
-        {
-            const std::unique_lock lk(stripe->mutex);
-            const auto             it = stripe->map.find(stored);
-            if (it != stripe->map.end())
-            {
-                updateStoredDataSegmentRef(shard, it->second, stored.dataSegmentRef());
-                return it->second;
-            }
-        }
-
-        uint32_t    localIndex = INVALID_REF;
-        ConstantRef result;
-        {
-            if (canDeduplicateByValue)
-            {
-                const std::unique_lock lk(stripe->mutex);
-                auto [it, inserted] = stripe->map.try_emplace(stored, ConstantRef{});
-                if (!inserted)
-                {
-                    updateStoredDataSegmentRef(shard, it->second, stored.dataSegmentRef());
-                    return it->second;
-                }
-
-                localIndex = shard.dataSegment.add(stored);
-                SWC_ASSERT(localIndex < ConstantManager::LOCAL_MASK);
-                result     = ConstantRef{(shardIndex << ConstantManager::LOCAL_BITS) | localIndex};
-                it->second = result;
-            }
-            else
-            {
-                localIndex = shard.dataSegment.add(stored);
-                SWC_ASSERT(localIndex < ConstantManager::LOCAL_MASK);
-                result = ConstantRef{(shardIndex << ConstantManager::LOCAL_BITS) | localIndex};
-            }
-        }
+        if (!canDeduplicateByValue)
+            return addCstFinalize(manager, ConstantRef{addStoredConstant(shard, shardIndex, stored)});
 
-        return addCstFinalize(manager, result);
+        const ConstantRef result = internConstant(manager, shard, stored, hash, [&] { return addStoredConstant(shard, shardIndex, stored); });
+        updateStoredDataSegmentRef(shard, result, stored.dataSegmentRef());
+        return result;
     }
 
     TypeRef normalizeTypeInfoTargetArray(Sema& sema, TypeRef typeRef)
@@ -487,17 +453,27 @@ ConstantRef ConstantManager::addConstant(const TaskContext& ctx, const ConstantV
             return cached;
 
         recordConstantSmallScalarCacheMiss();
-        const ConstantRef cstRef = addConstantSlow(ctx, value);
+        const ConstantRef cstRef = addConstantSlow(ctx, value, Math::hash(value.hash()));
         return publishSmallScalarCache(cacheIndex, cstRef);
     }
 
-    return addConstantSlow(ctx, value);
+    const uint32_t hash = Math::hash(value.hash());
+    if (!canUseFrontCache(value))
+        return addConstantSlow(ctx, value, hash);
+
+    const ConstantRef cached = tryGetFrontCache(value, hash);
+    if (cached.isValid())
+        return cached;
+
+    const ConstantRef cstRef = addConstantSlow(ctx, value, hash);
+    publishFrontCache(hash, cstRef);
+    return cstRef;
 }
 
-ConstantRef ConstantManager::addConstantSlow(const TaskContext& ctx, const ConstantValue& value)
+ConstantRef ConstantManager::addConstantSlow(const TaskContext& ctx, const ConstantValue& value, const uint32_t hash)
 {
     recordConstantSlowPathCall();
-    uint32_t      shardIndex          = Math::hash(value.hash()) & (SHARD_COUNT - 1);
+    uint32_t      shardIndex          = hash & (SHARD_COUNT - 1);
     const bool    isSpanValue         = value.isStruct() || value.isArray() || value.isSlice();
     bool          keepBorrowedPayload = false;
     ConstantValue valueToAdd          = value;
@@ -518,14 +494,14 @@ ConstantRef ConstantManager::addConstantSlow(const TaskContext& ctx, const Const
     if (isSpanValue)
     {
         if (keepBorrowedPayload)
-            return addCstOther(*this, shard, shardIndex, valueToAdd);
-        return addCstSpanPayload(*this, shard, shardIndex, valueToAdd);
+            return addCstOther(*this, shard, shardIndex, valueToAdd, hash);
+        return addCstSpanPayload(*this, shard, shardIndex, valueToAdd, hash);
     }
 
     if (valueToAdd.isString())
-        return addCstString(*this, shard, shardIndex, ctx, valueToAdd);
+        return addCstString(*this, shard, shardIndex, ctx, valueToAdd, hash);
 
-    return addCstOther(*this, shard, shardIndex, valueToAdd);
+    return addCstOther(*this, shard, shardIndex, valueToAdd, hash);
 }
 
 ConstantRef ConstantManager::addMaterializedPayloadConstant(const ConstantValue& value)
@@ -539,7 +515,7 @@ ConstantRef ConstantManager::addMaterializedPayloadConstant(const ConstantValue&
 
     recordConstantMaterializedPayloadFastPath();
     Shard& shard = shards_[dataRef.shardIndex];
-    return addCstOther(*this, shard, dataRef.shardIndex, value);
+    return addCstOther(*this, shard, dataRef.shardIndex, value, Math::hash(value.hash()));
 }
 
 ConstantRef ConstantManager::addUniqueMaterializedPayloadConstant(const ConstantValue& value)
@@ -600,20 +576,15 @@ ConstantRef ConstantManager::publishSmallScalarCache(const uint32_t cacheIndex,
     return cached;
 }
 
-ConstantRef ConstantManager::publishTypeInfoCache(Shard& shard, const TypeRef typeRef, const ConstantRef cstRef)
+ConstantRef ConstantManager::publishTypeInfoCache(Shard& shard, const TypeRef typeRef, const ConstantRef cstRef) const
 {
     SWC_ASSERT(typeRef.isValid());
     SWC_ASSERT(cstRef.isValid());
 
-    const std::unique_lock lk(shard.typeInfoMutex);
-    auto [it, inserted] = shard.typeInfoMap.try_emplace(typeRef, cstRef);
-    if (!inserted)
-    {
-        SWC_ASSERT(it->second == cstRef);
-        return it->second;
-    }
-
-    return cstRef;
+    bool           inserted = false;
+    const uint32_t raw      = shard.typeInfoTable.findOrInsert(typeRef.get(), MATCH_TYPE_KEY, [&] { return cstRef.get(); }, inserted);
+    SWC_ASSERT(inserted || raw == cstRef.get());
+    return constantRefFromRaw(raw);
 }
 
 ConstantRef ConstantManager::tryGetBuiltinConstant(const TaskContext& ctx, const ConstantValue& value) const
@@ -651,15 +622,50 @@ ConstantRef ConstantManager::tryGetSmallScalarCache(const uint32_t cacheIndex) c
     return constantRefFromRaw(raw);
 }
 
-ConstantRef ConstantManager::tryGetTypeInfoCache(const Shard& shard, const TypeRef typeRef)
+ConstantRef ConstantManager::tryGetTypeInfoCache(const Shard& shard, const TypeRef typeRef) const
 {
     SWC_ASSERT(typeRef.isValid());
 
-    const std::shared_lock lk(shard.typeInfoMutex);
-    const auto             it = shard.typeInfoMap.find(typeRef);
-    if (it == shard.typeInfoMap.end())
+    const uint32_t raw = shard.typeInfoTable.find(typeRef.get(), MATCH_TYPE_KEY);
+    if (raw == INVALID_REF)
         return ConstantRef::invalid();
-    return it->second;
+    return constantRefFromRaw(raw);
+}
+
+bool ConstantManager::canUseFrontCache(const ConstantValue& value)
+{
+    // Values the slow path rewrites before interning (borrowed payloads, pointers resolved to a
+    // data segment) or updates on a hit (a known data segment ref) always go to the shared table.
+    if ((value.isStruct() || value.isArray() || value.isSlice()) && value.isPayloadBorrowed())
+        return false;
+    if (value.isValuePointer() || value.isBlockPointer())
+        return false;
+    return value.dataSegmentRef().isInvalid();
+}
+
+ConstantRef ConstantManager::tryGetFrontCache(const ConstantValue& value, const uint32_t hash) const
+{
+    const FrontCacheEntry& entry = t_frontCache[hash & (FRONT_CACHE_SIZE - 1)];
+    if (entry.owner != instanceId_ || entry.hash != hash)
+        return ConstantRef::invalid();
+
+    const ConstantRef cstRef = constantRefFromRaw(entry.ref);
+    if (!(get(cstRef) == value))
+        return ConstantRef::invalid();
+
+    recordConstantFrontCacheHit();
+    return cstRef;
+}
+
+void ConstantManager::publishFrontCache(const uint32_t hash, const ConstantRef cstRef) const
+{
+    if (cstRef.isInvalid())
+        return;
+
+    FrontCacheEntry& entry = t_frontCache[hash & (FRONT_CACHE_SIZE - 1)];
+    entry.owner            = instanceId_;
+    entry.hash             = hash;
+    entry.ref              = cstRef.get();
 }
 
 uint32_t ConstantManager::zeroPayloadConstantCacheShard(const TypeRef typeRef)
@@ -673,12 +679,10 @@ ConstantRef ConstantManager::findZeroPayloadConstant(const uint32_t shardIndex,
     SWC_ASSERT(shardIndex < SHARD_COUNT);
     SWC_ASSERT(typeRef.isValid());
 
-    const Shard&           shard = shards_[shardIndex];
-    const std::shared_lock lock(shard.zeroPayloadMutex);
-    const auto             it = shard.zeroPayloadMap.find(typeRef);
-    if (it == shard.zeroPayloadMap.end())
+    const uint32_t raw = shards_[shardIndex].zeroPayloadTable.find(typeRef.get(), MATCH_TYPE_KEY);
+    if (raw == INVALID_REF)
         return ConstantRef::invalid();
-    return it->second;
+    return constantRefFromRaw(raw);
 }
 
 ConstantRef ConstantManager::publishZeroPayloadConstant(const uint32_t shardIndex, const TypeRef typeRef, const ConstantRef cstRef)
@@ -687,16 +691,9 @@ ConstantRef ConstantManager::publishZeroPayloadConstant(const uint32_t shardInde
     SWC_ASSERT(typeRef.isValid());
     SWC_ASSERT(cstRef.isValid());
 
-    Shard&                 shard = shards_[shardIndex];
-    const std::unique_lock lock(shard.zeroPayloadMutex);
-    auto [it, inserted] = shard.zeroPayloadMap.try_emplace(typeRef, cstRef);
-    if (!inserted)
-    {
-        SWC_ASSERT(it->second == cstRef);
-        return it->second;
-    }
-
-    return cstRef;
+    bool           inserted = false;
+    const uint32_t raw      = shards_[shardIndex].zeroPayloadTable.findOrInsert(typeRef.get(), MATCH_TYPE_KEY, [&] { return cstRef.get(); }, inserted);
+    return inserted ? cstRef : constantRefFromRaw(raw);
 }
 
 bool ConstantManager::smallScalarCacheIndex(uint32_t& outIndex, const TaskContext& ctx, const ConstantValue& value) const
@@ -5,6 +5,7 @@
 #include "Support/Core/RefTypes.h"
 #include "Support/Core/Result.h"
 #include "Support/Core/Utf8.h"
+#include "Support/Thread/ConcurrentRefTable.h"
 
 SWC_BEGIN_NAMESPACE();
 class CompilerInstance;
@@ -111,27 +112,22 @@ public:
         bool operator()(const RuntimeStringConstantCacheLookupKey& lhs, const RuntimeStringConstantCacheKey& rhs) const noexcept { return lhs.typeRef == rhs.typeRef && lhs.value == rhs.value.view(); }
     };
 
-    static constexpr uint32_t INTERN_STRIPE_BITS  = 4;
-    static constexpr uint32_t INTERN_STRIPE_COUNT = 1u << INTERN_STRIPE_BITS;
-
-    struct InternStripe
-    {
-        std::unordered_map<ConstantValue, ConstantRef, ConstantValueHash> map;
-        mutable std::shared_mutex                                         mutex;
-    };
+    static constexpr uint32_t TYPE_TABLE_CAPACITY = 256;
 
+    // Interned constants, type infos and zero payloads are looked up without a lock: the stored
+    // ConstantValue is appended to the data segment first, then its ref is published in a
+    // ConcurrentRefTable. The type-keyed tables match on the type ref alone, which is the hash.
     struct Shard
     {
         DataSegment                                                                                                                           dataSegment;
-        std::array<InternStripe, INTERN_STRIPE_COUNT>                                                                                         internStripes;
-        std::unordered_map<TypeRef, ConstantRef>                                                                                              typeInfoMap;
-        std::unordered_map<TypeRef, ConstantRef>                                                                                              zeroPayloadMap;
+        ConcurrentRefTable                                                                                                                    internTable;
+        ConcurrentRefTable                                                                                                                    typeInfoTable{TYPE_TABLE_CAPACITY};
+        ConcurrentRefTable                                                                                                                    zeroPayloadTable{TYPE_TABLE_CAPACITY};
         std::unordered_map<RuntimeBufferConstantCacheKey, ConstantRef, RuntimeBufferConstantCacheKeyHash>                                     runtimeBufferMap;
         std::unordered_map<RuntimeStringConstantCacheKey, ConstantRef, RuntimeStringConstantCacheKeyHash, RuntimeStringConstantCacheKeyEqual> runtimeStringMap;
-        mutable std::shared_mutex                                                                                                             typeInfoMutex;
-        mutable std::shared_mutex                                                                                                             zeroPayloadMutex;
         mutable std::shared_mutex                                                                                                             runtimeBufferMutex;
         mutable std::shared_mutex                                                                                                             runtimeStringMutex;
+        std::mutex                                                                                                                            storedRefMutex;
     };
 
     static constexpr uint32_t SHARD_BITS  = 4;
@@ -140,14 +136,17 @@ public:
     static constexpr uint32_t LOCAL_MASK  = (1u << LOCAL_BITS) - 1;
 
 private:
-    ConstantRef        addConstantSlow(const TaskContext& ctx, const ConstantValue& value);
+    ConstantRef        addConstantSlow(const TaskContext& ctx, const ConstantValue& value, uint32_t hash);
     ConstantRef        cachedS32(int32_t value) const;
     ConstantRef        constantRefFromRaw(uint32_t raw) const;
     ConstantRef        publishSmallScalarCache(uint32_t cacheIndex, ConstantRef cstRef);
-    static ConstantRef publishTypeInfoCache(Shard& shard, TypeRef typeRef, ConstantRef cstRef);
+    ConstantRef        publishTypeInfoCache(Shard& shard, TypeRef typeRef, ConstantRef cstRef) const;
     ConstantRef        tryGetBuiltinConstant(const TaskContext& ctx, const ConstantValue& value) const;
     ConstantRef        tryGetSmallScalarCache(uint32_t cacheIndex) const;
-    static ConstantRef tryGetTypeInfoCache(const Shard& shard, TypeRef typeRef);
+    ConstantRef        tryGetTypeInfoCache(const Shard& shard, TypeRef typeRef) const;
+    static bool        canUseFrontCache(const ConstantValue& value);
+    ConstantRef        tryGetFrontCache(const ConstantValue& value, uint32_t hash) const;
+    void               publishFrontCache(uint32_t hash, ConstantRef cstRef) const;
     static uint32_t    zeroPayloadConstantCacheShard(TypeRef typeRef);
     ConstantRef        findZeroPayloadConstant(uint32_t shardIndex, TypeRef typeRef) const;
     ConstantRef        publishZeroPayloadConstant(uint32_t shardIndex, TypeRef typeRef, ConstantRef cstRef);
@@ -162,6 +161,7 @@ private:
 
     Shard                                                     shards_[SHARD_COUNT];
     std::array<std::atomic<uint32_t>, SMALL_SCALAR_CACHE_LEN> smallScalarRefs_;
+    uint64_t                                                  instanceId_ = 0;
 
     ConstantRef cstBool_true_  = ConstantRef::invalid();
     ConstantRef cstBool_false_ = ConstantRef::invalid();
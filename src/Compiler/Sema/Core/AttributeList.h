@@ -41,6 +41,8 @@ enum class RtAttributeFlagsE : uint64_t
     NoDuplicate    = 1 << 25,
     NoDoc          = 1 << 26,
     OperatorIgnore = 1 << 27,
+    NoParallel     = 1 << 28,
+    NoTailCall     = 1 << 29,
 };
 using RtAttributeFlags = EnumFlags<RtAttributeFlagsE>;
 
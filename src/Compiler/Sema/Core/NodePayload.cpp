@@ -85,6 +85,14 @@ NodePayload::~NodePayload()
 {
     for (auto& shardRef : shards_)
         delete shardRef.load(std::memory_order_acquire);
+
+    const ResolvedCallArgs* record = resolvedCallArgsRecords_.load(std::memory_order_acquire);
+    while (record)
+    {
+        const ResolvedCallArgs* next = record->next;
+        delete record;
+        record = next;
+    }
 }
 
 NodePayload::StoredView NodePayload::viewStored(const TaskContext& ctx, AstNodeRef nodeRef) const
@@ -613,251 +621,145 @@ void NodePayload::updatePayloadFlags(AstNode& node, std::span<const Symbol*> sym
 void NodePayload::setResolvedCallArguments(AstNodeRef nodeRef, std::span<const ResolvedCallArgument> args)
 {
     SWC_ASSERT(nodeRef.isValid());
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
     if (args.empty())
     {
-        Shard* shard = tryGetShard(shardIdx);
-        if (!shard)
-            return;
+        resolvedCallArgs_.set(nodeRef, nullptr);
+        return;
+    }
 
-        const std::unique_lock lock(shard->resolvedCallArgsMutex);
-        shard->resolvedCallArgsByNode.erase(nodeRef);
+    // CodeGen re-assigns what sema already stored, for instance the count call of a 'for'
+    // loop, every time it lowers the node.
+    const ResolvedCallArgs* current = resolvedCallArgs_.get(nodeRef);
+    if (current && std::ranges::equal(current->args, args))
         return;
+
+    auto* record = new ResolvedCallArgs;
+    record->args.assign(args.begin(), args.end());
+    record->next = resolvedCallArgsRecords_.load(std::memory_order_relaxed);
+    while (!resolvedCallArgsRecords_.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed))
+    {
     }
 
-    Shard*                 shard = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->resolvedCallArgsMutex);
-    shard->resolvedCallArgsByNode[nodeRef].assign(args.begin(), args.end());
+    resolvedCallArgs_.set(nodeRef, record);
 }
 
 bool NodePayload::hasResolvedCallArguments(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return false;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return false;
-
-    const std::shared_lock lock(shard->resolvedCallArgsMutex);
-    return shard->resolvedCallArgsByNode.contains(nodeRef);
+    return resolvedCallArgs_.get(nodeRef) != nullptr;
 }
 
 void NodePayload::appendResolvedCallArguments(AstNodeRef nodeRef, SmallVector<ResolvedCallArgument>& out) const
 {
     if (nodeRef.isInvalid())
         return;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return;
 
-    const std::shared_lock lock(shard->resolvedCallArgsMutex);
-    const auto             it = shard->resolvedCallArgsByNode.find(nodeRef);
-    if (it == shard->resolvedCallArgsByNode.end())
+    const ResolvedCallArgs* record = resolvedCallArgs_.get(nodeRef);
+    if (!record)
         return;
 
-    out.append(it->second.data(), it->second.size());
+    out.append(record->args.data(), record->args.size());
 }
 
 bool NodePayload::hasLoweringPayload(AstNodeRef nodeRef) const
 {
-    if (nodeRef.isInvalid())
-        return false;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return false;
-
-    const std::shared_lock lock(shard->loweringPayloadsMutex);
-    const auto             it = shard->loweringPayloads.find(nodeRef);
-    return it != shard->loweringPayloads.end() && it->second != nullptr;
+    return getLoweringPayload(nodeRef) != nullptr;
 }
 
 void NodePayload::setLoweringPayload(AstNodeRef nodeRef, void* payload)
 {
     SWC_ASSERT(nodeRef.isValid());
     SWC_ASSERT(payload);
-    const uint32_t         shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*                 shard    = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->loweringPayloadsMutex);
-    shard->loweringPayloads[nodeRef] = payload;
+    loweringPayloads_.set(nodeRef, payload);
 }
 
 void* NodePayload::getLoweringPayload(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return nullptr;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return nullptr;
-
-    const std::shared_lock lock(shard->loweringPayloadsMutex);
-    const auto             it = shard->loweringPayloads.find(nodeRef);
-    if (it == shard->loweringPayloads.end())
-        return nullptr;
-    return it->second;
+    return loweringPayloads_.get(nodeRef);
 }
 
 bool NodePayload::hasSemaPayload(AstNodeRef nodeRef) const
 {
-    if (nodeRef.isInvalid())
-        return false;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return false;
-
-    const std::shared_lock lock(shard->semaPayloadsMutex);
-    const auto             it = shard->semaPayloads.find(nodeRef);
-    return it != shard->semaPayloads.end() && it->second != nullptr;
+    return getSemaPayload(nodeRef) != nullptr;
 }
 
 bool NodePayload::hasInlinePayload(AstNodeRef nodeRef) const
 {
-    if (nodeRef.isInvalid())
-        return false;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return false;
-
-    const std::shared_lock lock(shard->inlinePayloadsMutex);
-    const auto             it = shard->inlinePayloads.find(nodeRef);
-    return it != shard->inlinePayloads.end() && it->second != nullptr;
+    return getInlinePayload(nodeRef) != nullptr;
 }
 
 void NodePayload::setInlinePayload(AstNodeRef nodeRef, void* payload)
 {
     SWC_ASSERT(nodeRef.isValid());
     SWC_ASSERT(payload);
-    const uint32_t         shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*                 shard    = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->inlinePayloadsMutex);
-    SWC_ASSERT(!shard->inlinePayloads.contains(nodeRef));
-    shard->inlinePayloads[nodeRef] = payload;
+    SWC_ASSERT(!inlinePayloads_.get(nodeRef));
+    inlinePayloads_.set(nodeRef, payload);
 }
 
 void* NodePayload::getInlinePayload(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return nullptr;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return nullptr;
-
-    const std::shared_lock lock(shard->inlinePayloadsMutex);
-    const auto             it = shard->inlinePayloads.find(nodeRef);
-    if (it == shard->inlinePayloads.end())
-        return nullptr;
-    return it->second;
+    return inlinePayloads_.get(nodeRef);
 }
 
 bool NodePayload::hasInlineContextOverride(AstNodeRef nodeRef) const
 {
-    if (nodeRef.isInvalid())
-        return false;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return false;
-
-    const std::shared_lock lock(shard->inlineContextOverridesMutex);
-    const auto             it = shard->inlineContextOverrides.find(nodeRef);
-    return it != shard->inlineContextOverrides.end() && it->second != nullptr;
+    return getInlineContextOverride(nodeRef) != nullptr;
 }
 
 void NodePayload::setInlineContextOverride(AstNodeRef nodeRef, void* payload)
 {
     SWC_ASSERT(nodeRef.isValid());
     SWC_ASSERT(payload);
-    const uint32_t         shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*                 shard    = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->inlineContextOverridesMutex);
-    SWC_ASSERT(!shard->inlineContextOverrides.contains(nodeRef));
-    shard->inlineContextOverrides[nodeRef] = payload;
+    SWC_ASSERT(!inlineContextOverrides_.get(nodeRef));
+    inlineContextOverrides_.set(nodeRef, payload);
 }
 
 void* NodePayload::getInlineContextOverride(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return nullptr;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return nullptr;
-
-    const std::shared_lock lock(shard->inlineContextOverridesMutex);
-    const auto             it = shard->inlineContextOverrides.find(nodeRef);
-    if (it == shard->inlineContextOverrides.end())
-        return nullptr;
-    return it->second;
+    return inlineContextOverrides_.get(nodeRef);
 }
 
 void NodePayload::setSemaPayload(AstNodeRef nodeRef, void* payload)
 {
     SWC_ASSERT(nodeRef.isValid());
     SWC_ASSERT(payload);
-    const uint32_t         shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*                 shard    = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->semaPayloadsMutex);
-    SWC_ASSERT(!shard->semaPayloads.contains(nodeRef));
-    shard->semaPayloads[nodeRef] = payload;
+    SWC_ASSERT(!semaPayloads_.get(nodeRef));
+    semaPayloads_.set(nodeRef, payload);
 }
 
 void* NodePayload::getSemaPayload(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return nullptr;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return nullptr;
-
-    const std::shared_lock lock(shard->semaPayloadsMutex);
-    const auto             it = shard->semaPayloads.find(nodeRef);
-    if (it == shard->semaPayloads.end())
-        return nullptr;
-    return it->second;
+    return semaPayloads_.get(nodeRef);
 }
 
 void NodePayload::clearSemaPayload(AstNodeRef nodeRef)
 {
     if (nodeRef.isInvalid())
         return;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*         shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return;
-
-    const std::unique_lock lock(shard->semaPayloadsMutex);
-    shard->semaPayloads.erase(nodeRef);
+    semaPayloads_.set(nodeRef, nullptr);
 }
 
 void NodePayload::setConstAssignSourceParameter(AstNodeRef nodeRef, const SymbolVariable* sourceParam)
 {
     SWC_ASSERT(nodeRef.isValid());
     SWC_ASSERT(sourceParam);
-    const uint32_t         shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    Shard*                 shard    = ensureShard(shardIdx);
-    const std::unique_lock lock(shard->constAssignSourceParametersMutex);
-    shard->constAssignSourceParameters[nodeRef] = sourceParam;
+    constAssignSourceParameters_.set(nodeRef, sourceParam);
 }
 
 const SymbolVariable* NodePayload::getConstAssignSourceParameter(AstNodeRef nodeRef) const
 {
     if (nodeRef.isInvalid())
         return nullptr;
-    const uint32_t shardIdx = nodeRef.get() % NODE_PAYLOAD_SHARD_NUM;
-    const Shard*   shard    = tryGetShard(shardIdx);
-    if (!shard)
-        return nullptr;
-
-    const std::shared_lock lock(shard->constAssignSourceParametersMutex);
-    const auto             it = shard->constAssignSourceParameters.find(nodeRef);
-    return it == shard->constAssignSourceParameters.end() ? nullptr : it->second;
+    return constAssignSourceParameters_.get(nodeRef);
 }
 
 void NodePayload::propagatePayloadFlags(AstNode& nodeDst, const AstNode& nodeSrc, uint16_t mask, bool merge)
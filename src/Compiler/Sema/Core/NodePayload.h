@@ -1,5 +1,6 @@
 #pragma once
 #include "Compiler/Parser/Ast/Ast.h"
+#include "Compiler/Sema/Core/NodeSideTable.h"
 #include "Compiler/Sema/Symbol/Symbol.h"
 #include "Support/Core/RefTypes.h"
 
@@ -59,6 +60,8 @@ struct ResolvedCallArgument
     bool                    passUfcsAddressAsPointer = false;
     ConstantRef             typeInfoCstRef           = ConstantRef::invalid();
     ConstantRef             defaultCstRef            = ConstantRef::invalid();
+
+    bool operator==(const ResolvedCallArgument&) const = default;
 };
 
 class NodePayload
@@ -92,6 +95,7 @@ public:
 
     NodePayload() = default;
     ~NodePayload();
+
     bool            hasResolvedCallArguments(AstNodeRef nodeRef) const;
     StoredView      viewStored(const TaskContext& ctx, AstNodeRef nodeRef) const;
     ResolvedSymbols resolveSymbols(AstNodeRef nodeRef) const;
@@ -205,27 +209,30 @@ private:
 
     struct Shard
     {
-        mutable std::mutex                                    storeMutex;
-        mutable std::shared_mutex                             loweringPayloadsMutex;
-        mutable std::shared_mutex                             inlinePayloadsMutex;
-        mutable std::shared_mutex                             inlineContextOverridesMutex;
-        mutable std::shared_mutex                             semaPayloadsMutex;
-        mutable std::shared_mutex                             constAssignSourceParametersMutex;
-        mutable std::shared_mutex                             resolvedCallArgsMutex;
-        PagedStore                                            store;
-        std::unordered_map<AstNodeRef, void*>                 loweringPayloads;
-        std::unordered_map<AstNodeRef, void*>                 inlinePayloads;
-        std::unordered_map<AstNodeRef, void*>                 inlineContextOverrides;
-        std::unordered_map<AstNodeRef, void*>                 semaPayloads;
-        std::unordered_map<AstNodeRef, const SymbolVariable*> constAssignSourceParameters;
-
-        // Resolved call arguments are stored inline (not in `store`) so writing them only
-        // contends on `resolvedCallArgsMutex`, never on the hot `storeMutex` shared with the
-        // symbol/substitute payload writers.
-        std::unordered_map<AstNodeRef, SmallVector<ResolvedCallArgument, 4>> resolvedCallArgsByNode;
+        mutable std::mutex storeMutex;
+        PagedStore         store;
+    };
+
+    // A published argument list is never modified: assigning different arguments publishes a new
+    // record, and every record lives until the payload is destroyed, so readers need no lock.
+    // Assigning the arguments a node already has keeps its record.
+    struct ResolvedCallArgs
+    {
+        ResolvedCallArgs*                    next = nullptr;
+        SmallVector<ResolvedCallArgument, 4> args;
     };
 
     std::array<std::atomic<Shard*>, NODE_PAYLOAD_SHARD_NUM> shards_{};
+
+    // Dense per-node slots (see NodeSideTable): a lookup takes no lock, at the cost of one slot per
+    // 16-byte granule of any AST page a write has touched.
+    NodeSideTable<void>                 loweringPayloads_;
+    NodeSideTable<void>                 inlinePayloads_;
+    NodeSideTable<void>                 inlineContextOverrides_;
+    NodeSideTable<void>                 semaPayloads_;
+    NodeSideTable<const SymbolVariable> constAssignSourceParameters_;
+    NodeSideTable<ResolvedCallArgs>     resolvedCallArgs_;
+    std::atomic<ResolvedCallArgs*>      resolvedCallArgsRecords_{nullptr};
 };
 
 SWC_END_NAMESPACE();
@@ -0,0 +1,125 @@
+#pragma once
+#include "Compiler/Parser/Ast/Ast.h"
+#include "Compiler/Parser/Ast/AstNode.h"
+
+SWC_BEGIN_NAMESPACE();
+
+// One pointer slot per AST node, addressed by the node ref itself: the Ast shard picks a page
+// directory and the byte offset in the shard store picks the slot. Every node is at least one
+// granule long, so two nodes never share a slot. Reads and writes to an existing page are plain
+// atomic loads and stores; only creating a page or growing a directory takes the mutex, once per
+// PAGE_SIZE granules of AST. Pages are created on the first write that lands in them, so a table
+// that only a few nodes use stays small. Retired directories are kept alive until destruction.
+template<typename T>
+class NodeSideTable
+{
+public:
+    NodeSideTable() = default;
+
+    ~NodeSideTable()
+    {
+        for (const std::atomic<Directory*>& dir : dirs_)
+        {
+            const Directory* current = dir.load(std::memory_order_relaxed);
+            if (!current)
+                continue;
+            for (uint32_t i = 0; i < current->numPages; i++)
+                delete[] current->pages[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    NodeSideTable(const NodeSideTable&)            = delete;
+    NodeSideTable& operator=(const NodeSideTable&) = delete;
+
+    T* get(AstNodeRef nodeRef) const
+    {
+        const std::atomic<T*>* slot = findSlot(nodeRef);
+        return slot ? slot->load(std::memory_order_acquire) : nullptr;
+    }
+
+    void set(AstNodeRef nodeRef, T* value)
+    {
+        if (!value)
+        {
+            // Clearing never creates a page: a missing page already reads as null.
+            if (std::atomic<T*>* slot = findSlot(nodeRef))
+                slot->store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        ensureSlot(nodeRef).store(value, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t GRANULE_BITS = 4;
+    static constexpr uint32_t PAGE_BITS    = 9;
+    static constexpr uint32_t PAGE_SIZE    = 1u << PAGE_BITS;
+    static_assert(sizeof(AstNode) >= (1u << GRANULE_BITS));
+
+    struct Directory
+    {
+        explicit Directory(const uint32_t count) :
+            numPages(count),
+            pages(std::make_unique<std::atomic<std::atomic<T*>*>[]>(count))
+        {
+        }
+
+        uint32_t                                           numPages = 0;
+        std::unique_ptr<std::atomic<std::atomic<T*>*>[]> pages;
+    };
+
+    static uint32_t slotIndex(AstNodeRef nodeRef) { return Ast::refLocal(nodeRef.get()) >> GRANULE_BITS; }
+
+    std::atomic<T*>* findSlot(AstNodeRef nodeRef) const
+    {
+        SWC_ASSERT(nodeRef.isValid());
+        const uint32_t   index = slotIndex(nodeRef);
+        const Directory* dir   = dirs_[Ast::refShard(nodeRef.get())].load(std::memory_order_acquire);
+        if (!dir || (index >> PAGE_BITS) >= dir->numPages)
+            return nullptr;
+
+        std::atomic<T*>* page = dir->pages[index >> PAGE_BITS].load(std::memory_order_acquire);
+        return page ? &page[index & (PAGE_SIZE - 1)] : nullptr;
+    }
+
+    std::atomic<T*>& ensureSlot(AstNodeRef nodeRef)
+    {
+        if (std::atomic<T*>* slot = findSlot(nodeRef))
+            return *slot;
+
+        const uint32_t         index     = slotIndex(nodeRef);
+        const uint32_t         pageIndex = index >> PAGE_BITS;
+        std::atomic<Directory*>& dirRef  = dirs_[Ast::refShard(nodeRef.get())];
+
+        // Page creation and directory growth share the mutex, so a grow never copies a directory
+        // while a page is being installed in it.
+        const std::scoped_lock lock(mutex_);
+        Directory*             dir = dirRef.load(std::memory_order_acquire);
+        if (!dir || pageIndex >= dir->numPages)
+        {
+            const uint32_t wanted = std::bit_ceil(std::max(pageIndex + 1, dir ? dir->numPages * 2 : 8u));
+            auto           grown  = std::make_unique<Directory>(wanted);
+            for (uint32_t i = 0; dir && i < dir->numPages; i++)
+                grown->pages[i].store(dir->pages[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            dir = grown.get();
+            dirRef.store(dir, std::memory_order_release);
+            directories_.push_back(std::move(grown));
+        }
+
+        std::atomic<T*>* page = dir->pages[pageIndex].load(std::memory_order_acquire);
+        if (!page)
+        {
+            page = new std::atomic<T*>[PAGE_SIZE]{};
+            dir->pages[pageIndex].store(page, std::memory_order_release);
+        }
+
+        return page[index & (PAGE_SIZE - 1)];
+    }
+
+    std::array<std::atomic<Directory*>, Ast::SHARD_COUNT> dirs_{};
+    std::mutex                                            mutex_;
+    std::vector<std::unique_ptr<Directory>>               directories_;
+};
+
+SWC_END_NAMESPACE();
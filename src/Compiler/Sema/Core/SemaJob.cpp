@@ -1,12 +1,11 @@
 #include "pch.h"
 #include "Compiler/Sema/Core/SemaJob.h"
 #include "Compiler/Sema/Core/Sema.h"
+#include "Compiler/SourceFile.h"
 #include "Main/Global.h"
-#include "Support/Memory/MemoryProfile.h"
-#if SWC_HAS_STATS
 #include "Main/Stats.h"
 #include "Support/Core/Timer.h"
-#endif
+#include "Support/Memory/MemoryProfile.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -34,12 +33,17 @@ SemaJob::SemaJob(const TaskContext& ctx, Sema& parentSema, NodePayload& nodePayl
 {
 }
 
+void SemaJob::traceTarget(Utf8& outFile, Utf8& outSymbol) const
+{
+    SWC_UNUSED(outSymbol);
+    if (const SourceFile* file = sema_.file())
+        outFile = Utf8(file->path());
+}
+
 JobResult SemaJob::exec()
 {
     SWC_MEM_SCOPE("Sema");
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeSema));
-#endif
     const JobResult result = sema_.exec();
     if (result == JobResult::Done &&
         enqueueFullPassAfterDecl_ &&
@@ -21,6 +21,7 @@ public:
     SemaJob(const TaskContext& ctx, Sema& parentSema, AstNodeRef root);
     SemaJob(const TaskContext& ctx, Sema& parentSema, NodePayload& nodePayloadContext, AstNodeRef root);
     JobResult exec() override;
+    void      traceTarget(Utf8& outFile, Utf8& outSymbol) const override;
 
     Sema&       sema() { return sema_; }
     const Sema& sema() const { return sema_; }
@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "Compiler/Sema/Generic/GenericInstanceStorage.h"
+#include "Support/Math/Hash.h"
+#include "Support/Report/Assert.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    constexpr uint32_t INITIAL_INDEX_SLOTS = 16;
+}
+
+GenericInstanceStorage::GenericInstanceStorage()  = default;
+GenericInstanceStorage::~GenericInstanceStorage() = default;
+
+uint32_t GenericInstanceStorage::hashArgs(const std::span<const GenericInstanceKey> args) noexcept
+{
+    uint32_t result = Math::hash(static_cast<uint32_t>(args.size()));
+    for (const GenericInstanceKey& key : args)
+    {
+        result = Math::hashCombine(result, key.typeRef.get());
+        result = Math::hashCombine(result, key.cstRef.get());
+    }
+
+    return result;
+}
+
+bool GenericInstanceStorage::sameArgs(const std::span<const GenericInstanceKey> lhs, const std::span<const GenericInstanceKey> rhs) noexcept
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i] != rhs[i])
+            return false;
+    }
+
+    return true;
+}
+
+Symbol* GenericInstanceStorage::findNoLock(const std::span<const GenericInstanceKey> args) const
+{
+    const Index* index = publishedIndex_.load(std::memory_order_acquire);
+    if (!index)
+        return nullptr;
+
+    const uint32_t hash = hashArgs(args);
+    for (uint32_t slot = hash & index->mask;; slot = (slot + 1) & index->mask)
+    {
+        const GenericInstanceEntry* entry = index->slots[slot].load(std::memory_order_acquire);
+        if (!entry)
+            return nullptr;
+        if (entry->hash == hash && sameArgs(entry->args.span(), args))
+            return entry->symbol;
+    }
+}
+
+void GenericInstanceStorage::insertIntoIndex(const Index& index, const GenericInstanceEntry& entry)
+{
+    uint32_t slot = entry.hash & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed))
+        slot = (slot + 1) & index.mask;
+    index.slots[slot].store(&entry, std::memory_order_release);
+}
+
+// Keeps the index at most half full, so that a probe for a missing key stops early. A full
+// index is never grown in place: readers may be probing it, so the entries go to a new one
+// that replaces it once complete.
+const GenericInstanceStorage::Index& GenericInstanceStorage::indexForInsert()
+{
+    const Index* current = publishedIndex_.load(std::memory_order_relaxed);
+    if (current && (genericInstances_.size() + 1) * 2 <= current->mask + 1)
+        return *current;
+
+    const uint32_t numSlots = current ? (current->mask + 1) * 2 : INITIAL_INDEX_SLOTS;
+    auto           index    = std::make_unique<Index>();
+    index->mask             = numSlots - 1;
+    index->slots            = std::make_unique<std::atomic<const GenericInstanceEntry*>[]>(numSlots);
+    for (uint32_t i = 0; i < numSlots; ++i)
+        index->slots[i].store(nullptr, std::memory_order_relaxed);
+    for (const GenericInstanceEntry& entry : genericInstances_)
+        insertIntoIndex(*index, entry);
+
+    const Index* published = index.get();
+    indices_.push_back(std::move(index));
+    publishedIndex_.store(published, std::memory_order_release);
+    return *published;
+}
+
+Symbol* GenericInstanceStorage::addNoLock(const std::span<const GenericInstanceKey> args, Symbol* instance)
+{
+    if (auto* existing = findNoLock(args))
+        return existing;
+
+    const auto it = entryBySymbol_.find(instance);
+    if (it != entryBySymbol_.end())
+        return it->second->symbol;
+
+    const Index& index = indexForInsert();
+
+    GenericInstanceEntry& entry = genericInstances_.emplace_back();
+    entry.symbol                = instance;
+    entry.hash                  = hashArgs(args);
+    entry.args.assign(args.begin(), args.end());
+    entryBySymbol_[instance] = &entry;
+
+    insertIntoIndex(index, entry);
+    return instance;
+}
+
+SWC_END_NAMESPACE();
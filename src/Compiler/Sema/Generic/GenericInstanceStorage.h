@@ -21,14 +21,23 @@ struct GenericInstanceEntry
 {
     SmallVector<GenericInstanceKey> args;
     Symbol*                         symbol = nullptr;
+    uint32_t                        hash   = 0;
 };
 
+// Instances of one generic, indexed by their argument keys. Writers serialize on the mutex;
+// lookups by arguments take no lock at all. They probe an open-addressing index of entry
+// pointers that a writer fills in place and, when it runs out of room, rebuilds and publishes
+// whole. Entries never move and replaced indices stay alive with the storage, so a reader
+// holding an old one still reads valid memory and at worst misses an instance that is being
+// added, which the locked path in the caller finds again.
 class GenericInstanceStorage
 {
 public:
+    GenericInstanceStorage();
+    ~GenericInstanceStorage();
+
     Symbol* find(std::span<const GenericInstanceKey> args) const
     {
-        const std::shared_lock lock(genericMutex_);
         return findNoLock(args);
     }
 
@@ -41,62 +50,37 @@ public:
     bool tryGetArgs(const Symbol& instance, SmallVector<GenericInstanceKey>& outArgs) const
     {
         const std::shared_lock lock(genericMutex_);
-        const auto             it = genericInstanceIndices_.find(&instance);
-        if (it == genericInstanceIndices_.end())
+        const auto             it = entryBySymbol_.find(&instance);
+        if (it == entryBySymbol_.end())
             return false;
 
-        outArgs = genericInstances_[it->second].args;
+        outArgs = it->second->args;
         return true;
     }
 
     std::shared_mutex& getMutex() const noexcept { return genericMutex_; }
 
-    Symbol* findNoLock(std::span<const GenericInstanceKey> args) const
-    {
-        for (const auto& entry : genericInstances_)
-        {
-            if (sameArgs(entry.args.span(), args))
-                return entry.symbol;
-        }
-
-        return nullptr;
-    }
-
-    Symbol* addNoLock(std::span<const GenericInstanceKey> args, Symbol* instance)
-    {
-        if (auto* existing = findNoLock(args))
-            return existing;
-
-        const auto it = genericInstanceIndices_.find(instance);
-        if (it != genericInstanceIndices_.end())
-            return genericInstances_[it->second].symbol;
-
-        GenericInstanceEntry entry;
-        entry.symbol = instance;
-        entry.args.assign(args.begin(), args.end());
-        genericInstanceIndices_[instance] = genericInstances_.size();
-        genericInstances_.push_back(std::move(entry));
-        return instance;
-    }
+    Symbol* findNoLock(std::span<const GenericInstanceKey> args) const;
+    // Requires the exclusive lock.
+    Symbol* addNoLock(std::span<const GenericInstanceKey> args, Symbol* instance);
 
 private:
-    static bool sameArgs(std::span<const GenericInstanceKey> lhs, std::span<const GenericInstanceKey> rhs) noexcept
+    struct Index
     {
-        if (lhs.size() != rhs.size())
-            return false;
-
-        for (size_t i = 0; i < lhs.size(); ++i)
-        {
-            if (lhs[i] != rhs[i])
-                return false;
-        }
-
-        return true;
-    }
-
-    mutable std::shared_mutex                 genericMutex_;
-    std::vector<GenericInstanceEntry>         genericInstances_;
-    std::unordered_map<const Symbol*, size_t> genericInstanceIndices_;
+        uint32_t                                                    mask = 0;
+        std::unique_ptr<std::atomic<const GenericInstanceEntry*>[]> slots;
+    };
+
+    static uint32_t hashArgs(std::span<const GenericInstanceKey> args) noexcept;
+    static bool     sameArgs(std::span<const GenericInstanceKey> lhs, std::span<const GenericInstanceKey> rhs) noexcept;
+    static void     insertIntoIndex(const Index& index, const GenericInstanceEntry& entry);
+    const Index&    indexForInsert();
+
+    mutable std::shared_mutex                                      genericMutex_;
+    std::deque<GenericInstanceEntry>                               genericInstances_;
+    std::unordered_map<const Symbol*, const GenericInstanceEntry*> entryBySymbol_;
+    std::vector<std::unique_ptr<Index>>                            indices_;
+    std::atomic<const Index*>                                      publishedIndex_{nullptr};
 };
 
 SWC_END_NAMESPACE();
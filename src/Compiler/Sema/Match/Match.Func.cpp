@@ -20,6 +20,7 @@
 #include "Compiler/Sema/Symbol/Symbols.h"
 #include "Compiler/Sema/Type/TypeGen.h"
 #include "Compiler/Sema/Type/TypeInfo.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -353,11 +354,17 @@ namespace
         bool isReceiver = false;
     };
 
+    // Overload resolution runs for every call and never keeps its candidates past it, so the lists
+    // spill into the job scratch arena rather than the heap.
+    using AttemptList        = ScratchSmallVector<Attempt>;
+    using AttemptPtrList     = ScratchSmallVector<const Attempt*>;
+    using FunctionSymbolList = ScratchSmallVector<SymbolFunction*>;
+
     struct CandidateAttempts
     {
-        SmallVector<Attempt>         attempts;
-        SmallVector<SymbolFunction*> functions;
-        SmallVector<const Attempt*>  viable;
+        AttemptList        attempts;
+        FunctionSymbolList functions;
+        AttemptPtrList     viable;
     };
 
     AstNodeRef getCallArg(uint32_t callArgIndex, std::span<AstNodeRef> args, AstNodeRef ufcsArg)
@@ -1132,7 +1139,7 @@ namespace
         return Result::Error;
     }
 
-    Result errorNoOverloadMatch(Sema& sema, const SemaNodeView& nodeCallee, const SmallVector<Attempt>& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg)
+    Result errorNoOverloadMatch(Sema& sema, const SemaNodeView& nodeCallee, const AttemptList& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg)
     {
         const TaskContext& ctx = sema.ctx();
 
@@ -2075,7 +2082,7 @@ namespace
     // Evaluate every reachable function symbol in source order. Generic roots are probed
     // through speculative instantiation; concrete functions are probed first as regular
     // calls and then, if relevant, as UFCS/member-style calls with an injected receiver.
-    Result collectAttempts(Sema& sema, SmallVector<Attempt>& outAttempts, SmallVector<SymbolFunction*>& outFunctionSymbols, std::span<Symbol* const> symbols, std::span<AstNodeRef> args, AstNodeRef ufcsArg, std::span<const AstNodeRef> explicitGenericArgNodes, Match::ResolveCallMode mode)
+    Result collectAttempts(Sema& sema, AttemptList& outAttempts, FunctionSymbolList& outFunctionSymbols, std::span<Symbol* const> symbols, std::span<AstNodeRef> args, AstNodeRef ufcsArg, std::span<const AstNodeRef> explicitGenericArgNodes, Match::ResolveCallMode mode)
     {
         outAttempts.clear();
         outFunctionSymbols.clear();
@@ -2210,7 +2217,7 @@ namespace
     bool bindsReferenceToValue(Sema& sema, TypeRef paramTypeRef, AstNodeRef argRef);
     bool movesValueToParam(Sema& sema, TypeRef paramTypeRef, AstNodeRef argRef);
 
-    void gatherViableAttempts(const SmallVector<Attempt>& attempts, SmallVector<const Attempt*>& outViable)
+    void gatherViableAttempts(const AttemptList& attempts, AttemptPtrList& outViable)
     {
         outViable.clear();
         outViable.reserve(attempts.size());
@@ -2228,7 +2235,7 @@ namespace
         return Result::Continue;
     }
 
-    const Attempt* bestAttemptNoDiagnostics(Sema& sema, const SmallVector<const Attempt*>& viable, AstNodeRef ufcsArg)
+    const Attempt* bestAttemptNoDiagnostics(Sema& sema, const AttemptPtrList& viable, AstNodeRef ufcsArg)
     {
         if (viable.empty())
             return nullptr;
@@ -2243,7 +2250,7 @@ namespace
         return best;
     }
 
-    bool fallbackHasBetterCandidate(Sema& sema, const SmallVector<const Attempt*>& currentViable, const SmallVector<const Attempt*>& fallbackViable, AstNodeRef ufcsArg)
+    bool fallbackHasBetterCandidate(Sema& sema, const AttemptPtrList& currentViable, const AttemptPtrList& fallbackViable, AstNodeRef ufcsArg)
     {
         const Attempt* currentBest  = bestAttemptNoDiagnostics(sema, currentViable, ufcsArg);
         const Attempt* fallbackBest = bestAttemptNoDiagnostics(sema, fallbackViable, ufcsArg);
@@ -2341,7 +2348,7 @@ namespace
         return Result::Continue;
     }
 
-    Result raiseAmbiguousBest(Sema& sema, AstNodeRef calleeRef, const SmallVector<const Attempt*>& viable, const Candidate& best, AstNodeRef ufcsArg)
+    Result raiseAmbiguousBest(Sema& sema, AstNodeRef calleeRef, const AttemptPtrList& viable, const Candidate& best, AstNodeRef ufcsArg)
     {
         SmallVector<const Symbol*> ambiguousSymbols;
         for (const Attempt* a : viable)
@@ -2353,7 +2360,7 @@ namespace
         return SemaError::raiseAmbiguousSymbol(sema, calleeRef, ambiguousSymbols);
     }
 
-    Result raiseNoSelection(Sema& sema, const SemaNodeView& nodeCallee, const SmallVector<SymbolFunction*>& functions, const SmallVector<Attempt>& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg)
+    Result raiseNoSelection(Sema& sema, const SemaNodeView& nodeCallee, const FunctionSymbolList& functions, const AttemptList& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg)
     {
         if (functions.empty())
             return errorNotCallable(sema, nodeCallee);
@@ -2378,7 +2385,7 @@ namespace
     // Select exactly one viable candidate. Ambiguity is computed after all tie-breakers,
     // except for special assignment operators where keeping declaration order is part of
     // the language rule.
-    Result selectBestAttempt(Sema& sema, const SemaNodeView& nodeCallee, const SmallVector<const Attempt*>& viable, const SmallVector<SymbolFunction*>& functions, const SmallVector<Attempt>& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg, const Attempt*& outSelected)
+    Result selectBestAttempt(Sema& sema, const SemaNodeView& nodeCallee, const AttemptPtrList& viable, const FunctionSymbolList& functions, const AttemptList& attempts, std::span<AstNodeRef> args, AstNodeRef ufcsArg, const Attempt*& outSelected)
     {
         if (viable.empty())
             return raiseNoSelection(sema, nodeCallee, functions, attempts, args, ufcsArg);
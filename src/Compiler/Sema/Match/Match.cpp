@@ -9,6 +9,7 @@
 #include "Compiler/Sema/Symbol/SymbolMap.h"
 #include "Compiler/Sema/Symbol/Symbols.h"
 #include "Compiler/SourceFile.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -214,7 +215,7 @@ namespace
         return followNamespacePath(importRoot, nsPath.first(1));
     }
 
-    Result addUsingMemberSymMaps(Sema& sema, MatchContext& lookUpCxt, const SymbolStruct& symStruct, std::unordered_set<const SymbolStruct*>& visited)
+    Result addUsingMemberSymMaps(Sema& sema, MatchContext& lookUpCxt, const SymbolStruct& symStruct, ScratchUnorderedSet<const SymbolStruct*>& visited)
     {
         if (!visited.insert(&symStruct).second)
             return Result::Continue;
@@ -291,8 +292,8 @@ namespace
             // Struct member lookup must also see members of `using` fields.
             if (lookUpCxt.symMapHint->isStruct())
             {
-                const auto&                             structSym = lookUpCxt.symMapHint->cast<SymbolStruct>();
-                std::unordered_set<const SymbolStruct*> visited;
+                const auto&                              structSym = lookUpCxt.symMapHint->cast<SymbolStruct>();
+                ScratchUnorderedSet<const SymbolStruct*> visited;
                 SWC_RESULT(addUsingMemberSymMaps(sema, lookUpCxt, structSym, visited));
             }
 
@@ -10,6 +10,52 @@
 
 SWC_BEGIN_NAMESPACE();
 
+namespace
+{
+    constexpr size_t NAME_CHUNK_SIZE = 64 * 1024;
+
+    std::atomic<uint64_t> g_nextInstanceId{1};
+
+    // Tagged with the manager it belongs to, so a thread that outlives one manager (unit tests
+    // create several) never writes into the chunks of a released one.
+    struct ThreadNameChunk
+    {
+        uint64_t   owner = 0;
+        std::byte* cur   = nullptr;
+        size_t     left  = 0;
+    };
+
+    thread_local ThreadNameChunk t_nameChunk;
+}
+
+struct IdentifierManager::NameChunk
+{
+    NameChunk* next = nullptr;
+};
+
+IdentifierManager::IdentifierManager() :
+    instanceId_(g_nextInstanceId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+IdentifierManager::~IdentifierManager()
+{
+    for (Shard& shard : shards_)
+    {
+        for (std::atomic<Identifier*>& page : shard.pages)
+            delete[] page.load(std::memory_order_relaxed);
+    }
+
+    NameChunk* chunk = nameChunks_.load(std::memory_order_relaxed);
+    while (chunk)
+    {
+        NameChunk* next = chunk->next;
+        chunk->~NameChunk();
+        operator delete(chunk);
+        chunk = next;
+    }
+}
+
 void IdentifierManager::setup(const TaskContext& ctx)
 {
     SWC_UNUSED(ctx);
@@ -33,6 +79,8 @@ void IdentifierManager::setup(const TaskContext& ctx)
         {.name = PredefinedName::Compiler, .str = "Compiler"},
         {.name = PredefinedName::Inline, .str = "Inline"},
         {.name = PredefinedName::NoInline, .str = "NoInline"},
+        {.name = PredefinedName::NoParallel, .str = "NoParallel"},
+        {.name = PredefinedName::NoTailCall, .str = "NoTailCall"},
         {.name = PredefinedName::Optimize, .str = "Optimize"},
         {.name = PredefinedName::PlaceHolder, .str = "PlaceHolder"},
         {.name = PredefinedName::NoPrint, .str = "NoPrint"},
@@ -244,55 +292,74 @@ IdentifierRef IdentifierManager::addIdentifierInternal(std::string_view name, ui
 {
     const uint32_t shardIndex = hash & (SHARD_COUNT - 1);
     SWC_ASSERT(shardIndex < SHARD_COUNT);
-    auto&          shard       = shards_[shardIndex];
-    const uint32_t stripeIndex = (hash >> SHARD_BITS) & (INTERN_STRIPE_COUNT - 1);
-    auto&          stripe      = shard.internStripes[stripeIndex];
+    Shard&         shard      = shards_[shardIndex];
 
     // Most identifiers point directly into source buffers and are never copied.
-    // Owned/synthetic names opt into shard storage below so every interned string
-    // view remains valid for the compiler lifetime.
-    {
-        const std::shared_lock lk(stripe.mutex);
-        if (const auto* it = stripe.map.find(name, hash))
-            return *it;
-    }
+    // Owned/synthetic names are copied once they turn out to be new, so every
+    // interned string view remains valid for the compiler lifetime.
+    bool           inserted = false;
+    const uint32_t refValue = shard.table.findOrInsert(
+        hash,
+        [&](const uint32_t ref) { return get(IdentifierRef{ref}).name == name; },
+        [&] { return (shardIndex << LOCAL_BITS) | newRecord(shard, copyName ? storeOwnedName(name) : name); },
+        inserted);
+
+    if (inserted && Stats::enabledRuntime())
+        Stats::get().numIdentifiers.add(1);
+    return makeRef(refValue);
+}
 
-    const std::unique_lock lk(stripe.mutex);
-    if (const auto* it = stripe.map.find(name, hash))
-        return *it;
+IdentifierRef IdentifierManager::makeRef(uint32_t refValue) const
+{
+    auto result = IdentifierRef{refValue};
+#if SWC_HAS_REF_DEBUG_INFO
+    result.dbgPtr = &get(result);
+#endif
+    return result;
+}
+
+uint32_t IdentifierManager::newRecord(Shard& shard, std::string_view name)
+{
+    const uint32_t localIndex = shard.numRecords.fetch_add(1, std::memory_order_relaxed);
+    SWC_ASSERT(localIndex < MAX_PAGES * PAGE_SIZE);
 
-    std::string_view storedName = name;
-    if (copyName && !name.empty())
+    std::atomic<Identifier*>& page    = shard.pages[localIndex >> PAGE_BITS];
+    Identifier*               records = page.load(std::memory_order_acquire);
+    if (!records)
     {
-        // Copy before inserting into the map: the transparent lookup compares
-        // string_view contents, but the stored key must not reference a temporary.
-        const std::scoped_lock storeLock(shard.storeMutex);
-        const auto [span, _] = shard.stringStore.pushCopySpan(std::span{reinterpret_cast<const std::byte*>(name.data()), name.size()});
-        storedName           = std::string_view{reinterpret_cast<const char*>(span.data()), span.size()};
+        auto fresh = std::make_unique<Identifier[]>(PAGE_SIZE);
+        if (page.compare_exchange_strong(records, fresh.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+            records = fresh.release();
     }
 
-    const auto [it, inserted] = stripe.map.try_emplace(storedName, hash, IdentifierRef{});
-    if (!inserted)
-        return *it;
+    records[localIndex & (PAGE_SIZE - 1)].name = name;
+    return localIndex;
+}
 
-#if SWC_HAS_STATS
-    if (Stats::enabledRuntime())
-        Stats::get().numIdentifiers.fetch_add(1, std::memory_order_relaxed);
-#endif
+std::string_view IdentifierManager::storeOwnedName(std::string_view name)
+{
+    if (name.empty())
+        return name;
 
-    uint32_t localIndex = INVALID_REF;
+    ThreadNameChunk& chunk = t_nameChunk;
+    if (chunk.owner != instanceId_ || chunk.left < name.size())
     {
-        const std::scoped_lock storeLock(shard.storeMutex);
-        localIndex = shard.store.pushBack(Identifier{storedName});
-        SWC_ASSERT(localIndex < LOCAL_MASK);
-    }
+        const size_t size   = std::max(NAME_CHUNK_SIZE, name.size());
+        auto*        header = new (operator new(sizeof(NameChunk) + size)) NameChunk;
+        header->next        = nameChunks_.load(std::memory_order_relaxed);
+        while (!nameChunks_.compare_exchange_weak(header->next, header, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
 
-    auto result = IdentifierRef{(shardIndex << LOCAL_BITS) | localIndex};
-#if SWC_HAS_REF_DEBUG_INFO
-    result.dbgPtr = &get(result);
-#endif
+        chunk.owner = instanceId_;
+        chunk.cur   = reinterpret_cast<std::byte*>(header + 1);
+        chunk.left  = size;
+    }
 
-    *it = result;
+    std::memcpy(chunk.cur, name.data(), name.size());
+    const std::string_view result{reinterpret_cast<const char*>(chunk.cur), name.size()};
+    chunk.cur += name.size();
+    chunk.left -= name.size();
     return result;
 }
 
@@ -301,8 +368,10 @@ const Identifier& IdentifierManager::get(IdentifierRef idRef) const
     SWC_ASSERT(idRef.isValid());
     const auto shardIndex = idRef.get() >> LOCAL_BITS;
     SWC_ASSERT(shardIndex < SHARD_COUNT);
-    const auto localIndex = idRef.get() & LOCAL_MASK;
-    return *(shards_[shardIndex].store.ptr<Identifier>(localIndex));
+    const auto        localIndex = idRef.get() & LOCAL_MASK;
+    const Identifier* records    = shards_[shardIndex].pages[localIndex >> PAGE_BITS].load(std::memory_order_acquire);
+    SWC_ASSERT(records);
+    return records[localIndex & (PAGE_SIZE - 1)];
 }
 
 IdentifierManager::RuntimeFunctionKind IdentifierManager::runtimeFunctionKind(const IdentifierRef idRef) const
@@ -1,8 +1,7 @@
 ﻿#pragma once
 #include "Compiler/Lexer/SourceCodeRange.h"
-#include "Support/Core/PagedStore.h"
 #include "Support/Core/RefTypes.h"
-#include "Support/Core/StringMap.h"
+#include "Support/Thread/ConcurrentRefTable.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -63,6 +62,8 @@ public:
         Compiler,
         Inline,
         NoInline,
+        NoParallel,
+        NoTailCall,
         Optimize,
         PlaceHolder,
         NoPrint,
@@ -175,6 +176,12 @@ public:
         Count,
     };
 
+    IdentifierManager();
+    ~IdentifierManager();
+
+    IdentifierManager(const IdentifierManager&)            = delete;
+    IdentifierManager& operator=(const IdentifierManager&) = delete;
+
     void                setup(const TaskContext& ctx);
     IdentifierRef       addIdentifier(const TaskContext& ctx, const SourceCodeRef& codeRef);
     IdentifierRef       addIdentifier(std::string_view name);
@@ -187,30 +194,36 @@ public:
     RuntimeFunctionKind runtimeFunctionKind(IdentifierRef idRef) const;
 
 private:
-    IdentifierRef addIdentifierInternal(std::string_view name, uint32_t hash, bool copyName);
+    // Interning runs for every identifier token on every worker, so it takes no lock: an insert
+    // writes its Identifier first, then publishes it in the shard's ConcurrentRefTable.
+    static constexpr uint32_t SHARD_BITS  = 3;
+    static constexpr uint32_t SHARD_COUNT = 1u << SHARD_BITS;
+    static constexpr uint32_t LOCAL_BITS  = 32 - SHARD_BITS;
+    static constexpr uint32_t LOCAL_MASK  = (1u << LOCAL_BITS) - 1;
 
-    static constexpr uint32_t INTERN_STRIPE_BITS  = 4;
-    static constexpr uint32_t INTERN_STRIPE_COUNT = 1u << INTERN_STRIPE_BITS;
-
-    struct InternStripe
-    {
-        StringMap<IdentifierRef>  map;
-        mutable std::shared_mutex mutex;
-    };
+    static constexpr uint32_t INITIAL_TABLE_CAPACITY = 4096;
+    static constexpr uint32_t PAGE_BITS              = 12;
+    static constexpr uint32_t PAGE_SIZE              = 1u << PAGE_BITS;
+    static constexpr uint32_t MAX_PAGES              = 4096;
 
     struct Shard
     {
-        PagedStore                                    store;
-        PagedStore                                    stringStore;
-        std::array<InternStripe, INTERN_STRIPE_COUNT> internStripes;
-        mutable std::mutex                            storeMutex;
+        ConcurrentRefTable                              table{INITIAL_TABLE_CAPACITY};
+        std::atomic<uint32_t>                           numRecords{0};
+        std::array<std::atomic<Identifier*>, MAX_PAGES> pages{};
     };
 
-    static constexpr uint32_t SHARD_BITS  = 3;
-    static constexpr uint32_t SHARD_COUNT = 1u << SHARD_BITS;
-    static constexpr uint32_t LOCAL_BITS  = 32 - SHARD_BITS;
-    static constexpr uint32_t LOCAL_MASK  = (1u << LOCAL_BITS) - 1;
-    Shard                     shards_[SHARD_COUNT];
+    // Owned names are copied into chunks that each thread fills on its own.
+    struct NameChunk;
+
+    IdentifierRef    addIdentifierInternal(std::string_view name, uint32_t hash, bool copyName);
+    IdentifierRef    makeRef(uint32_t refValue) const;
+    uint32_t         newRecord(Shard& shard, std::string_view name);
+    std::string_view storeOwnedName(std::string_view name);
+
+    Shard                   shards_[SHARD_COUNT];
+    std::atomic<NameChunk*> nameChunks_{nullptr};
+    uint64_t                instanceId_ = 0;
 
     std::array<IdentifierRef, static_cast<size_t>(PredefinedName::Count)>      predefined_       = {};
     std::array<IdentifierRef, static_cast<size_t>(RuntimeFunctionKind::Count)> runtimeFunctions_ = {};
@@ -8,12 +8,13 @@
 #include "Compiler/Sema/Symbol/Symbol.Alias.h"
 #include "Compiler/Sema/Symbol/Symbol.Function.h"
 #include "Compiler/Sema/Symbol/Symbol.Variable.h"
-#include "Support/Memory/MemoryProfile.h"
-#include "Support/Report/Assert.h"
-#if SWC_HAS_STATS
+#include "Compiler/SourceFile.h"
+#include "Main/Command/CommandLine.h"
 #include "Main/Stats.h"
 #include "Support/Core/Timer.h"
-#endif
+#include "Support/Memory/Heap.h"
+#include "Support/Memory/MemoryProfile.h"
+#include "Support/Report/Assert.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -286,8 +287,39 @@ namespace
         adapter.tryMarkCodeGenJobScheduled();
         return Result::Continue;
     }
+
+    // Code that only ever runs inside the compiler. Anything else may also end up in a native
+    // artifact, which takes its lowered code as is.
+    bool isCompileTimeOnly(const TaskContext& ctx, const SymbolFunction& function)
+    {
+        const AttributeList& attributes = function.attributes();
+        if (attributes.hasRtFlag(RtAttributeFlagsE::Compiler) || attributes.hasRtFlag(RtAttributeFlagsE::Macro) || attributes.hasRtFlag(RtAttributeFlagsE::Mixin))
+            return true;
+
+        const AstNode* decl = function.decl();
+        if (!decl)
+            return false;
+        if (decl->id() == AstNodeId::CompilerRunBlock || decl->id() == AstNodeId::CompilerRunExpr)
+            return true;
+        if (decl->id() != AstNodeId::CompilerFunc)
+            return false;
+
+        const TokenId tokenId = ctx.compiler().srcView(function.srcViewRef()).token(function.tokRef()).id;
+        return !Token::isNativeArtifactCompilerFunc(tokenId);
+    }
 }
 
+// A baseline function keeps what its optimized recompile needs: the instruction stream as code
+// generation produced it, minus the call counter, and where the optimized code ends up.
+struct SymbolFunction::JitTierUp
+{
+    CompilerInstance* compiler          = nullptr;
+    MicroBuilder      builder;
+    MicroReg          debugStackBaseReg = MicroReg::invalid();
+    MachineCode       code;
+    JITMemory         memory;
+};
+
 MicroBuilder& SymbolFunction::microInstrBuilder(TaskContext& ctx) noexcept
 {
     microInstrBuilder_.setContext(ctx);
@@ -331,14 +363,33 @@ Result SymbolFunction::emit(TaskContext& ctx)
         const ABITypeNormalize::NormalizedType normalizedRet = ABITypeNormalize::normalize(ctx, callConv, returnTypeRef(), ABITypeNormalize::Usage::Return);
         builder.setRetUsesAbiRegs(!normalizedRet.isFloat, normalizedRet.isFloat);
     }
+
+    // A function starts at the baseline tier only without loops: the switch to optimized code
+    // happens on entry, so a single long-running call would never leave the baseline code.
+    MachineCodeTier tier = MachineCodeTier::Optimized;
+    if (builder.hasJitTierUpProbe())
+    {
+        if (!jitTierUp_ && !builder.hasBackwardJump())
+        {
+            tier                          = MachineCodeTier::Baseline;
+            jitTierUp_                    = heapNew<JitTierUp>();
+            jitTierUp_->compiler          = &ctx.compiler();
+            jitTierUp_->debugStackBaseReg = debugStackBaseReg();
+            jitTierUp_->builder.copyStreamFrom(builder);
+            jitTierUp_->builder.eraseJitTierUpProbe();
+        }
+        else
+        {
+            builder.eraseJitTierUpProbe();
+        }
+    }
+
     SWC_MEM_SCOPE("Backend/MicroLower");
-#if SWC_HAS_STATS
     Timer timeMicroLower(Stats::timedMetric(Stats::get().timeMicroLower));
-#endif
     // The static sanitizer runs the checks whose sanity guard is on for this function:
     // the build-config default combined with any `#[Swag.Sanity(...)]` override on it.
     const uint16_t sanitizerSafetyMask = attributes().effectiveSanityMask(ctx.compiler().buildCfg().sanityGuards);
-    const Result   emitResult          = loweredMicroCode_.emit(ctx, builder, debugStackBaseReg(), sanitizerSafetyMask, this);
+    const Result   emitResult          = loweredMicroCode_.emit(ctx, builder, debugStackBaseReg(), sanitizerSafetyMask, this, tier);
     if (emitResult != Result::Continue)
     {
         ctx.state().jitEmissionError = true;
@@ -355,14 +406,50 @@ Result SymbolFunction::emit(TaskContext& ctx)
     // The micro builder itself is transient and otherwise retains per-function IR memory.
     builder.releaseMemory();
 
-#if SWC_HAS_STATS
     if (Stats::enabledRuntime())
-        Stats::get().numCodeGenFunctions.fetch_add(1, std::memory_order_relaxed);
-#endif
+    {
+        Stats::get().numCodeGenFunctions.add(1);
+        if (tier == MachineCodeTier::Baseline)
+            Stats::get().numJitBaselineFunctions.add(1);
+    }
     ctx.compiler().notifyAlive();
     return Result::Continue;
 }
 
+// Lowered code is shared with native output, which must never see baseline code. Only code that
+// stays in the JIT goes through the tiers: everything a script runs, and compile-time code.
+bool SymbolFunction::usesJitTiering(const TaskContext& ctx) const
+{
+    if (!ctx.cmdLine().jitTiering)
+        return false;
+    if (!microInstrBuilder_.backendBuildCfg().optimize)
+        return false;
+    return ctx.cmdLine().scriptMode || isCompileTimeOnly(ctx, *this);
+}
+
+// Called by baseline code when its call counter runs out. The counter goes on below zero
+// afterwards, so the call happens once per function.
+void SymbolFunction::onJitTierUpProbe(SymbolFunction* function)
+{
+    if (!function || !function->jitTierUp_)
+        return;
+    if (function->jitTierUpRequested_.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    TaskContext ctx(*function->jitTierUp_->compiler);
+    JITPatchJob::scheduleTierUp(ctx, *function);
+}
+
+bool SymbolFunction::tryGetJitOptimizedCode(const MachineCode*& outCode, const void*& outEntry) const
+{
+    if (!jitTierUpInstalled_.load(std::memory_order_acquire))
+        return false;
+
+    outCode  = &jitTierUp_->code;
+    outEntry = jitTierUp_->memory.entryPoint();
+    return true;
+}
+
 bool SymbolFunction::hasLoweredCode() const noexcept
 {
     return !loweredMicroCode_.bytes.empty();
@@ -376,6 +463,11 @@ void SymbolFunction::resetJitState() noexcept
     jitEntryAddress_.store(nullptr, std::memory_order_release);
     jitPatchJobScheduled_.store(false, std::memory_order_release);
     jitReadyVersion_.store(0, std::memory_order_release);
+    if (jitTierUp_)
+        jitTierUp_->memory.reset();
+    jitTierUpInstalled_.store(false, std::memory_order_release);
+    jitTierUpRequested_.store(false, std::memory_order_release);
+    jitTierUpCounter_.store(K_JIT_TIER_UP_CALLS, std::memory_order_release);
 }
 
 Result SymbolFunction::ensureClosureAdapter(TaskContext& ctx, SymbolFunction*& outAdapter)
@@ -594,4 +686,60 @@ void SymbolFunction::jitFinalize(TaskContext& ctx)
     ctx.compiler().notifyAlive();
 }
 
+// Nothing waits on a tier-up: whatever goes wrong, the function simply stays at the baseline.
+Result SymbolFunction::jitTierUp(TaskContext& ctx)
+{
+    SWC_ASSERT(jitTierUp_ != nullptr);
+    JitTierUp& tierUp = *jitTierUp_;
+    if (tierUp.code.bytes.empty())
+    {
+        // The baseline lowering already ran the static sanitizer on this function.
+        tierUp.builder.setContext(ctx);
+        if (tierUp.code.emit(ctx, tierUp.builder, tierUp.debugStackBaseReg, 0, this, MachineCodeTier::Optimized) != Result::Continue)
+            return Result::Continue;
+        tierUp.builder.releaseMemory();
+    }
+
+    const std::scoped_lock lock(emitMutex_);
+    if (!hasJitEntryAddress() || jitTierUpInstalled_.load(std::memory_order_acquire))
+        return Result::Continue;
+
+    JIT::prepare(ctx, tierUp.memory, tierUp.code.bytes, tierUp.code.unwindInfo, tierUp.code.codeRelocations);
+    if (!tierUp.memory.entryPoint())
+        return Result::Continue;
+
+    auto relocations = tierUp.code.codeRelocations;
+    for (MicroRelocation& relocation : relocations)
+    {
+        if (relocation.kind != MicroRelocation::Kind::LocalFunctionAddress)
+            continue;
+        if (relocation.targetSymbol != this)
+            continue;
+        if (relocation.targetAddress != 0)
+            continue;
+
+        relocation.targetAddress = MicroRelocation::K_SELF_ADDRESS;
+    }
+
+    if (JIT::patch(ctx, tierUp.memory, relocations, this) != Result::Continue)
+    {
+        ctx.state().setNone();
+        tierUp.memory.reset();
+        return Result::Continue;
+    }
+
+    JIT::finalize(tierUp.memory);
+    if (!JIT::redirect(jitExecMemory_, tierUp.memory.entryPoint()))
+    {
+        tierUp.memory.reset();
+        return Result::Continue;
+    }
+
+    jitTierUpInstalled_.store(true, std::memory_order_release);
+    if (Stats::enabledRuntime())
+        Stats::get().numJitTierUps.add(1);
+    ctx.compiler().notifyAlive();
+    return Result::Continue;
+}
+
 SWC_END_NAMESPACE();
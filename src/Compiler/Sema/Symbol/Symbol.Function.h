@@ -202,6 +202,11 @@ public:
     uint64_t                jitReadyVersion() const noexcept { return jitReadyVersion_.load(std::memory_order_acquire); }
     void                    setJitReadyVersion(uint64_t version) noexcept { jitReadyVersion_.store(version, std::memory_order_release); }
     void                    resetJitState() noexcept;
+    bool                    usesJitTiering(const TaskContext& ctx) const;
+    std::atomic<int32_t>&   jitTierUpCounter() noexcept { return jitTierUpCounter_; }
+    bool                    jitTierUpRequested() const noexcept { return jitTierUpRequested_.load(std::memory_order_acquire); }
+    static void             onJitTierUpProbe(SymbolFunction* function);
+    bool                    tryGetJitOptimizedCode(const MachineCode*& outCode, const void*& outEntry) const;
     Result                  emit(TaskContext& ctx);
     Result                  ensureClosureAdapter(TaskContext& ctx, SymbolFunction*& outAdapter);
     GenericInstanceStorage& genericInstanceStorage(const TaskContext& ctx) const noexcept;
@@ -237,6 +242,7 @@ public:
 
 private:
     struct GenericData;
+    struct JitTierUp;
     friend class JITPatchJob;
 
     static constexpr SymbolFunctionFlags K_SEMANTIC_FLAGS = SymbolFunctionFlagsE::Closure |
@@ -259,9 +265,11 @@ private:
     bool         jitPrepare(TaskContext& ctx);
     Result       jitPatch(TaskContext& ctx);
     void         jitFinalize(TaskContext& ctx);
+    Result       jitTierUp(TaskContext& ctx);
 
     static constexpr uint32_t K_INVALID_INTERFACE_METHOD_SLOT  = 0xFFFFFFFFu;
     static constexpr uint8_t  K_INVALID_RT_ATTRIBUTE_BIT_INDEX = 0xFFu;
+    static constexpr int32_t  K_JIT_TIER_UP_CALLS              = 1000;
 
     std::vector<SymbolVariable*>              parameters_;
     std::vector<SymbolVariable*>              localVariables_;
@@ -298,6 +306,10 @@ private:
     std::atomic<void*>                   jitEntryAddress_      = nullptr;
     std::atomic_bool                     jitPatchJobScheduled_ = false;
     std::atomic<uint64_t>                jitReadyVersion_{0};
+    JitTierUp*                           jitTierUp_          = nullptr;
+    std::atomic<int32_t>                 jitTierUpCounter_   = K_JIT_TIER_UP_CALLS;
+    std::atomic_bool                     jitTierUpRequested_ = false;
+    std::atomic_bool                     jitTierUpInstalled_ = false;
     mutable std::atomic<GenericData*>    genericData_ = nullptr;
 };
 
@@ -239,10 +239,8 @@ public:
     template<typename T>
     static T* make(TaskContext& ctx, const AstNode* decl, TokenRef tokRef, IdentifierRef idRef, SymbolFlags flags)
     {
-#if SWC_HAS_STATS
         if (Stats::enabledRuntime())
-            Stats::get().numSymbols.fetch_add(1, std::memory_order_relaxed);
-#endif
+            Stats::get().numSymbols.add(1);
         return ctx.compiler().allocate<T>(decl, tokRef, idRef, flags);
     }
 
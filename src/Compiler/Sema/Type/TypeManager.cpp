@@ -293,10 +293,8 @@ TypeRef TypeManager::addType(const TypeInfo& typeInfo)
     if (!inserted)
         return it->second;
 
-#if SWC_HAS_STATS
     if (Stats::enabledRuntime())
-        Stats::get().numTypes.fetch_add(1, std::memory_order_relaxed);
-#endif
+        Stats::get().numTypes.add(1);
 
     uint32_t  localIndex = INVALID_REF;
     TypeInfo* ptr        = nullptr;
@@ -9,11 +9,18 @@
 #include "Main/TaskContext.h"
 #include "Support/Core/Timer.h"
 #include "Support/Memory/MemoryProfile.h"
+#include "Support/Os/Os.h"
 #include "Support/Report/Assert.h"
 #include "Support/Report/Diagnostic.h"
 
 SWC_BEGIN_NAMESPACE();
 
+namespace
+{
+    // Below this size a copy costs less than creating and tearing down a mapping.
+    constexpr size_t MIN_MAPPED_FILE_SIZE = 16 * 1024;
+}
+
 SourceFile::SourceFile(FileRef fileRef, fs::path path, FileFlags flags) :
     fileRef_(fileRef),
     path_(std::move(path)),
@@ -28,7 +35,10 @@ SourceFile::SourceFile(FileRef fileRef, fs::path path, FileFlags flags) :
     unitTest_           = std::make_unique<Verify>(this);
 }
 
-SourceFile::~SourceFile() = default;
+SourceFile::~SourceFile()
+{
+    releaseContent();
+}
 
 const Utf8& SourceFile::formattedFileName(const TaskContext* ctx) const
 {
@@ -84,16 +94,17 @@ void SourceFile::setContent(const std::string_view content)
 {
     SWC_ASSERT(!ast().hasSourceView());
 
-    content_.clear();
-    content_.reserve(content.size() + TRAILING_0);
-    content_.resize(content.size());
+    const std::scoped_lock lock(contentMutex_);
+    releaseContent();
+    ownedContent_.reserve(content.size() + TRAILING_0);
+    ownedContent_.resize(content.size());
     if (!content.empty())
     {
-        std::memcpy(content_.data(), content.data(), content.size());
+        std::memcpy(ownedContent_.data(), content.data(), content.size());
     }
 
-    for (int i = 0; i < TRAILING_0; i++)
-        content_.push_back(0);
+    ownedContent_.insert(ownedContent_.end(), TRAILING_0, 0);
+    content_ = {ownedContent_.data(), content.size()};
 }
 
 void SourceFile::addErrorLineRange(const uint32_t lineStart, const uint32_t lineEnd) const
@@ -137,33 +148,79 @@ void SourceFile::ensureSourceView(TaskContext& ctx)
     ast().setSourceView(srcView);
 }
 
-Result SourceFile::loadContent(TaskContext& ctx)
+void SourceFile::releaseContent()
 {
-    if (!content_.empty())
+    if (mappedContent_)
     {
-        ensureSourceView(ctx);
-        return Result::Continue;
+        Os::unmapFile(*mappedContent_);
+        mappedContent_.reset();
     }
 
+    ownedContent_.clear();
+    content_ = {};
+}
+
+// The lexer reads up to TRAILING_0 bytes past the end of the file, so a mapping is only kept
+// when those bytes are zeros of its own last page.
+bool SourceFile::mapContent()
+{
+    Os::MappedFile mapped;
+    if (!Os::mapFileReadOnly(mapped, path_, MIN_MAPPED_FILE_SIZE, TRAILING_0))
+        return false;
+
+    Os::prefetchMemory(mapped.data, mapped.size);
+    mappedContent_ = std::make_unique<Os::MappedFile>(mapped);
+    content_       = {mapped.data, mapped.size};
+    return true;
+}
+
+Result SourceFile::readContent(FileSystem::IoErrorInfo& outError, const ContentLoadMode mode)
+{
     SWC_MEM_SCOPE("Frontend/LoadFile");
-    Stats::get().numFiles.fetch_add(1, std::memory_order_relaxed);
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeLoadFile));
-#endif
 
-    FileSystem::IoErrorInfo ioError;
-    if (FileSystem::readBinaryFile(path_, content_, ioError) != Result::Continue)
+    if (mode != ContentLoadMode::Map || !mapContent())
     {
-        const DiagnosticId diagId = ioError.problem == FileSystem::IoProblem::OpenRead ? DiagnosticId::io_err_open_file : DiagnosticId::io_err_read_file;
-        Diagnostic         diag   = Diagnostic::get(diagId, ref());
-        FileSystem::setDiagnosticPathAndBecause(diag, &ctx, path_, ioError.because);
-        diag.report(ctx);
-        return Result::Error;
+        if (FileSystem::readBinaryFile(path_, ownedContent_, outError) != Result::Continue)
+            return Result::Error;
+
+        const size_t size = ownedContent_.size();
+        ownedContent_.insert(ownedContent_.end(), TRAILING_0, 0);
+        content_ = {ownedContent_.data(), size};
     }
 
-    // Ensure we have at least 4 characters in the buffer
-    for (int i = 0; i < TRAILING_0; i++)
-        content_.push_back(0);
+    Stats::get().numFiles.fetch_add(1, std::memory_order_relaxed);
+    return Result::Continue;
+}
+
+void SourceFile::prefetchContent()
+{
+    // The job that needs the file may already be reading it.
+    const std::unique_lock lock(contentMutex_, std::try_to_lock);
+    if (!lock.owns_lock() || content_.data())
+        return;
+
+    FileSystem::IoErrorInfo ioError;
+    (void) readContent(ioError, ContentLoadMode::Map);
+}
+
+Result SourceFile::loadContent(TaskContext& ctx, const ContentLoadMode mode)
+{
+    {
+        const std::scoped_lock lock(contentMutex_);
+        if (!content_.data())
+        {
+            FileSystem::IoErrorInfo ioError;
+            if (readContent(ioError, mode) != Result::Continue)
+            {
+                const DiagnosticId diagId = ioError.problem == FileSystem::IoProblem::OpenRead ? DiagnosticId::io_err_open_file : DiagnosticId::io_err_read_file;
+                Diagnostic         diag   = Diagnostic::get(diagId, ref());
+                FileSystem::setDiagnosticPathAndBecause(diag, &ctx, path_, ioError.because);
+                diag.report(ctx);
+                return Result::Error;
+            }
+        }
+    }
 
     ensureSourceView(ctx);
     return Result::Continue;
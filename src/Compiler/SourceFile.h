@@ -14,6 +14,16 @@ class TaskContext;
 class Global;
 class Verify;
 
+namespace Os
+{
+    struct MappedFile;
+}
+
+namespace FileSystem
+{
+    struct IoErrorInfo;
+}
+
 enum class FileFlagsE : uint32_t
 {
     Zero        = 0,
@@ -30,6 +40,14 @@ enum class FileFlagsE : uint32_t
 };
 using FileFlags = EnumFlags<FileFlagsE>;
 
+// How a file reaches memory. A mapped file cannot be truncated while it stays mapped, so a
+// file that may be written back during the command is copied instead.
+enum class ContentLoadMode : uint8_t
+{
+    Map,
+    Copy,
+};
+
 class SourceFile;
 using FileRef = StrongRef<SourceFile>;
 
@@ -41,13 +59,13 @@ public:
 
     FileRef ref() const { return fileRef_; }
 
-    fs::path                    path() const { return path_; }
-    Utf8                        name() const { return path_.filename().string().c_str(); }
-    const Utf8&                 formattedFileName(const TaskContext* ctx) const;
-    Utf8                        formatFileLocation(const TaskContext* ctx, uint32_t line, uint32_t column = 0, uint32_t columnEnd = 0) const;
-    size_t                      size() const { return content_.empty() ? 0 : content_.size() - TRAILING_0; }
-    const std::vector<char8_t>& content() const { return content_; }
-    std::string_view            sourceView() const { return std::string_view(reinterpret_cast<std::string_view::const_pointer>(content_.data()), size()); }
+    fs::path                 path() const { return path_; }
+    Utf8                     name() const { return path_.filename().string().c_str(); }
+    const Utf8&              formattedFileName(const TaskContext* ctx) const;
+    Utf8                     formatFileLocation(const TaskContext* ctx, uint32_t line, uint32_t column = 0, uint32_t columnEnd = 0) const;
+    size_t                   size() const { return content_.size(); }
+    std::span<const char8_t> content() const { return content_; }
+    std::string_view         sourceView() const { return std::string_view(reinterpret_cast<std::string_view::const_pointer>(content_.data()), content_.size()); }
 
     FileFlags&       flags() { return flags_; }
     const FileFlags& flags() const { return flags_; }
@@ -82,10 +100,16 @@ public:
     bool hasWarning() const { return hasWarning_; }
 
     void   setContent(std::string_view content);
-    Result loadContent(TaskContext& ctx);
+    Result loadContent(TaskContext& ctx, ContentLoadMode mode = ContentLoadMode::Map);
+    // Loads the content ahead of the job that needs it. Errors are left for loadContent to
+    // find again and report.
+    void   prefetchContent();
 
 private:
-    void ensureSourceView(TaskContext& ctx);
+    void   ensureSourceView(TaskContext& ctx);
+    Result readContent(FileSystem::IoErrorInfo& outError, ContentLoadMode mode);
+    bool   mapContent();
+    void   releaseContent();
 
     static constexpr int TRAILING_0 = 4;
 
@@ -97,10 +121,16 @@ private:
     mutable std::mutex           formattedFileNamesMutex_;
     mutable std::array<Utf8, 3>  formattedFileNames_;
     mutable std::array<bool, 3>  formattedFileNamesComputed_ = {};
-    std::vector<char8_t>         content_;
     std::unique_ptr<NodePayload> nodePayloadContext_;
     std::unique_ptr<Verify>      unitTest_;
 
+    // Either a mapping of the file or an owned copy of it, followed by TRAILING_0 zeros in both
+    // cases; 'content_' covers the file bytes alone.
+    std::mutex                      contentMutex_;
+    std::span<const char8_t>        content_;
+    std::vector<char8_t>            ownedContent_;
+    std::unique_ptr<Os::MappedFile> mappedContent_;
+
     mutable std::mutex                                 errorLinesMutex_;
     mutable std::vector<std::pair<uint32_t, uint32_t>> errorLineRanges_;
 
@@ -15,10 +15,17 @@ FormatJob::FormatJob(const TaskContext& ctx, SourceFile* file, FormatOptions for
 {
 }
 
+void FormatJob::traceTarget(Utf8& outFile, Utf8& outSymbol) const
+{
+    SWC_UNUSED(outSymbol);
+    outFile = Utf8(file_->path());
+}
+
 JobResult FormatJob::exec()
 {
     TaskContext& jobCtx = ctx();
-    if (file_->loadContent(jobCtx) != Result::Continue)
+    // The file may be rewritten below, which a mapping would forbid.
+    if (file_->loadContent(jobCtx, ContentLoadMode::Copy) != Result::Continue)
         return JobResult::Done;
 
     const bool savedMuteOutput    = jobCtx.muteOutput();
@@ -36,9 +43,7 @@ JobResult FormatJob::exec()
     if (jobCtx.hasError())
     {
         skippedInvalid_ = true;
-#if SWC_HAS_STATS
-        Stats::get().numFormatSkippedInvalidFiles.fetch_add(1, std::memory_order_relaxed);
-#endif
+        Stats::get().numFormatSkippedInvalidFiles.add(1);
         return JobResult::Done;
     }
 
@@ -47,9 +52,7 @@ JobResult FormatJob::exec()
     skippedFmt_ = formatter.skipped();
     if (skippedFmt_)
     {
-#if SWC_HAS_STATS
-        Stats::get().numFormatSkipFmtFiles.fetch_add(1, std::memory_order_relaxed);
-#endif
+        Stats::get().numFormatSkipFmtFiles.add(1);
     }
 
     auto writeResult = Result::Continue;
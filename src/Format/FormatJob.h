@@ -12,6 +12,7 @@ public:
     FormatJob(const TaskContext& ctx, SourceFile* file, FormatOptions formatOptions, ParserJobOptions parserOptions);
 
     JobResult exec() override;
+    void      traceTarget(Utf8& outFile, Utf8& outSymbol) const override;
 
     bool rewritten() const { return rewritten_; }
     bool skippedFmt() const { return skippedFmt_; }
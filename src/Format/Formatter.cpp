@@ -21,9 +21,7 @@ Formatter::Formatter(FormatOptions options) :
 
 void Formatter::prepare(const SourceFile& file)
 {
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeFormat));
-#endif
     file_ = &file;
     if (file.mustSkipFormat())
     {
@@ -81,9 +79,7 @@ Result Formatter::write(TaskContext& ctx) const
     if (!changed_)
         return Result::Continue;
 
-#if SWC_HAS_STATS
     Timer time(Stats::timedMetric(Stats::get().timeFormatWrite));
-#endif
     FileSystem::IoErrorInfo ioError;
     if (FileSystem::writeBinaryFile(file_->path(), text_.data(), text_.size(), ioError) != Result::Continue)
         return reportFormatFailure(ctx, *file_, FileSystem::describeIoFailure(ioError));
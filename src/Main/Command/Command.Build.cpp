@@ -235,6 +235,9 @@ namespace Command
             SWC_RESULT(runJitScriptFunctions(ctx, dropFunctions, JITRuntimeSetupMode::None));
             SWC_RESULT(runRuntimeDependencyHooks(ctx, runtimeDependencies, runtimeDependencyDropOrder, ScriptRuntimeHookStage::Drop));
 
+            // Hot script functions may still be recompiling in the background.
+            ctx.global().jobMgr().waitAll(compiler.jitTierUpClientId());
+
             if (stage)
                 stage->setStat(ScopedTimedLog::formatStatCount(ctx, mainFunctions.size(), "main"));
             return Result::Continue;
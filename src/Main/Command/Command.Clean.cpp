@@ -105,6 +105,8 @@ namespace
         // Only the compiler's own subdirectories: the cache root is a shared temporary directory,
         // and nothing else that lives there was put there by a build.
         addCleanTarget(outTargets, "Dependency cache", WorkspaceLayout::dependencyCacheRoot());
+        addCleanTarget(outTargets, "Lexer cache", WorkspaceLayout::lexerCacheRoot());
+        addCleanTarget(outTargets, "Library index cache", WorkspaceLayout::archiveIndexCacheRoot());
         addCleanTarget(outTargets, "Legacy script cache", WorkspaceLayout::legacyScriptCacheRoot());
     }
 
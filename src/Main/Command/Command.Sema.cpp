@@ -85,12 +85,7 @@ namespace Command
         const ParserJobOptions parserOptions = {
             .emitTrivia = compiler.cmdLine().command == CommandKind::Doc,
         };
-        for (SourceFile* f : inputFiles)
-        {
-            auto* job = compiler.makeJob<ParserJob>(ctx, f, parserOptions);
-            jobMgr.enqueue(*job, JobPriority::Normal, clientId);
-        }
-
+        enqueueParserJobs(compiler, ctx, inputFiles, parserOptions);
         jobMgr.waitAll(clientId);
         if (Stats::getNumErrors() != errorsBefore)
             return;
@@ -29,13 +29,8 @@ namespace Command
         if (compiler.collectFiles(ctx) == Result::Error)
             return;
 
-        for (SourceFile* f : compiler.files())
-        {
-            auto* job = compiler.makeJob<ParserJob>(ctx, f);
-            jobMgr.enqueue(*job, JobPriority::Normal, clientId);
-        }
-
-        jobMgr.waitAll(compiler.jobClientId());
+        enqueueParserJobs(compiler, ctx, compiler.files());
+        jobMgr.waitAll(clientId);
 
         if (stage)
             stage->setStat(ScopedTimedLog::formatStatCount(ctx, compiler.files().size(), "file"));
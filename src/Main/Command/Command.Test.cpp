@@ -9,6 +9,7 @@
 #include "Main/Command/CommandLine.h"
 #include "Main/Command/CommandLineParser.h"
 #include "Main/Command/CommandRun.h"
+#include "Main/Command/CommandTest.h"
 #include "Main/CompilerInstance.h"
 #include "Main/Global.h"
 #include "Main/Stats.h"
@@ -19,6 +20,7 @@
 #include "Support/Report/Diagnostic.h"
 #include "Support/Report/Logger.h"
 #include "Support/Report/ScopedTimedLog.h"
+#include "Support/Thread/JobManager.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -430,6 +432,14 @@ namespace
         return result;
     }
 
+    void restoreDataSegments(CompilerInstance& compiler, const DataSegmentSnapshot& snapshot)
+    {
+        if (!snapshot.globalZero.empty())
+            compiler.globalZeroSegment().restoreFromPreserveOffsets(snapshot.globalZero.span());
+        if (!snapshot.globalInit.empty())
+            compiler.globalInitSegment().restoreFromPreserveOffsets(snapshot.globalInit.span());
+    }
+
     struct DataSegmentRestoreGuard
     {
         CompilerInstance*   compiler = nullptr;
@@ -437,13 +447,8 @@ namespace
 
         ~DataSegmentRestoreGuard()
         {
-            if (!compiler)
-                return;
-
-            if (!snapshot.globalZero.empty())
-                compiler->globalZeroSegment().restoreFromPreserveOffsets(snapshot.globalZero.span());
-            if (!snapshot.globalInit.empty())
-                compiler->globalInitSegment().restoreFromPreserveOffsets(snapshot.globalInit.span());
+            if (compiler)
+                restoreDataSegments(*compiler, snapshot);
         }
     };
 
@@ -501,6 +506,65 @@ namespace
         return Stats::getNumErrors() == errorsBefore;
     }
 
+    struct JitTestOutcome
+    {
+        Utf8 output;
+        bool ran    = false;
+        bool passed = false;
+    };
+
+    bool isParallelJitTest(const SymbolFunction& function)
+    {
+        return !function.attributes().hasRtFlag(RtAttributeFlagsE::NoParallel);
+    }
+
+    // Runs one test on a worker thread, with its own context so that its errors are its own. What
+    // it logs is kept aside and printed in test order once every worker is done. A test that would
+    // have to pause for the compiler is left to the serial pass, which can wait.
+    void runParallelJitTestFunction(TaskContext& workerCtx, const SymbolFunction& function, JitTestOutcome& outOutcome)
+    {
+        TaskContext testCtx(workerCtx.compiler());
+        testCtx.setOutputCapture(&outOutcome.output);
+
+        JITExecManager::Request request;
+        request.function     = &function;
+        request.nodeRef      = function.declNodeRef();
+        request.codeRef      = function.decl() ? function.decl()->codeRef() : SourceCodeRef::invalid();
+        request.runImmediate = true;
+
+        const Result result = testCtx.compiler().jitExecMgr().submit(testCtx, request);
+        if (result == Result::Pause)
+        {
+            outOutcome.output.clear();
+            return;
+        }
+
+        outOutcome.ran    = true;
+        outOutcome.passed = result == Result::Continue && !testCtx.hasError();
+    }
+
+    // Runs a batch of consecutive parallel-safe tests at once. Each one gets a thread, a runtime
+    // context and a TLS block of its own, but global variables are shared: the JIT code addresses
+    // them directly, so the batch never holds a test marked '#[Swag.NoParallel]'.
+    void runParallelJitTests(TaskContext& ctx, std::span<SymbolFunction* const> batch, std::span<JitTestOutcome> outOutcomes, ScopedTimedLog* stage, const CommandTest::JitTestTally& tallyBefore, uint32_t expectedTestCount)
+    {
+        std::atomic<uint32_t> numFinished = tallyBefore.executed;
+        std::atomic<uint32_t> numFailed   = tallyBefore.failed;
+        ctx.global().jobMgr().parallelForIndexed(ctx, static_cast<uint32_t>(batch.size()), JobKind::JitTest, ctx.compiler().jobClientId(), [&](TaskContext& workerCtx, uint32_t i) {
+            const SymbolFunction& function = *batch[i];
+            JitTestOutcome&       outcome  = outOutcomes[i];
+            runParallelJitTestFunction(workerCtx, function, outcome);
+
+            const uint32_t finished = numFinished.fetch_add(1, std::memory_order_relaxed) + 1;
+            const uint32_t failure  = outcome.ran && !outcome.passed ? 1 : 0;
+            const uint32_t failed   = numFailed.fetch_add(failure, std::memory_order_relaxed) + failure;
+
+            // The progress line is not thread-safe; only the calling thread updates it.
+            if (stage && &workerCtx == &ctx)
+                stage->setProgressStat(ScopedTimedLog::formatTestProgress(ctx, finished, expectedTestCount, failed, ScopedTimedLog::formatTestLocation(ctx, function)));
+        });
+    }
+
     bool runJitTests(CompilerInstance& compiler)
     {
         if (!hasJitEligibleInputs(compiler))
@@ -594,31 +658,10 @@ namespace
                 return false;
         }
 
-        // Run every test even when one fails: a failing #test has already reported its
-        // diagnostic through the JIT exception handler, so keep executing the remaining
-        // tests and report a pass/fail tally instead of stopping at the first failure.
-        uint32_t executedTestCount = 0;
-        uint32_t failedTestCount   = 0;
-        for (const SymbolFunction* function : testFunctions)
-        {
-            const Utf8 testLocation = ScopedTimedLog::formatTestLocation(ctx, *function);
-            if (stage)
-                stage->setProgressStat(ScopedTimedLog::formatTestProgress(ctx, executedTestCount, expectedTestCount, failedTestCount, testLocation));
-            const bool testPassed = runJitTestFunction(ctx, *function);
-            if (!testPassed)
-            {
-                failedTestCount++;
-
-                // The panic or exception that reported the failure runs below the JIT boundary,
-                // where the '#test' being executed is unknown; name it here.
-                Diagnostic diag = Diagnostic::get(DiagnosticId::cmd_note_jit_test_did_not_pass);
-                diag.addArgument(Diagnostic::ARG_VALUE, testLocation);
-                diag.report(ctx);
-            }
-            executedTestCount++;
-            if (stage)
-                stage->setProgressStat(ScopedTimedLog::formatTestProgress(ctx, executedTestCount, expectedTestCount, failedTestCount, testLocation));
-        }
+        CommandTest::JitTestTally tally;
+        CommandTest::runJitTestFunctions(ctx, testFunctions, stage ? &*stage : nullptr, expectedTestCount, tally);
+        const uint32_t executedTestCount = tally.executed;
+        const uint32_t failedTestCount   = tally.failed;
 
         if (stage)
         {
@@ -699,6 +742,73 @@ namespace
 
 }
 
+// With '--test-parallel', consecutive parallel-safe tests run as one batch and every test marked
+// '#[Swag.NoParallel]' runs alone, at its place in source order. The data segments go back to the
+// state '#init' and '#premain' left before each test that runs alone and after each batch, so a
+// test never sees what another one wrote. Without it, tests run one after the other on the
+// calling thread, as they always did.
+void CommandTest::runJitTestFunctions(TaskContext& ctx, std::span<SymbolFunction* const> testFunctions, ScopedTimedLog* stage, uint32_t expectedTestCount, JitTestTally& outTally)
+{
+    CompilerInstance&         compiler  = ctx.compiler();
+    const bool                parallel  = ctx.cmdLine().testParallel;
+    const DataSegmentSnapshot testStart = parallel ? snapshotDataSegments(compiler) : DataSegmentSnapshot{};
+    if (parallel)
+        compiler.ensureProcessInfosRunArgs();
+
+    // Run every test even when one fails: a failing #test has already reported its
+    // diagnostic through the JIT exception handler, so keep executing the remaining
+    // tests and report a pass/fail tally instead of stopping at the first failure.
+    // Tests that already ran in a batch only replay their output here, in the same
+    // order and with the same tally as a serial run.
+    std::vector<JitTestOutcome> outcomes(testFunctions.size());
+    uint32_t                    batchEnd = 0;
+    for (uint32_t testIndex = 0; testIndex < testFunctions.size(); ++testIndex)
+    {
+        const SymbolFunction* function     = testFunctions[testIndex];
+        const Utf8            testLocation = ScopedTimedLog::formatTestLocation(ctx, *function);
+        if (parallel && testIndex >= batchEnd && isParallelJitTest(*function))
+        {
+            batchEnd = testIndex + 1;
+            while (batchEnd < testFunctions.size() && isParallelJitTest(*testFunctions[batchEnd]))
+                batchEnd++;
+
+            const uint32_t batchSize = batchEnd - testIndex;
+            runParallelJitTests(ctx, testFunctions.subspan(testIndex, batchSize), std::span(outcomes).subspan(testIndex, batchSize), stage, outTally, expectedTestCount);
+            restoreDataSegments(compiler, testStart);
+        }
+
+        if (stage)
+            stage->setProgressStat(ScopedTimedLog::formatTestProgress(ctx, outTally.executed, expectedTestCount, outTally.failed, testLocation));
+
+        const JitTestOutcome& outcome    = outcomes[testIndex];
+        bool                  testPassed = outcome.passed;
+        if (!outcome.ran)
+        {
+            if (parallel)
+                restoreDataSegments(compiler, testStart);
+            testPassed = runJitTestFunction(ctx, *function);
+        }
+        else if (!outcome.output.empty())
+        {
+            Logger::print(ctx, outcome.output);
+        }
+
+        if (!testPassed)
+        {
+            outTally.failed++;
+
+            // The panic or exception that reported the failure runs below the JIT boundary,
+            // where the '#test' being executed is unknown; name it here.
+            Diagnostic diag = Diagnostic::get(DiagnosticId::cmd_note_jit_test_did_not_pass);
+            diag.addArgument(Diagnostic::ARG_VALUE, testLocation);
+            diag.report(ctx);
+        }
+        outTally.executed++;
+        if (stage)
+            stage->setProgressStat(ScopedTimedLog::formatTestProgress(ctx, outTally.executed, expectedTestCount, outTally.failed, testLocation));
+    }
+}
+
 namespace Command
 {
     void test(CompilerInstance& compiler)
@@ -191,11 +191,13 @@ struct CommandLine
     bool commandExplicit         = false;
     bool testNative              = true;
     bool testJit                 = true;
+    bool testParallel            = false;
     bool lexOnly                 = false;
     bool syntaxOnly              = false;
     bool semaOnly                = false;
     bool output                  = true;
     bool outputDoc               = true;
+    bool jitTiering              = true;
     bool devStopDiagnostics      = true;
 
     bool devFull = false;
@@ -261,6 +263,7 @@ struct CommandLine
     fs::path          docOutputDir;
     fs::path          outDir;
     fs::path          workDir;
+    fs::path          traceFile;
     Runtime::BuildCfg defaultBuildCfg{};
     NewProjectKind    newProjectKind = NewProjectKind::Invalid;
 };
@@ -118,6 +118,9 @@ void CommandLineParser::registerCommands()
     add(HelpOptionGroup::Target, "sema doc test build run smoke", "--optimize", "-o",
         &cmdLine_->backendOptimize,
         "Enable backend optimization for JIT folding and native code generation");
+    add(HelpOptionGroup::Target, "sema doc test build run smoke", "--jit-tiering", nullptr,
+        &cmdLine_->jitTiering,
+        "Compile JIT-only code without optimization first and recompile it optimized once called often; use --no-jit-tiering to optimize it up front");
     addEnum(HelpOptionGroup::Target, "sema doc test build run smoke", "--cpu-vectorize", nullptr,
             &cmdLine_->cpuVectorize,
             {
@@ -144,6 +147,9 @@ void CommandLineParser::registerCommands()
     add(HelpOptionGroup::Compiler, "all", "--stats-mem", "-stm",
         &cmdLine_->statsMem,
         "Show runtime memory statistics after execution");
+    add(HelpOptionGroup::Compiler, "all", "--trace", nullptr,
+        &cmdLine_->traceFile,
+        "Record a timeline of every job and micro pass, and write it to this file as Chrome trace JSON");
     add(HelpOptionGroup::Compiler, "sema doc test build run smoke", "--tag", nullptr,
         &cmdLine_->tags,
         "Register a compiler tag for #hastag and #gettag; use Name, Name = value, or Name: type = value");
@@ -161,7 +167,7 @@ void CommandLineParser::registerCommands()
         "Recompile every selected module even when all generated outputs are up to date, and rebuild the standard-library modules a script imports");
     add(HelpOptionGroup::Input, "clean", "--cache", nullptr,
         &cmdLine_->cleanCache,
-        "Remove the dependency copies the compiler keeps outside any workspace, one per build of a dependency a script imported");
+        "Remove the caches the compiler keeps outside any workspace: the dependency copies, one per build of a dependency a script imported, and the lexer cache");
     add(HelpOptionGroup::Input, "clean", "--cache-days", nullptr,
         &cmdLine_->cleanCacheDays,
         "Restrict --cache to the copies no run has used for at least this many days");
@@ -219,6 +225,9 @@ void CommandLineParser::registerCommands()
     add(HelpOptionGroup::Testing, "test", "--test-jit", "-tj",
         &cmdLine_->testJit,
         "Run #test functions through the JIT during testing");
+    add(HelpOptionGroup::Testing, "test", "--test-parallel", "-tp",
+        &cmdLine_->testParallel,
+        "Run JIT #test functions on several threads; tests marked #[Swag.NoParallel] still run one at a time");
     add(HelpOptionGroup::Testing, "test", "--test-file", nullptr,
         &cmdLine_->testFileFilter,
         "Run #test functions whose source path contains this substring; repeat the option to accept more files");
@@ -1250,6 +1250,21 @@ Result CommandLineParser::checkCommandLine(TaskContext& ctx) const
     SWC_RESULT(normalizeAbsoluteDirectory(ctx, cmdLine_->exportApiDir));
     SWC_RESULT(normalizeAbsoluteDirectory(ctx, cmdLine_->docOutputDir));
 
+    if (!cmdLine_->traceFile.empty())
+    {
+        fs::path temp = cmdLine_->traceFile;
+        Utf8     because;
+        if (FileSystem::normalizeAbsolutePath(temp, because) != Result::Continue)
+        {
+            Diagnostic diag = Diagnostic::get(DiagnosticId::cmdline_err_invalid_file);
+            FileSystem::setDiagnosticPathAndBecause(diag, &ctx, temp, because);
+            diag.report(ctx);
+            return Result::Error;
+        }
+
+        cmdLine_->traceFile = std::move(temp);
+    }
+
     // Nothing about a removal is guessed: the command empties the directories it was pointed at.
     if (cmdLine_->command == CommandKind::Clean &&
         cmdLine_->workspacePath.empty() &&
@@ -0,0 +1,22 @@
+#pragma once
+
+SWC_BEGIN_NAMESPACE();
+
+class ScopedTimedLog;
+class SymbolFunction;
+class TaskContext;
+
+namespace CommandTest
+{
+    struct JitTestTally
+    {
+        uint32_t executed = 0;
+        uint32_t failed   = 0;
+    };
+
+    // Runs the '#test' functions of a module that is already jitted and initialized, in source
+    // order, and adds what ran and what failed to 'outTally'.
+    void runJitTestFunctions(TaskContext& ctx, std::span<SymbolFunction* const> testFunctions, ScopedTimedLog* stage, uint32_t expectedTestCount, JitTestTally& outTally);
+}
+
+SWC_END_NAMESPACE();
@@ -2289,8 +2289,8 @@ bool CompilerInstance::isWorkspaceModuleActive(const WorkspaceModuleBuild& modul
 // pointer) by the compiler. Declaration order matters for teardown: the job is drained first, then
 // the builder, then the compiler, then the CommandLine.
 //
-// The link runs on its own job client so the next module's (CPU-bound) compilation, which waits only
-// on its own client, can overlap it instead of stalling. The job object is owned here so it outlives
+// The link runs on its own job client so the following modules' (CPU-bound) compilation, which waits
+// only on its own client, can overlap it instead of stalling. The job object is owned here so it outlives
 // its execution and is torn down with the rest of the retained module state.
 struct WorkspaceModuleLink
 {
@@ -2360,6 +2360,24 @@ namespace
         return Result::Continue;
     }
 
+    // Upper bound on module links kept in flight. Each one retains a whole module compiler until it is
+    // finalized, so the bound follows the physical memory still available, measured against what the
+    // process already holds per retained module. Never more than the worker count: a link is one job.
+    size_t workspaceMaxInFlightLinks(const JobManager& jobMgr, size_t numInFlight)
+    {
+        constexpr size_t K_MIN_RETAINED_MODULE_BYTES = 256ull * 1024 * 1024;
+
+        const size_t maxWorkers = std::max<size_t>(1, jobMgr.numWorkers());
+        const size_t available  = Os::availablePhysicalMemory();
+        if (!available)
+            return 1;
+
+        // Keep half of the free memory for the front end of the modules still to compile.
+        const size_t perModule = std::max(K_MIN_RETAINED_MODULE_BYTES, Os::processMemoryUsage() / (numInFlight + 1));
+        const size_t byMemory  = numInFlight + (available / 2) / perModule;
+        return std::clamp<size_t>(byMemory, 1, maxWorkers);
+    }
+
     // Foreground completion of a backgrounded module link: drain the link job, interpret its result
     // and report any diagnostics in order, then record the artifact manifest now that the output exists.
     Result finalizeWorkspaceModuleLink(WorkspaceModuleLink& link)
@@ -2688,30 +2706,75 @@ ExitCode CompilerInstance::runWorkspace()
         }
     }
 
-    // Module compilation runs serially in dependency order, but each module's link is launched on a
-    // background thread so it overlaps the next module's compilation. A module reads its dependencies'
-    // link artifacts while resolving imports during setup, so a pending dependency link is joined
-    // before its dependent starts. This is a depth-1 pipeline: at most one link is in flight, which
-    // bounds the extra peak memory to a single retained module compiler.
-    std::unique_ptr<WorkspaceModuleLink> pendingLink;
+    // Module compilation runs in dependency order on this thread. Inside a module the work is already
+    // on the workers: one ParserJob per file lexes and parses it, one SemaJob per file runs its
+    // semantic passes, and one CodeGenJob per function lowers it. Each module's link is launched as
+    // a background job and stays in flight until something needs it. A module reads the link
+    // artifacts of its whole dependency closure while resolving imports during setup, so only the
+    // links it depends on are joined before it starts: sibling modules that do not import each other
+    // keep linking while the next ones compile. Links are always finalized in launch order, so diagnostics and manifests come
+    // out in the same order whatever the timing. Each in-flight link retains a whole module compiler,
+    // so the number of links in flight is capped by the physical memory left.
+    //
+    // Only links overlap. Two module front ends (and their codegen) never run side by side:
+    // - runWorkspaceModule decides success by diffing the process-wide Stats::getNumErrors(), so a
+    //   concurrent module's errors would fail the wrong module;
+    // - the Module stage log and its stats are printed from this thread as each module ends;
+    // - compile-time execution runs JIT code against process-wide runtime state.
+    // Until those become per-module, a module's front end gets every worker to itself instead.
+    std::vector<std::vector<bool>> dependencyClosure(modules.size());
+    for (const size_t moduleIndex : buildOrder)
+    {
+        // Build order is topological: every dependency's closure is already complete.
+        std::vector<bool>& closure = dependencyClosure[moduleIndex];
+        closure.assign(modules.size(), false);
+        for (const Utf8& dependency : modules[moduleIndex].workspaceDependencies)
+        {
+            const size_t dependencyIndex = moduleIndices.at(dependency);
+            if (!isWorkspaceModuleActive(modules[dependencyIndex]))
+                continue;
+
+            closure[dependencyIndex] = true;
+            const std::vector<bool>& nested = dependencyClosure[dependencyIndex];
+            for (size_t i = 0; i < nested.size(); ++i)
+                closure[i] = closure[i] || nested[i];
+        }
+    }
+
+    std::deque<std::unique_ptr<WorkspaceModuleLink>> inFlightLinks;
 
-    const auto joinPendingLink = [&]() -> Result {
-        if (!pendingLink)
-            return Result::Continue;
-        const std::unique_ptr<WorkspaceModuleLink> link = std::move(pendingLink);
+    const auto finalizeOldestLink = [&]() -> Result {
+        const std::unique_ptr<WorkspaceModuleLink> link = std::move(inFlightLinks.front());
+        inFlightLinks.pop_front();
         return finalizeWorkspaceModuleLink(*link);
     };
 
+    // An early error return drops the remaining links without finalizing them: each one joins its
+    // job on destruction (see ~WorkspaceModuleLink).
+    const auto finalizeAllLinks = [&]() -> Result {
+        while (!inFlightLinks.empty())
+            SWC_RESULT(finalizeOldestLink());
+        return Result::Continue;
+    };
+
     const uint32_t buildCount = static_cast<uint32_t>(buildOrder.size());
     for (uint32_t buildIndex = 0; buildIndex < buildCount; ++buildIndex)
     {
         const size_t                moduleIndex = buildOrder[buildIndex];
         const WorkspaceModuleBuild& moduleBuild = modules[moduleIndex];
 
-        if (pendingLink &&
-            std::ranges::find(moduleBuild.workspaceDependencies, pendingLink->moduleName) != moduleBuild.workspaceDependencies.end() &&
-            joinPendingLink() != Result::Continue)
-            return ExitCode::CompileError;
+        size_t numLinksToJoin = 0;
+        for (size_t i = 0; i < inFlightLinks.size(); ++i)
+        {
+            if (dependencyClosure[moduleIndex][moduleIndices.at(inFlightLinks[i]->moduleName)])
+                numLinksToJoin = i + 1;
+        }
+
+        while (numLinksToJoin--)
+        {
+            if (finalizeOldestLink() != Result::Continue)
+                return ExitCode::CompileError;
+        }
 
         // A documentation leaf renders directly from its in-memory symbols. Only modules with
         // active dependents need an API file for a later module to import.
@@ -2722,20 +2785,22 @@ ExitCode CompilerInstance::runWorkspace()
 
         if (modulePending)
         {
-            // Drain the previous in-flight link (it overlapped this module's compilation) before
-            // launching this one, keeping the pipeline depth at one.
-            if (joinPendingLink() != Result::Continue)
-                return ExitCode::CompileError;
+            const size_t maxInFlight = workspaceMaxInFlightLinks(global().jobMgr(), inFlightLinks.size());
+            while (inFlightLinks.size() >= maxInFlight)
+            {
+                if (finalizeOldestLink() != Result::Continue)
+                    return ExitCode::CompileError;
+            }
 
             modulePending->launchLink();
-            pendingLink = std::move(modulePending);
+            inFlightLinks.push_back(std::move(modulePending));
         }
 
         workspaceBuildLogState_.builtModules++;
         workspaceStage.setStat(formatWorkspaceStageStat(ctx, workspaceBuildLogState_));
     }
 
-    if (joinPendingLink() != Result::Continue)
+    if (finalizeAllLinks() != Result::Continue)
         return ExitCode::CompileError;
 
     if (cmdLine().command == CommandKind::Test && !cmdLine().testFileFilter.empty() && Stats::get().numTests.load(std::memory_order_relaxed) == testsBefore)
@@ -3106,12 +3171,7 @@ Result CompilerInstance::collectModuleSetupLoadedFiles(TaskContext& ctx, const s
         return Result::Continue;
 
     const uint64_t errorsBefore = Stats::getNumErrors();
-    for (SourceFile* file : added)
-    {
-        auto* job = makeJob<ParserJob>(ctx, file);
-        jobMgr.enqueue(*job, JobPriority::Normal, clientId);
-    }
-
+    enqueueParserJobs(*this, ctx, added);
     jobMgr.waitAll(clientId);
     if (Stats::getNumErrors() != errorsBefore)
         return Result::Error;
@@ -3149,12 +3209,7 @@ Result CompilerInstance::captureModuleSetupSnapshot(const TaskContext& ctx, cons
     const JobClientId clientId     = setupCompiler.jobClientId();
     const uint64_t    errorsBefore = Stats::getNumErrors();
 
-    for (SourceFile* file : setupCompiler.files())
-    {
-        auto* job = setupCompiler.makeJob<ParserJob>(setupCtx, file);
-        jobMgr.enqueue(*job, JobPriority::Normal, clientId);
-    }
-
+    enqueueParserJobs(setupCompiler, setupCtx, setupCompiler.files());
     jobMgr.waitAll(clientId);
     if (Stats::getNumErrors() != errorsBefore)
         return Result::Error;
@@ -3,6 +3,7 @@
 #include "Backend/JIT/JIT.h"
 #include "Backend/JIT/JITExecManager.h"
 #include "Backend/JIT/JITMemoryManager.h"
+#include "Backend/Micro/MachineCodeDedup.h"
 #include "Backend/Native/NativeBackendBuilder.h"
 #include "Backend/RuntimeName.h"
 #include "Compiler/CodeGen/Core/CodeGenJob.h"
@@ -26,6 +27,7 @@
 #include "Main/Global.h"
 #include "Main/Stats.h"
 #include "Main/TaskContext.h"
+#include "Main/Trace.h"
 #include "Support/Core/LookupTable.h"
 #include "Support/Core/Timer.h"
 #include "Support/Core/Utf8Helper.h"
@@ -340,8 +342,9 @@ CompilerInstance::CompilerInstance(const Global& global, const CommandLine& cmdL
     if (cmdLine.command == CommandKind::Test || hasRunArg(cmdLine.runArgs, SWAG_TEST_RUN_ARG))
         headlessTestRun = true;
 
-    jobClientId_ = global.jobMgr().newClientId();
-    exeFullName_ = Os::getExeFullName();
+    jobClientId_       = global.jobMgr().newClientId();
+    jitTierUpClientId_ = global.jobMgr().newClientId();
+    exeFullName_       = Os::getExeFullName();
 
     // The mutable global segments live in the proximity arena so JIT-executed
     // code reaches them RIP-relative (see Os::allocProximityMemory).
@@ -359,6 +362,11 @@ CompilerInstance::CompilerInstance(const Global& global, const CommandLine& cmdL
 
 CompilerInstance::~CompilerInstance()
 {
+    // Running JIT code asks for optimized recompiles whenever a function gets hot, whatever the
+    // path that ran it. They have a client of their own so that this is the one place that must
+    // drain them: the jobs and the functions they patch die with this instance.
+    global().jobMgr().waitAll(jitTierUpClientId_);
+
     // SymbolFunction instances are arena-allocated, so their JITMemory destructors do not reliably
     // run during compiler teardown. Unregister prepared function tables before executable pages are
     // released or stale Windows unwind entries can survive into the next compiler instance.
@@ -388,6 +396,14 @@ const JITMemoryManager& CompilerInstance::jitMemMgr() const
     return const_cast<CompilerInstance*>(this)->jitMemMgr();
 }
 
+MachineCodeDedup& CompilerInstance::machineCodeDedup()
+{
+    std::call_once(machineCodeDedupOnce_, [this] {
+        machineCodeDedup_ = std::make_unique<MachineCodeDedup>();
+    });
+    return *machineCodeDedup_;
+}
+
 JITExecManager& CompilerInstance::jitExecMgr()
 {
     std::call_once(jitExecMgrOnce_, [this] {
@@ -539,6 +555,21 @@ void CompilerInstance::logStats()
     Stats::get().print(ctx);
 }
 
+void CompilerInstance::writeTrace()
+{
+    if (cmdLine().traceFile.empty())
+        return;
+
+    TaskContext             ctx(*this);
+    FileSystem::IoErrorInfo ioError;
+    if (Trace::write(cmdLine().traceFile, ioError) != Result::Continue)
+    {
+        Diagnostic diag = Diagnostic::get(DiagnosticId::cmd_err_trace_write_failed);
+        FileSystem::setDiagnosticPathAndBecause(diag, &ctx, cmdLine().traceFile, FileSystem::describeIoFailure(ioError));
+        diag.report(ctx);
+    }
+}
+
 void CompilerInstance::processCommand()
 {
     const Timer time(&Stats::get().timeTotal);
@@ -944,6 +975,7 @@ ExitCode CompilerInstance::run()
 
     commandWallTimeNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - runStart).count();
     logStats();
+    writeTrace();
     return exitCode;
 }
 
@@ -34,6 +34,7 @@ class SymbolNamespace;
 class SymbolFunction;
 class SymbolVariable;
 class JITMemoryManager;
+class MachineCodeDedup;
 class ExternalModuleManager;
 class Global;
 class SourceFile;
@@ -119,6 +120,7 @@ public:
     const Global&      global() const { return *(global_); }
     const CommandLine& cmdLine() const { return *(cmdLine_); }
     JobClientId        jobClientId() const { return jobClientId_; }
+    JobClientId        jitTierUpClientId() const { return jitTierUpClientId_; }
 
     template<typename T, typename... ARGS>
     T* makeJob(ARGS&&... args) const
@@ -166,6 +168,7 @@ public:
     const Runtime::CompilerMessage& runtimeCompilerMessage() const { return runtimeCompilerMessage_; }
     JITMemoryManager&               jitMemMgr();
     const JITMemoryManager&         jitMemMgr() const;
+    MachineCodeDedup&               machineCodeDedup();
     JITExecManager&                 jitExecMgr();
     const JITExecManager&           jitExecMgr() const;
     ExternalModuleManager&          externalModuleMgr() { return *(externalModuleMgr_.get()); }
@@ -425,10 +428,13 @@ private:
     std::unique_ptr<IdentifierManager>             idMgr_;
     mutable std::unique_ptr<JITMemoryManager>      jitMemMgr_;
     mutable std::once_flag                         jitMemMgrOnce_;
+    std::unique_ptr<MachineCodeDedup>              machineCodeDedup_;
+    std::once_flag                                 machineCodeDedupOnce_;
     std::unique_ptr<ExternalModuleManager>         externalModuleMgr_;
     SymbolModule*                                  symModule_           = nullptr;
     SymbolNamespace*                               importRootNamespace_ = nullptr;
     JobClientId                                    jobClientId_         = 0;
+    JobClientId                                    jitTierUpClientId_   = 0;
     mutable std::mutex                             ownedJobsMutex_;
     mutable std::vector<std::unique_ptr<Job>>      ownedJobs_;
     fs::path                                       modulePathSrc_;
@@ -547,6 +553,7 @@ private:
 
     void   logBefore();
     void   logStats();
+    void   writeTrace();
     void   processCommand();
     void   setupRuntimeCompiler();
     bool   tryGetCompilerMessageTypeInfo(TypeRef typeRef, const Runtime::TypeInfo*& outType);
@@ -4,6 +4,7 @@
 #include "Compiler/Lexer/LangSpec.h"
 #include "Main/Command/CommandLine.h"
 #include "Main/Stats.h"
+#include "Main/Trace.h"
 #include "Support/Memory/MemoryProfile.h"
 #include "Support/Os/Os.h"
 #include "Support/Report/Logger.h"
@@ -25,6 +26,7 @@ Global::Global()
 void Global::initialize(const CommandLine& cmdLine) const
 {
     Stats::setEnabled(cmdLine.stats);
+    Trace::setEnabled(!cmdLine.traceFile.empty());
     MemoryProfile::setTrackingEnabled(cmdLine.statsMem);
     MemoryProfile::setDetailedTrackingEnabled(cmdLine.statsMem);
     Os::initialize();
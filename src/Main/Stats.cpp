@@ -51,7 +51,7 @@ namespace
     }
 }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
 namespace
 {
     struct TreeNode
@@ -194,7 +194,11 @@ namespace
                 appendMemoryTree(entries, *child, totalPeakBytes, depth + 1);
         }
     }
+}
+#endif
 
+namespace
+{
     struct MicroStageTransition
     {
         const char* countLabel    = nullptr;
@@ -219,6 +223,8 @@ namespace
         addField(entries, "SkipFmt", Utf8Helper::countWithLabel(skippedFmtFiles, "file"));
         addField(entries, "Parse errors", Utf8Helper::countWithLabel(skippedInvalidFile, "file"));
         addField(entries, "Tokens", Utf8Helper::toNiceBigNumber(stats.numTokens.load()));
+        addField(entries, "Lexer cache hits", Utf8Helper::toNiceBigNumber(stats.numLexerCacheHits.load()));
+        addField(entries, "Lexer cache misses", Utf8Helper::toNiceBigNumber(stats.numLexerCacheMisses.load()));
         addField(entries, "AST nodes", Utf8Helper::toNiceBigNumber(stats.numAstNodes.load()));
         Logger::printFieldGroup(ctx, "Format", entries, nextInfoGroupStyle(hasPrintedGroup, 32));
 
@@ -232,7 +238,6 @@ namespace
         Logger::printFieldGroup(ctx, "Timings", entries, nextInfoGroupStyle(hasPrintedGroup, 30));
     }
 }
-#endif
 
 void Stats::resetCommandMetrics()
 {
@@ -247,45 +252,8 @@ void Stats::resetCommandMetrics()
     stats.numTokens.store(0, std::memory_order_relaxed);
     stats.numFormatRewrittenFiles.store(0, std::memory_order_relaxed);
 
-#if SWC_HAS_STATS
-    stats.timeLoadFile.store(0, std::memory_order_relaxed);
-    stats.timeLexer.store(0, std::memory_order_relaxed);
-    stats.timeParser.store(0, std::memory_order_relaxed);
-    stats.timeSema.store(0, std::memory_order_relaxed);
-    stats.timeCodeGen.store(0, std::memory_order_relaxed);
-    stats.timeMicroLower.store(0, std::memory_order_relaxed);
-    stats.timeFormat.store(0, std::memory_order_relaxed);
-    stats.timeFormatWrite.store(0, std::memory_order_relaxed);
-
-    stats.numFormatSkipFmtFiles.store(0, std::memory_order_relaxed);
-    stats.numFormatSkippedInvalidFiles.store(0, std::memory_order_relaxed);
-    stats.numAstNodes.store(0, std::memory_order_relaxed);
-    stats.numVisitedAstNodes.store(0, std::memory_order_relaxed);
-    stats.numConstants.store(0, std::memory_order_relaxed);
-    stats.numConstantBuiltinFastHits.store(0, std::memory_order_relaxed);
-    stats.numConstantSmallScalarCacheHits.store(0, std::memory_order_relaxed);
-    stats.numConstantSmallScalarCacheMisses.store(0, std::memory_order_relaxed);
-    stats.numConstantSlowPathCalls.store(0, std::memory_order_relaxed);
-    stats.numConstantMaterializedPayloadFastPath.store(0, std::memory_order_relaxed);
-    stats.numTypes.store(0, std::memory_order_relaxed);
-    stats.numIdentifiers.store(0, std::memory_order_relaxed);
-    stats.numSymbols.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrInitial.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrAfterStart.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrAfterPreRaOptim.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrAfterRa.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrAfterPostRaSetup.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrAfterPostRaOptim.store(0, std::memory_order_relaxed);
-    stats.numMicroInstrFinal.store(0, std::memory_order_relaxed);
-    stats.numCodeGenFunctions.store(0, std::memory_order_relaxed);
-    stats.numMicroSsaBuilds.store(0, std::memory_order_relaxed);
-    stats.numMicroSsaInvalidations.store(0, std::memory_order_relaxed);
-    stats.timeMicroSsaBuild.store(0, std::memory_order_relaxed);
-    stats.timeMicroSsaBlocks.store(0, std::memory_order_relaxed);
-    stats.timeMicroSsaDominators.store(0, std::memory_order_relaxed);
-    stats.timeMicroSsaPhiPlacement.store(0, std::memory_order_relaxed);
-    stats.timeMicroSsaRename.store(0, std::memory_order_relaxed);
-#endif
+    stats.timeSanitizerMaxFunction.store(0, std::memory_order_relaxed);
+    StatCounter::resetAll();
 }
 
 void Stats::print(const TaskContext& ctx) const
@@ -300,10 +268,10 @@ void Stats::print(const TaskContext& ctx) const
         addField(entries, "Workers", Utf8Helper::toNiceBigNumber(ctx.global().jobMgr().numWorkers()));
         addField(entries, "Total time", Utf8Helper::toNiceTime(Timer::toSeconds(timeTotal.load())));
         addField(entries, "OS peak memory", Utf8Helper::toNiceSize(Os::peakProcessMemoryUsage()));
+        addField(entries, "Job scratch", std::format("{} in {} blocks", Utf8Helper::toNiceSize(numScratchBytes.load()), Utf8Helper::toNiceBigNumber(numScratchBlocks.load())));
         Logger::printFieldGroup(ctx, "Session", entries, nextInfoGroupStyle(hasPrintedGroup, 32));
     }
 
-#if SWC_HAS_STATS
     if (ctx.cmdLine().stats)
     {
         if (ctx.cmdLine().command == CommandKind::Format)
@@ -315,6 +283,8 @@ void Stats::print(const TaskContext& ctx) const
             entries.clear();
             addField(entries, "Files", Utf8Helper::toNiceBigNumber(numFiles.load()));
             addField(entries, "Tokens", Utf8Helper::toNiceBigNumber(numTokens.load()));
+            addField(entries, "Lexer cache hits", Utf8Helper::toNiceBigNumber(numLexerCacheHits.load()));
+            addField(entries, "Lexer cache misses", Utf8Helper::toNiceBigNumber(numLexerCacheMisses.load()));
             addField(entries, "AST nodes", Utf8Helper::toNiceBigNumber(numAstNodes.load()));
             addField(entries, "Visited AST nodes", Utf8Helper::toNiceBigNumber(numVisitedAstNodes.load()));
             Logger::printFieldGroup(ctx, "Frontend", entries, nextInfoGroupStyle(hasPrintedGroup, 32));
@@ -325,6 +295,8 @@ void Stats::print(const TaskContext& ctx) const
             addField(entries, "Small scalar cache hits", Utf8Helper::toNiceBigNumber(numConstantSmallScalarCacheHits.load()));
             addField(entries, "Small scalar cache misses", Utf8Helper::toNiceBigNumber(numConstantSmallScalarCacheMisses.load()));
             addField(entries, "Slow path calls", Utf8Helper::toNiceBigNumber(numConstantSlowPathCalls.load()));
+            addField(entries, "Front cache hits", Utf8Helper::toNiceBigNumber(numConstantFrontCacheHits.load()));
+            addField(entries, "Intern races lost", Utf8Helper::toNiceBigNumber(numConstantInternRacesLost.load()));
             addField(entries, "Materialized payload fast path", Utf8Helper::toNiceBigNumber(numConstantMaterializedPayloadFastPath.load()));
             addField(entries, "Types", Utf8Helper::toNiceBigNumber(numTypes.load()));
             addField(entries, "Identifiers", Utf8Helper::toNiceBigNumber(numIdentifiers.load()));
@@ -368,6 +340,17 @@ void Stats::print(const TaskContext& ctx) const
             addField(entries, "Initial to final delta", std::format("{}{} ({}%)", pipelineSign, Utf8Helper::toNiceBigNumber(pipelineAbs), Utf8Helper::formatFixedDecimal(pipelinePct, 2, true)));
             addField(entries, "SSA builds", Utf8Helper::toNiceBigNumber(numMicroSsaBuilds.load()));
             addField(entries, "SSA invalidations", Utf8Helper::toNiceBigNumber(numMicroSsaInvalidations.load()));
+            addField(entries, "Safety guards removed", Utf8Helper::toNiceBigNumber(numMicroSafetyGuardsRemoved.load()));
+            addField(entries, "Functions with guards removed", Utf8Helper::toNiceBigNumber(numMicroSafetyGuardFunctions.load()));
+            addField(entries, "Tail calls", Utf8Helper::toNiceBigNumber(numMicroTailCalls.load()));
+            addField(entries, "Machine code dedup hits", Utf8Helper::toNiceBigNumber(numMachineCodeDedupHits.load()));
+            addField(entries, "Machine code dedup misses", Utf8Helper::toNiceBigNumber(numMachineCodeDedupMisses.load()));
+            addField(entries, "Short jumps (rel8)", Utf8Helper::toNiceBigNumber(numMicroShortJumps.load()));
+            addField(entries, "Near jumps (rel32)", Utf8Helper::toNiceBigNumber(numMicroNearJumps.load()));
+            addField(entries, "Native code size", Utf8Helper::toNiceSize(numNativeCodeBytes.load()));
+            addField(entries, "JIT baseline functions", Utf8Helper::toNiceBigNumber(numJitBaselineFunctions.load()));
+            addField(entries, "JIT tier-ups", Utf8Helper::toNiceBigNumber(numJitTierUps.load()));
+            addField(entries, "Sanitized functions", Utf8Helper::toNiceBigNumber(numSanitizedFunctions.load()));
             Logger::printFieldGroup(ctx, "Micro Pipeline", entries, nextInfoGroupStyle(hasPrintedGroup, 36));
 
             entries.clear();
@@ -382,10 +365,23 @@ void Stats::print(const TaskContext& ctx) const
             addField(entries, "Micro SSA dominators", Utf8Helper::toNiceTime(Timer::toSeconds(timeMicroSsaDominators.load())));
             addField(entries, "Micro SSA phi placement", Utf8Helper::toNiceTime(Timer::toSeconds(timeMicroSsaPhiPlacement.load())));
             addField(entries, "Micro SSA rename", Utf8Helper::toNiceTime(Timer::toSeconds(timeMicroSsaRename.load())));
+            addField(entries, "Sanitizer", Utf8Helper::toNiceTime(Timer::toSeconds(timeSanitizer.load())));
+            addField(entries, "Sanitizer per function", Utf8Helper::toNiceTime(Timer::toSeconds(numSanitizedFunctions.load() ? timeSanitizer.load() / numSanitizedFunctions.load() : 0)));
+            addField(entries, "Sanitizer slowest function", Utf8Helper::toNiceTime(Timer::toSeconds(timeSanitizerMaxFunction.load())));
             Logger::printFieldGroup(ctx, "Timings", entries, nextInfoGroupStyle(hasPrintedGroup, 34));
+
+            entries.clear();
+            addField(entries, "Module streams", Utf8Helper::toNiceTime(Timer::toSeconds(timePdbModuleStreams.load())));
+            addField(entries, "Symbol streams", Utf8Helper::toNiceTime(Timer::toSeconds(timePdbSymbolStreams.load())));
+            addField(entries, "Type streams", Utf8Helper::toNiceTime(Timer::toSeconds(timePdbTypeStreams.load())));
+            addField(entries, "DBI stream", Utf8Helper::toNiceTime(Timer::toSeconds(timePdbDbiStream.load())));
+            addField(entries, "MSF layout", Utf8Helper::toNiceTime(Timer::toSeconds(timePdbMsfLayout.load())));
+            addField(entries, "Shared type records", Utf8Helper::toNiceBigNumber(numDebugTypeRecordsShared.load()));
+            Logger::printFieldGroup(ctx, "PDB", entries, nextInfoGroupStyle(hasPrintedGroup, 34));
         }
     }
 
+#if SWC_HAS_MEMORY_STATS
     if (ctx.cmdLine().statsMem)
     {
         MemoryProfile::Summary summary;
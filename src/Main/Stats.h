@@ -1,4 +1,6 @@
 #pragma once
+#include "Support/Core/StatCounter.h"
+
 SWC_BEGIN_NAMESPACE();
 
 class TaskContext;
@@ -14,50 +16,77 @@ struct Stats
     std::atomic<size_t>   numTokens               = 0;
     std::atomic<size_t>   numFormatRewrittenFiles = 0;
 
-#if SWC_HAS_STATS
     std::atomic<bool> enabled = false;
 
-    std::atomic<uint64_t> timeLoadFile    = 0;
-    std::atomic<uint64_t> timeLexer       = 0;
-    std::atomic<uint64_t> timeParser      = 0;
-    std::atomic<uint64_t> timeSema        = 0;
-    std::atomic<uint64_t> timeCodeGen     = 0;
-    std::atomic<uint64_t> timeMicroLower  = 0;
-    std::atomic<uint64_t> timeFormat      = 0;
-    std::atomic<uint64_t> timeFormatWrite = 0;
-
+#if SWC_HAS_MEMORY_STATS
     std::atomic<size_t> memAllocated    = 0;
     std::atomic<size_t> memMaxAllocated = 0;
+#endif
 
-    std::atomic<size_t>   numFormatSkipFmtFiles                  = 0;
-    std::atomic<size_t>   numFormatSkippedInvalidFiles           = 0;
-    std::atomic<size_t>   numAstNodes                            = 0;
-    std::atomic<size_t>   numVisitedAstNodes                     = 0;
-    std::atomic<size_t>   numConstants                           = 0;
-    std::atomic<size_t>   numConstantBuiltinFastHits             = 0;
-    std::atomic<size_t>   numConstantSmallScalarCacheHits        = 0;
-    std::atomic<size_t>   numConstantSmallScalarCacheMisses      = 0;
-    std::atomic<size_t>   numConstantSlowPathCalls               = 0;
-    std::atomic<size_t>   numConstantMaterializedPayloadFastPath = 0;
-    std::atomic<size_t>   numTypes                               = 0;
-    std::atomic<size_t>   numIdentifiers                         = 0;
-    std::atomic<size_t>   numSymbols                             = 0;
-    std::atomic<size_t>   numMicroInstrInitial                   = 0;
-    std::atomic<size_t>   numMicroInstrAfterStart                = 0;
-    std::atomic<size_t>   numMicroInstrAfterPreRaOptim           = 0;
-    std::atomic<size_t>   numMicroInstrAfterRa                   = 0;
-    std::atomic<size_t>   numMicroInstrAfterPostRaSetup          = 0;
-    std::atomic<size_t>   numMicroInstrAfterPostRaOptim          = 0;
-    std::atomic<size_t>   numMicroInstrFinal                     = 0;
-    std::atomic<size_t>   numCodeGenFunctions                    = 0;
-    std::atomic<size_t>   numMicroSsaBuilds                      = 0;
-    std::atomic<size_t>   numMicroSsaInvalidations               = 0;
-    std::atomic<uint64_t> timeMicroSsaBuild                      = 0;
-    std::atomic<uint64_t> timeMicroSsaBlocks                     = 0;
-    std::atomic<uint64_t> timeMicroSsaDominators                 = 0;
-    std::atomic<uint64_t> timeMicroSsaPhiPlacement               = 0;
-    std::atomic<uint64_t> timeMicroSsaRename                     = 0;
-#endif // SWC_HAS_STATS
+    // Bumped from every worker, so each one counts in a slab of its own (see StatCounter).
+    StatCounter timeLoadFile;
+    StatCounter timeLexer;
+    StatCounter timeParser;
+    StatCounter timeSema;
+    StatCounter timeCodeGen;
+    StatCounter timeMicroLower;
+    StatCounter timeFormat;
+    StatCounter timeFormatWrite;
+
+    StatCounter numLexerCacheHits;
+    StatCounter numLexerCacheMisses;
+    StatCounter numFormatSkipFmtFiles;
+    StatCounter numFormatSkippedInvalidFiles;
+    StatCounter numAstNodes;
+    StatCounter numVisitedAstNodes;
+    StatCounter numConstants;
+    StatCounter numConstantBuiltinFastHits;
+    StatCounter numConstantSmallScalarCacheHits;
+    StatCounter numConstantSmallScalarCacheMisses;
+    StatCounter numConstantSlowPathCalls;
+    StatCounter numConstantFrontCacheHits;
+    StatCounter numConstantInternRacesLost;
+    StatCounter numConstantMaterializedPayloadFastPath;
+    StatCounter numTypes;
+    StatCounter numIdentifiers;
+    StatCounter numSymbols;
+    StatCounter numMicroInstrInitial;
+    StatCounter numMicroInstrAfterStart;
+    StatCounter numMicroInstrAfterPreRaOptim;
+    StatCounter numMicroInstrAfterRa;
+    StatCounter numMicroInstrAfterPostRaSetup;
+    StatCounter numMicroInstrAfterPostRaOptim;
+    StatCounter numMicroInstrFinal;
+    StatCounter numCodeGenFunctions;
+    StatCounter numMachineCodeDedupHits;
+    StatCounter numMachineCodeDedupMisses;
+    StatCounter numMicroShortJumps;
+    StatCounter numMicroNearJumps;
+    StatCounter numNativeCodeBytes;
+    StatCounter numJitBaselineFunctions;
+    StatCounter numJitTierUps;
+    StatCounter numMicroSsaBuilds;
+    StatCounter numMicroSsaInvalidations;
+    StatCounter numMicroSafetyGuardsRemoved;
+    StatCounter numMicroSafetyGuardFunctions;
+    StatCounter numMicroTailCalls;
+    StatCounter timeMicroSsaBuild;
+    StatCounter timeMicroSsaBlocks;
+    StatCounter timeMicroSsaDominators;
+    StatCounter timeMicroSsaPhiPlacement;
+    StatCounter timeMicroSsaRename;
+    StatCounter numSanitizedFunctions;
+    StatCounter timeSanitizer;
+    StatCounter numDebugTypeRecordsShared;
+    StatCounter timePdbModuleStreams;
+    StatCounter timePdbSymbolStreams;
+    StatCounter timePdbTypeStreams;
+    StatCounter timePdbDbiStream;
+    StatCounter timePdbMsfLayout;
+    StatCounter numScratchBytes;
+    StatCounter numScratchBlocks;
+
+    std::atomic<uint64_t> timeSanitizerMaxFunction = 0;
 
     static Stats& get()
     {
@@ -84,36 +113,27 @@ struct Stats
 
     static void setEnabled(bool enabled)
     {
-#if SWC_HAS_STATS
         get().enabled.store(enabled, std::memory_order_relaxed);
-#else
-        SWC_UNUSED(enabled);
-#endif
     }
 
     static bool enabledRuntime()
     {
-#if SWC_HAS_STATS
         return get().enabled.load(std::memory_order_relaxed);
-#else
-        return false;
-#endif
     }
 
-    static std::atomic<uint64_t>* timedMetric(std::atomic<uint64_t>& metric)
+    static const StatCounter* timedMetric(const StatCounter& metric)
     {
-#if SWC_HAS_STATS
-        if (enabledRuntime())
-            return &metric;
-#endif
-        SWC_UNUSED(metric);
-        return nullptr;
+        return enabledRuntime() ? &metric : nullptr;
     }
 
     static void setMax(const std::atomic<size_t>& valCur, std::atomic<size_t>& valMax)
     {
-        const size_t current = valCur.load(std::memory_order_relaxed);
-        size_t       prevMax = valMax.load(std::memory_order_relaxed);
+        setMax(valCur.load(std::memory_order_relaxed), valMax);
+    }
+
+    static void setMax(const size_t current, std::atomic<size_t>& valMax)
+    {
+        size_t prevMax = valMax.load(std::memory_order_relaxed);
         while (current > prevMax && !valMax.compare_exchange_weak(prevMax, current, std::memory_order_relaxed))
         {
         }
@@ -24,6 +24,7 @@ TaskContext::TaskContext(const TaskContext& other) :
     silentDiagnostic_(other.silentDiagnostic_),
     reportToStats_(other.reportToStats_),
     muteOutput_(other.muteOutput_),
+    outputCapture_(other.outputCapture_),
     hasError_(other.hasError_),
     hasWarning_(other.hasWarning_),
     state_(other.state_)
@@ -41,6 +42,7 @@ TaskContext& TaskContext::operator=(const TaskContext& other)
     silentDiagnostic_ = other.silentDiagnostic_;
     reportToStats_    = other.reportToStats_;
     muteOutput_       = other.muteOutput_;
+    outputCapture_    = other.outputCapture_;
     hasError_         = other.hasError_;
     hasWarning_       = other.hasWarning_;
     state_            = other.state_;
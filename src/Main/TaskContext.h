@@ -10,6 +10,7 @@ class Global;
 class SourceFile;
 class TypeManager;
 class TypeGen;
+class Utf8;
 struct CommandLine;
 class TaskContext
 {
@@ -46,6 +47,8 @@ public:
     void                         setReportToStats(bool reportToStats) { reportToStats_ = reportToStats; }
     bool                         muteOutput() const { return muteOutput_; }
     void                         setMuteOutput(bool mute) { muteOutput_ = mute; }
+    Utf8*                        outputCapture() const { return outputCapture_; }
+    void                         setOutputCapture(Utf8* capture) { outputCapture_ = capture; }
     void                         setHasError() { hasError_ = true; }
     void                         setHasWarning() { hasWarning_ = true; }
     bool                         hasError() const { return hasError_; }
@@ -68,6 +71,7 @@ private:
     bool                                          silentDiagnostic_ = false;
     bool                                          reportToStats_    = true;
     bool                                          muteOutput_       = false;
+    Utf8*                                         outputCapture_    = nullptr;
     bool                                          hasError_         = false;
     bool                                          hasWarning_       = false;
     TaskState                                     state_;
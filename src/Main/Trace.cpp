@@ -0,0 +1,278 @@
+#include "pch.h"
+#include "Main/Trace.h"
+#include "Main/FileSystem.h"
+#include "Support/Core/Timer.h"
+#include "Support/Os/Os.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    constexpr size_t THREAD_BUFFER_CAPACITY = 256 * 1024;
+
+    struct TraceEvent
+    {
+        std::string_view name;
+        std::string_view reason;
+        Utf8             file;
+        Utf8             symbol;
+        uint64_t         startNs    = 0;
+        uint64_t         durationNs = 0;
+        TraceEventKind   kind       = TraceEventKind::Job;
+        bool             instant    = false;
+    };
+
+    // Only its own thread records into a buffer; the mutex is there for write(), which may run
+    // while a late worker still records.
+    struct ThreadBuffer
+    {
+        std::mutex              mutex;
+        Utf8                    threadName;
+        uint32_t                tid = 0;
+        std::vector<TraceEvent> events;
+        size_t                  next    = 0;
+        uint64_t                dropped = 0;
+
+        void push(TraceEvent&& event)
+        {
+            const std::scoped_lock lock(mutex);
+            if (events.size() < THREAD_BUFFER_CAPACITY)
+            {
+                events.push_back(std::move(event));
+                return;
+            }
+
+            events[next] = std::move(event);
+            next         = (next + 1) % THREAD_BUFFER_CAPACITY;
+            dropped++;
+        }
+    };
+
+    struct TraceRegistry
+    {
+        std::mutex                                 mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        Timer::Tick                                origin = Timer::Clock::now();
+    };
+
+    TraceRegistry& registry()
+    {
+        static TraceRegistry instance;
+        return instance;
+    }
+
+    thread_local ThreadBuffer* t_buffer = nullptr;
+
+    ThreadBuffer& threadBuffer()
+    {
+        if (t_buffer)
+            return *t_buffer;
+
+        TraceRegistry&         reg = registry();
+        const std::scoped_lock lock(reg.mutex);
+        auto                   buffer = std::make_unique<ThreadBuffer>();
+        buffer->tid                   = static_cast<uint32_t>(reg.buffers.size()) + 1;
+        buffer->threadName            = std::format("Thread {}", buffer->tid);
+        t_buffer                      = buffer.get();
+        reg.buffers.push_back(std::move(buffer));
+        return *t_buffer;
+    }
+
+    std::string_view kindCategory(const TraceEventKind kind)
+    {
+        switch (kind)
+        {
+            case TraceEventKind::Job:
+                return "job";
+            case TraceEventKind::Sleep:
+                return "sleep";
+            case TraceEventKind::Wake:
+                return "wake";
+            case TraceEventKind::Idle:
+                return "idle";
+            case TraceEventKind::Pass:
+                return "pass";
+        }
+
+        return "job";
+    }
+
+    void appendJsonString(Utf8& out, const std::string_view value)
+    {
+        out += '"';
+        for (const char c : value)
+        {
+            switch (c)
+            {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+                    else
+                        out += c;
+                    break;
+            }
+        }
+        out += '"';
+    }
+
+    void appendEvent(Utf8& out, const TraceEvent& event, const uint32_t pid, const uint32_t tid)
+    {
+        out += "{\"name\":";
+        appendJsonString(out, event.name);
+        out += ",\"cat\":";
+        appendJsonString(out, kindCategory(event.kind));
+        if (event.instant)
+            out += std::format(",\"ph\":\"i\",\"s\":\"t\",\"ts\":{:.3f}", static_cast<double>(event.startNs) / 1000.0);
+        else
+            out += std::format(",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f}", static_cast<double>(event.startNs) / 1000.0, static_cast<double>(event.durationNs) / 1000.0);
+        out += std::format(",\"pid\":{},\"tid\":{}", pid, tid);
+
+        if (!event.file.empty() || !event.symbol.empty() || !event.reason.empty())
+        {
+            out += ",\"args\":{";
+            bool first = true;
+            for (const auto& [key, value] : {std::pair<std::string_view, std::string_view>{"file", event.file}, {"symbol", event.symbol}, {"reason", event.reason}})
+            {
+                if (value.empty())
+                    continue;
+                if (!first)
+                    out += ',';
+                first = false;
+                appendJsonString(out, key);
+                out += ':';
+                appendJsonString(out, value);
+            }
+            out += '}';
+        }
+
+        out += '}';
+    }
+}
+
+void Trace::setEnabled(const bool enabled)
+{
+    if (enabled)
+    {
+        // Timestamps are relative to the origin, so whatever was recorded before it moved is meaningless.
+        clear();
+        registry().origin = Timer::Clock::now();
+        setThreadName("Main");
+    }
+
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - registry().origin).count();
+}
+
+void Trace::setThreadName(const std::string_view name)
+{
+    ThreadBuffer&          buffer = threadBuffer();
+    const std::scoped_lock lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void Trace::addSpan(const TraceEventKind kind, const std::string_view name, const uint64_t startNs, TraceArgs args)
+{
+    addSpan(kind, name, startNs, now(), std::move(args));
+}
+
+void Trace::addSpan(const TraceEventKind kind, const std::string_view name, const uint64_t startNs, const uint64_t endNs, TraceArgs args)
+{
+    TraceEvent event;
+    event.name       = name;
+    event.reason     = args.reason;
+    event.file       = std::move(args.file);
+    event.symbol     = std::move(args.symbol);
+    event.startNs    = startNs;
+    event.durationNs = endNs > startNs ? endNs - startNs : 0;
+    event.kind       = kind;
+    threadBuffer().push(std::move(event));
+}
+
+void Trace::addInstant(const TraceEventKind kind, const std::string_view name, TraceArgs args)
+{
+    addInstant(kind, name, now(), std::move(args));
+}
+
+void Trace::addInstant(const TraceEventKind kind, const std::string_view name, const uint64_t atNs, TraceArgs args)
+{
+    TraceEvent event;
+    event.name    = name;
+    event.reason  = args.reason;
+    event.file    = std::move(args.file);
+    event.symbol  = std::move(args.symbol);
+    event.startNs = atNs;
+    event.kind    = kind;
+    event.instant = true;
+    threadBuffer().push(std::move(event));
+}
+
+// Buffers stay registered: every thread that recorded keeps a pointer to its own.
+void Trace::clear()
+{
+    TraceRegistry&         reg = registry();
+    const std::scoped_lock regLock(reg.mutex);
+    for (const auto& buffer : reg.buffers)
+    {
+        const std::scoped_lock lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->next    = 0;
+        buffer->dropped = 0;
+    }
+}
+
+Result Trace::write(const fs::path& path, FileSystem::IoErrorInfo& outError)
+{
+    const uint32_t pid = Os::currentProcessId();
+
+    Utf8     out;
+    uint64_t dropped = 0;
+    out += "{\"traceEvents\":[";
+    bool first = true;
+
+    TraceRegistry&         reg = registry();
+    const std::scoped_lock regLock(reg.mutex);
+    for (const auto& buffer : reg.buffers)
+    {
+        const std::scoped_lock lock(buffer->mutex);
+        if (!first)
+            out += ',';
+        first = false;
+        out += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":", pid, buffer->tid);
+        appendJsonString(out, buffer->threadName);
+        out += "}}";
+
+        // Oldest first: once the ring has wrapped, that is the slot the next event would overwrite.
+        const size_t count = buffer->events.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            out += ",\n";
+            appendEvent(out, buffer->events[(buffer->next + i) % count], pid, buffer->tid);
+        }
+
+        dropped += buffer->dropped;
+    }
+
+    out += std::format("],\"displayTimeUnit\":\"ms\",\"otherData\":{{\"droppedEvents\":{}}}}}\n", dropped);
+    return FileSystem::writeBinaryFile(path, out.data(), out.size(), outError);
+}
+
+SWC_END_NAMESPACE();
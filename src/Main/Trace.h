@@ -0,0 +1,85 @@
+#pragma once
+#include "Support/Core/Result.h"
+#include "Support/Core/Utf8.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace FileSystem
+{
+    struct IoErrorInfo;
+}
+
+enum class TraceEventKind : uint8_t
+{
+    Job,
+    Sleep,
+    Wake,
+    Idle,
+    Pass,
+};
+
+// What an event was about. reason must outlive the trace, like event names: both are stored as
+// views and only copied when the file is written.
+struct TraceArgs
+{
+    std::string_view reason;
+    Utf8             file;
+    Utf8             symbol;
+};
+
+// Timeline of what every thread did, written with --trace as Chrome trace JSON that
+// chrome://tracing and Perfetto open directly. Each thread records into its own ring buffer: its
+// lock is only ever wanted by write() besides the owner, and the registry lock is taken once per
+// thread, on its first event. A full buffer overwrites its oldest events. Recording sites test
+// enabled() first, which is one relaxed load when tracing is off.
+//
+// Recording still takes a lock, so a site holding a contended lock of its own reads now() there
+// and records once it has let go, with the timestamp it read.
+class Trace
+{
+public:
+    static void     setEnabled(bool enabled);
+    static bool     enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static uint64_t now();
+
+    static void setThreadName(std::string_view name);
+    static void addSpan(TraceEventKind kind, std::string_view name, uint64_t startNs, TraceArgs args = {});
+    static void addSpan(TraceEventKind kind, std::string_view name, uint64_t startNs, uint64_t endNs, TraceArgs args = {});
+    static void addInstant(TraceEventKind kind, std::string_view name, TraceArgs args = {});
+    static void addInstant(TraceEventKind kind, std::string_view name, uint64_t atNs, TraceArgs args = {});
+    static void clear();
+
+    static Result write(const fs::path& path, FileSystem::IoErrorInfo& outError);
+
+    class ScopedSpan
+    {
+    public:
+        ScopedSpan(TraceEventKind kind, std::string_view name) :
+            name_(name),
+            startNs_(enabled() ? now() : 0),
+            kind_(kind),
+            active_(enabled())
+        {
+        }
+
+        ~ScopedSpan()
+        {
+            if (active_)
+                addSpan(kind_, name_, startNs_);
+        }
+
+        ScopedSpan(const ScopedSpan&)            = delete;
+        ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    private:
+        std::string_view name_;
+        uint64_t         startNs_ = 0;
+        TraceEventKind   kind_    = TraceEventKind::Pass;
+        bool             active_  = false;
+    };
+
+private:
+    static inline std::atomic<bool> enabled_ = false;
+};
+
+SWC_END_NAMESPACE();
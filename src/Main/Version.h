@@ -5,4 +5,4 @@
 // so what the previous one left behind is ignored instead of trusted.
 inline constexpr uint32_t SWC_VERSION   = 0;
 inline constexpr uint32_t SWC_REVISION  = 1;
-inline constexpr uint32_t SWC_BUILD_NUM = 181;
+inline constexpr uint32_t SWC_BUILD_NUM = 183;
@@ -73,6 +73,20 @@ namespace WorkspaceLayout
     // the directory is an entry rather than something else a user left here.
     inline constexpr std::string_view DEPENDENCY_CACHE_USED_MARKER = ".swc-used";
 
+    // Token streams of the source files a build lexed, one file per content, so that the inputs
+    // nearly every build shares (the runtime, the prelude, imported APIs) are lexed only once.
+    inline fs::path lexerCacheRoot()
+    {
+        return (cacheRoot() / "lex").lexically_normal();
+    }
+
+    // Symbol indices of the static and import libraries a link searched, one file per version of
+    // each library, so that a link does not decode the same system libraries every time.
+    inline fs::path archiveIndexCacheRoot()
+    {
+        return (cacheRoot() / "lib").lexically_normal();
+    }
+
     // Where compilers before 0.0.2 mirrored a script's dependencies: one directory per set of
     // imports, each with its own copy of every one of them. Nothing fills it any more, and it is
     // named here so that `swc clean --cache` can still give back the disk it holds.
@@ -110,7 +110,7 @@ uint32_t PagedStore::extentSize() const noexcept
     return 0;
 }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
 uint64_t PagedStore::allocatedBytes() const noexcept
 {
     return snapshotPages()->size() * pageSizeValue_;
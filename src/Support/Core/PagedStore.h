@@ -35,7 +35,7 @@ public:
     void     enableProximityPages() noexcept { proximityPages_ = true; }
     uint32_t size() const noexcept;
     uint32_t extentSize() const noexcept;
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
     uint64_t allocatedBytes() const noexcept;
 #endif
     bool     containsRef(Ref ref, uint32_t minSize = 1) const noexcept;
@@ -4,14 +4,14 @@
 
 SWC_BEGIN_NAMESPACE();
 
-template<class T, std::size_t InlineCapacity = 16>
+template<class T, std::size_t InlineCapacity = 16, class Allocator = std::allocator<T>>
 class SmallVector
 {
     static_assert(InlineCapacity > 0, "InlineCapacity must be > 0");
 
 public:
     using value_type             = T;
-    using allocator_type         = std::allocator<T>;
+    using allocator_type         = Allocator;
     using size_type              = std::size_t;
     using difference_type        = std::ptrdiff_t;
     using reference              = T&;
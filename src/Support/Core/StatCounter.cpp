@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "Support/Core/StatCounter.h"
+#include "Support/Report/Assert.h"
+
+SWC_BEGIN_NAMESPACE();
+
+struct StatCounter::Registry
+{
+    std::mutex                         mutex;
+    std::vector<std::unique_ptr<Slab>> slabs;
+    std::array<uint64_t, MAX_COUNTERS> origins{};
+    uint32_t                           numCounters = 0;
+
+    uint64_t sum(const uint32_t index) const
+    {
+        uint64_t result = 0;
+        for (const auto& slab : slabs)
+            result += slab->values[index].load(std::memory_order_relaxed);
+        return result;
+    }
+};
+
+StatCounter::Registry& StatCounter::registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+StatCounter::StatCounter()
+{
+    Registry&              reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    SWC_ASSERT(reg.numCounters < MAX_COUNTERS);
+    index_ = reg.numCounters++;
+}
+
+StatCounter::Slab* StatCounter::registerThreadSlab()
+{
+    Registry&              reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    reg.slabs.push_back(std::make_unique<Slab>());
+    return reg.slabs.back().get();
+}
+
+uint64_t StatCounter::load() const
+{
+    Registry&              reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    return reg.sum(index_) - reg.origins[index_];
+}
+
+void StatCounter::resetAll()
+{
+    Registry&              reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    for (uint32_t i = 0; i < reg.numCounters; ++i)
+        reg.origins[i] = reg.sum(i);
+}
+
+SWC_END_NAMESPACE();
@@ -0,0 +1,52 @@
+#pragma once
+
+SWC_BEGIN_NAMESPACE();
+
+// A statistic any worker may bump. Each thread adds into its own slab of slots, so an increment
+// is a plain load and store on a cache line no other thread writes. load() sums the slabs of
+// every thread that ever counted, including the ones that have exited since.
+class StatCounter
+{
+public:
+    static constexpr uint32_t MAX_COUNTERS = 128;
+
+    StatCounter();
+
+    StatCounter(const StatCounter&)            = delete;
+    StatCounter& operator=(const StatCounter&) = delete;
+
+    void add(uint64_t value) const
+    {
+        std::atomic<uint64_t>& slot = threadSlab().values[index_];
+        slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const;
+
+    // Restarts every counter from zero. Slabs are only ever written by their own thread, so this
+    // records the current sums as the new origin instead of clearing them.
+    static void resetAll();
+
+private:
+    struct alignas(64) Slab
+    {
+        std::array<std::atomic<uint64_t>, MAX_COUNTERS> values{};
+    };
+
+    static Slab& threadSlab()
+    {
+        if (!threadSlab_)
+            threadSlab_ = registerThreadSlab();
+        return *threadSlab_;
+    }
+
+    struct Registry;
+
+    static Registry& registry();
+    static Slab*     registerThreadSlab();
+
+    static inline thread_local Slab* threadSlab_ = nullptr;
+    uint32_t                          index_     = 0;
+};
+
+SWC_END_NAMESPACE();
@@ -1,4 +1,5 @@
 #pragma once
+#include "Support/Core/StatCounter.h"
 
 SWC_BEGIN_NAMESPACE();
 
@@ -15,6 +16,14 @@ struct Timer
             start();
     }
 
+    explicit Timer(const StatCounter* dest) :
+        destCounter_{dest},
+        started_{destCounter_ != nullptr}
+    {
+        if (started_)
+            start();
+    }
+
     ~Timer()
     {
         stop();
@@ -29,8 +38,12 @@ struct Timer
     {
         if (started_)
         {
-            const Clock::duration duration = Clock::now() - timeBefore_;
-            *destValue_ += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            const Clock::duration duration   = Clock::now() - timeBefore_;
+            const uint64_t        durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            if (destCounter_)
+                destCounter_->add(durationNs);
+            else
+                *destValue_ += durationNs;
         }
     }
 
@@ -40,7 +53,8 @@ struct Timer
     }
 
 private:
-    std::atomic<uint64_t>* destValue_;
+    std::atomic<uint64_t>* destValue_   = nullptr;
+    const StatCounter*     destCounter_ = nullptr;
     Tick                   timeBefore_{};
     bool                   started_ = false;
 };
@@ -27,7 +27,7 @@ Arena::~Arena()
     releaseAll();
 }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
 size_t Arena::usedBytes() const noexcept
 {
     size_t result = 0;
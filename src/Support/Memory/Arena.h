@@ -38,7 +38,7 @@ public:
         head_ = nullptr;
     }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
     size_t usedBytes() const noexcept;
     size_t reservedBytes() const noexcept;
 #endif
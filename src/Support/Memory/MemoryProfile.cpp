@@ -4,7 +4,7 @@
 #include "Support/Os/Os.h"
 #include "Support/Report/Assert.h"
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
 #include "Main/Stats.h"
 #endif
 
@@ -19,7 +19,7 @@ namespace
         uint32_t flags         = 0;
     };
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
     constexpr uint32_t K_EXTERNAL_CAPACITY       = 16 * 1024;
     constexpr uint32_t K_INVALID_CATEGORY        = MemoryProfile::INVALID_CATEGORY;
     constexpr uint32_t K_ALLOCATION_FLAG_TRACKED = 1u << 0;
@@ -236,7 +236,7 @@ namespace MemoryProfile
 
     void setTrackingEnabled(const bool enabled)
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         memoryProfileState().trackingEnabled.store(enabled, std::memory_order_relaxed);
 #else
         SWC_UNUSED(enabled);
@@ -256,7 +256,7 @@ namespace MemoryProfile
 
     void setDetailedTrackingEnabled(const bool enabled)
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         memoryProfileState().detailedTrackingEnabled.store(enabled, std::memory_order_relaxed);
 #else
         SWC_UNUSED(enabled);
@@ -265,7 +265,7 @@ namespace MemoryProfile
 
     bool isTrackingEnabled()
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         return memoryProfileState().trackingEnabled.load(std::memory_order_relaxed);
 #else
         return false;
@@ -274,7 +274,7 @@ namespace MemoryProfile
 
     bool isDetailedTrackingEnabled()
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         return memoryProfileState().detailedTrackingEnabled.load(std::memory_order_relaxed);
 #else
         return false;
@@ -286,7 +286,7 @@ namespace MemoryProfile
         if (size == 0)
             size = 1;
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         const size_t effectiveAlignment = std::max(alignment, alignof(AllocationHeader));
         if (size > std::numeric_limits<size_t>::max() - sizeof(AllocationHeader))
         {
@@ -338,7 +338,7 @@ namespace MemoryProfile
         if (!block)
             return;
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         const auto* header = static_cast<AllocationHeader*>(block) - 1;
         if (header->flags & K_ALLOCATION_FLAG_TRACKED)
         {
@@ -354,7 +354,7 @@ namespace MemoryProfile
 
     void trackExternalAlloc(const void* ptr, const size_t size, const char* category, const char* file, const uint32_t line)
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         if (!ptr || size == 0 || !isTrackingEnabledInternal())
             return;
 
@@ -398,7 +398,7 @@ namespace MemoryProfile
 
     void trackExternalFree(const void* ptr) noexcept
     {
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
         if (!ptr)
             return;
 
@@ -417,7 +417,7 @@ namespace MemoryProfile
 #endif
     }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
     ScopedCategory::ScopedCategory(const char* category, const char* file, const uint32_t line)
     {
         prevIndex_ = g_CurrentCategory;
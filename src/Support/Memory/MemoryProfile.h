@@ -26,7 +26,7 @@ namespace MemoryProfile
     void                trackExternalAlloc(const void* ptr, size_t size, const char* category = nullptr, const char* file = nullptr, uint32_t line = 0);
     void                trackExternalFree(const void* ptr) noexcept;
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
     inline constexpr uint32_t MAX_CATEGORIES   = 512;
     inline constexpr uint32_t INVALID_CATEGORY = std::numeric_limits<uint32_t>::max();
 
@@ -79,7 +79,7 @@ namespace MemoryProfile
 #endif
 }
 
-#if SWC_HAS_STATS
+#if SWC_HAS_MEMORY_STATS
 #define SWC_MEM_CONCAT_IMPL(a, b) a##b
 #define SWC_MEM_CONCAT(a, b)      SWC_MEM_CONCAT_IMPL(a, b)
 #define SWC_MEM_SCOPE(category)   ::swc::MemoryProfile::ScopedCategory SWC_MEM_CONCAT(_swc_mem_, __LINE__)(category, __FILE__, __LINE__)
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "Support/Memory/ScratchArena.h"
+#include "Main/Stats.h"
+#include "Support/Memory/MemoryProfile.h"
+#include "Support/Report/Assert.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    ScratchArena& threadArena()
+    {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+}
+
+ScratchArena::~ScratchArena()
+{
+    for (const Block& block : blocks_)
+        operator delete(block.data);
+}
+
+ScratchArena::Mark ScratchArena::enter()
+{
+    ScratchArena& arena = threadArena();
+    if (!arena.depth_++)
+        active_ = &arena;
+    return {.block = arena.current_, .used = arena.used_};
+}
+
+void ScratchArena::leave(const Mark& mark)
+{
+    ScratchArena& arena = threadArena();
+    SWC_ASSERT(arena.depth_);
+    arena.current_ = mark.block;
+    arena.used_    = mark.used;
+    if (--arena.depth_)
+        return;
+
+    active_ = nullptr;
+    arena.trim();
+}
+
+void* ScratchArena::allocate(size_t size, const size_t alignment)
+{
+    if (!size)
+        size = 1;
+
+    if (Stats::enabledRuntime())
+        Stats::get().numScratchBytes.add(size);
+
+    if (!blocks_.empty())
+    {
+        if (void* ptr = tryBump(size, alignment))
+            return ptr;
+
+        // Blocks past the current one are free since the last rewind: reuse the next one if the
+        // request fits, otherwise slot a new block in front of it.
+        if (current_ + 1 < blocks_.size() && blocks_[current_ + 1].size >= size + alignment)
+        {
+            current_++;
+            used_ = 0;
+            return tryBump(size, alignment);
+        }
+    }
+
+    SWC_MEM_SCOPE("Scratch");
+    if (Stats::enabledRuntime())
+        Stats::get().numScratchBlocks.add(1);
+
+    const uint32_t index = blocks_.empty() ? 0 : current_ + 1;
+    const size_t   bytes = std::max(BLOCK_SIZE, size + alignment);
+    blocks_.insert(blocks_.begin() + index, {.data = static_cast<std::byte*>(operator new(bytes)), .size = bytes});
+    current_ = index;
+    used_    = 0;
+    return tryBump(size, alignment);
+}
+
+void ScratchArena::release(const void* ptr, const size_t size)
+{
+    if (blocks_.empty())
+        return;
+
+    const std::byte* data = blocks_[current_].data;
+    const auto*      at   = static_cast<const std::byte*>(ptr);
+    if (at >= data && at + std::max<size_t>(size, 1) == data + used_)
+        used_ = static_cast<size_t>(at - data);
+}
+
+void* ScratchArena::tryBump(const size_t size, const size_t alignment)
+{
+    const Block&    block  = blocks_[current_];
+    const uintptr_t base   = reinterpret_cast<uintptr_t>(block.data);
+    const uintptr_t offset = ((base + used_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - base;
+    if (offset + size > block.size)
+        return nullptr;
+
+    used_ = offset + size;
+    return block.data + offset;
+}
+
+void ScratchArena::trim()
+{
+    // A job with an unusually large working set should not pin its peak on the thread forever:
+    // keep a bounded set of regular blocks and give the rest back.
+    size_t   retained = 0;
+    uint32_t kept     = 0;
+    for (const Block& block : blocks_)
+    {
+        if (block.size == BLOCK_SIZE && retained + block.size <= RETAINED_BYTES)
+        {
+            blocks_[kept++] = block;
+            retained += block.size;
+        }
+        else
+        {
+            operator delete(block.data);
+        }
+    }
+
+    blocks_.resize(kept);
+    current_ = 0;
+    used_    = 0;
+}
+
+SWC_END_NAMESPACE();
@@ -0,0 +1,120 @@
+#pragma once
+#include "Support/Core/SmallVector.h"
+
+SWC_BEGIN_NAMESPACE();
+
+// Per-thread bump allocator for temporaries that die with the job that made them. JobManager
+// opens a scope around every Job::exec() and rewinds it afterwards, so the next job on the same
+// thread reuses the blocks instead of going back to the heap. Scopes nest: a job run from inside
+// another one (waitAll() in single-threaded mode) only rewinds what it allocated itself.
+class ScratchArena
+{
+public:
+    struct Mark
+    {
+        uint32_t block = 0;
+        size_t   used  = 0;
+    };
+
+    ScratchArena() = default;
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&)            = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    // The arena of the calling thread while it runs a job, null otherwise.
+    static ScratchArena* active() { return active_; }
+    static Mark          enter();
+    static void          leave(const Mark& mark);
+
+    void* allocate(size_t size, size_t alignment);
+
+    // Gives the bytes back only when they are the last ones handed out; anything else waits for
+    // the scope to end.
+    void release(const void* ptr, size_t size);
+
+private:
+    struct Block
+    {
+        std::byte* data = nullptr;
+        size_t     size = 0;
+    };
+
+    static constexpr size_t BLOCK_SIZE     = 64 * 1024;
+    static constexpr size_t RETAINED_BYTES = 1024 * 1024;
+
+    void* tryBump(size_t size, size_t alignment);
+    void  trim();
+
+    std::vector<Block> blocks_;
+    uint32_t           current_ = 0;
+    size_t             used_    = 0;
+    uint32_t           depth_   = 0;
+
+    static inline thread_local ScratchArena* active_ = nullptr;
+};
+
+// Allocator for containers local to one job. It binds to the arena of the thread that creates
+// the container, so such a container must neither escape the job nor be filled from another
+// thread. Outside a job it falls back to the heap.
+template<class T>
+class ScratchAllocator
+{
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    ScratchAllocator() noexcept :
+        arena_(ScratchArena::active())
+    {
+    }
+
+    template<class U>
+    ScratchAllocator(const ScratchAllocator<U>& other) noexcept :
+        arena_(other.arena())
+    {
+    }
+
+    T* allocate(const size_t n)
+    {
+        if (arena_)
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, const size_t n) noexcept
+    {
+        if (arena_)
+            arena_->release(ptr, n * sizeof(T));
+        else
+            std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    ScratchArena* arena() const noexcept { return arena_; }
+
+    template<class U>
+    bool operator==(const ScratchAllocator<U>& other) const noexcept
+    {
+        return arena_ == other.arena();
+    }
+
+private:
+    ScratchArena* arena_ = nullptr;
+};
+
+template<class T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+template<class T, size_t InlineCapacity = 16>
+using ScratchSmallVector = SmallVector<T, InlineCapacity, ScratchAllocator<T>>;
+
+template<class K, class V, class HASH = std::hash<K>, class EQ = std::equal_to<K>>
+using ScratchUnorderedMap = std::unordered_map<K, V, HASH, EQ, ScratchAllocator<std::pair<const K, V>>>;
+
+template<class K, class HASH = std::hash<K>, class EQ = std::equal_to<K>>
+using ScratchUnorderedSet = std::unordered_set<K, HASH, EQ, ScratchAllocator<K>>;
+
+SWC_END_NAMESPACE();
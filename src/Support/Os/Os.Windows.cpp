@@ -915,6 +915,24 @@ namespace Os
         return memoryCounters.PeakWorkingSetSize;
     }
 
+    size_t processMemoryUsage()
+    {
+        PROCESS_MEMORY_COUNTERS memoryCounters = {};
+        memoryCounters.cb                      = sizeof(memoryCounters);
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+            return 0;
+        return memoryCounters.WorkingSetSize;
+    }
+
+    size_t availablePhysicalMemory()
+    {
+        MEMORYSTATUSEX status = {};
+        status.dwLength       = sizeof(status);
+        if (!GlobalMemoryStatusEx(&status))
+            return 0;
+        return static_cast<size_t>(status.ullAvailPhys);
+    }
+
     void decodeHostException(uint32_t& outExceptionCode, const void*& outExceptionAddress, const void* platformExceptionPointers)
     {
         outExceptionCode    = 0;
@@ -1534,6 +1552,83 @@ namespace Os
         (void) VirtualFree(ptr, 0, MEM_RELEASE);
     }
 
+    bool mapFileReadOnly(MappedFile& outFile, const fs::path& path, const size_t minSize, const size_t zeroPadding)
+    {
+        outFile = {};
+
+        // Without FILE_SHARE_WRITE, the open fails while another process writes the file, and
+        // nobody can open it for writing while this handle lives.
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        // The system zero-fills the last page of a view past the end of the file, which is where
+        // the padding has to fit: a file ending exactly on a page boundary has none.
+        LARGE_INTEGER fileSize{};
+        const size_t  pageSize = memoryPageSize();
+        if (!GetFileSizeEx(file, &fileSize) ||
+            fileSize.QuadPart <= 0 ||
+            static_cast<uint64_t>(fileSize.QuadPart) < minSize ||
+            static_cast<uint64_t>(fileSize.QuadPart) > std::numeric_limits<uint32_t>::max())
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const size_t size  = static_cast<size_t>(fileSize.QuadPart);
+        const size_t tail  = size % pageSize;
+        const size_t zeros = tail ? pageSize - tail : 0;
+        if (zeros < zeroPadding)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // The sharing mode only holds while a handle is open: the mapping's own reference on the
+        // file would not stop a writer, so the handle is kept until the view goes away.
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        outFile.data    = static_cast<const char8_t*>(view);
+        outFile.size    = size;
+        outFile.file    = file;
+        outFile.mapping = mapping;
+        return true;
+    }
+
+    void unmapFile(MappedFile& file)
+    {
+        if (file.data)
+            (void) UnmapViewOfFile(file.data);
+        if (file.mapping)
+            CloseHandle(file.mapping);
+        if (file.file)
+            CloseHandle(file.file);
+        file = {};
+    }
+
+    void prefetchMemory(const void* ptr, const size_t size)
+    {
+        if (!ptr || !size)
+            return;
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<void*>(ptr);
+        range.NumberOfBytes  = size;
+        (void) PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
     bool addHostJitFunctionTable(JITMemory& executableMemory)
     {
         if (!executableMemory.ptr_ || !executableMemory.size_)
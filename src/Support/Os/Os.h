@@ -107,6 +107,25 @@ namespace Os
     bool     makeExecutableMemory(void* ptr, uint32_t size);
     void     freeExecutableMemory(void* ptr);
 
+    // Read-only view of a whole file. The rest of the last page past 'size' reads as zeros.
+    // The file stays open until it is unmapped, which keeps other writers out for that long.
+    struct MappedFile
+    {
+        const char8_t* data    = nullptr;
+        size_t         size    = 0;
+        void*          file    = nullptr;
+        void*          mapping = nullptr;
+    };
+
+    // Fails without mapping anything when the file is smaller than 'minSize', when its last
+    // page leaves fewer than 'zeroPadding' zero bytes after the end of the file, or when the
+    // file is open for writing elsewhere: the bytes of a view must not change under a reader.
+    bool mapFileReadOnly(MappedFile& outFile, const fs::path& path, size_t minSize, size_t zeroPadding);
+    void unmapFile(MappedFile& file);
+    // Starts reading the pages of the range in the background, so that touching them later
+    // does not stall on disk.
+    void prefetchMemory(const void* ptr, size_t size);
+
     // The proximity arena: one reserved region that both JIT code and the
     // compile-time global data segments carve from, so a RIP-relative
     // displacement in JIT-executed code always reaches the segment payload.
@@ -134,6 +153,8 @@ namespace Os
     uint32_t    captureCallStack(std::span<uintptr_t> outFrames, uint32_t skipFrames = 0);
     bool        resolveAddress(ResolvedAddress& outAddress, uintptr_t address, const TaskContext* ctx = nullptr);
     size_t      peakProcessMemoryUsage();
+    size_t      processMemoryUsage();
+    size_t      availablePhysicalMemory();
     void        decodeHostException(uint32_t& outExceptionCode, const void*& outExceptionAddress, const void* platformExceptionPointers);
     void        appendHostExceptionSummary(const TaskContext* ctx, Utf8& outMsg, const void* platformExceptionPointers);
     void        appendHostCpuContext(Utf8& outMsg, const void* platformExceptionPointers);
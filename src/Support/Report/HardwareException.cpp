@@ -146,7 +146,7 @@ Utf8 HardwareException::format(const TaskContext* ctx, const std::string_view ti
 void HardwareException::log(const TaskContext& ctx, const std::string_view title, const void* platformExceptionPointers, const std::string_view extraInfo)
 {
     const Utf8 msg = format(&ctx, title, platformExceptionPointers, extraInfo);
-    Logger::printStdErr(LogColor::Reset, msg, false);
+    Logger::printStdErr(ctx, LogColor::Reset, msg, false);
 }
 
 void HardwareException::print(const std::string_view title, const void* platformExceptionPointers, const std::string_view extraInfo)
@@ -229,15 +229,28 @@ bool Logger::claimStageOnce(const std::string_view key)
     return true;
 }
 
-void Logger::print(const TaskContext& ctx, std::string_view message)
+// Everything that goes through a task's context ends here: while the task's output is held back
+// (see TaskContext::setOutputCapture) it is appended to the capture, otherwise it is written to
+// the console in one piece.
+void Logger::write(const TaskContext& ctx, std::string_view text, bool trackLine)
 {
-    if (ctx.cmdLine().silent || ctx.muteOutput())
+    if (Utf8* capture = ctx.outputCapture())
+    {
+        capture->append(text);
         return;
+    }
 
     const ScopedLock lock(ctx.global().logger());
-    std::cout << message;
-    if (!message.empty())
-        ctx.global().logger().permanentLineOpen_ = message.back() != '\n';
+    std::cout << text;
+    if (trackLine && !text.empty())
+        ctx.global().logger().permanentLineOpen_ = text.back() != '\n';
+}
+
+void Logger::print(const TaskContext& ctx, std::string_view message)
+{
+    if (ctx.cmdLine().silent || ctx.muteOutput())
+        return;
+    write(ctx, message, true);
 }
 
 void Logger::printDim(const TaskContext& ctx, std::string_view message)
@@ -245,14 +258,30 @@ void Logger::printDim(const TaskContext& ctx, std::string_view message)
     if (ctx.cmdLine().silent || ctx.muteOutput())
         return;
 
-    const ScopedLock lock(ctx.global().logger());
-    std::cout << LogColorHelper::toAnsi(ctx, LogColor::Dim);
-    std::cout << message;
-    std::cout << LogColorHelper::toAnsi(ctx, LogColor::Reset);
-    if (!message.empty())
+    Utf8 out = LogColorHelper::toAnsi(ctx, LogColor::Dim);
+    out += message;
+    out += LogColorHelper::toAnsi(ctx, LogColor::Reset);
+    write(ctx, out, false);
+    if (!message.empty() && !ctx.outputCapture())
         ctx.global().logger().permanentLineOpen_ = message.back() != '\n';
 }
 
+// A task whose output is held back keeps its error report with the rest of its lines, so that
+// it comes out next to them once the capture is replayed, on standard output like them.
+void Logger::printStdErr(const TaskContext& ctx, const LogColor color, const std::string_view message, const bool resetColor)
+{
+    if (Utf8* capture = ctx.outputCapture())
+    {
+        capture->append(LogColorHelper::toAnsi(ctx, color));
+        capture->append(message);
+        if (resetColor)
+            capture->append(LogColorHelper::toAnsi(ctx, LogColor::Reset));
+        return;
+    }
+
+    printStdErr(color, message, resetColor);
+}
+
 void Logger::printStdErr(const LogColor color, const std::string_view message, const bool resetColor)
 {
     const std::scoped_lock lock(stdErrMutex());
@@ -330,9 +359,8 @@ void Logger::printField(const TaskContext& ctx, const FieldEntry& entry, const F
     if (ctx.cmdLine().silent || ctx.muteOutput())
         return;
 
-    const ScopedLock  lock(ctx.global().logger());
     const std::vector entries = {entry};
-    std::cout << formatFieldEntry(ctx, entry, style, computeLabelColumn(entries, style));
+    write(ctx, formatFieldEntry(ctx, entry, style, computeLabelColumn(entries, style)), false);
 }
 
 void Logger::printFieldGroup(const TaskContext& ctx, const std::string_view title, const std::vector<FieldEntry>& entries, const FieldGroupStyle& style)
@@ -340,23 +368,24 @@ void Logger::printFieldGroup(const TaskContext& ctx, const std::string_view titl
     if (ctx.cmdLine().silent || ctx.muteOutput() || entries.empty())
         return;
 
-    const ScopedLock lock(ctx.global().logger());
+    Utf8 out;
     if (!title.empty())
     {
         if (style.blankLineBefore)
-            std::cout << "\n";
-        std::cout << LogColorHelper::toAnsi(ctx, style.titleColor);
-        std::cout << title;
-        std::cout << LogColorHelper::toAnsi(ctx, LogColor::Reset);
-        std::cout << "\n";
+            out += "\n";
+        out += LogColorHelper::toAnsi(ctx, style.titleColor);
+        out += title;
+        out += LogColorHelper::toAnsi(ctx, LogColor::Reset);
+        out += "\n";
     }
 
     const size_t labelColumn = computeLabelColumn(entries, style);
     for (const FieldEntry& entry : entries)
-        std::cout << formatFieldEntry(ctx, entry, style, labelColumn);
+        out += formatFieldEntry(ctx, entry, style, labelColumn);
 
     if (style.blankLineAfter)
-        std::cout << "\n";
+        out += "\n";
+    write(ctx, out, false);
 }
 
 void Logger::printHeaderDot(const TaskContext& ctx, LogColor headerColor, std::string_view header, LogColor msgColor, std::string_view message, std::string_view dot, size_t messageColumn)
@@ -389,21 +418,22 @@ void Logger::printHeaderCentered(const TaskContext& ctx, LogColor headerColor, s
     if (ctx.cmdLine().silent || ctx.muteOutput())
         return;
 
-    const ScopedLock lock(ctx.global().logger());
-    size_t           size = header.size();
+    Utf8   out;
+    size_t size = header.size();
     while (size < centerColumn)
     {
-        std::cout << " ";
+        out += " ";
         size++;
     }
 
-    std::cout << LogColorHelper::toAnsi(ctx, headerColor);
-    std::cout << header;
-    std::cout << " ";
-    std::cout << LogColorHelper::toAnsi(ctx, msgColor);
-    std::cout << message;
-    std::cout << LogColorHelper::toAnsi(ctx, LogColor::Reset);
-    std::cout << "\n";
+    out += LogColorHelper::toAnsi(ctx, headerColor);
+    out += header;
+    out += " ";
+    out += LogColorHelper::toAnsi(ctx, msgColor);
+    out += message;
+    out += LogColorHelper::toAnsi(ctx, LogColor::Reset);
+    out += "\n";
+    write(ctx, out, false);
 }
 
 void Logger::printAction(const TaskContext& ctx, std::string_view left, std::string_view right)
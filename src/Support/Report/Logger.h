@@ -167,6 +167,7 @@ public:
     static void print(const TaskContext& ctx, std::string_view message);
     static void printDim(const TaskContext& ctx, std::string_view message);
     static void printStdErr(LogColor color, std::string_view message, bool resetColor = true);
+    static void printStdErr(const TaskContext& ctx, LogColor color, std::string_view message, bool resetColor = true);
     static void printField(const TaskContext& ctx, const FieldEntry& entry, const FieldGroupStyle& style = FieldGroupStyle{});
     static void printFieldGroup(const TaskContext& ctx, std::string_view title, const std::vector<FieldEntry>& entries, const FieldGroupStyle& style = FieldGroupStyle{});
     static void printHeaderDot(const TaskContext& ctx, LogColor headerColor, std::string_view header, LogColor msgColor, std::string_view message, std::string_view dot = ".", size_t messageColumn = 60);
@@ -175,6 +176,8 @@ public:
     static void printAction(const TaskContext& ctx, std::string_view left, std::string_view right);
 
 private:
+    static void write(const TaskContext& ctx, std::string_view text, bool trackLine);
+
     struct ActiveProgress
     {
         size_t                                id = 0;
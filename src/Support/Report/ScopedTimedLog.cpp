@@ -274,6 +274,11 @@ Utf8 ScopedTimedLog::formatStatName(const TaskContext& ctx, const std::string_vi
     return colorize(ctx, LogColor::Gray, name);
 }
 
+Utf8 ScopedTimedLog::formatStatSize(const TaskContext& ctx, const size_t numBytes, const std::string_view what)
+{
+    return colorize(ctx, LogColor::Gray, Utf8Helper::toNiceSize(numBytes)) + " " + colorize(ctx, LogColor::Gray, what);
+}
+
 Utf8 ScopedTimedLog::joinStatItems(const TaskContext& ctx, const std::vector<Utf8>& items)
 {
     const Utf8 bullet = colorize(ctx, LogColor::Gray, LogSymbolHelper::toString(ctx, LogSymbol::DotList));
@@ -0,0 +1,166 @@
+#pragma once
+#include "Support/Core/PagedStore.h"
+#include "Support/Report/Assert.h"
+
+SWC_BEGIN_NAMESPACE();
+
+// Open-addressing hash table of 32-bit refs for interning from many threads at once. Lookups
+// never lock: they probe slots that hold the key hash next to the ref. An insert builds its
+// record first, then publishes the ref with a CAS on an empty slot; a thread that loses the race
+// for an equal key adopts the winner's ref and leaves its own record unused. Only growing the
+// table serializes, and only the inserts that reach it while it is copied. The table does not
+// know the keys: callers recognize their entry from the ref, so a key that fits in the 32-bit
+// hash can be matched on the hash alone. Retired tables are kept alive until destruction, so a
+// reader that raced with a grow never reads freed memory.
+class ConcurrentRefTable
+{
+public:
+    explicit ConcurrentRefTable(const uint32_t capacity = 4096)
+    {
+        tables_.push_back(std::make_unique<Table>(capacity));
+        table_.store(tables_.back().get(), std::memory_order_relaxed);
+    }
+
+    ConcurrentRefTable(const ConcurrentRefTable&)            = delete;
+    ConcurrentRefTable& operator=(const ConcurrentRefTable&) = delete;
+
+    // The ref of the first entry with this hash that `match(ref)` accepts, or INVALID_REF.
+    template<typename MATCH>
+    uint32_t find(const uint32_t hash, const MATCH& match) const
+    {
+        const uint64_t hashBits = static_cast<uint64_t>(hash) << 32;
+        const Table*   table    = table_.load(std::memory_order_acquire);
+        for (uint32_t index = table->indexOf(hash);; index = (index + 1) & table->mask)
+        {
+            const uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+            if (slot == EMPTY_SLOT)
+                return INVALID_REF;
+
+            // A frozen slot was empty when the table was retired: everything inserted since lives
+            // in the grown table, which is in place once the grow lets go of the mutex.
+            if (slot == FROZEN_SLOT)
+            {
+                {
+                    const std::scoped_lock lock(growMutex_);
+                }
+                return find(hash, match);
+            }
+
+            if ((slot & HASH_MASK) == hashBits && match(static_cast<uint32_t>(slot) - 1))
+                return static_cast<uint32_t>(slot) - 1;
+        }
+    }
+
+    // The ref of the entry that `match` accepts, or the one `make()` returns once published.
+    // make() runs at most once; outInserted tells whether its ref is the one returned.
+    template<typename MATCH, typename MAKE>
+    uint32_t findOrInsert(const uint32_t hash, const MATCH& match, const MAKE& make, bool& outInserted)
+    {
+        const uint64_t hashBits = static_cast<uint64_t>(hash) << 32;
+        uint32_t       made     = INVALID_REF;
+        outInserted             = false;
+        for (;;)
+        {
+            Table*   table = table_.load(std::memory_order_acquire);
+            uint32_t index = table->indexOf(hash);
+            for (;;)
+            {
+                uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+                if (slot == EMPTY_SLOT)
+                {
+                    if ((table->count.load(std::memory_order_relaxed) + 1) * 2 > table->mask + 1)
+                    {
+                        grow(table);
+                        break;
+                    }
+
+                    if (made == INVALID_REF)
+                    {
+                        made = make();
+                        SWC_ASSERT(made != INVALID_REF);
+                    }
+
+                    if (table->slots[index].compare_exchange_strong(slot, hashBits | (static_cast<uint64_t>(made) + 1), std::memory_order_release, std::memory_order_acquire))
+                    {
+                        table->count.fetch_add(1, std::memory_order_relaxed);
+                        outInserted = true;
+                        return made;
+                    }
+
+                    // Someone else took the slot first: look at what they put there.
+                    continue;
+                }
+
+                // The table is being copied into a larger one: wait for it, then start over there.
+                if (slot == FROZEN_SLOT)
+                {
+                    grow(table);
+                    break;
+                }
+
+                if ((slot & HASH_MASK) == hashBits && match(static_cast<uint32_t>(slot) - 1))
+                    return static_cast<uint32_t>(slot) - 1;
+
+                index = (index + 1) & table->mask;
+            }
+        }
+    }
+
+private:
+    // A slot holds the key hash in its high half and the ref plus one in its low half, so a
+    // published slot never has a zero low half.
+    static constexpr uint64_t EMPTY_SLOT  = 0;
+    static constexpr uint64_t FROZEN_SLOT = uint64_t{1} << 32;
+    static constexpr uint64_t HASH_MASK   = ~uint64_t{0xFFFFFFFF};
+
+    struct Table
+    {
+        explicit Table(const uint32_t capacity) :
+            mask(capacity - 1),
+            shift(static_cast<uint32_t>(std::countl_zero(capacity)) + 1),
+            slots(std::make_unique<std::atomic<uint64_t>[]>(capacity))
+        {
+            SWC_ASSERT(capacity >= 2 && std::has_single_bit(capacity));
+        }
+
+        // Fibonacci hashing: sequential keys (type refs) land far apart.
+        uint32_t indexOf(const uint32_t hash) const { return (hash * 0x9E3779B1u) >> shift; }
+
+        uint32_t                                 mask  = 0;
+        uint32_t                                 shift = 0;
+        std::atomic<uint32_t>                    count{0};
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+    };
+
+    void grow(const Table* table)
+    {
+        const std::scoped_lock lock(growMutex_);
+        if (table_.load(std::memory_order_acquire) != table)
+            return;
+
+        auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+        for (uint32_t i = 0; i <= table->mask; i++)
+        {
+            // Freezing the empty slots makes any insert still racing on this table fail its CAS
+            // and come here to wait. Occupied slots never change again, so they are copied as is.
+            uint64_t slot = EMPTY_SLOT;
+            if (table->slots[i].compare_exchange_strong(slot, FROZEN_SLOT, std::memory_order_acq_rel, std::memory_order_acquire))
+                continue;
+
+            uint32_t index = grown->indexOf(static_cast<uint32_t>(slot >> 32));
+            while (grown->slots[index].load(std::memory_order_relaxed) != EMPTY_SLOT)
+                index = (index + 1) & grown->mask;
+            grown->slots[index].store(slot, std::memory_order_relaxed);
+            grown->count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        table_.store(grown.get(), std::memory_order_release);
+        tables_.push_back(std::move(grown));
+    }
+
+    std::atomic<Table*>                 table_{nullptr};
+    mutable std::mutex                  growMutex_;
+    std::vector<std::unique_ptr<Table>> tables_;
+};
+
+SWC_END_NAMESPACE();
@@ -32,6 +32,10 @@ const char* Job::kindName(const JobKind kind)
             return "NativeLink";
         case JobKind::ModuleApiExport:
             return "ModuleApiExport";
+        case JobKind::SourcePrefetch:
+            return "SourcePrefetch";
+        case JobKind::JitTest:
+            return "JitTest";
         default:
             return "Unknown";
     }
@@ -8,6 +8,7 @@ SWC_BEGIN_NAMESPACE();
 class JobManager;
 class Job;
 class CompilerContext;
+struct JobClientState;
 
 using JobClientId = uint32_t;
 
@@ -25,6 +26,8 @@ enum class JobKind
     NativeLinkPrepare,
     NativeLink,
     ModuleApiExport,
+    SourcePrefetch,
+    JitTest,
 };
 
 enum class JobPriority : std::uint8_t
@@ -69,6 +72,11 @@ struct JobRecord
     JobPriority priority = JobPriority::Normal;
     JobClientId clientId = 0;
 
+    // Owning client's READY/RUNNING counter, resolved once at enqueue.
+    JobClientState* clientState = nullptr;
+
+    // Ready/Running transitions happen while the record is exclusively owned by one queue or
+    // one worker. Waiting transitions happen under the scheduler mutex.
     enum class State : uint8_t
     {
         Ready,   // queued to run
@@ -108,6 +116,13 @@ public:
     static JobResult   toJobResult(const TaskContext& ctx, Result result);
     static const char* kindName(JobKind kind);
 
+    // What the job works on, for --trace. Left empty by jobs with nothing worth naming.
+    virtual void traceTarget(Utf8& outFile, Utf8& outSymbol) const
+    {
+        SWC_UNUSED(outFile);
+        SWC_UNUSED(outSymbol);
+    }
+
     template<typename T>
     const T* cast() const
     {
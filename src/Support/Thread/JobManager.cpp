@@ -3,6 +3,8 @@
 #include "Compiler/Sema/Symbol/Symbol.h"
 #include "Main/Command/CommandLine.h"
 #include "Main/Stats.h"
+#include "Main/Trace.h"
+#include "Support/Memory/ScratchArena.h"
 #include "Support/Os/Os.h"
 #include "Support/Report/Assert.h"
 #include "Support/Report/HardwareException.h"
@@ -17,8 +19,51 @@ struct JobManager::RecordPool
 };
 
 thread_local size_t                                  JobManager::threadIndex_ = 0;
+thread_local const JobManager*                       JobManager::workerOwner_ = nullptr;
 thread_local std::vector<std::unique_ptr<JobRecord>> JobManager::RecordPool::tls;
 
+namespace
+{
+    // Distinguishes manager instances in the thread-local client cache, even when a new manager
+    // reuses the address of a destroyed one.
+    std::atomic<uint64_t> g_NextGeneration{1};
+
+    struct ClientCache
+    {
+        uint64_t        generation = 0;
+        JobClientId     client     = 0;
+        JobClientState* state      = nullptr;
+    };
+
+    thread_local ClientCache g_ClientCache;
+
+    // A wake is stamped on the waking thread, so the trace shows who made the job ready, but it
+    // is only recorded once the scheduler lock is released. By then the job may be running or
+    // gone, so what the event says about it is copied while it is still parked.
+    struct PendingWake
+    {
+        std::string_view name;
+        TraceArgs        args;
+        uint64_t         atNs = 0;
+    };
+
+    void stampWake(std::vector<PendingWake>& out, const Job& job, const std::string_view reason)
+    {
+        PendingWake wake;
+        wake.name        = Job::kindName(job.kind());
+        wake.args.reason = reason;
+        wake.atNs        = Trace::now();
+        job.traceTarget(wake.args.file, wake.args.symbol);
+        out.push_back(std::move(wake));
+    }
+
+    void recordWakes(std::vector<PendingWake>& wakes)
+    {
+        for (PendingWake& wake : wakes)
+            Trace::addInstant(TraceEventKind::Wake, wake.name, wake.atNs, std::move(wake.args));
+    }
+}
+
 JobRecord* JobManager::allocRecord()
 {
     // Job records are short-lived and recycled on the thread that releases them. Keeping
@@ -91,6 +136,10 @@ void JobManager::setup(const CommandLine& cmdLine)
     // Worker threads keep [0..configuredWorkerCount_-1], main thread gets the last slot.
     threadIndex_ = singleThreaded_ ? 0 : configuredWorkerCount_;
 
+    generation_ = g_NextGeneration.fetch_add(1, std::memory_order_relaxed);
+    if (!singleThreaded_)
+        workerQueues_ = std::make_unique<WorkerQueues[]>(configuredWorkerCount_);
+
     accepting_ = true;
     joined_    = false;
 }
@@ -100,30 +149,82 @@ JobClientId JobManager::newClientId()
     return nextClientId_.fetch_add(1, std::memory_order_relaxed);
 }
 
+// Drops the state of a client that has no job left, once waitAll(client) has returned. Ids are
+// never handed out twice, so a short-lived client released this way is not used again. Only the
+// thread that enqueues for a client caches its state, and that is the thread releasing it.
+void JobManager::releaseClientId(JobClientId client)
+{
+    if (g_ClientCache.client == client)
+        g_ClientCache = {};
+
+    const std::unique_lock lk(clientsMtx_);
+    const auto             it = clients_.find(client);
+    if (it == clients_.end())
+        return;
+
+    SWC_ASSERT(it->second->readyRunning.load(std::memory_order_acquire) == 0);
+    clients_.erase(it);
+}
+
+JobManager::WorkerQueues* JobManager::localQueues() const noexcept
+{
+    if (workerOwner_ != this)
+        return nullptr;
+    return &workerQueues_[threadIndex_];
+}
+
+JobClientState* JobManager::clientState(JobClientId client)
+{
+    // Most threads keep enqueuing for the same client, so a one-entry thread-local cache keeps
+    // the shared lock off the enqueue path.
+    ClientCache& cache = g_ClientCache;
+    if (cache.state && cache.generation == generation_ && cache.client == client)
+        return cache.state;
+
+    JobClientState* state = nullptr;
+    {
+        const std::shared_lock lk(clientsMtx_);
+        const auto             it = clients_.find(client);
+        if (it != clients_.end())
+            state = it->second.get();
+    }
+
+    if (!state)
+    {
+        const std::unique_lock lk(clientsMtx_);
+        auto&                  slot = clients_[client];
+        if (!slot)
+            slot = std::make_unique<JobClientState>();
+        state = slot.get();
+    }
+
+    cache = {.generation = generation_, .client = client, .state = state};
+    return state;
+}
+
 void JobManager::enqueue(Job& job, JobPriority priority, JobClientId client)
 {
-    const std::unique_lock lk(mtx_);
     SWC_ASSERT(accepting_);
 
     // If already scheduled on this manager, refuse (simplifies invariants).
     SWC_ASSERT(!(job.owner() == this && job.rec() != nullptr));
 
     // Acquire a Record from the pool and wire it up.
-    JobRecord* rec = allocRecord();
-    rec->job       = &job;
-    rec->priority  = priority;
-    rec->clientId  = client;
-    rec->state     = JobRecord::State::Ready;
-    rec->index     = nextIndex_.fetch_add(1);
+    JobRecord* rec   = allocRecord();
+    rec->job         = &job;
+    rec->priority    = priority;
+    rec->clientId    = client;
+    rec->clientState = clientState(client);
+    rec->state       = JobRecord::State::Ready;
+    rec->index       = nextIndex_.fetch_add(1, std::memory_order_relaxed);
 
     job.setOwner(this);
     job.setRec(rec);
 
-    liveRecs_.insert(rec);
-    bumpClientCountLocked(client, +1);
-    pushReady(rec, priority);
-    growWorkersForLoadLocked();
-    cv_.notify_one();
+    rec->clientState->readyRunning.fetch_add(1, std::memory_order_acq_rel);
+    pushReady(rec);
+    growWorkersForLoad();
+    signalWork();
 }
 
 std::optional<WaitKey> JobManager::computeWaitKey(const Job& job)
@@ -183,6 +284,14 @@ void JobManager::unregisterWaiterLocked(JobRecord* rec)
     rec->registered = false;
 }
 
+void JobManager::readyWaiterLocked(JobRecord* rec)
+{
+    sleepingRecs_.erase(rec);
+    rec->state = JobRecord::State::Ready;
+    rec->clientState->readyRunning.fetch_add(1, std::memory_order_acq_rel);
+    pushReady(rec);
+}
+
 void JobManager::wake(const WaitKey& key)
 {
     if (!key.valid())
@@ -195,12 +304,16 @@ void JobManager::wake(const WaitKey& key)
     if (waiterFilter_[waiterShard(key)].load(std::memory_order_acquire) == 0)
         return;
 
-    const std::unique_lock lk(mtx_);
+    std::unique_lock lk(mtx_);
 
     const auto range = waiters_.equal_range(key);
     if (range.first == range.second)
         return;
 
+    std::vector<PendingWake> wakes;
+
+    // Woken jobs go to the waking worker's own deques: the producer that just published the
+    // dependency is the most likely to have the data the consumer needs in cache.
     size_t woken = 0;
     for (auto it = range.first; it != range.second;)
     {
@@ -212,9 +325,9 @@ void JobManager::wake(const WaitKey& key)
         if (rec->state != JobRecord::State::Waiting)
             continue;
 
-        rec->state = JobRecord::State::Ready;
-        bumpClientCountLocked(rec->clientId, +1);
-        pushReady(rec, rec->priority);
+        readyWaiterLocked(rec);
+        if (Trace::enabled())
+            stampWake(wakes, *rec->job, TaskState::kindName(key.kind));
         ++woken;
     }
 
@@ -226,6 +339,9 @@ void JobManager::wake(const WaitKey& key)
         cv_.notify_one();
     else if (woken > 1)
         cv_.notify_all();
+
+    lk.unlock();
+    recordWakes(wakes);
 }
 
 void JobManager::waitingJobs(std::vector<Job*>& waiting, JobClientId client) const
@@ -233,14 +349,14 @@ void JobManager::waitingJobs(std::vector<Job*>& waiting, JobClientId client) con
     waiting.clear();
 
     const std::unique_lock lk(mtx_);
-    if (liveRecs_.empty())
+    if (sleepingRecs_.empty())
         return;
 
     std::vector<const JobRecord*> temp;
-    temp.reserve(liveRecs_.size());
-    for (const JobRecord* rec : liveRecs_)
+    temp.reserve(sleepingRecs_.size());
+    for (const JobRecord* rec : sleepingRecs_)
     {
-        if (rec && rec->clientId == client && rec->state == JobRecord::State::Waiting)
+        if (rec->clientId == client)
             temp.push_back(rec);
     }
 
@@ -250,36 +366,41 @@ void JobManager::waitingJobs(std::vector<Job*>& waiting, JobClientId client) con
         waiting.push_back(t->job);
 }
 
-JobRecord* JobManager::popReadyLocked()
+JobRecord* JobManager::popInjectedLocked(int priority)
 {
-    for (int idx = static_cast<int>(JobPriority::High); idx <= static_cast<int>(JobPriority::Low); idx++)
-    {
-        std::deque<JobRecord*>& q = readyQ_[idx];
-        if (!q.empty())
-        {
+    std::deque<JobRecord*>& q = injectQ_[priority];
+    if (q.empty())
+        return nullptr;
+
 #if SWC_DEV_MODE
-            uint32_t pickIndex = 0;
-            if (singleThreaded_ && cmdLine_->randomize)
-                pickIndex = static_cast<uint32_t>(std::rand()) % q.size(); // NOLINT(concurrency-mt-unsafe)
-            JobRecord* rec = q[pickIndex];
-            q.erase(q.begin() + pickIndex);
+    uint32_t pickIndex = 0;
+    if (singleThreaded_ && cmdLine_->randomize)
+        pickIndex = static_cast<uint32_t>(std::rand()) % q.size(); // NOLINT(concurrency-mt-unsafe)
+    JobRecord* rec = q[pickIndex];
+    q.erase(q.begin() + pickIndex);
 #else
-            JobRecord* rec = q.front();
-            q.pop_front();
+    JobRecord* rec = q.front();
+    q.pop_front();
 #endif
-            readyCount_.fetch_sub(1, std::memory_order_acq_rel);
-            return rec;
-        }
-    }
+    injectCount_.fetch_sub(1, std::memory_order_relaxed);
+    readyCount_.fetch_sub(1, std::memory_order_acq_rel);
+    return rec;
+}
 
-    return nullptr;
+JobRecord* JobManager::popInjected(int priority)
+{
+    if (injectCount_.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    const std::unique_lock lk(injectMtx_);
+    return popInjectedLocked(priority);
 }
 
-JobRecord* JobManager::popReadyForClientLocked(JobClientId client)
+JobRecord* JobManager::popInjectedForClientLocked(JobClientId client)
 {
     for (int idx = static_cast<int>(JobPriority::High); idx <= static_cast<int>(JobPriority::Low); idx++)
     {
-        std::deque<JobRecord*>& q = readyQ_[idx];
+        std::deque<JobRecord*>& q = injectQ_[idx];
         if (q.empty())
             continue;
 
@@ -300,6 +421,7 @@ JobRecord* JobManager::popReadyForClientLocked(JobClientId client)
                 const uint32_t pickIndex = matches[std::rand() % matches.size()]; // NOLINT(concurrency-mt-unsafe)
                 JobRecord*     rec       = q[pickIndex];
                 q.erase(q.begin() + pickIndex);
+                injectCount_.fetch_sub(1, std::memory_order_relaxed);
                 readyCount_.fetch_sub(1, std::memory_order_acq_rel);
                 return rec;
             }
@@ -315,6 +437,7 @@ JobRecord* JobManager::popReadyForClientLocked(JobClientId client)
                 continue;
 
             q.erase(it);
+            injectCount_.fetch_sub(1, std::memory_order_relaxed);
             readyCount_.fetch_sub(1, std::memory_order_acq_rel);
             return rec;
         }
@@ -327,8 +450,8 @@ void JobManager::waitAll()
 {
     if (!singleThreaded_)
     {
-        // In worker mode, wait for the global ready queue to drain and for every worker
-        // that already claimed a job to publish its result.
+        // In worker mode, wait for every queue to drain and for every worker that already
+        // claimed a job to publish its result.
         std::unique_lock lk(mtx_);
         idleCv_.wait(lk, [this] { return readyCount_.load(std::memory_order_acquire) == 0 && activeWorkers_.load(std::memory_order_acquire) == 0; });
         return;
@@ -340,19 +463,18 @@ void JobManager::waitAll()
         JobRecord* rec = nullptr;
 
         {
-            const std::unique_lock lk(mtx_);
-            rec = popReadyLocked();
-            if (!rec)
-                break;
-
-            if (rec->state == JobRecord::State::Done)
-                continue;
-
-            rec->state = JobRecord::State::Running;
-            // Note: clientReadyRunning_ already includes this job from enqueue().
-            // We do NOT touch bumpClientCountLocked() here, just like in workerLoop().
+            const std::unique_lock lk(injectMtx_);
+            for (int idx = static_cast<int>(JobPriority::High); idx <= static_cast<int>(JobPriority::Low) && !rec; idx++)
+                rec = popInjectedLocked(idx);
         }
 
+        if (!rec)
+            break;
+        if (rec->state == JobRecord::State::Done)
+            continue;
+
+        // Note: the client counter already includes this job from enqueue().
+        rec->state          = JobRecord::State::Running;
         const JobResult res = executeJob(*rec->job);
         handleJobResult(rec, res);
     }
@@ -360,97 +482,74 @@ void JobManager::waitAll()
 
 bool JobManager::wakeAll(JobClientId client)
 {
-    const std::unique_lock lk(mtx_);
+    std::unique_lock lk(mtx_);
 
-    if (liveRecs_.empty())
+    if (sleepingRecs_.empty())
         return false;
 
-    std::size_t woken = 0;
+    std::vector<JobRecord*> temp;
+    temp.reserve(sleepingRecs_.size());
+    for (JobRecord* rec : sleepingRecs_)
+    {
+        if (rec->clientId == client)
+            temp.push_back(rec);
+    }
 
     // Sort by job index to be deterministic
     if (singleThreaded_)
-    {
-        std::vector<JobRecord*> temp;
-        temp.reserve(liveRecs_.size());
-        for (JobRecord* rec : liveRecs_)
-        {
-            if (rec && rec->clientId == client && rec->state == JobRecord::State::Waiting)
-                temp.push_back(rec);
-        }
-
         std::ranges::sort(temp, {}, &JobRecord::index);
-        for (JobRecord* rec : temp)
-        {
-            unregisterWaiterLocked(rec);
-            rec->state = JobRecord::State::Ready;
-            bumpClientCountLocked(rec->clientId, +1);
-            pushReady(rec, rec->priority);
-            ++woken;
-        }
-    }
-    else
+
+    std::vector<PendingWake> wakes;
+    for (JobRecord* rec : temp)
     {
-        for (JobRecord* rec : liveRecs_)
-        {
-            if (!rec)
-                continue;
-            if (rec->clientId != client)
-                continue;
-            if (rec->state != JobRecord::State::Waiting)
-                continue;
-            unregisterWaiterLocked(rec);
-            rec->state = JobRecord::State::Ready;
-            bumpClientCountLocked(rec->clientId, +1);
-            pushReady(rec, rec->priority);
-            ++woken;
-        }
+        unregisterWaiterLocked(rec);
+        readyWaiterLocked(rec);
+        if (Trace::enabled())
+            stampWake(wakes, *rec->job, "barrier");
     }
 
-    if (woken != 0)
+    if (!temp.empty())
     {
         growWorkersForLoadLocked();
         cv_.notify_all();
     }
 
-    return woken != 0;
+    lk.unlock();
+    recordWakes(wakes);
+    return !temp.empty();
 }
 
 void JobManager::waitAll(JobClientId client)
 {
+    const JobClientState* state = clientState(client);
+
     if (!singleThreaded_)
     {
         // Per-client waiting watches ready+running jobs only. Sleeping jobs are excluded
         // so the caller can perform the compiler action that may wake them.
         std::unique_lock lk(mtx_);
-        idleCv_.wait(lk, [&] { const auto it = clientReadyRunning_.find(client); return it == clientReadyRunning_.end() || it->second == 0; });
+        idleCv_.wait(lk, [&] { return state->readyRunning.load(std::memory_order_acquire) == 0; });
         return;
     }
 
     // Single-threaded: execute this client's jobs until its ready+running count is 0,
     // or all of its jobs are sleeping.
-    while (true)
+    while (state->readyRunning.load(std::memory_order_acquire) != 0)
     {
         JobRecord* rec = nullptr;
 
         {
-            const std::unique_lock lk(mtx_);
-
-            const auto it = clientReadyRunning_.find(client);
-            if (it == clientReadyRunning_.end() || it->second == 0)
-                break;
-
-            rec = popReadyForClientLocked(client);
-
-            // No ready jobs for this client (only sleepers): nothing more to do now.
-            if (!rec)
-                break;
-
-            if (rec->state == JobRecord::State::Done)
-                continue;
-
-            rec->state = JobRecord::State::Running;
+            const std::unique_lock lk(injectMtx_);
+            rec = popInjectedForClientLocked(client);
         }
 
+        // No ready jobs for this client (only sleepers): nothing more to do now.
+        if (!rec)
+            break;
+        if (rec->state == JobRecord::State::Done)
+            continue;
+
+        rec->state          = JobRecord::State::Running;
         const JobResult res = executeJob(*rec->job);
         handleJobResult(rec, res);
     }
@@ -478,10 +577,60 @@ void JobManager::shutdown() noexcept
     // They are not runnable; their rec_ remains set until they are woken and run to completion.
 }
 
-void JobManager::pushReady(JobRecord* rec, JobPriority priority)
+void JobManager::pushReady(JobRecord* rec)
 {
-    readyQ_[static_cast<int>(priority)].push_back(rec);
-    readyCount_.fetch_add(1, std::memory_order_release);
+    // Count first: readyCount_ must never undercount the queues, or waitAll() could observe an
+    // idle manager while a job is being pushed.
+    readyCount_.fetch_add(1, std::memory_order_seq_cst);
+
+    if (WorkerQueues* local = localQueues())
+    {
+        local->ready[static_cast<int>(rec->priority)].push(rec);
+        return;
+    }
+
+    const std::unique_lock lk(injectMtx_);
+    injectQ_[static_cast<int>(rec->priority)].push_back(rec);
+    injectCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobManager::signalWork()
+{
+    // Pairs with the idleWorkers_ increment in workerLoop(): either the parked worker sees the
+    // new readyCount_ in its wait predicate, or we see it parked and notify it. Taking mtx_
+    // closes the window between its predicate check and its wait.
+    if (idleWorkers_.load(std::memory_order_seq_cst) == 0)
+        return;
+
+    {
+        const std::unique_lock lk(mtx_);
+    }
+
+    cv_.notify_one();
+}
+
+void JobManager::notifyIdle()
+{
+    {
+        const std::unique_lock lk(mtx_);
+    }
+
+    idleCv_.notify_all();
+}
+
+void JobManager::releaseClient(JobClientState* state)
+{
+    if (state->readyRunning.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        notifyIdle();
+}
+
+void JobManager::growWorkersForLoad()
+{
+    if (startedWorkers_.load(std::memory_order_acquire) >= configuredWorkerCount_)
+        return;
+
+    const std::unique_lock lk(mtx_);
+    growWorkersForLoadLocked();
 }
 
 void JobManager::growWorkersForLoadLocked()
@@ -502,9 +651,14 @@ void JobManager::growWorkersForLoadLocked()
         const size_t threadIndex = workers_.size();
         workers_.emplace_back([this, threadIndex] {
             threadIndex_ = threadIndex;
+            workerOwner_ = this;
+            if (Trace::enabled())
+                Trace::setThreadName(std::format("Worker {}", threadIndex));
             workerLoop();
         });
     }
+
+    startedWorkers_.store(static_cast<uint32_t>(workers_.size()), std::memory_order_release);
 }
 
 namespace
@@ -523,12 +677,34 @@ namespace
         Os::panicBox("hardware exception during job execution");
         return SWC_EXCEPTION_EXECUTE_HANDLER;
     }
+
+    void traceJob(const Job& job, const JobResult res, const uint64_t startNs)
+    {
+        TraceArgs args;
+        job.traceTarget(args.file, args.symbol);
+        Trace::addSpan(TraceEventKind::Job, Job::kindName(job.kind()), startNs, args);
+
+        if (res != JobResult::Sleep)
+            return;
+
+        const TaskState& state = job.ctx().state();
+        args.reason            = TaskState::kindName(state.kind);
+        if (state.symbol)
+            args.symbol = state.symbol->name(job.ctx());
+        Trace::addInstant(TraceEventKind::Sleep, Job::kindName(job.kind()), std::move(args));
+    }
 }
 
 JobResult JobManager::executeJob(Job& job)
 {
     JobResult          res;
     const TaskContext* savedContext = TaskContext::setCurrent(&job.ctx());
+    const bool         tracing      = Trace::enabled();
+    const uint64_t     startNs      = tracing ? Trace::now() : 0;
+
+    // Whatever the job kept in the scratch arena is dead once exec() returns, sleeping or not:
+    // a resumed job starts exec() over.
+    const ScratchArena::Mark scratchMark = ScratchArena::enter();
 
     SWC_TRY
     {
@@ -539,33 +715,38 @@ JobResult JobManager::executeJob(Job& job)
         res = JobResult::Done;
     }
 
+    ScratchArena::leave(scratchMark);
+
+    if (tracing)
+        traceJob(job, res, startNs);
+
     TaskContext::setCurrent(savedContext);
     return res;
 }
 
 void JobManager::handleJobResult(JobRecord* rec, const JobResult res)
 {
-    const std::unique_lock lk(mtx_);
+    JobClientState* state = rec->clientState;
 
     switch (res)
     {
         case JobResult::Done:
         {
+            // The record is exclusively ours while running: detach and recycle it without any
+            // lock. The job itself must not be touched after the client counter drops, since
+            // its owner may destroy it as soon as waitAll(client) returns.
             rec->state = JobRecord::State::Done;
-            bumpClientCountLocked(rec->clientId, -1);
-
-            // Detach and recycle the record
             rec->job->setRec(nullptr);
             rec->job->setOwner(nullptr);
-            liveRecs_.erase(rec);
             freeRecord(rec);
             break;
         }
 
         case JobResult::Sleep:
         {
+            const std::unique_lock lk(mtx_);
             rec->state = JobRecord::State::Waiting;
-            bumpClientCountLocked(rec->clientId, -1);
+            sleepingRecs_.insert(rec);
 
             // Register on the precise dependency so the producer can wake it directly.
             // Non-keyable reasons remain wildcard sleepers, woken only by the barrier.
@@ -579,17 +760,10 @@ void JobManager::handleJobResult(JobRecord* rec, const JobResult res)
             break;
         }
     }
-}
-JobRecord* JobManager::popReadyAndMarkRunningLocked()
-{
-    JobRecord* rec = popReadyLocked();
-    if (!rec)
-        return nullptr;
-    if (rec->state == JobRecord::State::Done)
-        return nullptr;
-    rec->state = JobRecord::State::Running;
-    activeWorkers_.fetch_add(1, std::memory_order_acq_rel);
-    return rec;
+
+    // Release only once the sleeper is registered, so a waitAll(client) that returns can always
+    // find it with wakeAll(client).
+    releaseClient(state);
 }
 
 bool JobManager::isDrainedLocked() const
@@ -599,16 +773,61 @@ bool JobManager::isDrainedLocked() const
     return !accepting_ && readyCount_.load(std::memory_order_acquire) == 0;
 }
 
+JobRecord* JobManager::findWork()
+{
+    if (readyCount_.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    // Count as active while searching: the job we are about to pop stops being counted in
+    // readyCount_ before it starts running, and waitAll() must not see that gap as idle.
+    activeWorkers_.fetch_add(1, std::memory_order_acq_rel);
+
+    WorkerQueues&  own         = workerQueues_[threadIndex_];
+    const uint32_t numStarted  = startedWorkers_.load(std::memory_order_acquire);
+    const auto     selfIndex   = static_cast<uint32_t>(threadIndex_);
+    JobRecord*     rec         = nullptr;
+    constexpr int  numPriority = static_cast<int>(JobPriority::Low) + 1;
+
+    for (int idx = 0; idx < numPriority && !rec; idx++)
+        rec = own.ready[idx].pop();
+
+    // The injection queue uncounts its records under its own lock.
+    for (int idx = 0; idx < numPriority && !rec; idx++)
+    {
+        if (JobRecord* injected = popInjected(idx))
+            return injected;
+    }
+
+    for (int idx = 0; idx < numPriority && !rec; idx++)
+    {
+        for (uint32_t i = 1; i < numStarted && !rec; i++)
+            rec = workerQueues_[(selfIndex + i) % numStarted].ready[idx].steal();
+    }
+
+    if (!rec)
+    {
+        if (activeWorkers_.fetch_sub(1, std::memory_order_acq_rel) == 1 && readyCount_.load(std::memory_order_acquire) == 0)
+            notifyIdle();
+        return nullptr;
+    }
+
+    readyCount_.fetch_sub(1, std::memory_order_acq_rel);
+    return rec;
+}
+
 void JobManager::workerLoop()
 {
+    int spins = 0;
     while (true)
     {
-        JobRecord* rec = nullptr;
+        JobRecord* rec = findWork();
 
-        // Fast path: brief spin/yield if no ready work
-        int spins = 0;
-        while (readyCount_.load(std::memory_order_acquire) == 0 && accepting_)
+        if (!rec)
         {
+            if (!accepting_ && readyCount_.load(std::memory_order_acquire) == 0)
+                return;
+
+            // Fast path: brief spin/yield if no ready work
             constexpr int spinMax = 200;
             if (++spins < spinMax)
             {
@@ -616,58 +835,35 @@ void JobManager::workerLoop()
                 continue;
             }
 
-            // Slow path: fall back to CV wait
-            {
-                std::unique_lock lk(mtx_);
-                cv_.wait(lk, [this] { return readyCount_.load(std::memory_order_acquire) > 0 || !accepting_; });
-
-                if (isDrainedLocked())
-                    return;
-                rec = popReadyAndMarkRunningLocked();
-            }
-
-            break;
-        }
-
-        // If the spin loop did not acquire a job yet, but we observed ready work, do a short locked pop.
-        if (!rec)
-        {
-            const std::unique_lock lk(mtx_);
-            if (isDrainedLocked())
+            // Slow path: park on the CV until a producer signals work.
+            std::unique_lock lk(mtx_);
+            idleWorkers_.fetch_add(1, std::memory_order_seq_cst);
+            const bool     tracing     = Trace::enabled();
+            const uint64_t idleStartNs = tracing ? Trace::now() : 0;
+            cv_.wait(lk, [this] { return readyCount_.load(std::memory_order_seq_cst) > 0 || !accepting_; });
+            idleWorkers_.fetch_sub(1, std::memory_order_relaxed);
+            const uint64_t idleEndNs = tracing ? Trace::now() : 0;
+            const bool     drained   = isDrainedLocked();
+            lk.unlock();
+            if (tracing)
+                Trace::addSpan(TraceEventKind::Idle, "Idle", idleStartNs, idleEndNs);
+            if (drained)
                 return;
-            rec = popReadyAndMarkRunningLocked();
-        }
-
-        if (!rec)
+            spins = 0;
             continue;
+        }
 
-        // From here on, we are an active worker for this job.
-        struct ActiveGuard
-        {
-            std::atomic<size_t>*     ref;
-            std::atomic<uint64_t>*   ready;
-            std::condition_variable* idleCv;
-            ~ActiveGuard()
-            {
-                if (ref->fetch_sub(1, std::memory_order_acq_rel) == 1 &&
-                    ready->load(std::memory_order_acquire) == 0)
-                    idleCv->notify_all();
-            }
-        };
-
-        const ActiveGuard activeGuard{.ref = &activeWorkers_, .ready = &readyCount_, .idleCv = &idleCv_};
+        spins      = 0;
+        rec->state = JobRecord::State::Running;
 
         const JobResult res = executeJob(*rec->job);
         handleJobResult(rec, res);
-    }
-}
 
-void JobManager::bumpClientCountLocked(JobClientId client, int delta)
-{
-    std::size_t& c = clientReadyRunning_[client];
-    c              = static_cast<std::size_t>(static_cast<long long>(c) + delta);
-    if (c == 0)
-        idleCv_.notify_all();
+        // Drop our active slot once the result is published (children, if any, are already
+        // counted in readyCount_).
+        if (activeWorkers_.fetch_sub(1, std::memory_order_acq_rel) == 1 && readyCount_.load(std::memory_order_acquire) == 0)
+            notifyIdle();
+    }
 }
 
 SWC_END_NAMESPACE();
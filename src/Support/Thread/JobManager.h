@@ -1,10 +1,24 @@
 #pragma once
 #include "Support/Thread/Job.h"
+#include "Support/Thread/WorkStealingDeque.h"
 
 SWC_BEGIN_NAMESPACE();
 
 using JobClientId = uint32_t;
 
+// Per-client READY+RUNNING counter. Records point at it directly, so only enqueue() has to
+// look the client up.
+struct JobClientState
+{
+    std::atomic<std::size_t> readyRunning{0};
+};
+
+// Work-stealing scheduler. Each worker owns one lock-free deque per priority: jobs enqueued or
+// woken from a worker land in that worker's own deques, and idle workers steal from the others.
+// Threads that are not workers of this manager (the main thread, and every thread in
+// single-threaded mode) push into a small locked injection queue. Priority is a soft ordering: a
+// worker drains its own deques from High to Low before it looks at the injection queue, then at
+// the other workers. The scheduler mutex only guards sleeping jobs and worker parking.
 class JobManager
 {
 public:
@@ -15,6 +29,7 @@ public:
 
     void        setup(const CommandLine& cmdLine);
     JobClientId newClientId();
+    void        releaseClientId(JobClientId client);
 
     void enqueue(Job& job, JobPriority priority, JobClientId client = 0);
     void waitingJobs(std::vector<Job*>& waiting, JobClientId client) const;
@@ -35,8 +50,10 @@ public:
     void waitAll(JobClientId client);
 
     // Runs `fn(workerCtx, index)` for index in [0, count). Each worker owns a
-    // TaskContext copy and claims indices atomically. The caller must restrict shared
-    // access to thread-safe services and write each result to its own indexed slot.
+    // TaskContext copy and claims indices atomically. The caller claims indices too,
+    // with its own context, so the loop makes progress even when every worker is busy.
+    // The caller must restrict shared access to thread-safe services and write each
+    // result to its own indexed slot.
     template<typename T>
     void parallelForIndexed(TaskContext& ctx, uint32_t count, JobKind kind, JobClientId clientId, const T& fn, JobPriority priority = JobPriority::Normal)
     {
@@ -74,15 +91,19 @@ public:
             const T*               fn_;
         };
 
-        const uint32_t        workerCount = std::min(count, numWorkers());
+        const uint32_t        helperCount = std::min(count, numWorkers()) - 1;
         std::atomic<uint32_t> nextIndex{0};
 
         std::vector<std::unique_ptr<WorkerJob>> jobs;
-        jobs.reserve(workerCount);
-        for (uint32_t i = 0; i < workerCount; ++i)
+        jobs.reserve(helperCount);
+        for (uint32_t i = 0; i < helperCount; ++i)
             jobs.push_back(std::make_unique<WorkerJob>(ctx, kind, nextIndex, count, fn));
         for (auto& job : jobs)
             enqueue(*job, priority, clientId);
+
+        for (uint32_t i = nextIndex.fetch_add(1, std::memory_order_relaxed); i < count; i = nextIndex.fetch_add(1, std::memory_order_relaxed))
+            fn(ctx, i);
+
         waitAll(clientId);
     }
 
@@ -92,17 +113,30 @@ public:
     bool          isSingleThreaded() const noexcept { return singleThreaded_; }
 
 private:
-    void       pushReady(JobRecord* rec, JobPriority priority);
-    JobRecord* popReadyLocked();
-    JobRecord* popReadyAndMarkRunningLocked();
-    JobRecord* popReadyForClientLocked(JobClientId client);
-    bool       isDrainedLocked() const;
+    struct WorkerQueues
+    {
+        WorkStealingDeque<JobRecord> ready[3];
+    };
+
+    WorkerQueues*   localQueues() const noexcept;
+    JobClientState* clientState(JobClientId client);
+    void            pushReady(JobRecord* rec);
+    JobRecord*      popInjected(int priority);
+    JobRecord*      popInjectedLocked(int priority);
+    JobRecord*      popInjectedForClientLocked(JobClientId client);
+    JobRecord*      findWork();
+    void            signalWork();
+    void            notifyIdle();
+    void            releaseClient(JobClientState* state);
+    bool            isDrainedLocked() const;
 
     static JobResult              executeJob(Job& job);
     void                          handleJobResult(JobRecord* rec, JobResult res);
+    void                          readyWaiterLocked(JobRecord* rec);
     void                          workerLoop();
     static std::optional<WaitKey> computeWaitKey(const Job& job);
     void                          unregisterWaiterLocked(JobRecord* rec);
+    void                          growWorkersForLoad();
     void                          growWorkersForLoadLocked();
 
     void shutdown() noexcept;
@@ -112,19 +146,34 @@ private:
     const CommandLine*         cmdLine_               = nullptr;
     uint32_t                   randSeed_              = 0;
     uint32_t                   configuredWorkerCount_ = 0;
+    uint64_t                   generation_            = 0;
     static thread_local size_t threadIndex_;
 
-    // Ready queues per priority (store Record* for direct access).
-    std::deque<JobRecord*> readyQ_[3];
+    // Set on worker threads only, so enqueue/wake can tell whether the calling thread owns
+    // one of this manager's deques.
+    static thread_local const JobManager* workerOwner_;
+
+    // One set of deques per configured worker, indexed by threadIndex_.
+    std::unique_ptr<WorkerQueues[]> workerQueues_;
+
+    // Injection queues per priority, for threads that are not workers of this manager.
+    std::deque<JobRecord*> injectQ_[3];
+    std::mutex             injectMtx_;
+    std::atomic<uint64_t>  injectCount_{0};
 
-    // Fast “is work available” counter to avoid CV churn.
+    // Jobs sitting in any queue. Bumped before the push and dropped after the pop, so it never
+    // undercounts: a zero here proves every queue is empty.
     std::atomic<std::uint64_t> readyCount_{0};
 
-    // Running job count.
+    // Workers that are searching for or running a job.
     std::atomic<std::size_t> activeWorkers_{0};
 
+    // Workers parked on cv_. Producers only take mtx_ to notify when this is non-zero.
+    std::atomic<uint32_t> idleWorkers_{0};
+
     // Threading & sync
     std::vector<std::thread> workers_;
+    std::atomic<uint32_t>    startedWorkers_{0};
     mutable std::mutex       mtx_;
     std::condition_variable  cv_;     // work available / shutdown
     std::condition_variable  idleCv_; // becomes idle (global or per-client)
@@ -133,13 +182,14 @@ private:
     std::atomic<bool> accepting_{false};
     std::atomic<bool> joined_{false};
 
-    // Per-client READY/RUNNING counters (protected by mtx_)
-    std::atomic<JobClientId>                     nextClientId_{1}; // start at 1, 0 reserved as "default client"
-    std::unordered_map<JobClientId, std::size_t> clientReadyRunning_;
-    std::atomic<uint32_t>                        nextIndex_{0};
+    // Per-client READY/RUNNING counters. Entries are never erased, so records can keep raw pointers.
+    std::atomic<JobClientId>                                         nextClientId_{1}; // start at 1, 0 reserved as "default client"
+    std::unordered_map<JobClientId, std::unique_ptr<JobClientState>> clients_;
+    std::shared_mutex                                                clientsMtx_;
+    std::atomic<uint32_t>                                            nextIndex_{0};
 
-    // All currently scheduled records (any state except free), to allow wakeAll scans.
-    std::unordered_set<JobRecord*> liveRecs_;
+    // Records currently Waiting, to allow wakeAll scans (protected by mtx_).
+    std::unordered_set<JobRecord*> sleepingRecs_;
 
     // Sleeping jobs indexed by the exact dependency they wait on, for targeted wakeups.
     // Only keyable sleepers appear here; non-keyable ones stay wildcard (barrier-woken).
@@ -162,8 +212,6 @@ private:
     void          filterAdd(const WaitKey& key) noexcept { waiterFilter_[waiterShard(key)].fetch_add(1, std::memory_order_release); }
     void          filterSub(const WaitKey& key) noexcept { waiterFilter_[waiterShard(key)].fetch_sub(1, std::memory_order_release); }
 
-    void bumpClientCountLocked(JobClientId client, int delta);
-
     struct RecordPool;
     static JobRecord* allocRecord();
     static void       freeRecord(JobRecord* r);
@@ -0,0 +1,125 @@
+#pragma once
+
+SWC_BEGIN_NAMESPACE();
+
+// Chase-Lev work-stealing deque, with the memory orderings from Le, Pop, Cohen and Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models". The owning worker pushes and pops
+// at the bottom without any lock; every other thread steals from the top with one CAS.
+// Retired rings are kept alive until destruction, so a thief that raced with a grow never reads
+// freed memory. The queue only stores pointers and never owns the pointees.
+template<typename T>
+class WorkStealingDeque
+{
+public:
+    WorkStealingDeque()
+    {
+        rings_.push_back(std::make_unique<Ring>(K_INITIAL_CAPACITY));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void push(T* item)
+    {
+        const int64_t b    = bottom_.load(std::memory_order_relaxed);
+        const int64_t t    = top_.load(std::memory_order_acquire);
+        Ring*         ring = ring_.load(std::memory_order_relaxed);
+        if (b - t >= ring->capacity())
+            ring = grow(ring, t, b);
+
+        ring->store(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. LIFO: the most recently pushed job is still hot in this worker's cache.
+    T* pop()
+    {
+        const int64_t b    = bottom_.load(std::memory_order_relaxed) - 1;
+        const Ring*   ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b)
+        {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = ring->load(b);
+        if (t == b)
+        {
+            // Last element: race the thieves for it.
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    // Any thread. FIFO: thieves take the oldest job. Returns null when empty or when the CAS lost
+    // against another thief or the owner; callers simply move on to the next victim.
+    T* steal()
+    {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+
+        const Ring* ring = ring_.load(std::memory_order_acquire);
+        T*          item = ring->load(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    bool empty() const
+    {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int64_t K_INITIAL_CAPACITY = 256; // power of two
+
+    class Ring
+    {
+    public:
+        explicit Ring(int64_t capacity) :
+            slots_(std::make_unique<std::atomic<T*>[]>(static_cast<size_t>(capacity))),
+            mask_(capacity - 1)
+        {
+        }
+
+        int64_t capacity() const { return mask_ + 1; }
+        T*      load(int64_t index) const { return slots_[static_cast<size_t>(index & mask_)].load(std::memory_order_relaxed); }
+        void    store(int64_t index, T* item) { slots_[static_cast<size_t>(index & mask_)].store(item, std::memory_order_relaxed); }
+
+    private:
+        std::unique_ptr<std::atomic<T*>[]> slots_;
+        int64_t                            mask_ = 0;
+    };
+
+    Ring* grow(const Ring* ring, int64_t t, int64_t b)
+    {
+        auto bigger = std::make_unique<Ring>(ring->capacity() * 2);
+        for (int64_t i = t; i < b; ++i)
+            bigger->store(i, ring->load(i));
+
+        Ring* result = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(result, std::memory_order_release);
+        return result;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring*>                 ring_{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings_; // owner only; retired rings stay alive for late thieves
+};
+
+SWC_END_NAMESPACE();
@@ -0,0 +1,119 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Backend/Native/NativeBackendBuilder.h"
+#include "Backend/Native/SymbolSort.h"
+#include "Compiler/Sema/Core/Sema.h"
+#include "Compiler/Sema/Symbol/Symbol.Function.h"
+#include "Main/Command/Command.h"
+#include "Main/Command/CommandLine.h"
+#include "Main/Command/CommandLineParser.h"
+#include "Main/Command/CommandTest.h"
+#include "Main/CompilerInstance.h"
+#include "Main/Stats.h"
+#include "Unittest/Unittest.h"
+#include "Unittest/UnittestSource.h"
+
+SWC_BEGIN_NAMESPACE();
+#ifdef _M_X64
+
+namespace
+{
+    struct RestoreErrorCount
+    {
+        uint64_t saved = 0;
+
+        ~RestoreErrorCount()
+        {
+            Stats::get().numErrors.store(saved, std::memory_order_relaxed);
+        }
+    };
+}
+
+// '--test-parallel' with a passing test, then a '#[Swag.NoParallel]' one and a parallel one that
+// both fail. The test that runs alone writes a global before failing: the parallel test after it
+// must see the value '#init' left, and what the failures print must come out in source order.
+SWC_TEST_BEGIN(Compiler_ParallelTestsKeepSourceOrder)
+{
+    static constexpr std::string_view SOURCE     = R"(var g_value = 1
+
+#test
+{
+    @assert(g_value == 1)
+}
+
+#[Swag.NoParallel]
+#test
+{
+    g_value = 2
+    @panic("no-parallel test stops", #curlocation)
+}
+
+#test
+{
+    if g_value == 1 do
+        @panic("parallel test sees the initial globals", #curlocation)
+}
+)";
+    const fs::path                    sourcePath = Unittest::makeTestSourcePath("Compiler", "ParallelTestsKeepSourceOrder");
+
+    CommandLine cmdLine;
+    cmdLine.command      = CommandKind::Test;
+    cmdLine.backendKind  = Runtime::BuildCfgBackendKind::Executable;
+    cmdLine.name         = "compiler_parallel_tests_keep_source_order";
+    cmdLine.testParallel = true;
+    cmdLine.files.insert(sourcePath);
+    CommandLineParser::refreshBuildCfg(cmdLine);
+
+    const uint64_t    errorsBefore = Stats::getNumErrors();
+    RestoreErrorCount restoreErrors{errorsBefore};
+    CompilerInstance  compiler(ctx.global(), cmdLine);
+    Unittest::registerTestSource(compiler, sourcePath, SOURCE);
+    Command::sema(compiler);
+    if (Stats::getNumErrors() != errorsBefore)
+        return Result::Error;
+
+    NativeBackendBuilder nativeBuilder(compiler, false);
+    if (nativeBuilder.prepare() != Result::Continue || Stats::getNumErrors() != errorsBefore)
+        return Result::Error;
+
+    TaskContext                  compilerCtx(compiler);
+    std::vector<SymbolFunction*> testFunctions = nativeBuilder.testFunctions;
+    SymbolSort::sortAndUniqueByLocation(testFunctions, compiler);
+    if (testFunctions.size() != 3)
+        return Result::Error;
+
+    while (true)
+    {
+        const Result jitBatchResult = SymbolFunction::jitBatch(compilerCtx, testFunctions);
+        if (jitBatchResult == Result::Continue)
+            break;
+        if (jitBatchResult == Result::Error)
+            return Result::Error;
+
+        Sema::waitDone(compilerCtx, compiler.jobClientId());
+        if (Stats::hasError() || compilerCtx.state().jitEmissionError)
+            return Result::Error;
+    }
+
+    Utf8 output;
+    compilerCtx.setOutputCapture(&output);
+    CommandTest::JitTestTally tally;
+    CommandTest::runJitTestFunctions(compilerCtx, testFunctions, nullptr, 3, tally);
+    compilerCtx.setOutputCapture(nullptr);
+
+    if (tally.executed != 3 || tally.failed != 2)
+        return Result::Error;
+
+    const size_t noParallelPos = output.find("no-parallel test stops");
+    const size_t parallelPos   = output.find("parallel test sees the initial globals");
+    if (noParallelPos == Utf8::npos || parallelPos == Utf8::npos || noParallelPos > parallelPos)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+#endif
+SWC_END_NAMESPACE();
+
+#endif
@@ -292,6 +292,63 @@ SWC_TEST_BEGIN(ConstantManager_DoesNotDeduplicateMaterializedArrayPayloadsWithDi
 }
 SWC_TEST_END()
 
+SWC_TEST_BEGIN(ConstantManager_ConcurrentAddsAgreeOnOneRefPerValue)
+{
+    constexpr uint32_t numThreads = 8;
+    constexpr uint32_t numValues  = 4000;
+
+    std::vector<std::string> strings;
+    strings.reserve(numValues);
+    for (uint32_t i = 0; i < numValues; ++i)
+        strings.push_back(std::format("concurrent-constant-{}", i));
+
+    // Strings and integers outside the small scalar cache, so every first add goes to the
+    // shared table and every second one can be answered by the thread's front cache.
+    std::vector<ConstantValue> values;
+    for (uint32_t i = 0; i < numValues; ++i)
+    {
+        values.push_back(ConstantValue::makeString(ctx, strings[i]));
+        values.push_back(ConstantValue::makeIntUnsized(ctx, ApsInt{uint64_t{1000000} + i, ApsInt::maxBitWidth()}, TypeInfo::Sign::Unknown));
+    }
+
+    std::vector<std::vector<ConstantRef>> refs(numThreads, std::vector<ConstantRef>(values.size(), ConstantRef::invalid()));
+    std::vector<std::thread>              threads;
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (uint32_t pass = 0; pass < 2; ++pass)
+            {
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    // Each thread starts from a different value, so inserts really race.
+                    const size_t index = (i + t * (values.size() / numThreads)) % values.size();
+                    refs[t][index]     = ctx.cstMgr().addConstant(ctx, values[index]);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::unordered_set<uint32_t> seen;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        const ConstantRef ref = refs[0][i];
+        if (!ref.isValid() || !(ctx.cstMgr().get(ref) == values[i]))
+            return Result::Error;
+        if (!seen.insert(ref.get()).second)
+            return Result::Error;
+
+        for (uint32_t t = 1; t < numThreads; ++t)
+        {
+            if (refs[t][i] != ref)
+                return Result::Error;
+        }
+    }
+}
+SWC_TEST_END()
+
 SWC_END_NAMESPACE();
 
 #endif
@@ -0,0 +1,133 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Compiler/Sema/Generic/GenericInstanceStorage.h"
+#include "Support/Core/Timer.h"
+#include "Support/Core/Utf8Helper.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    // The storage never looks through instance pointers, so distinct addresses in a buffer
+    // stand in for symbols.
+    Symbol* fakeInstance(std::vector<std::byte>& backing, const uint32_t index)
+    {
+        return reinterpret_cast<Symbol*>(backing.data() + index);
+    }
+
+    // Shaped like the keys of a generic container: one type argument out of a few hundred,
+    // then a value argument.
+    void makeInstanceArgs(SmallVector<GenericInstanceKey>& outArgs, const uint32_t index)
+    {
+        outArgs.clear();
+        outArgs.push_back({.typeRef = TypeRef(index % 509)});
+        outArgs.push_back({.cstRef = ConstantRef(index / 509)});
+    }
+}
+
+SWC_TEST_BEGIN(GenericInstanceStorage_FindsEveryInstanceAcrossIndexGrowth)
+{
+    constexpr uint32_t numInstances = 2000;
+
+    std::vector<std::byte>          backing(numInstances);
+    GenericInstanceStorage          storage;
+    SmallVector<GenericInstanceKey> args;
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        makeInstanceArgs(args, i);
+        if (storage.find(args.span()) != nullptr)
+            return Result::Error;
+        if (storage.add(args.span(), fakeInstance(backing, i)) != fakeInstance(backing, i))
+            return Result::Error;
+    }
+
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        makeInstanceArgs(args, i);
+        if (storage.find(args.span()) != fakeInstance(backing, i))
+            return Result::Error;
+
+        SmallVector<GenericInstanceKey> storedArgs;
+        if (!storage.tryGetArgs(*fakeInstance(backing, i), storedArgs) || storedArgs.span().size() != args.span().size())
+            return Result::Error;
+    }
+
+    // The first instance added for some arguments wins.
+    makeInstanceArgs(args, 7);
+    if (storage.add(args.span(), fakeInstance(backing, 8)) != fakeInstance(backing, 7))
+        return Result::Error;
+
+    const GenericInstanceKey unknown[] = {{.typeRef = TypeRef(1)}, {.cstRef = ConstantRef(numInstances)}};
+    if (storage.find(unknown) != nullptr)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// Lookups into a generic holding thousands of instances, against the linear scan the hashed
+// index replaced.
+SWC_BENCHMARK_TEST_BEGIN(GenericInstanceStorage_Lookup)
+{
+    constexpr uint32_t numInstances = 4096;
+    constexpr uint32_t numRounds    = 8;
+
+    std::vector<std::byte>            backing(numInstances);
+    GenericInstanceStorage            storage;
+    std::vector<GenericInstanceEntry> linear;
+    SmallVector<GenericInstanceKey>   args;
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        makeInstanceArgs(args, i);
+        storage.add(args.span(), fakeInstance(backing, i));
+
+        GenericInstanceEntry entry;
+        entry.args.assign(args.begin(), args.end());
+        entry.symbol = fakeInstance(backing, i);
+        linear.push_back(std::move(entry));
+    }
+
+    const auto timeLookups = [&](const auto& lookup, uint64_t& outDurationNs) {
+        const Timer::Tick startTick = Timer::Clock::now();
+        for (uint32_t round = 0; round < numRounds; ++round)
+        {
+            for (uint32_t i = 0; i < numInstances; ++i)
+            {
+                makeInstanceArgs(args, i);
+                if (lookup(args.span()) != fakeInstance(backing, i))
+                    return false;
+            }
+        }
+
+        outDurationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count();
+        return true;
+    };
+
+    const auto hashedLookup = [&](const std::span<const GenericInstanceKey> key) {
+        return storage.find(key);
+    };
+
+    const auto linearLookup = [&](const std::span<const GenericInstanceKey> key) -> Symbol* {
+        for (const GenericInstanceEntry& entry : linear)
+        {
+            if (std::ranges::equal(entry.args.span(), key))
+                return entry.symbol;
+        }
+        return nullptr;
+    };
+
+    uint64_t hashedNs = 0;
+    uint64_t linearNs = 0;
+    if (!timeLookups(hashedLookup, hashedNs) || !timeLookups(linearLookup, linearNs))
+        return Result::Error;
+
+    const double speedup = hashedNs ? static_cast<double>(linearNs) / static_cast<double>(hashedNs) : 0.0;
+    const Utf8   result  = std::format("{} lookups, {} ({:.1f}x over linear scan)", Utf8Helper::toNiceBigNumber(numInstances * numRounds), Utf8Helper::toNiceTime(Timer::toSeconds(hashedNs)), speedup);
+    Unittest::logBenchmark(ctx, "GenericInstance-4k", result);
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -0,0 +1,167 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Compiler/Lexer/Lexer.h"
+#include "Compiler/Lexer/SourceView.h"
+#include "Compiler/Sema/Symbol/IdentifierManager.h"
+#include "Compiler/SourceFile.h"
+#include "Main/FileSystem.h"
+#include "Main/TaskContext.h"
+#include "Support/Core/Timer.h"
+#include "Support/Core/Utf8Helper.h"
+#include "Support/Os/Os.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    struct InternedName
+    {
+        std::string_view name;
+        uint32_t         hash = 0;
+    };
+
+    void collectStdSources(std::vector<fs::path>& outPaths)
+    {
+        const fs::path  stdRoot = FileSystem::compilerResourceRoot(Os::getExeFullName()) / "std";
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(stdRoot, ec), last; !ec && it != last; it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".swg")
+                outPaths.push_back(it->path());
+        }
+
+        std::ranges::sort(outPaths);
+    }
+
+    // Interns names[i] for every i of the given thread's share, as the parser workers do.
+    void internShare(IdentifierManager& idMgr, std::span<const InternedName> names, std::span<IdentifierRef> outRefs, const uint32_t thread, const uint32_t numThreads)
+    {
+        for (size_t i = thread; i < names.size(); i += numThreads)
+            outRefs[i] = idMgr.addIdentifier(names[i].name, names[i].hash);
+    }
+}
+
+// Every thread interns every name, including owned copies of temporaries, while the shard tables
+// grow underneath: all of them must agree on one ref per name.
+SWC_TEST_BEGIN(IdentifierManager_ConcurrentInternAgreesOnOneRefPerName)
+{
+    constexpr uint32_t numThreads = 8;
+    constexpr uint32_t numNames   = 50000;
+
+    IdentifierManager idMgr;
+    idMgr.setup(ctx);
+
+    std::vector<std::vector<IdentifierRef>> refs(numThreads, std::vector<IdentifierRef>(numNames, IdentifierRef::invalid()));
+    std::vector<std::thread>                threads;
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (uint32_t i = 0; i < numNames; ++i)
+            {
+                // Each thread walks the names from a different start, so inserts really race.
+                const uint32_t    index = (i + t * (numNames / numThreads)) % numNames;
+                const std::string name  = std::format("name{}", index);
+                refs[t][index]          = idMgr.addIdentifierOwned(name);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::unordered_set<uint32_t> seen;
+    for (uint32_t i = 0; i < numNames; ++i)
+    {
+        const IdentifierRef ref = refs[0][i];
+        if (!ref.isValid() || idMgr.get(ref).name != std::format("name{}", i))
+            return Result::Error;
+        if (!seen.insert(ref.get()).second)
+            return Result::Error;
+
+        for (uint32_t t = 1; t < numThreads; ++t)
+        {
+            if (refs[t][i] != ref)
+                return Result::Error;
+        }
+    }
+
+    if (idMgr.addIdentifier("name123") != refs[0][123])
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// Interning throughput over every identifier token of the standard library, with 1 to N threads
+// sharing one manager.
+SWC_BENCHMARK_TEST_BEGIN(IdentifierManager_StdInternScaling)
+{
+    std::vector<fs::path> paths;
+    collectStdSources(paths);
+    if (paths.empty())
+        return Result::Error;
+
+    TaskContext lexCtx = ctx;
+    lexCtx.setSilentDiagnostic(true);
+
+    std::vector<std::unique_ptr<SourceFile>> files;
+    std::vector<InternedName>                names;
+    for (const fs::path& path : paths)
+    {
+        std::vector<char8_t>    content;
+        FileSystem::IoErrorInfo ioError;
+        if (FileSystem::readBinaryFile(path, content, ioError) != Result::Continue)
+            return Result::Error;
+
+        auto file = std::make_unique<SourceFile>(FileRef::invalid(), path, FileFlagsE::CustomSrc);
+        file->setContent(std::string_view{reinterpret_cast<const char*>(content.data()), content.size()});
+
+        SourceView srcView(SourceViewRef::invalid(), file.get());
+        Lexer      lexer;
+        lexer.tokenize(lexCtx, srcView, LexerFlagsE::IgnoreGlobalCompilerIfSkip);
+        for (const Token& tok : srcView.tokens())
+        {
+            if (tok.id == TokenId::Identifier)
+                names.push_back({.name = tok.string(srcView), .hash = tok.crc(srcView)});
+        }
+
+        files.push_back(std::move(file));
+    }
+
+    const uint32_t        maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t numThreads = 1; numThreads < maxThreads; numThreads *= 2)
+        threadCounts.push_back(numThreads);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<IdentifierRef> refs(names.size());
+    uint64_t                   baseNs = 0;
+    for (const uint32_t numThreads : threadCounts)
+    {
+        IdentifierManager idMgr;
+        idMgr.setup(ctx);
+
+        const Timer::Tick        startTick = Timer::Clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < numThreads; ++t)
+            threads.emplace_back([&, t] { internShare(idMgr, names, refs, t, numThreads); });
+        for (std::thread& thread : threads)
+            thread.join();
+
+        const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count();
+        if (numThreads == 1)
+            baseNs = durationNs;
+
+        const double seconds = Timer::toSeconds(durationNs);
+        const double speedup = durationNs ? static_cast<double>(baseNs) / static_cast<double>(durationNs) : 0.0;
+        const double perSec  = seconds > 0 ? static_cast<double>(names.size()) / seconds : 0.0;
+        const Utf8   result  = std::format("{} identifiers, {} ({} /s, {:.2f}x)", Utf8Helper::toNiceBigNumber(names.size()), Utf8Helper::toNiceTime(seconds), Utf8Helper::toNiceBigNumber(static_cast<size_t>(perSec)), speedup);
+        Unittest::logBenchmark(ctx, std::format("IdentifierIntern-{}t", numThreads), result);
+    }
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -0,0 +1,161 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Compiler/Lexer/LangSpec.h"
+#include "Compiler/Lexer/Lexer.h"
+#include "Compiler/Lexer/LexerScan.h"
+#include "Compiler/Lexer/SourceView.h"
+#include "Compiler/SourceFile.h"
+#include "Main/FileSystem.h"
+#include "Main/Global.h"
+#include "Main/TaskContext.h"
+#include "Support/Core/Timer.h"
+#include "Support/Core/Utf8Helper.h"
+#include "Support/Os/Os.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    using ScanFn = const char8_t* (*) (const char8_t*, const char8_t*);
+
+    struct ScanPair
+    {
+        ScanFn block;
+        ScanFn scalar;
+    };
+
+    constexpr std::array SCAN_PAIRS = {
+        ScanPair{LexerScan::skipBlanks, LexerScan::Scalar::skipBlanks},
+        ScanPair{LexerScan::skipIdentifierPart, LexerScan::Scalar::skipIdentifierPart},
+        ScanPair{LexerScan::findLineEnd, LexerScan::Scalar::findLineEnd},
+        ScanPair{LexerScan::findStringStop, LexerScan::Scalar::findStringStop},
+        ScanPair{LexerScan::findCommentStop, LexerScan::Scalar::findCommentStop},
+    };
+
+    // Mostly bytes some scanner stops on, so that stops land at every lane of a block.
+    std::vector<char8_t> makeScanInput(uint32_t seed, size_t size)
+    {
+        constexpr std::string_view interesting = " \t\v\f\n\r\"\\/*_azAZ09@#`[{\x7f";
+
+        std::vector<char8_t> result(size);
+        for (char8_t& c : result)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            if ((seed >> 28) < 12)
+                c = static_cast<char8_t>(interesting[(seed >> 8) % interesting.size()]);
+            else
+                c = static_cast<char8_t>(seed >> 16);
+        }
+
+        return result;
+    }
+
+    void collectStdSources(std::vector<fs::path>& outPaths)
+    {
+        const fs::path  stdRoot = FileSystem::compilerResourceRoot(Os::getExeFullName()) / "std";
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(stdRoot, ec), last; !ec && it != last; it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".swg")
+                outPaths.push_back(it->path());
+        }
+
+        std::ranges::sort(outPaths);
+    }
+}
+
+// The block scanners must stop exactly where the byte loops they replace stop, from every start
+// offset and for every length, including the tails shorter than one block.
+SWC_TEST_BEGIN(Lexer_BlockScannersMatchScalar)
+{
+    for (uint32_t seed = 1; seed <= 64; ++seed)
+    {
+        const std::vector<char8_t> input = makeScanInput(seed, seed * 3);
+        const char8_t*             end   = input.data() + input.size();
+        for (const ScanPair& pair : SCAN_PAIRS)
+        {
+            for (const char8_t* cur = input.data(); cur <= end; ++cur)
+            {
+                if (pair.block(cur, end) != pair.scalar(cur, end))
+                    return Result::Error;
+            }
+        }
+    }
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(Lexer_KeywordPerfectHashFindsEveryWord)
+{
+    const LangSpec& langSpec = ctx.global().langSpec();
+    for (size_t i = 0; i < TOKEN_ID_INFOS.size(); ++i)
+    {
+        const TokenId id = static_cast<TokenId>(i);
+        if (!Token::isSpecialWord(id) || TOKEN_ID_INFOS[i].displayName.empty())
+            continue;
+        if (langSpec.keyword(TOKEN_ID_INFOS[i].displayName) != id)
+            return Result::Error;
+    }
+
+    for (const std::string_view name : {"", "x", "iff", "Me", "#iff", "@siz", "s320", "whilee"})
+    {
+        if (langSpec.keyword(name) != TokenId::Identifier)
+            return Result::Error;
+    }
+}
+SWC_TEST_END()
+
+// Raw lexer throughput over the standard library sources, every file lexed several times.
+SWC_BENCHMARK_TEST_BEGIN(Lexer_StdThroughput)
+{
+    constexpr uint32_t numRounds = 8;
+
+    std::vector<fs::path> paths;
+    collectStdSources(paths);
+    if (paths.empty())
+        return Result::Error;
+
+    std::vector<std::unique_ptr<SourceFile>> files;
+    size_t                                   totalBytes = 0;
+    for (const fs::path& path : paths)
+    {
+        std::vector<char8_t>    content;
+        FileSystem::IoErrorInfo ioError;
+        if (FileSystem::readBinaryFile(path, content, ioError) != Result::Continue)
+            return Result::Error;
+
+        auto file = std::make_unique<SourceFile>(FileRef::invalid(), path, FileFlagsE::CustomSrc);
+        file->setContent(std::string_view{reinterpret_cast<const char*>(content.data()), content.size()});
+        totalBytes += content.size();
+        files.push_back(std::move(file));
+    }
+
+    TaskContext lexCtx = ctx;
+    lexCtx.setSilentDiagnostic(true);
+
+    size_t            numTokens = 0;
+    const Timer::Tick startTick = Timer::Clock::now();
+    for (uint32_t round = 0; round < numRounds; ++round)
+    {
+        for (const auto& file : files)
+        {
+            SourceView srcView(SourceViewRef::invalid(), file.get());
+            Lexer      lexer;
+            lexer.tokenize(lexCtx, srcView, LexerFlagsE::IgnoreGlobalCompilerIfSkip);
+            numTokens += srcView.tokens().size();
+        }
+    }
+
+    const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count();
+    const double   seconds    = Timer::toSeconds(durationNs);
+    const double   mbPerSec   = seconds > 0 ? static_cast<double>(totalBytes) * numRounds / (1024.0 * 1024.0) / seconds : 0.0;
+    const Utf8     result     = std::format("{} files, {} tokens, {} ({:.1f} MB/s)", files.size(), Utf8Helper::toNiceBigNumber(numTokens), Utf8Helper::toNiceTime(seconds), mbPerSec);
+    Unittest::logBenchmark(ctx, "Lexer-std", result);
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -3,6 +3,8 @@
 #if SWC_HAS_UNITTEST
 
 #include "Compiler/Sema/Core/NodePayload.h"
+#include "Support/Core/Timer.h"
+#include "Support/Core/Utf8Helper.h"
 #include "Unittest/Unittest.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -14,6 +16,57 @@ namespace
     public:
         static void addValueFlag(AstNode& node) { addPayloadFlags(node, NodePayloadFlags::Value); }
         static void setTypeKind(AstNode& node) { setPayloadKind(node, NodePayloadKind::TypeRef); }
+
+        using NodePayload::appendResolvedCallArguments;
+        using NodePayload::clearSemaPayload;
+        using NodePayload::copyResolvedCallArguments;
+        using NodePayload::getLoweringPayload;
+        using NodePayload::getSemaPayload;
+        using NodePayload::hasSemaPayload;
+        using NodePayload::setLoweringPayload;
+        using NodePayload::setResolvedCallArguments;
+        using NodePayload::setSemaPayload;
+    };
+
+    // Side tables only look at the ref, so the tests address nodes that were never allocated.
+    AstNodeRef nodeRefAt(const uint32_t shard, const uint32_t index)
+    {
+        return AstNodeRef{Ast::packRef(shard % Ast::SHARD_COUNT, index * static_cast<uint32_t>(sizeof(AstNode)))};
+    }
+
+    void* payloadFor(const uint32_t index)
+    {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(index + 1) << 4);
+    }
+
+    // The per-shard maps behind a shared_mutex that the side tables replaced: the baseline of
+    // the lookup benchmark.
+    class LockedNodeMap
+    {
+    public:
+        void* get(AstNodeRef nodeRef) const
+        {
+            const Shard&           shard = shards_[nodeRef.get() % NODE_PAYLOAD_SHARD_NUM];
+            const std::shared_lock lock(shard.mutex);
+            const auto             it = shard.map.find(nodeRef);
+            return it == shard.map.end() ? nullptr : it->second;
+        }
+
+        void set(AstNodeRef nodeRef, void* payload)
+        {
+            Shard&                 shard = shards_[nodeRef.get() % NODE_PAYLOAD_SHARD_NUM];
+            const std::unique_lock lock(shard.mutex);
+            shard.map[nodeRef] = payload;
+        }
+
+    private:
+        struct Shard
+        {
+            mutable std::shared_mutex             mutex;
+            std::unordered_map<AstNodeRef, void*> map;
+        };
+
+        std::array<Shard, NODE_PAYLOAD_SHARD_NUM> shards_;
     };
 }
 
@@ -53,6 +106,179 @@ SWC_TEST_BEGIN(NodePayload_ConcurrentUpdatesPreserveDisjointState)
 }
 SWC_TEST_END()
 
+SWC_TEST_BEGIN(NodePayload_SideTablesKeepOnePayloadPerNode)
+{
+    SWC_UNUSED(ctx);
+
+    NodePayloadTestAccess payload;
+    const AstNodeRef      first  = nodeRefAt(0, 0);
+    const AstNodeRef      second = nodeRefAt(0, 1);
+    const AstNodeRef      other  = nodeRefAt(5, 1);
+
+    // Far enough into its shard to need a grown page directory.
+    const AstNodeRef far = nodeRefAt(3, 1'000'000);
+
+    payload.setSemaPayload(first, payloadFor(1));
+    payload.setSemaPayload(far, payloadFor(2));
+    payload.setLoweringPayload(second, payloadFor(3));
+    if (payload.getSemaPayload(first) != payloadFor(1) || payload.getSemaPayload(far) != payloadFor(2))
+        return Result::Error;
+    if (payload.hasSemaPayload(second) || payload.hasSemaPayload(other) || payload.getLoweringPayload(first))
+        return Result::Error;
+    if (payload.getLoweringPayload(second) != payloadFor(3))
+        return Result::Error;
+
+    payload.clearSemaPayload(first);
+    payload.clearSemaPayload(other);
+    if (payload.hasSemaPayload(first) || payload.getSemaPayload(far) != payloadFor(2))
+        return Result::Error;
+
+    const ResolvedCallArgument args[] = {{.argRef = first}, {.argRef = second, .movesValueToParam = true}};
+    payload.setResolvedCallArguments(other, args);
+    payload.copyResolvedCallArguments(far, other);
+
+    SmallVector<ResolvedCallArgument> out;
+    payload.appendResolvedCallArguments(far, out);
+    if (out.size() != 2 || out[0].argRef != first || out[1].argRef != second || !out[1].movesValueToParam)
+        return Result::Error;
+    if (!payload.hasResolvedCallArguments(other) || payload.hasResolvedCallArguments(first))
+        return Result::Error;
+
+    payload.setResolvedCallArguments(other, {});
+    if (payload.hasResolvedCallArguments(other) || !payload.hasResolvedCallArguments(far))
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// Workers publish payloads on their own nodes while reading everyone else's, as Sema jobs of
+// one file do: pages and directories are created underneath the readers.
+SWC_TEST_BEGIN(NodePayload_ConcurrentSideTableWritesAreSeen)
+{
+    SWC_UNUSED(ctx);
+
+    constexpr uint32_t numThreads = 8;
+    constexpr uint32_t numNodes   = 40000;
+
+    NodePayloadTestAccess    payload;
+    std::atomic_bool         valid = true;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (uint32_t i = t; i < numNodes; i += numThreads)
+            {
+                payload.setSemaPayload(nodeRefAt(i, i), payloadFor(i));
+
+                // Whatever a reader sees for another node is either nothing yet or its payload.
+                const uint32_t j    = (i * 7919) % numNodes;
+                void* const    seen = payload.getSemaPayload(nodeRefAt(j, j));
+                if (seen && seen != payloadFor(j))
+                    valid.store(false, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    if (!valid.load(std::memory_order_relaxed))
+        return Result::Error;
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        if (payload.getSemaPayload(nodeRefAt(i, i)) != payloadFor(i))
+            return Result::Error;
+    }
+}
+SWC_TEST_END()
+
+// The lookups Sema and CodeGen make for every node they visit (sema payload, lowering payload,
+// resolved call arguments), from 1 to N threads sharing one file, against the locked maps the
+// side tables replaced.
+SWC_BENCHMARK_TEST_BEGIN(NodePayload_SideTableLookupScaling)
+{
+    constexpr uint32_t numNodes  = 1u << 18;
+    constexpr uint32_t numRounds = 8;
+
+    NodePayloadTestAccess payload;
+    LockedNodeMap         lockedSema;
+    LockedNodeMap         lockedLowering;
+    LockedNodeMap         lockedCallArgs;
+
+    const ResolvedCallArgument arg{.argRef = nodeRefAt(0, 0)};
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        const AstNodeRef nodeRef = nodeRefAt(i, i);
+        if (i % 4 == 0)
+        {
+            payload.setSemaPayload(nodeRef, payloadFor(i));
+            lockedSema.set(nodeRef, payloadFor(i));
+        }
+        if (i % 16 == 0)
+        {
+            payload.setLoweringPayload(nodeRef, payloadFor(i));
+            lockedLowering.set(nodeRef, payloadFor(i));
+        }
+        if (i % 8 == 0)
+        {
+            payload.setResolvedCallArguments(nodeRef, std::span{&arg, 1});
+            lockedCallArgs.set(nodeRef, payloadFor(i));
+        }
+    }
+
+    const auto timeLookups = [&](const uint32_t numThreads, const auto& lookup) {
+        std::atomic<uintptr_t>   sink      = 0;
+        const Timer::Tick        startTick = Timer::Clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&, t] {
+                uintptr_t found = 0;
+                for (uint32_t round = 0; round < numRounds; ++round)
+                {
+                    for (uint32_t i = t; i < numNodes; i += numThreads)
+                        found += lookup(nodeRefAt(i, i));
+                }
+                sink.fetch_add(found, std::memory_order_relaxed);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count());
+    };
+
+    const auto sideTableLookup = [&](const AstNodeRef nodeRef) {
+        return reinterpret_cast<uintptr_t>(payload.getSemaPayload(nodeRef)) +
+               reinterpret_cast<uintptr_t>(payload.getLoweringPayload(nodeRef)) +
+               (payload.hasResolvedCallArguments(nodeRef) ? 1 : 0);
+    };
+
+    const auto lockedMapLookup = [&](const AstNodeRef nodeRef) {
+        return reinterpret_cast<uintptr_t>(lockedSema.get(nodeRef)) +
+               reinterpret_cast<uintptr_t>(lockedLowering.get(nodeRef)) +
+               (lockedCallArgs.get(nodeRef) ? 1 : 0);
+    };
+
+    const uint32_t        maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t numThreads = 1; numThreads < maxThreads; numThreads *= 2)
+        threadCounts.push_back(numThreads);
+    threadCounts.push_back(maxThreads);
+
+    const size_t numLookups = static_cast<size_t>(numNodes) * numRounds * 3;
+    for (const uint32_t numThreads : threadCounts)
+    {
+        const uint64_t sideTableNs = timeLookups(numThreads, sideTableLookup);
+        const uint64_t lockedMapNs = timeLookups(numThreads, lockedMapLookup);
+        const double   seconds     = Timer::toSeconds(sideTableNs);
+        const double   perSec      = seconds > 0 ? static_cast<double>(numLookups) / seconds : 0.0;
+        const double   speedup     = sideTableNs ? static_cast<double>(lockedMapNs) / static_cast<double>(sideTableNs) : 0.0;
+        const Utf8     result      = std::format("{} lookups, {} ({} /s, {:.1f}x over locked maps)", Utf8Helper::toNiceBigNumber(numLookups), Utf8Helper::toNiceTime(seconds), Utf8Helper::toNiceBigNumber(static_cast<size_t>(perSec)), speedup);
+        Unittest::logBenchmark(ctx, std::format("NodeSideTable-{}t", numThreads), result);
+    }
+}
+SWC_TEST_END()
+
 SWC_END_NAMESPACE();
 
 #endif
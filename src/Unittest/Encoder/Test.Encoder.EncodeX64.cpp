@@ -826,6 +826,52 @@ SWC_TEST_BEGIN(EncodeX64_UnwindStopsAfterBodyStart)
 }
 SWC_TEST_END()
 
+SWC_TEST_BEGIN(EncodeX64_RelaxLabelJumps)
+{
+    const auto runRelaxed = [&](const char* name, const std::string& expectedHex, const BuilderCaseFn& fn) {
+        X64Encoder encoder(ctx);
+        return Backend::Unittest::runEncodeCase(ctx, encoder, name, expectedHex.c_str(), fn, true);
+    };
+
+    const auto nops = [](const uint32_t count) {
+        std::string result;
+        for (uint32_t i = 0; i < count; ++i)
+            result += " 90";
+        return result;
+    };
+
+    SWC_RESULT(runRelaxed("relax_forward", "74 01 90", [](MicroBuilder& b) {
+        const auto l = b.createLabel();
+        b.emitJumpToLabel(MicroCond::Zero, MicroOpBits::B32, l);
+        b.emitNop();
+        b.placeLabel(l); }));
+
+    SWC_RESULT(runRelaxed("relax_backward", "90 75 FD", [](MicroBuilder& b) {
+        const auto l = b.createLabel();
+        b.placeLabel(l);
+        b.emitNop();
+        b.emitJumpToLabel(MicroCond::NotZero, MicroOpBits::B32, l); }));
+
+    SWC_RESULT(runRelaxed("relax_out_of_reach", "0F 84 C8 00 00 00" + nops(200), [](MicroBuilder& b) {
+        const auto l = b.createLabel();
+        b.emitJumpToLabel(MicroCond::Zero, MicroOpBits::B32, l);
+        for (uint32_t i = 0; i < 200; ++i)
+            b.emitNop();
+        b.placeLabel(l); }));
+
+    // The first jump only reaches its label once the second one is short.
+    SWC_RESULT(runRelaxed("relax_chained", "74 7E 75 7C" + nops(124), [](MicroBuilder& b) {
+        const auto l0 = b.createLabel();
+        const auto l1 = b.createLabel();
+        b.emitJumpToLabel(MicroCond::Zero, MicroOpBits::B32, l0);
+        b.emitJumpToLabel(MicroCond::NotZero, MicroOpBits::B32, l1);
+        for (uint32_t i = 0; i < 124; ++i)
+            b.emitNop();
+        b.placeLabel(l1);
+        b.placeLabel(l0); }));
+}
+SWC_TEST_END()
+
 SWC_END_NAMESPACE();
 
 #endif
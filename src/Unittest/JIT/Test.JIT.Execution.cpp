@@ -7,6 +7,10 @@
 #include "Backend/JIT/JIT.h"
 #include "Backend/JIT/JITMemory.h"
 #include "Backend/Micro/MachineCode.h"
+#include "Main/Command/CommandLine.h"
+#include "Main/Global.h"
+#include "Support/Report/Logger.h"
+#include "Support/Thread/JobManager.h"
 #include "Unittest/Unittest.h"
 
 SWC_BEGIN_NAMESPACE();
@@ -531,6 +535,52 @@ SWC_TEST_BEGIN(JIT_Return42)
 }
 SWC_TEST_END()
 
+// Parallel '#test' runs call JIT code from several workers at once, each through a context that
+// keeps what it logs aside. Every result and every captured line must stay with its own call.
+SWC_TEST_BEGIN(JIT_ParallelCallsKeepOutputPerContext)
+{
+    MicroBuilder builder(ctx);
+    buildReturn42(builder, CallConv::swag());
+
+    MachineCode loweredCode;
+    SWC_RESULT(loweredCode.emit(ctx, builder));
+
+    JITMemory executableMemory;
+    SWC_RESULT(JIT::emit(ctx, executableMemory, loweredCode.bytes, loweredCode.codeRelocations, loweredCode.unwindInfo));
+
+    using TestFn  = uint64_t (*)();
+    const auto fn = reinterpret_cast<TestFn>(executableMemory.entryPoint());
+    if (!fn)
+        return Result::Error;
+
+    CommandLine cmdLine;
+    cmdLine.numCores = 4;
+
+    JobManager jobMgr;
+    jobMgr.setup(cmdLine);
+
+    const Global global;
+    TaskContext  jobCtx(global, cmdLine);
+    const auto   clientId = jobMgr.newClientId();
+
+    constexpr uint32_t    count = 257;
+    std::vector<uint64_t> results(count, 0);
+    std::vector<Utf8>     outputs(count);
+    jobMgr.parallelForIndexed(jobCtx, count, JobKind::JitTest, clientId, [&](TaskContext& workerCtx, uint32_t index) {
+        TaskContext callCtx(workerCtx);
+        callCtx.setOutputCapture(&outputs[index]);
+        results[index] = fn();
+        Logger::print(callCtx, std::format("call {}\n", index));
+    });
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (results[i] != 42 || outputs[i] != std::format("call {}\n", i))
+            return Result::Error;
+    }
+}
+SWC_TEST_END()
+
 SWC_TEST_BEGIN(JIT_RegAllocAvoidsFutureConcreteClobber)
 {
     SWC_RESULT(runCase(ctx, &buildReturnVirtualAcrossConcreteClobber, 3));
@@ -0,0 +1,285 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Backend/ABI/CallConv.h"
+#include "Backend/JIT/JIT.h"
+#include "Backend/JIT/JITMemory.h"
+#include "Backend/Micro/MachineCode.h"
+#include "Backend/Micro/MicroPassContext.h"
+#include "Backend/Native/NativeBackendBuilder.h"
+#include "Compiler/Sema/Core/Sema.h"
+#include "Compiler/Sema/Symbol/Symbol.Function.h"
+#include "Main/Command/Command.h"
+#include "Main/Command/CommandLine.h"
+#include "Main/Command/CommandLineParser.h"
+#include "Main/CompilerInstance.h"
+#include "Main/Stats.h"
+#include "Unittest/Unittest.h"
+#include "Unittest/UnittestSource.h"
+
+SWC_BEGIN_NAMESPACE();
+#ifdef _M_X64
+
+namespace
+{
+    // What the encoder emits for the 8 bytes a baseline function reserves at its entry.
+    constexpr std::array<uint8_t, MicroPassContext::K_JIT_ENTRY_PATCH_SIZE> ENTRY_NOP = {0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    constexpr std::string_view TIER_UP_SOURCE = R"(func tierLeaf(x: s32)->s32
+{
+    return x * 3 + 1
+}
+
+func tierLoop(n: s32)->s32
+{
+    var total: s32 = 0
+    var i:     s32 = 0
+    while i < n
+    {
+        total += i
+        i += 1
+    }
+
+    return total
+}
+
+var GTierLeaf: func(s32)->s32 = &tierLeaf
+var GTierLoop: func(s32)->s32 = &tierLoop
+)";
+
+    using TierFn = int32_t (*)(int32_t);
+
+    struct RestoreErrorCount
+    {
+        uint64_t saved = 0;
+
+        ~RestoreErrorCount()
+        {
+            Stats::get().numErrors.store(saved, std::memory_order_relaxed);
+        }
+    };
+
+    bool startsWithEntryNop(const void* entry)
+    {
+        return entry && std::memcmp(entry, ENTRY_NOP.data(), ENTRY_NOP.size()) == 0;
+    }
+
+    // The entry is 'jmp rel32' to the target, the rest of the reserved bytes being 'int3'.
+    bool isRedirectedTo(const void* entry, const void* target)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(entry);
+        if (bytes[0] != 0xE9 || bytes[5] != 0xCC || bytes[6] != 0xCC || bytes[7] != 0xCC)
+            return false;
+
+        int32_t rel = 0;
+        std::memcpy(&rel, bytes + 1, sizeof(rel));
+        return bytes + 5 + rel == target;
+    }
+
+    void buildReturn42(MicroBuilder& builder, const CallConv& callConv)
+    {
+        builder.emitLoadRegImm(callConv.intReturn, ApInt(42, 64), MicroOpBits::B64);
+        builder.emitRet();
+    }
+
+    void buildReturn7(MicroBuilder& builder, const CallConv& callConv)
+    {
+        builder.emitLoadRegImm(callConv.intReturn, ApInt(7, 64), MicroOpBits::B64);
+        builder.emitRet();
+    }
+
+    Result emitTier(TaskContext& ctx, JITMemory& outMemory, void (*buildFn)(MicroBuilder&, const CallConv&), MachineCodeTier tier)
+    {
+        MicroBuilder builder(ctx);
+        buildFn(builder, CallConv::swag());
+
+        MachineCode loweredCode;
+        SWC_RESULT(loweredCode.emit(ctx, builder, MicroReg::invalid(), 0, nullptr, tier));
+        return JIT::emit(ctx, outMemory, loweredCode.bytes, loweredCode.codeRelocations, loweredCode.unwindInfo);
+    }
+
+    // Compiles TIER_UP_SOURCE the way a script is compiled, so every function goes through the
+    // tiers, and hands back the JIT entry of each function named.
+    template<typename F>
+    Result runTierUpSource(TaskContext& ctx, std::string_view testName, std::span<const std::string_view> names, F&& check)
+    {
+        const fs::path sourcePath = Unittest::makeTestSourcePath("JIT", testName);
+
+        CommandLine cmdLine;
+        cmdLine.command     = CommandKind::Test;
+        cmdLine.buildCfg    = "fast-debug";
+        cmdLine.backendKind = Runtime::BuildCfgBackendKind::Executable;
+        cmdLine.name        = Utf8(testName);
+        cmdLine.scriptMode  = true;
+        cmdLine.jitTiering  = true;
+        cmdLine.files.insert(sourcePath);
+        CommandLineParser::refreshBuildCfg(cmdLine);
+
+        const uint64_t    errorsBefore = Stats::getNumErrors();
+        RestoreErrorCount restoreErrors{errorsBefore};
+        CompilerInstance  compiler(ctx.global(), cmdLine);
+        Unittest::registerTestSource(compiler, sourcePath, TIER_UP_SOURCE);
+        Command::sema(compiler);
+        if (Stats::getNumErrors() != errorsBefore)
+            return Result::Error;
+
+        NativeBackendBuilder nativeBuilder(compiler, false);
+        if (nativeBuilder.prepare() != Result::Continue || Stats::getNumErrors() != errorsBefore)
+            return Result::Error;
+
+        TaskContext                  compilerCtx(compiler);
+        const auto                   initTargets = compiler.nativeGlobalFunctionInitTargetsSnapshot();
+        SmallVector<SymbolFunction*> functions;
+        for (const std::string_view name : names)
+        {
+            SymbolFunction* found = nullptr;
+            for (SymbolFunction* function : initTargets)
+            {
+                if (function && function->name(compilerCtx) == name)
+                {
+                    found = function;
+                    break;
+                }
+            }
+
+            if (!found)
+                return Result::Error;
+            functions.push_back(found);
+        }
+
+        while (true)
+        {
+            const Result jitBatchResult = SymbolFunction::jitBatch(compilerCtx, functions.span());
+            if (jitBatchResult == Result::Continue)
+                break;
+            if (jitBatchResult == Result::Error)
+                return Result::Error;
+
+            Sema::waitDone(compilerCtx, compiler.jobClientId());
+            if (Stats::hasError() || compilerCtx.state().jitEmissionError)
+                return Result::Error;
+        }
+
+        for (const SymbolFunction* function : functions)
+        {
+            if (!function->jitEntryAddress())
+                return Result::Error;
+        }
+
+        return check(compilerCtx, compiler, functions.span());
+    }
+}
+
+// A baseline function opens with an 8-byte NOP that optimized code does not have. Redirecting
+// it writes a rel32 jump over those bytes, and calls through the old entry reach the new code.
+SWC_TEST_BEGIN(JIT_RedirectPatchesReservedEntry)
+{
+    JITMemory baselineMemory;
+    SWC_RESULT(emitTier(ctx, baselineMemory, &buildReturn42, MachineCodeTier::Baseline));
+    JITMemory optimizedMemory;
+    SWC_RESULT(emitTier(ctx, optimizedMemory, &buildReturn7, MachineCodeTier::Optimized));
+
+    void* const baselineEntry  = baselineMemory.entryPoint();
+    void* const optimizedEntry = optimizedMemory.entryPoint();
+    if (!startsWithEntryNop(baselineEntry) || startsWithEntryNop(optimizedEntry))
+        return Result::Error;
+
+    const auto fn = reinterpret_cast<uint64_t (*)()>(baselineEntry);
+    if (fn() != 42)
+        return Result::Error;
+
+    if (!JIT::redirect(baselineMemory, optimizedEntry))
+        return Result::Error;
+    if (!isRedirectedTo(baselineEntry, optimizedEntry))
+        return Result::Error;
+    if (fn() != 7)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// The call counter of a baseline function asks for the optimized recompile on the call that
+// brings it to zero, not before. Once redirected, calls no longer count, and results stay the
+// same across the switch.
+SWC_TEST_BEGIN(JIT_TierUpRequestedOnceAtThreshold)
+{
+    static constexpr std::array<std::string_view, 1> NAMES = {"tierLeaf"};
+    SWC_RESULT(runTierUpSource(ctx, "TierUpRequestedOnceAtThreshold", NAMES, [](TaskContext&, CompilerInstance& compiler, std::span<SymbolFunction* const> functions) {
+        SymbolFunction& leaf      = *functions[0];
+        void* const     entry     = leaf.jitEntryAddress();
+        const int32_t   threshold = leaf.jitTierUpCounter().load(std::memory_order_acquire);
+        if (threshold <= 1 || !startsWithEntryNop(entry))
+            return Result::Error;
+
+        const auto fn = reinterpret_cast<TierFn>(entry);
+        for (int32_t i = 0; i < threshold - 1; ++i)
+        {
+            if (fn(i) != i * 3 + 1 || leaf.jitTierUpRequested())
+                return Result::Error;
+        }
+
+        if (fn(threshold) != threshold * 3 + 1 || !leaf.jitTierUpRequested())
+            return Result::Error;
+        if (leaf.jitTierUpCounter().load(std::memory_order_acquire) != 0)
+            return Result::Error;
+
+        TaskContext tierUpCtx(compiler);
+        Sema::waitDone(tierUpCtx, compiler.jitTierUpClientId());
+
+        const MachineCode* optimizedCode  = nullptr;
+        const void*        optimizedEntry = nullptr;
+        if (!leaf.tryGetJitOptimizedCode(optimizedCode, optimizedEntry))
+            return Result::Error;
+        if (!isRedirectedTo(entry, optimizedEntry) || startsWithEntryNop(optimizedEntry))
+            return Result::Error;
+
+        constexpr int32_t numCallsAfter = 16;
+        for (int32_t i = 0; i < numCallsAfter; ++i)
+        {
+            if (fn(-i) != -i * 3 + 1)
+                return Result::Error;
+        }
+
+        // The optimized code has no counter, and the redirect sends every call there.
+        if (leaf.jitTierUpCounter().load(std::memory_order_acquire) != 0 || !leaf.jitTierUpRequested())
+            return Result::Error;
+        return Result::Continue;
+    }));
+}
+SWC_TEST_END()
+
+// Tier-up happens on entry only, so a function with a loop is lowered optimized up front: no
+// reserved entry, no call counter, and no recompile however often it is called.
+SWC_TEST_BEGIN(JIT_TierUpLowersLoopsOptimized)
+{
+    static constexpr std::array<std::string_view, 2> NAMES = {"tierLeaf", "tierLoop"};
+    SWC_RESULT(runTierUpSource(ctx, "TierUpLowersLoopsOptimized", NAMES, [](TaskContext&, CompilerInstance&, std::span<SymbolFunction* const> functions) {
+        const SymbolFunction& leaf = *functions[0];
+        SymbolFunction&       loop = *functions[1];
+        if (!startsWithEntryNop(leaf.jitEntryAddress()) || startsWithEntryNop(loop.jitEntryAddress()))
+            return Result::Error;
+
+        const int32_t threshold = loop.jitTierUpCounter().load(std::memory_order_acquire);
+        const auto    fn        = reinterpret_cast<TierFn>(loop.jitEntryAddress());
+        for (int32_t i = 0; i <= threshold; ++i)
+        {
+            const int32_t n = i % 32;
+            if (fn(n) != n * (n - 1) / 2)
+                return Result::Error;
+        }
+
+        const MachineCode* optimizedCode  = nullptr;
+        const void*        optimizedEntry = nullptr;
+        if (loop.jitTierUpRequested() || loop.tryGetJitOptimizedCode(optimizedCode, optimizedEntry))
+            return Result::Error;
+        if (loop.jitTierUpCounter().load(std::memory_order_acquire) != threshold)
+            return Result::Error;
+        return Result::Continue;
+    }));
+}
+SWC_TEST_END()
+
+#endif
+SWC_END_NAMESPACE();
+
+#endif
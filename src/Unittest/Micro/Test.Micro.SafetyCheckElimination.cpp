@@ -0,0 +1,333 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Backend/ABI/CallConv.h"
+#include "Backend/Micro/MicroBuilder.h"
+#include "Backend/Micro/MicroPassContext.h"
+#include "Backend/Micro/MicroPassManager.h"
+#include "Backend/Micro/Passes/Pass.SafetyCheckElimination.h"
+#include "Compiler/Sema/Symbol/Symbol.Function.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    SymbolFunction* makeTestFunction(TaskContext& ctx, std::string_view name)
+    {
+        auto* function = Symbol::make<SymbolFunction>(ctx, nullptr, TokenRef::invalid(), ctx.idMgr().addIdentifier(name), SymbolFlagsE::Zero);
+        function->setReturnTypeRef(ctx.typeMgr().typeVoid());
+        function->setTyped(ctx);
+        function->setSemaCompleted(ctx);
+        return function;
+    }
+
+    Result runSafetyCheckEliminationPass(MicroBuilder& builder, const SymbolFunction* panicFunction)
+    {
+        MicroSafetyCheckEliminationPass pass;
+        MicroPassManager                passManager;
+        passManager.addStartPass(pass);
+
+        MicroPassContext passContext;
+        passContext.callConvKind        = CallConvKind::Swag;
+        passContext.safetyPanicFunction = panicFunction;
+        return builder.runPasses(passManager, nullptr, passContext);
+    }
+
+    uint32_t countConditionalJumps(const MicroBuilder& builder)
+    {
+        const MicroOperandStorage& operands = builder.operands();
+        uint32_t                   count    = 0;
+        for (const MicroInstr& inst : builder.instructions().view())
+        {
+            if (inst.op != MicroInstrOpcode::JumpCond)
+                continue;
+            const MicroInstrOperand* ops = inst.ops(operands);
+            if (ops && ops[0].cpuCond != MicroCond::Unconditional)
+                ++count;
+        }
+
+        return count;
+    }
+
+    uint32_t countOpcode(const MicroBuilder& builder, MicroInstrOpcode opcode)
+    {
+        uint32_t count = 0;
+        for (const MicroInstr& inst : builder.instructions().view())
+        {
+            if (inst.op == opcode)
+                ++count;
+        }
+
+        return count;
+    }
+
+    // `cmp index, count; jb ok; call panic; ok:`, as CodeGenSafety emits it.
+    void emitBoundGuard(MicroBuilder& builder, MicroReg index, MicroReg count, const SymbolFunction* panicFunction)
+    {
+        const MicroLabelRef labelOk = builder.createLabel();
+        builder.emitCmpRegReg(index, count, MicroOpBits::B64);
+        builder.emitJumpToLabel(MicroCond::Below, MicroOpBits::B32, labelOk);
+        builder.emitCallLocal(panicFunction, CallConvKind::Swag);
+        builder.placeLabel(labelOk);
+    }
+}
+
+// The guard sits behind a branch that already tested the same index against
+// the same count: the jump becomes unconditional and its compare goes away.
+SWC_TEST_BEGIN(SafetyCheckElimination_RemovesGuardBehindDominatingTest)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn = makeTestFunction(ctx, "__safetyPanic");
+
+    const MicroLabelRef labelOut = builder.createLabel();
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelOut);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.emitLoadRegMem(vIndex, vBase, 16, MicroOpBits::B64);
+    builder.placeLabel(labelOut);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 1)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::CmpRegReg) != 1)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// A masked index is in range of a constant count without any branch.
+SWC_TEST_BEGIN(SafetyCheckElimination_RemovesGuardOnMaskedIndex)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn = makeTestFunction(ctx, "__safetyPanic");
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitOpBinaryRegImm(vIndex, ApInt(7, 64), MicroOp::And, MicroOpBits::B64);
+    builder.emitLoadRegImm(vCount, ApInt(8, 64), MicroOpBits::B64);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 0)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// `for i in 0..<n { a[i] }`: the pre-test proves the index in range on entry
+// and the rotated latch test on the back edge, so the guard in the body goes.
+SWC_TEST_BEGIN(SafetyCheckElimination_RemovesLoopIndexGuard)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    const MicroReg vValue = MicroReg::virtualIntReg(13);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn = makeTestFunction(ctx, "__safetyPanic");
+
+    const MicroLabelRef labelDone = builder.createLabel();
+    const MicroLabelRef labelLoop = builder.createLabel();
+
+    builder.emitLoadRegMem(vCount, vBase, 0, MicroOpBits::B64);
+    builder.emitClearReg(vIndex, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelDone);
+    builder.placeLabel(labelLoop);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.emitLoadRegMem(vValue, vBase, 8, MicroOpBits::B64);
+    builder.emitOpBinaryRegImm(vIndex, ApInt(1, 64), MicroOp::Add, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::Below, MicroOpBits::B32, labelLoop);
+    builder.placeLabel(labelDone);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    // Only the loop's own pre-test and latch test remain.
+    if (countConditionalJumps(builder) != 2)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// An index zero-extended from a byte cannot carry out of a 64-bit add.
+SWC_TEST_BEGIN(SafetyCheckElimination_RemovesOverflowGuardOnNarrowValue)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vValue = MicroReg::virtualIntReg(11);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn = makeTestFunction(ctx, "__safetyPanic");
+
+    const MicroLabelRef labelOk = builder.createLabel();
+
+    builder.emitLoadZeroExtendRegMem(vValue, vBase, 0, MicroOpBits::B64, MicroOpBits::B8);
+    builder.emitOpBinaryRegImm(vValue, ApInt(1, 64), MicroOp::Add, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelOk);
+    builder.emitCallLocal(panicFn, CallConvKind::Swag);
+    builder.placeLabel(labelOk);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 0)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// Nothing relates the index to the count: the guard stays as it is.
+SWC_TEST_BEGIN(SafetyCheckElimination_KeepsUnprovenGuard)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn = makeTestFunction(ctx, "__safetyPanic");
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 1)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::CmpRegReg) != 1)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// The dominating test bounds the index, but the guard checks `index - 1`,
+// which wraps around to the top of the range when the index is zero.
+SWC_TEST_BEGIN(SafetyCheckElimination_KeepsGuardOnWrappingIndex)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn  = makeTestFunction(ctx, "__safetyPanic");
+    const MicroLabelRef   labelOut = builder.createLabel();
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelOut);
+    builder.emitOpBinaryRegImm(vIndex, ApInt(1, 64), MicroOp::Subtract, MicroOpBits::B64);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.placeLabel(labelOut);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 2)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// The index was tested against one count and is guarded against another.
+SWC_TEST_BEGIN(SafetyCheckElimination_KeepsGuardAgainstOtherCount)
+{
+    const MicroReg vBase   = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex  = MicroReg::virtualIntReg(11);
+    const MicroReg vCount  = MicroReg::virtualIntReg(12);
+    const MicroReg vCount2 = MicroReg::virtualIntReg(13);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn  = makeTestFunction(ctx, "__safetyPanic");
+    const MicroLabelRef   labelOut = builder.createLabel();
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount2, vBase, 16, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelOut);
+    emitBoundGuard(builder, vIndex, vCount2, panicFn);
+    builder.placeLabel(labelOut);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 2)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::CmpRegReg) != 2)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// A signed `index < count` lets a negative index through, and a negative
+// index is huge to the unsigned bound check.
+SWC_TEST_BEGIN(SafetyCheckElimination_KeepsUnsignedGuardBehindSignedTest)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn  = makeTestFunction(ctx, "__safetyPanic");
+    const MicroLabelRef   labelOut = builder.createLabel();
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::GreaterOrEqual, MicroOpBits::B32, labelOut);
+    emitBoundGuard(builder, vIndex, vCount, panicFn);
+    builder.placeLabel(labelOut);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 2)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// Same shape as a proven guard, but the branch skips a call to some other
+// function: that is user code, and the branch is not the pass's to remove.
+SWC_TEST_BEGIN(SafetyCheckElimination_KeepsBranchOverOtherCall)
+{
+    const MicroReg vBase  = MicroReg::virtualIntReg(10);
+    const MicroReg vIndex = MicroReg::virtualIntReg(11);
+    const MicroReg vCount = MicroReg::virtualIntReg(12);
+    MicroBuilder   builder(ctx);
+
+    const SymbolFunction* panicFn  = makeTestFunction(ctx, "__safetyPanic");
+    const SymbolFunction* userFn   = makeTestFunction(ctx, "userFunction");
+    const MicroLabelRef   labelOut = builder.createLabel();
+
+    builder.emitLoadRegMem(vIndex, vBase, 0, MicroOpBits::B64);
+    builder.emitLoadRegMem(vCount, vBase, 8, MicroOpBits::B64);
+    builder.emitCmpRegReg(vIndex, vCount, MicroOpBits::B64);
+    builder.emitJumpToLabel(MicroCond::AboveOrEqual, MicroOpBits::B32, labelOut);
+    emitBoundGuard(builder, vIndex, vCount, userFn);
+    builder.placeLabel(labelOut);
+    builder.emitRet();
+
+    SWC_RESULT(runSafetyCheckEliminationPass(builder, panicFn));
+
+    if (countConditionalJumps(builder) != 2)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::CmpRegReg) != 2)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
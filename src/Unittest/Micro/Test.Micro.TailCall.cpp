@@ -0,0 +1,196 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Backend/Micro/MachineCodeDedup.h"
+#include "Backend/Micro/MicroBuilder.h"
+#include "Backend/Micro/MicroPassContext.h"
+#include "Backend/Micro/MicroPassManager.h"
+#include "Backend/Micro/Passes/Pass.PrologEpilog.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    constexpr MicroReg RAX = MicroReg::intReg(0);
+    constexpr MicroReg RBX = MicroReg::intReg(1);
+    constexpr MicroReg RCX = MicroReg::intReg(2);
+    constexpr MicroReg RDX = MicroReg::intReg(3);
+    constexpr MicroReg RSP = MicroReg::intReg(4);
+    constexpr MicroReg R11 = MicroReg::intReg(11);
+
+    Result runPrologEpilogPass(MicroBuilder& builder, MicroPassContext& passContext)
+    {
+        MicroPrologEpilogPass pass;
+        MicroPassManager      passManager;
+        passManager.addStartPass(pass);
+
+        passContext.callConvKind           = CallConvKind::Swag;
+        passContext.preservePersistentRegs = true;
+        return builder.runPasses(passManager, nullptr, passContext);
+    }
+
+    uint32_t countOpcode(const MicroBuilder& builder, MicroInstrOpcode op)
+    {
+        uint32_t count = 0;
+        for (const MicroInstr& inst : builder.instructions().view())
+        {
+            if (inst.op == op)
+                ++count;
+        }
+
+        return count;
+    }
+
+    // rbx is callee-saved, so the function gets a push/pop epilogue the tail call has to run first.
+    void emitCallInReturnPosition(MicroBuilder& builder, bool markTailCall, uint8_t intArgMask = 0b1)
+    {
+        builder.emitLoadRegImm(RBX, ApInt(7, 64), MicroOpBits::B64);
+        builder.emitOpBinaryRegImm(RSP, ApInt(32, 64), MicroOp::Subtract, MicroOpBits::B64);
+        builder.emitLoadRegReg(RCX, RBX, MicroOpBits::B64);
+        builder.emitLoadRegImm(R11, ApInt(0x1000, 64), MicroOpBits::B64);
+        builder.emitCallReg(R11, CallConvKind::Swag, intArgMask, 0);
+        if (markTailCall)
+            builder.markLastCallTailCallCandidate();
+        builder.emitOpBinaryRegImm(RSP, ApInt(32, 64), MicroOp::Add, MicroOpBits::B64);
+        builder.emitLoadRegReg(RAX, RAX, MicroOpBits::B64);
+        builder.emitRet();
+    }
+}
+
+SWC_TEST_BEGIN(MicroTailCall_RewritesCallBeforeReturn)
+{
+    MicroBuilder builder(ctx);
+    emitCallInReturnPosition(builder, true);
+
+    MicroPassContext passContext;
+    SWC_RESULT(runPrologEpilogPass(builder, passContext));
+
+    if (countOpcode(builder, MicroInstrOpcode::CallIndirect) != 0)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::TailCallIndirect) != 1)
+        return Result::Error;
+    if (passContext.statsTailCalls != 1)
+        return Result::Error;
+
+    // The only epilogue is the one in front of the jump: the Ret behind it is dead.
+    if (countOpcode(builder, MicroInstrOpcode::Pop) != 1)
+        return Result::Error;
+
+    // Expected tail: mov rax, r11 / add rsp, 32 / epilogue / tailcall rax / ret.
+    const auto&         instructions = builder.instructions();
+    const auto&         operands     = builder.operands();
+    const MicroInstrRef retRef       = instructions.findPreviousInstructionRef(MicroInstrRef::invalid());
+    if (instructions.ptr(retRef)->op != MicroInstrOpcode::Ret)
+        return Result::Error;
+
+    MicroInstrRef     ref  = instructions.findPreviousInstructionRef(retRef);
+    const MicroInstr* inst = instructions.ptr(ref);
+    if (inst->op != MicroInstrOpcode::TailCallIndirect || inst->ops(operands)[0].reg != RAX)
+        return Result::Error;
+
+    bool     sawPop        = false;
+    uint64_t stackReleased = 0;
+    for (ref = instructions.findPreviousInstructionRef(ref); ref.isValid(); ref = instructions.findPreviousInstructionRef(ref))
+    {
+        inst                         = instructions.ptr(ref);
+        const MicroInstrOperand* ops = inst->ops(operands);
+        if (inst->op == MicroInstrOpcode::Pop && ops[0].reg == RBX)
+            sawPop = true;
+        else if (inst->op == MicroInstrOpcode::OpBinaryRegImm && ops[0].reg == RSP && ops[2].microOp == MicroOp::Add)
+            stackReleased += ops[3].valueU64;
+        else
+            break;
+    }
+
+    // The call's own 32 bytes come back along with whatever the epilogue releases.
+    if (!sawPop || stackReleased < 32)
+        return Result::Error;
+
+    const MicroInstrOperand* moveOps = inst->ops(operands);
+    if (inst->op != MicroInstrOpcode::LoadRegReg || moveOps[0].reg != RAX || moveOps[1].reg != R11)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(MicroTailCall_KeepsUnmarkedCall)
+{
+    MicroBuilder builder(ctx);
+    emitCallInReturnPosition(builder, false);
+
+    MicroPassContext passContext;
+    SWC_RESULT(runPrologEpilogPass(builder, passContext));
+
+    if (countOpcode(builder, MicroInstrOpcode::CallIndirect) != 1)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::TailCallIndirect) != 0)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(MicroTailCall_KeepsCallReceivingFrameAddress)
+{
+    MicroBuilder builder(ctx);
+    builder.emitLoadAddressRegMem(RDX, RSP, 40, MicroOpBits::B64);
+    emitCallInReturnPosition(builder, true, 0b11);
+
+    MicroPassContext passContext;
+    SWC_RESULT(runPrologEpilogPass(builder, passContext));
+
+    // The callee may still read through rdx: the frame has to outlive the call.
+    if (countOpcode(builder, MicroInstrOpcode::CallIndirect) != 1)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::TailCallIndirect) != 0)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(MicroTailCall_KeepsCallWithWorkAfterIt)
+{
+    MicroBuilder builder(ctx);
+    builder.emitLoadRegImm(RBX, ApInt(7, 64), MicroOpBits::B64);
+    builder.emitLoadRegReg(RCX, RBX, MicroOpBits::B64);
+    builder.emitLoadRegImm(R11, ApInt(0x1000, 64), MicroOpBits::B64);
+    builder.emitCallReg(R11, CallConvKind::Swag, 0b1, 0);
+    builder.markLastCallTailCallCandidate();
+    builder.emitOpBinaryRegImm(RAX, ApInt(1, 64), MicroOp::Add, MicroOpBits::B64);
+    builder.emitRet();
+
+    MicroPassContext passContext;
+    SWC_RESULT(runPrologEpilogPass(builder, passContext));
+
+    if (countOpcode(builder, MicroInstrOpcode::CallIndirect) != 1)
+        return Result::Error;
+    if (countOpcode(builder, MicroInstrOpcode::TailCallIndirect) != 0)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(MicroTailCall_DedupKeyCoversCandidacy)
+{
+    MicroBuilder marked(ctx);
+    MicroBuilder unmarked(ctx);
+    MicroBuilder markedAgain(ctx);
+    emitCallInReturnPosition(marked, true);
+    emitCallInReturnPosition(unmarked, false);
+    emitCallInReturnPosition(markedAgain, true);
+
+    // Same instructions: only the mark tells whether the call may become a jump, so a shared
+    // lowering of one stream must never be handed to the other.
+    MicroPassContext passContext;
+    passContext.callConvKind           = CallConvKind::Swag;
+    passContext.preservePersistentRegs = true;
+    const MachineCodeDedup::Key markedKey      = MachineCodeDedup::computeKey(marked, passContext);
+    const MachineCodeDedup::Key unmarkedKey    = MachineCodeDedup::computeKey(unmarked, passContext);
+    const MachineCodeDedup::Key markedAgainKey = MachineCodeDedup::computeKey(markedAgain, passContext);
+    if (markedKey == unmarkedKey)
+        return Result::Error;
+    if (markedKey != markedAgainKey)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
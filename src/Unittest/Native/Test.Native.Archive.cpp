@@ -0,0 +1,97 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Backend/Linker/Archive.h"
+#include "Main/FileSystem.h"
+#include "Support/Os/Os.h"
+#include "Support/Report/Diagnostic.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    void makeExportNames(std::vector<Utf8>& outNames)
+    {
+        for (uint32_t i = 0; i < 300; ++i)
+            outNames.push_back(Utf8(std::format("Export{}", i)));
+    }
+
+    // Every export resolves to a short-import record naming it, and nothing else resolves.
+    bool resolvesExports(const Archive& archive, const std::vector<Utf8>& names)
+    {
+        for (const Utf8& name : names)
+        {
+            Diagnostic    diag;
+            ArchiveImport import;
+            const auto    memberOffset = archive.memberOffsetForSymbol(name);
+            if (!memberOffset || !archive.tryReadImport(import, diag, memberOffset) || import.importName != name)
+                return false;
+            if (!archive.memberOffsetForSymbol("__imp_" + name))
+                return false;
+        }
+
+        return !archive.memberOffsetForSymbol("Export") && !archive.memberOffsetForSymbol("Export300");
+    }
+}
+
+SWC_TEST_BEGIN(Archive_ResolvesEverySymbolOfAnImportLibrary)
+{
+    SWC_UNUSED(ctx);
+
+    std::vector<Utf8> names;
+    makeExportNames(names);
+
+    ByteArray bytes;
+    buildCoffImportLibrary(bytes, "test.dll", names);
+
+    Archive    archive;
+    Diagnostic diag;
+    if (!archive.load(diag, std::move(bytes)) || !resolvesExports(archive, names))
+        return Result::Error;
+
+    ByteArray notAnArchive(64, std::byte{0});
+    if (archive.load(diag, std::move(notAnArchive)))
+        return Result::Error;
+}
+SWC_TEST_END()
+
+// The first load of a file stores its index and the second one reads it back; both must answer
+// like an archive decoded from memory.
+SWC_FILESYSTEM_TEST_BEGIN(Archive_MappedFileReusesItsStoredIndex)
+{
+    SWC_UNUSED(ctx);
+
+    std::vector<Utf8> names;
+    makeExportNames(names);
+
+    ByteArray bytes;
+    buildCoffImportLibrary(bytes, "test.dll", names);
+
+    const fs::path  dir  = (Os::getTemporaryPath() / "swc_unittest" / "archive" / std::format("index_p{}", Os::currentProcessId())).lexically_normal();
+    const fs::path  path = dir / "test.lib";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    FileSystem::IoErrorInfo ioError;
+    if (FileSystem::writeBinaryFile(path, bytes.data(), bytes.size(), ioError) != Result::Continue)
+        return Result::Error;
+
+    Result result = Result::Continue;
+    for (const bool readIndexCache : {false, true, true})
+    {
+        Archive    archive;
+        Diagnostic diag;
+        if (!archive.loadFile(diag, path, readIndexCache) || !resolvesExports(archive, names))
+            result = Result::Error;
+    }
+
+    fs::remove_all(dir, ec);
+    return result;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -2,6 +2,7 @@
 
 #if SWC_HAS_UNITTEST
 
+#include "Backend/Linker/PdbWriter.h"
 #include "Backend/Linker/PeWriter.h"
 #include "Support/Os/Os.h"
 #include "Support/Report/Diagnostic.h"
@@ -57,6 +58,20 @@ namespace
 
         return false;
     }
+
+    // Every function sits at a fixed offset derived from its name, in section 1.
+    struct FixedSymbolResolver final : PdbWriter::SymbolResolver
+    {
+        PdbSymbolAddress resolve(const Utf8& symbolName) const override
+        {
+            return {.found = true, .segment = 1, .offset = static_cast<uint32_t>(std::stoul(std::string(symbolName.view().substr(2)))) * 16};
+        }
+
+        PdbSymbolAddress resolveSection(const Utf8&, uint32_t) const override
+        {
+            return {};
+        }
+    };
 }
 
 // Builds a tiny executable plus its PDB through the internal writer, then loads them with dbghelp -- the
@@ -298,6 +313,59 @@ SWC_FILESYSTEM_TEST_BEGIN(Pdb_DbgHelpResolvesNamesAndLines)
 }
 SWC_TEST_END()
 
+// Module streams built in parallel must land in the same PDB, byte for byte, as a serial build.
+SWC_TEST_BEGIN(Pdb_ParallelModuleStreamsMatchSerial)
+{
+    constexpr uint32_t numObjects   = 16;
+    constexpr uint32_t numFunctions = 512;
+
+    LinkDebugInfo dbg;
+    dbg.enabled = true;
+    for (uint32_t i = 0; i < numObjects; ++i)
+    {
+        LinkDebugFile file;
+        file.path = Utf8(std::format("src/file{}.swg", i));
+        dbg.files.push_back(std::move(file));
+        dbg.objectNames.push_back(Utf8(std::format("obj{}.obj", i)));
+    }
+
+    for (uint32_t i = 0; i < numFunctions; ++i)
+    {
+        LinkDebugFunction fn;
+        fn.symbolName       = Utf8(std::format("fn{}", i));
+        fn.displayName      = fn.symbolName;
+        fn.codeSize         = 16;
+        fn.objIndex         = i % numObjects;
+        fn.primaryFileIndex = fn.objIndex;
+
+        LinkDebugLineBlock block;
+        block.fileIndex   = fn.objIndex;
+        block.codeOffsets = {0, 8};
+        block.lines       = {i + 1, i + 2};
+        fn.lineBlocks.push_back(std::move(block));
+        dbg.functions.push_back(std::move(fn));
+    }
+
+    std::vector<PdbSectionInfo> sections;
+    sections.push_back({.name = ".text", .rva = 0x1000, .virtualSize = numFunctions * 16, .rawSize = numFunctions * 16, .fileOffset = 0x400, .characteristics = 0x60000020});
+
+    const FixedSymbolResolver resolver;
+    const auto                buildPdb = [&](ByteArray& outBytes, TaskContext* workerCtx) {
+        std::array<uint8_t, 16> guid{};
+        uint32_t                age       = 0;
+        uint32_t                signature = 0;
+        PdbWriter::build(outBytes, guid, age, signature, dbg, sections, resolver, "test.exe", "test.pdb", workerCtx);
+    };
+
+    ByteArray serialBytes;
+    ByteArray parallelBytes;
+    buildPdb(serialBytes, nullptr);
+    buildPdb(parallelBytes, &ctx);
+    if (serialBytes.empty() || !std::ranges::equal(serialBytes.span(), parallelBytes.span()))
+        return Result::Error;
+}
+SWC_TEST_END()
+
 SWC_END_NAMESPACE();
 
 #endif
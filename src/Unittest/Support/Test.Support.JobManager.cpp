@@ -4,6 +4,8 @@
 
 #include "Main/Command/CommandLine.h"
 #include "Main/Global.h"
+#include "Support/Core/Timer.h"
+#include "Support/Core/Utf8Helper.h"
 #include "Support/Thread/JobManager.h"
 #include "Unittest/Unittest.h"
 
@@ -90,6 +92,76 @@ namespace
     private:
         std::atomic<uint32_t>* count_ = nullptr;
     };
+
+    // One node of an implicit binary tree: node i enqueues nodes 2i+1 and 2i+2 from inside its
+    // own exec(), so children land in the running worker's deque and idle workers must steal.
+    class SpawnTreeJob final : public Job
+    {
+    public:
+        SpawnTreeJob(const TaskContext& ctx, JobManager& jobMgr, std::vector<std::unique_ptr<SpawnTreeJob>>& tree, uint32_t index, uint32_t workPerJob, std::atomic<uint32_t>& count) :
+            Job(ctx, JobKind::Sema),
+            jobMgr_(&jobMgr),
+            tree_(&tree),
+            index_(index),
+            workPerJob_(workPerJob),
+            count_(&count)
+        {
+        }
+
+        JobResult exec() override
+        {
+            for (const uint32_t child : {2 * index_ + 1, 2 * index_ + 2})
+            {
+                if (child < tree_->size())
+                    jobMgr_->enqueue(*(*tree_)[child], JobPriority::Normal, clientId());
+            }
+
+            uint64_t h = index_;
+            for (uint32_t i = 0; i < workPerJob_; ++i)
+                h = h * 0x9E3779B97F4A7C15ull + i;
+            sink_ = h;
+
+            count_->fetch_add(1, std::memory_order_relaxed);
+            return JobResult::Done;
+        }
+
+    private:
+        JobManager*                                 jobMgr_     = nullptr;
+        std::vector<std::unique_ptr<SpawnTreeJob>>* tree_       = nullptr;
+        uint32_t                                    index_      = 0;
+        uint32_t                                    workPerJob_ = 0;
+        std::atomic<uint32_t>*                      count_      = nullptr;
+        volatile uint64_t                           sink_       = 0;
+    };
+
+    Result runSpawnTree(uint32_t numCores, uint32_t numJobs, uint32_t workPerJob, uint64_t* outDurationNs)
+    {
+        CommandLine cmdLine;
+        cmdLine.numCores = numCores;
+
+        JobManager jobMgr;
+        jobMgr.setup(cmdLine);
+
+        const Global      global;
+        const TaskContext jobCtx(global, cmdLine);
+        const auto        clientId = jobMgr.newClientId();
+
+        std::atomic<uint32_t>                      count{0};
+        std::vector<std::unique_ptr<SpawnTreeJob>> tree;
+        tree.reserve(numJobs);
+        for (uint32_t index = 0; index < numJobs; ++index)
+            tree.push_back(std::make_unique<SpawnTreeJob>(jobCtx, jobMgr, tree, index, workPerJob, count));
+
+        const Timer::Tick startTick = Timer::Clock::now();
+        jobMgr.enqueue(*tree.front(), JobPriority::Normal, clientId);
+        jobMgr.waitAll(clientId);
+        if (outDurationNs)
+            *outDurationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Timer::Clock::now() - startTick).count();
+
+        if (count.load(std::memory_order_relaxed) != numJobs)
+            return Result::Error;
+        return Result::Continue;
+    }
 }
 
 SWC_TEST_BEGIN(JobManager_DebugStateReportsSleepingJobs)
@@ -181,6 +253,65 @@ SWC_TEST_BEGIN(JobManager_TargetedWakeBySymbol)
 }
 SWC_TEST_END()
 
+// Jobs spawned from inside a worker go to that worker's own deque; the tree only completes if the
+// other workers steal them and the per-client counter tracks every hop.
+SWC_TEST_BEGIN(JobManager_WorkStealingDrainsSpawnedJobs)
+{
+    SWC_RESULT(runSpawnTree(4, 1023, 0, nullptr));
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(JobManager_ParallelForIndexedVisitsEveryIndex)
+{
+    CommandLine cmdLine;
+    cmdLine.numCores = 4;
+
+    JobManager jobMgr;
+    jobMgr.setup(cmdLine);
+
+    const Global global;
+    TaskContext  jobCtx(global, cmdLine);
+    const auto   clientId = jobMgr.newClientId();
+
+    constexpr uint32_t    count = 257;
+    std::vector<uint32_t> visits(count, 0);
+    jobMgr.parallelForIndexed(jobCtx, count, JobKind::Sema, clientId, [&](TaskContext&, uint32_t index) { visits[index]++; });
+
+    for (const uint32_t v : visits)
+    {
+        if (v != 1)
+            return Result::Error;
+    }
+}
+SWC_TEST_END()
+
+// Scaling of the scheduler itself: many short jobs that spawn each other, run with 1 to N workers.
+SWC_BENCHMARK_TEST_BEGIN(JobManager_StressScaling)
+{
+    constexpr uint32_t numJobs    = 1u << 16;
+    constexpr uint32_t workPerJob = 1024;
+
+    const uint32_t        maxCores = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> coreCounts;
+    for (uint32_t numCores = 1; numCores < maxCores; numCores *= 2)
+        coreCounts.push_back(numCores);
+    coreCounts.push_back(maxCores);
+
+    uint64_t baseNs = 0;
+    for (const uint32_t numCores : coreCounts)
+    {
+        uint64_t durationNs = 0;
+        SWC_RESULT(runSpawnTree(numCores, numJobs, workPerJob, &durationNs));
+        if (numCores == 1)
+            baseNs = durationNs;
+
+        const double speedup = durationNs ? static_cast<double>(baseNs) / static_cast<double>(durationNs) : 0.0;
+        const Utf8   result  = std::format("{} jobs, {} ({:.2f}x)", Utf8Helper::toNiceBigNumber(numJobs), Utf8Helper::toNiceTime(Timer::toSeconds(durationNs)), speedup);
+        Unittest::logBenchmark(ctx, std::format("JobManager-{}w", numCores), result);
+    }
+}
+SWC_TEST_END()
+
 SWC_END_NAMESPACE();
 
 #endif
@@ -0,0 +1,87 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Support/Memory/ScratchArena.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    // Leaves the scope on every exit path, after the containers declared below it are gone.
+    class ScratchScope
+    {
+    public:
+        ScratchScope() :
+            mark_(ScratchArena::enter())
+        {
+        }
+
+        ~ScratchScope() { ScratchArena::leave(mark_); }
+
+        ScratchScope(const ScratchScope&)            = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+
+    private:
+        ScratchArena::Mark mark_;
+    };
+}
+
+SWC_TEST_BEGIN(ScratchArena_NestedScopeRewindsOnlyItsOwnAllocations)
+{
+    SWC_UNUSED(ctx);
+
+    const ScratchScope  outerScope;
+    ScratchArena* const arena = ScratchArena::active();
+    if (!arena)
+        return Result::Error;
+
+    ScratchVector<uint64_t> outer;
+    for (uint64_t i = 0; i < 1000; ++i)
+        outer.push_back(i);
+
+    void* first = nullptr;
+    {
+        const ScratchScope innerScope;
+        first = arena->allocate(256, 64);
+    }
+
+    if (reinterpret_cast<uintptr_t>(first) % 64)
+        return Result::Error;
+
+    // The inner scope is gone: the next allocation lands where its first one did.
+    if (arena->allocate(256, 64) != first)
+        return Result::Error;
+
+    for (uint64_t i = 0; i < outer.size(); ++i)
+    {
+        if (outer[i] != i)
+            return Result::Error;
+    }
+}
+SWC_TEST_END()
+
+SWC_TEST_BEGIN(ScratchArena_SpillsLargeRequestsAndReleasesTheTop)
+{
+    SWC_UNUSED(ctx);
+
+    const ScratchScope  scope;
+    ScratchArena* const arena = ScratchArena::active();
+
+    ScratchSmallVector<uint32_t, 4> values;
+    for (uint32_t i = 0; i < 100000; ++i)
+        values.push_back(i);
+    if (values.size() != 100000 || values.back() != 99999)
+        return Result::Error;
+
+    void* top = arena->allocate(32, 8);
+    arena->release(top, 32);
+    if (arena->allocate(32, 8) != top)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -0,0 +1,62 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Main/Command/CommandLine.h"
+#include "Main/Global.h"
+#include "Support/Core/StatCounter.h"
+#include "Support/Thread/JobManager.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    // Counters are never released, so every run of the test shares one.
+    const StatCounter& testCounter()
+    {
+        static StatCounter counter;
+        return counter;
+    }
+}
+
+SWC_TEST_BEGIN(StatCounter_SumsTheSlabsOfEveryWorker)
+{
+    SWC_UNUSED(ctx);
+
+    CommandLine cmdLine;
+    cmdLine.numCores = 4;
+
+    JobManager jobMgr;
+    jobMgr.setup(cmdLine);
+
+    const Global global;
+    TaskContext  jobCtx(global, cmdLine);
+
+    constexpr uint32_t numTasks      = 64;
+    constexpr uint32_t addsPerTask   = 1000;
+    const StatCounter& counter       = testCounter();
+    const uint64_t     countedBefore = counter.load();
+
+    jobMgr.parallelForIndexed(jobCtx, numTasks, JobKind::Sema, jobMgr.newClientId(), [&](TaskContext&, const uint32_t index) {
+        for (uint32_t i = 0; i < addsPerTask; ++i)
+            counter.add(index + 1);
+    });
+
+    const uint64_t expected = static_cast<uint64_t>(addsPerTask) * numTasks * (numTasks + 1) / 2;
+    if (counter.load() - countedBefore != expected)
+        return Result::Error;
+
+    StatCounter::resetAll();
+    if (counter.load() != 0)
+        return Result::Error;
+
+    counter.add(3);
+    if (counter.load() != 3)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -0,0 +1,404 @@
+#include "pch.h"
+
+#if SWC_HAS_UNITTEST
+
+#include "Main/FileSystem.h"
+#include "Main/Trace.h"
+#include "Unittest/Unittest.h"
+
+SWC_BEGIN_NAMESPACE();
+
+namespace
+{
+    struct JsonValue
+    {
+        enum class Kind : uint8_t
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+        Kind                                    kind    = Kind::Null;
+        bool                                    boolean = false;
+        double                                  number  = 0;
+        Utf8                                    string;
+        std::vector<JsonValue>                  array;
+        std::vector<std::pair<Utf8, JsonValue>> object;
+
+        const JsonValue* find(const std::string_view key) const
+        {
+            for (const auto& [name, value] : object)
+            {
+                if (name == key)
+                    return &value;
+            }
+
+            return nullptr;
+        }
+    };
+
+    // Strict reader for the subset of JSON the trace writer can produce: anything it does not
+    // understand, including trailing bytes, makes the document invalid.
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(const std::string_view text) :
+            text_(text)
+        {
+        }
+
+        bool parseDocument(JsonValue& out)
+        {
+            if (!parseValue(out))
+                return false;
+            skipBlanks();
+            return pos_ == text_.size();
+        }
+
+    private:
+        void skipBlanks()
+        {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' || text_[pos_] == '\t'))
+                ++pos_;
+        }
+
+        bool consume(const char c)
+        {
+            skipBlanks();
+            if (pos_ >= text_.size() || text_[pos_] != c)
+                return false;
+            ++pos_;
+            return true;
+        }
+
+        bool parseLiteral(const std::string_view word)
+        {
+            if (!text_.substr(pos_).starts_with(word))
+                return false;
+            pos_ += word.size();
+            return true;
+        }
+
+        bool parseString(Utf8& out)
+        {
+            if (!consume('"'))
+                return false;
+
+            while (pos_ < text_.size())
+            {
+                const char c = text_[pos_++];
+                if (c == '"')
+                    return true;
+                if (static_cast<unsigned char>(c) < 0x20)
+                    return false;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+
+                if (pos_ >= text_.size())
+                    return false;
+                switch (text_[pos_++])
+                {
+                    case '"':
+                        out += '"';
+                        break;
+                    case '\\':
+                        out += '\\';
+                        break;
+                    case '/':
+                        out += '/';
+                        break;
+                    case 'n':
+                        out += '\n';
+                        break;
+                    case 'r':
+                        out += '\r';
+                        break;
+                    case 't':
+                        out += '\t';
+                        break;
+                    case 'u':
+                    {
+                        uint32_t code = 0;
+                        if (pos_ + 4 > text_.size() || std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, code, 16).ptr != text_.data() + pos_ + 4)
+                            return false;
+                        if (code >= 0x80)
+                            return false;
+                        out += static_cast<char>(code);
+                        pos_ += 4;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+
+            return false;
+        }
+
+        bool parseNumber(double& out)
+        {
+            const char* first      = text_.data() + pos_;
+            const char* last       = text_.data() + text_.size();
+            const auto [ptr, errc] = std::from_chars(first, last, out);
+            if (errc != std::errc{})
+                return false;
+            pos_ += static_cast<size_t>(ptr - first);
+            return true;
+        }
+
+        bool parseValue(JsonValue& out)
+        {
+            skipBlanks();
+            if (pos_ >= text_.size())
+                return false;
+
+            switch (text_[pos_])
+            {
+                case '{':
+                    out.kind = JsonValue::Kind::Object;
+                    ++pos_;
+                    if (consume('}'))
+                        return true;
+                    do
+                    {
+                        Utf8 key;
+                        if (!parseString(key) || !consume(':'))
+                            return false;
+                        JsonValue value;
+                        if (!parseValue(value))
+                            return false;
+                        out.object.emplace_back(std::move(key), std::move(value));
+                    } while (consume(','));
+                    return consume('}');
+
+                case '[':
+                    out.kind = JsonValue::Kind::Array;
+                    ++pos_;
+                    if (consume(']'))
+                        return true;
+                    do
+                    {
+                        JsonValue value;
+                        if (!parseValue(value))
+                            return false;
+                        out.array.push_back(std::move(value));
+                    } while (consume(','));
+                    return consume(']');
+
+                case '"':
+                    out.kind = JsonValue::Kind::String;
+                    return parseString(out.string);
+
+                case 't':
+                    out.kind    = JsonValue::Kind::Bool;
+                    out.boolean = true;
+                    return parseLiteral("true");
+
+                case 'f':
+                    out.kind = JsonValue::Kind::Bool;
+                    return parseLiteral("false");
+
+                case 'n':
+                    return parseLiteral("null");
+
+                default:
+                    out.kind = JsonValue::Kind::Number;
+                    return parseNumber(out.number);
+            }
+        }
+
+        std::string_view text_;
+        size_t           pos_ = 0;
+    };
+
+    struct TraceSpan
+    {
+        Utf8   name;
+        double begin = 0;
+        double end   = 0;
+    };
+
+    bool readString(const JsonValue& event, const std::string_view key, Utf8& out)
+    {
+        const JsonValue* value = event.find(key);
+        if (!value || value->kind != JsonValue::Kind::String)
+            return false;
+        out = value->string;
+        return true;
+    }
+
+    bool readNumber(const JsonValue& event, const std::string_view key, double& out)
+    {
+        const JsonValue* value = event.find(key);
+        if (!value || value->kind != JsonValue::Kind::Number)
+            return false;
+        out = value->number;
+        return true;
+    }
+
+    // Spans are written as complete events, a begin and its matching end in one record. Read as
+    // begin/end pairs, those of one thread must nest: no span may end after an enclosing span
+    // does, or a viewer pairs the ends with the wrong begins.
+    bool spansNest(std::vector<TraceSpan>& spans)
+    {
+        constexpr double epsilon = 0.0005;
+        std::ranges::sort(spans, [](const TraceSpan& a, const TraceSpan& b) {
+            if (a.begin != b.begin)
+                return a.begin < b.begin;
+            return a.end > b.end;
+        });
+
+        std::vector<const TraceSpan*> open;
+        for (const TraceSpan& span : spans)
+        {
+            while (!open.empty() && open.back()->end <= span.begin + epsilon)
+                open.pop_back();
+            if (!open.empty() && span.end > open.back()->end + epsilon)
+                return false;
+            open.push_back(&span);
+        }
+
+        return true;
+    }
+
+    bool hasSpan(const std::vector<TraceSpan>& spans, const std::string_view name, const double begin, const double end)
+    {
+        constexpr double epsilon = 0.0005;
+        for (const TraceSpan& span : spans)
+        {
+            if (span.name == name && std::abs(span.begin - begin) < epsilon && std::abs(span.end - end) < epsilon)
+                return true;
+        }
+
+        return false;
+    }
+}
+
+SWC_FILESYSTEM_TEST_BEGIN(Trace_WritesWellFormedChromeJson)
+{
+    SWC_UNUSED(ctx);
+    Trace::clear();
+
+    constexpr std::string_view symbolWithEscapes = "a\"b\\c\nd\x01";
+
+    TraceArgs outerArgs;
+    outerArgs.reason = "test";
+    outerArgs.file   = "C:\\trace\\file.swg";
+    outerArgs.symbol = symbolWithEscapes;
+    Trace::addSpan(TraceEventKind::Job, "TraceTestInner", 200'000, 300'000);
+    Trace::addInstant(TraceEventKind::Wake, "TraceTestWake", 250'000);
+    Trace::addSpan(TraceEventKind::Job, "TraceTestOuter", 100'000, 500'000, std::move(outerArgs));
+    Trace::addSpan(TraceEventKind::Idle, "TraceTestSibling", 600'000, 700'000);
+
+    std::thread other([] {
+        Trace::setThreadName("Trace test \"other\"");
+        Trace::addSpan(TraceEventKind::Pass, "TraceTestOther", 150'000, 450'000);
+    });
+    other.join();
+
+    const fs::path  dir = fs::temp_directory_path() / "swc_trace_test";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    const fs::path path = dir / "trace.json";
+
+    FileSystem::IoErrorInfo ioError;
+    const Result            writeResult = Trace::write(path, ioError);
+    Trace::clear();
+    if (writeResult != Result::Continue)
+        return Result::Error;
+
+    std::vector<char> bytes;
+    const Result      readResult = FileSystem::readBinaryFile(path, bytes, ioError);
+    fs::remove_all(dir, ec);
+    if (readResult != Result::Continue)
+        return Result::Error;
+
+    JsonValue  root;
+    JsonReader reader(std::string_view(bytes.data(), bytes.size()));
+    if (!reader.parseDocument(root) || root.kind != JsonValue::Kind::Object)
+        return Result::Error;
+
+    const JsonValue* events = root.find("traceEvents");
+    if (!events || events->kind != JsonValue::Kind::Array)
+        return Result::Error;
+
+    std::map<uint32_t, std::vector<TraceSpan>> spansByThread;
+    bool                                       sawWake         = false;
+    bool                                       sawEscapedArgs  = false;
+    bool                                       sawQuotedThread = false;
+    for (const JsonValue& event : events->array)
+    {
+        Utf8   phase;
+        Utf8   name;
+        double pid = 0;
+        double tid = 0;
+        if (event.kind != JsonValue::Kind::Object ||
+            !readString(event, "ph", phase) ||
+            !readString(event, "name", name) ||
+            !readNumber(event, "pid", pid) ||
+            !readNumber(event, "tid", tid))
+            return Result::Error;
+
+        if (phase == "M")
+        {
+            const JsonValue* args = event.find("args");
+            Utf8             threadName;
+            if (!args || !readString(*args, "name", threadName))
+                return Result::Error;
+            sawQuotedThread |= threadName == "Trace test \"other\"";
+            continue;
+        }
+
+        double ts = 0;
+        if (!readNumber(event, "ts", ts))
+            return Result::Error;
+
+        if (phase == "i")
+        {
+            sawWake |= name == "TraceTestWake" && std::abs(ts - 250.0) < 0.0005;
+            continue;
+        }
+
+        double dur = 0;
+        if (phase != "X" || !readNumber(event, "dur", dur) || dur < 0)
+            return Result::Error;
+
+        if (name == "TraceTestOuter")
+        {
+            const JsonValue* args = event.find("args");
+            Utf8             symbol;
+            Utf8             file;
+            sawEscapedArgs = args && readString(*args, "symbol", symbol) && readString(*args, "file", file) && symbol == symbolWithEscapes && file == "C:\\trace\\file.swg";
+        }
+
+        spansByThread[static_cast<uint32_t>(tid)].push_back({.name = name, .begin = ts, .end = ts + dur});
+    }
+
+    if (!sawWake || !sawEscapedArgs || !sawQuotedThread)
+        return Result::Error;
+
+    bool sawOwnSpans   = false;
+    bool sawOtherSpans = false;
+    for (auto& spans : spansByThread | std::views::values)
+    {
+        if (!spansNest(spans))
+            return Result::Error;
+        sawOwnSpans |= hasSpan(spans, "TraceTestOuter", 100.0, 500.0) && hasSpan(spans, "TraceTestInner", 200.0, 300.0) && hasSpan(spans, "TraceTestSibling", 600.0, 700.0);
+        sawOtherSpans |= hasSpan(spans, "TraceTestOther", 150.0, 450.0) && !hasSpan(spans, "TraceTestOuter", 100.0, 500.0);
+    }
+
+    if (!sawOwnSpans || !sawOtherSpans)
+        return Result::Error;
+}
+SWC_TEST_END()
+
+SWC_END_NAMESPACE();
+
+#endif
@@ -29,7 +29,7 @@ namespace Unittest
 
         bool shouldRunTest(const CommandLine& cmdLine, const TestCase& test)
         {
-            if (test.kind == TestKind::Filesystem && !cmdLine.devFull)
+            if ((test.kind == TestKind::Filesystem || test.kind == TestKind::Benchmark) && !cmdLine.devFull)
                 return false;
 
             return true;
@@ -107,7 +107,7 @@ namespace Unittest
             return result;
         }
 
-        void logUnittestSummary(const TaskContext& ctx, const std::vector<TimedTestResult>& timedTests, uint64_t setupDurationNs, size_t skippedFilesystemTests)
+        void logUnittestSummary(const TaskContext& ctx, const std::vector<TimedTestResult>& timedTests, uint64_t setupDurationNs, size_t skippedFilesystemTests, size_t skippedBenchmarkTests)
         {
             const uint64_t totalTestDurationNs = totalTestDuration(timedTests);
             const Utf8     testsSummary        = std::format("{} tests ({})", Utf8Helper::toNiceBigNumber(timedTests.size()), formatDuration(totalTestDurationNs));
@@ -122,6 +122,12 @@ namespace Unittest
                 Logger::printHeaderDot(ctx, LogColor::BrightCyan, "Skipped", LogColor::White, skippedSummary);
             }
 
+            if (skippedBenchmarkTests)
+            {
+                const Utf8 skippedSummary = std::format("{} benchmark tests (run with --dev-full)", Utf8Helper::toNiceBigNumber(skippedBenchmarkTests));
+                Logger::printHeaderDot(ctx, LogColor::BrightCyan, "Skipped", LogColor::White, skippedSummary);
+            }
+
             std::vector<TimedTestResult> slowTests = timedTests;
             std::ranges::sort(slowTests, hasLongerDuration);
             const size_t count = std::min<size_t>(10, slowTests.size());
@@ -145,6 +151,12 @@ namespace Unittest
         setupRegistry().push_back(setupFn);
     }
 
+    void logBenchmark(const TaskContext& ctx, std::string_view name, std::string_view result)
+    {
+        const std::string header = std::format("Bench-{}", name);
+        Logger::printHeaderDot(ctx, LogColor::BrightCyan, header, LogColor::White, result);
+    }
+
     Result runAll(const TaskContext& ctx)
     {
         // Internal C++ unit tests must stay isolated from the caller inputs so they
@@ -159,6 +171,7 @@ namespace Unittest
         bool                         hasFailure             = false;
         uint64_t                     setupDurationNs        = 0;
         size_t                       skippedFilesystemTests = 0;
+        size_t                       skippedBenchmarkTests  = 0;
         size_t                       selectedTestCount      = 0;
         size_t                       executedTestCount      = 0;
         size_t                       failedTestCount        = 0;
@@ -188,6 +201,8 @@ namespace Unittest
             {
                 if (test.kind == TestKind::Filesystem)
                     ++skippedFilesystemTests;
+                else if (test.kind == TestKind::Benchmark)
+                    ++skippedBenchmarkTests;
                 continue;
             }
 
@@ -218,7 +233,7 @@ namespace Unittest
         }
 
         if (verboseUnittest)
-            logUnittestSummary(testCtx, timedTests, setupDurationNs, skippedFilesystemTests);
+            logUnittestSummary(testCtx, timedTests, setupDurationNs, skippedFilesystemTests, skippedBenchmarkTests);
 
         std::vector<Utf8> statParts;
         ScopedTimedLog::appendTestStats(testCtx, statParts, executedTestCount, failedTestCount);
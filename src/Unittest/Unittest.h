@@ -12,6 +12,7 @@ namespace Unittest
     {
         Fast,
         Filesystem,
+        Benchmark,
     };
 
     using TestFn  = Result (*)(TaskContext&);
@@ -27,6 +28,7 @@ namespace Unittest
     void   registerTest(const TestCase& test);
     void   registerSetup(SetupFn setupFn);
     Result runAll(const TaskContext& ctx);
+    void   logBenchmark(const TaskContext& ctx, std::string_view name, std::string_view result);
 
     class TestRegistrar
     {
@@ -68,6 +70,16 @@ namespace Unittest
         const swc::Unittest::TestRegistrar reg_##__name{#__name, &__name, swc::Unittest::TestKind::Filesystem}; \
         swc::Result                        __name(swc::TaskContext& ctx)                                        \
         {
+// Benchmarks measure scaling or throughput rather than correctness alone. They are too slow for the
+// per-launch run, so like filesystem tests they only run with --dev-full, and they report their
+// numbers through logBenchmark().
+#define SWC_BENCHMARK_TEST_BEGIN(__name)                                                                       \
+    namespace                                                                                                  \
+    {                                                                                                          \
+        swc::Result                        __name(swc::TaskContext&);                                          \
+        const swc::Unittest::TestRegistrar reg_##__name{#__name, &__name, swc::Unittest::TestKind::Benchmark}; \
+        swc::Result                        __name(swc::TaskContext& ctx)                                       \
+        {
 #define SWC_TEST_END()            \
     return swc::Result::Continue; \
     }                             \
@@ -71,7 +71,7 @@ namespace Backend::Unittest
         return Result::Continue;
     }
 
-    Result runEncodeCase(TaskContext& ctx, Encoder& encoder, const char* name, const char* expectedHex, const std::function<void(MicroBuilder&)>& fn)
+    Result runEncodeCase(TaskContext& ctx, Encoder& encoder, const char* name, const char* expectedHex, const std::function<void(MicroBuilder&)>& fn, bool relaxBranches)
     {
         MicroBuilder builder(ctx);
         fn(builder);
@@ -86,6 +86,7 @@ namespace Backend::Unittest
         passes.addStartPass(encodePass);
 
         MicroPassContext passCtx;
+        passCtx.relaxBranches = relaxBranches;
         SWC_RESULT(builder.runPasses(passes, &encoder, passCtx));
 
         if (encoder.size() == 0)
@@ -16,7 +16,7 @@ namespace Backend::Unittest
     };
 
     Result parseExpected(const char* text, std::vector<ExpectedByte>& result);
-    Result runEncodeCase(TaskContext& ctx, Encoder& encoder, const char* name, const char* expectedHex, const std::function<void(MicroBuilder&)>& fn);
+    Result runEncodeCase(TaskContext& ctx, Encoder& encoder, const char* name, const char* expectedHex, const std::function<void(MicroBuilder&)>& fn, bool relaxBranches = false);
 
     bool   isPersistentReg(MicroRegSpan regs, MicroReg reg);
     Result assertNoVirtualRegs(MicroBuilder& builder);
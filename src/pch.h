@@ -75,8 +75,10 @@ namespace fs = std::filesystem;
 #endif
 #endif
 
+// Statistics counters and phase timers are always built in. Memory profiling puts a header in
+// front of every heap allocation, so it stays opt-in.
 #ifdef SWC_FORCE_STATS
-#define SWC_HAS_STATS 1
+#define SWC_HAS_MEMORY_STATS 1
 #else
-#define SWC_HAS_STATS 0
+#define SWC_HAS_MEMORY_STATS 0
 #endif